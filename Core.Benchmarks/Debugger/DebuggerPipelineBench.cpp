@@ -2,6 +2,7 @@
 #include <array>
 #include <memory>
 #include <deque>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <random>
@@ -5,6 +5,7 @@
 #include <vector>
 #include <cstring>
 #include "Debugger/DebugTypes.h"
+#include "Debugger/DebuggerRefreshSnapshot.h"
 #include "Utilities/HexUtilities.h"
 #include "Utilities/StringUtilities.h"
 
@@ -534,3 +535,65 @@ static void BM_DebugRefresh_FullWindowRefresh_Simulation(benchmark::State& state
 	state.SetItemsProcessed(state.iterations() * kWindowRows);
 }
 BENCHMARK(BM_DebugRefresh_FullWindowRefresh_Simulation);
+
+// ---------------------------------------------------------------------------
+// 8. Batched Refresh Snapshot
+// ---------------------------------------------------------------------------
+// DebuggerRefreshSnapshot::GetSnapshot() replaces the per-view interop calls:
+// one copy of CPU state + PPU state + 64 disassembly rows + a 256-byte memory
+// view into a caller-owned buffer. Sections whose generation did not change
+// since the buffer was last filled are skipped.
+
+namespace {
+	class BenchRefreshSnapshot : public DebuggerRefreshSnapshot {
+	public:
+		BenchRefreshSnapshot() : DebuggerRefreshSnapshot(nullptr, nullptr) {}
+
+		void Fill(uint8_t cpuValue) {
+			vector<uint8_t> cpuState(256, cpuValue);
+			vector<uint8_t> ppuState(256, 2);
+			vector<CodeLineData> rows(kWindowRows);
+			vector<uint8_t> memory(256, 4);
+			UpdateSection(DebuggerRefreshSection::CpuState, cpuState.data(), (uint32_t)cpuState.size());
+			UpdateSection(DebuggerRefreshSection::PpuState, ppuState.data(), (uint32_t)ppuState.size());
+			UpdateSection(DebuggerRefreshSection::Disassembly, rows.data(), (uint32_t)(rows.size() * sizeof(CodeLineData)));
+			UpdateSection(DebuggerRefreshSection::Memory, memory.data(), (uint32_t)memory.size());
+		}
+
+		uint32_t Write(vector<uint8_t>& buffer) {
+			return WriteSnapshot(buffer.data(), (uint32_t)buffer.size());
+		}
+	};
+}
+
+// Every section changed (first refresh, or a new frame while scrolling)
+static void BM_DebugRefresh_Snapshot_AllChanged(benchmark::State& state) {
+	BenchRefreshSnapshot snapshot;
+	snapshot.Fill(1);
+	vector<uint8_t> buffer;
+	buffer.resize(snapshot.Write(buffer));
+
+	for (auto _ : state) {
+		std::fill(buffer.begin(), buffer.begin() + sizeof(DebuggerRefreshHeader), 0);
+		benchmark::DoNotOptimize(snapshot.Write(buffer));
+	}
+}
+BENCHMARK(BM_DebugRefresh_Snapshot_AllChanged);
+
+// Typical running-game refresh: only the CPU state changed, disassembly/memory are skipped
+static void BM_DebugRefresh_Snapshot_CpuStateChanged(benchmark::State& state) {
+	BenchRefreshSnapshot snapshot;
+	snapshot.Fill(1);
+	vector<uint8_t> buffer;
+	buffer.resize(snapshot.Write(buffer));
+	snapshot.Write(buffer);
+
+	uint8_t value = 1;
+	for (auto _ : state) {
+		state.PauseTiming();
+		snapshot.Fill(++value);
+		state.ResumeTiming();
+		benchmark::DoNotOptimize(snapshot.Write(buffer));
+	}
+}
+BENCHMARK(BM_DebugRefresh_Snapshot_CpuStateChanged);
@@ -0,0 +1,145 @@
+#include "pch.h"
+#include <unordered_set>
+#include <vector>
+#include "Debugger/MemorySearch.h"
+
+// =============================================================================
+// RAM Search Benchmarks
+// =============================================================================
+// A typical cheat hunt on SNES searches 128KB work RAM + save RAM (~384KB
+// total with a large cartridge RAM) and repeatedly narrows candidates with
+// "changed", "decreased" or "equal to N" filters.
+//
+// Measured here:
+//   - First pass over every address (worst case: all candidates alive)
+//   - A later narrowing pass with ~1% of the candidates left
+//   - The per-address loop with a hidden-address set used by the UI, as a
+//     baseline for the first pass
+// =============================================================================
+
+namespace {
+	constexpr uint32_t SearchSize = 384 * 1024;
+
+	vector<uint8_t> MakeMemory(uint32_t seed) {
+		vector<uint8_t> mem(SearchSize);
+		uint32_t lcg = seed;
+		for (uint32_t i = 0; i < SearchSize; i++) {
+			lcg = lcg * 1664525u + 1013904223u;
+			mem[i] = (uint8_t)(lcg >> 24);
+		}
+		return mem;
+	}
+
+	// Mutates ~1 byte in 16, like a frame of gameplay would
+	vector<uint8_t> Mutate(const vector<uint8_t>& src, uint32_t seed) {
+		vector<uint8_t> mem = src;
+		uint32_t lcg = seed;
+		for (uint32_t i = 0; i < SearchSize; i += 16) {
+			lcg = lcg * 1664525u + 1013904223u;
+			mem[i + (lcg >> 28)] -= 1;
+		}
+		return mem;
+	}
+
+	MemorySearchFilter MakeFilter(MemorySearchValueSize size, MemorySearchCompareTo compareTo, MemorySearchOperator op) {
+		MemorySearchFilter filter = {};
+		filter.ValueSize = size;
+		filter.CompareTo = compareTo;
+		filter.Operator = op;
+		filter.SpecificValue = 0x40;
+		return filter;
+	}
+}
+
+static void BM_MemorySearch_FirstPass(benchmark::State& state) {
+	MemorySearchValueSize size = (MemorySearchValueSize)state.range(0);
+	vector<uint8_t> before = MakeMemory(1);
+	vector<uint8_t> after = Mutate(before, 2);
+	MemorySearchFilter filter = MakeFilter(size, MemorySearchCompareTo::PreviousSearchValue, MemorySearchOperator::LessThan);
+
+	MemorySearch search(nullptr);
+	for (auto _ : state) {
+		state.PauseTiming();
+		search.Reset(MemoryType::SnesWorkRam, before.data(), SearchSize);
+		search.Refresh(after.data());
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(search.ApplyFilter(filter));
+	}
+	state.SetBytesProcessed(state.iterations() * SearchSize);
+}
+BENCHMARK(BM_MemorySearch_FirstPass)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMicrosecond);
+
+static void BM_MemorySearch_SpecificValue(benchmark::State& state) {
+	vector<uint8_t> mem = MakeMemory(3);
+	MemorySearchFilter filter = MakeFilter(MemorySearchValueSize::Word, MemorySearchCompareTo::SpecificValue, MemorySearchOperator::GreaterThanOrEqual);
+	filter.IsSigned = true;
+	filter.BigEndian = true;
+
+	MemorySearch search(nullptr);
+	for (auto _ : state) {
+		state.PauseTiming();
+		search.Reset(MemoryType::SnesWorkRam, mem.data(), SearchSize);
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(search.ApplyFilter(filter));
+	}
+	state.SetBytesProcessed(state.iterations() * SearchSize);
+}
+BENCHMARK(BM_MemorySearch_SpecificValue)->Unit(benchmark::kMicrosecond);
+
+static void BM_MemorySearch_NarrowingPass(benchmark::State& state) {
+	vector<uint8_t> before = MakeMemory(4);
+	vector<uint8_t> after = Mutate(before, 5);
+
+	MemorySearch search(nullptr);
+	search.Reset(MemoryType::SnesWorkRam, before.data(), SearchSize);
+	// Leaves ~1% of the addresses as candidates
+	search.ApplyFilter(MakeFilter(MemorySearchValueSize::Byte, MemorySearchCompareTo::SpecificValue, MemorySearchOperator::Equal));
+	search.ApplyFilter(MakeFilter(MemorySearchValueSize::Byte, MemorySearchCompareTo::SpecificValue, MemorySearchOperator::GreaterThanOrEqual));
+	search.Refresh(after.data());
+
+	MemorySearchFilter filter = MakeFilter(MemorySearchValueSize::Byte, MemorySearchCompareTo::PreviousRefreshValue, MemorySearchOperator::LessThanOrEqual);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(search.ApplyFilter(filter));
+		state.PauseTiming();
+		search.Undo();
+		state.ResumeTiming();
+	}
+	state.counters["candidates"] = search.GetCandidateCount();
+}
+BENCHMARK(BM_MemorySearch_NarrowingPass)->Unit(benchmark::kMicrosecond);
+
+static void BM_MemorySearch_GetResultsPage(benchmark::State& state) {
+	vector<uint8_t> mem = MakeMemory(6);
+	MemorySearch search(nullptr);
+	search.Reset(MemoryType::SnesWorkRam, mem.data(), SearchSize);
+	search.ApplyFilter(MakeFilter(MemorySearchValueSize::Byte, MemorySearchCompareTo::SpecificValue, MemorySearchOperator::LessThan));
+
+	MemorySearchResult page[100];
+	uint32_t offset = search.GetCandidateCount() / 2;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(search.GetResults(offset, page, 100, MemorySearchValueSize::Word, false));
+	}
+}
+BENCHMARK(BM_MemorySearch_GetResultsPage);
+
+// Baseline: per-address compare + hidden address set (same algorithm as the UI's AddFilter)
+static void BM_MemorySearch_PerAddressBaseline(benchmark::State& state) {
+	vector<uint8_t> before = MakeMemory(1);
+	vector<uint8_t> after = Mutate(before, 2);
+
+	for (auto _ : state) {
+		unordered_set<int> hidden;
+		for (uint32_t i = 0; i < SearchSize; i++) {
+			if (hidden.contains(i)) {
+				continue;
+			} else if (!(after[i] < before[i])) {
+				hidden.insert(i);
+			}
+		}
+		benchmark::DoNotOptimize(hidden.size());
+	}
+	state.SetBytesProcessed(state.iterations() * SearchSize);
+}
+BENCHMARK(BM_MemorySearch_PerAddressBaseline)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,285 @@
+#include "pch.h"
+#include <filesystem>
+#include "Shared/IdleLoopDetector.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "GBA/GbaConsole.h"
+#include "GBA/GbaCpu.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+
+// =============================================================================
+// GBA Idle Loop Skipping Benchmarks
+// =============================================================================
+// Many GBA games wait for VBlank by polling VCOUNT/DISPSTAT in a 3-instruction
+// loop instead of halting (VBlankIntrWait), which can be most of the frame's
+// executed instructions once the game logic is done.
+//
+// BM_GbaIdleLoop_Frame models one frame the same way GbaConsole::RunFrame runs it:
+//   - The "system" ticks one master clock at a time (PPU line/cycle counters
+//     + 4 timers with one running for audio, like ProcessInternalCycle)
+//   - The "CPU" fetches each opcode through a (non-inlined) bus read with ROM
+//     wait states, dispatches it through a function pointer table and ticks
+//     the system for each of its cycles
+//   - Game logic runs for the first ~25% of the frame, then the game polls
+//     VCOUNT until VBlank (line 160) and until the next frame (line 0)
+//
+// With skipping enabled, each taken backward branch is reported to
+// IdleLoopDetector and confirmed idle loops are skipped the same way
+// GbaMemoryManager::SkipIdleLoop does: the system is advanced to the cycle
+// before the next PPU event/timer overflow in one step, then the loop runs
+// normally through the event.
+//
+// BM_GbaIdleLoop_Console runs a generated ROM on a headless GbaConsole with the
+// same frame structure (logic loop, then VCOUNT polling until the next frame).
+// =============================================================================
+
+namespace {
+	constexpr uint32_t CyclesPerLine = 308 * 4;
+	constexpr uint32_t LinesPerFrame = 228;
+
+	struct MockSystem {
+		uint64_t MasterClock = 0;
+		uint16_t Cycle = 0;
+		uint16_t Scanline = 0;
+		uint32_t FrameCount = 0;
+		struct {
+			bool Enabled;
+			uint16_t PrescaleMask;
+			uint16_t Value;
+			uint16_t Reload;
+		} Timers[4] = { { true, 0, 0, 0xFC00 } };
+
+		__forceinline void Tick() {
+			MasterClock++;
+			if (++Cycle == CyclesPerLine) {
+				Cycle = 0;
+				if (++Scanline == LinesPerFrame) {
+					Scanline = 0;
+					FrameCount++;
+				}
+			}
+			for (auto& timer : Timers) {
+				if (timer.Enabled && (MasterClock & timer.PrescaleMask) == 0 && ++timer.Value == 0) {
+					timer.Value = timer.Reload;
+				}
+			}
+		}
+
+		uint32_t GetQuietCycles() {
+			uint64_t minCycles = (Cycle < 1006 ? 1006 : CyclesPerLine) - Cycle;
+			for (auto& timer : Timers) {
+				if (timer.Enabled) {
+					uint64_t firstTick = (MasterClock | timer.PrescaleMask) + 1;
+					minCycles = std::min(minCycles, firstTick + (uint64_t)(0xFFFF - timer.Value) * (timer.PrescaleMask + 1) - MasterClock);
+				}
+			}
+			return (uint32_t)minCycles - 1;
+		}
+
+		void FastForward(uint32_t cycles) {
+			for (auto& timer : Timers) {
+				if (timer.Enabled) {
+					uint64_t period = timer.PrescaleMask + 1;
+					timer.Value += (uint16_t)((MasterClock + cycles) / period - MasterClock / period);
+				}
+			}
+			Cycle += cycles;
+			MasterClock += cycles;
+		}
+	};
+
+	class MockCpu {
+	public:
+		typedef void (MockCpu::*Func)();
+
+		MockSystem& Sys;
+		IdleLoopDetector Detector;
+		bool SkipEnabled = false;
+		uint32_t Pc = 0;
+		uint32_t R[4] = {};
+		bool Zero = false;
+		uint32_t SideEffects = 0;
+		uint64_t Instructions = 0;
+		Func Program[8] = {};
+		uint16_t Rom[8] = {};
+		uint8_t WaitStates[16] = { 1, 1, 3, 1, 1, 1, 1, 1, 4, 4, 5, 5, 9, 9, 5, 5 };
+
+		MockCpu(MockSystem& sys) : Sys(sys) {
+			// 0-2: game logic loop (writes to RAM), 3-5: VCOUNT == R1 polling loop, 6: switch wait target
+			Program[0] = &MockCpu::LogicAlu;
+			Program[1] = &MockCpu::LogicStore;
+			Program[2] = &MockCpu::LogicBranch;
+			Program[3] = &MockCpu::LoadVcount;
+			Program[4] = &MockCpu::Compare;
+			Program[5] = &MockCpu::BranchNotEqual;
+			Program[6] = &MockCpu::NextWait;
+			R[1] = 160;
+		}
+
+		void Tick(uint32_t cycles) {
+			for (uint32_t i = 0; i < cycles; i++) {
+				Sys.Tick();
+			}
+		}
+
+		__noinline uint16_t Fetch() {
+			// ROM fetch: wait states depend on the region (bank 8) and the access
+			Tick(WaitStates[0x08 | (Pc & 0x01)]);
+			return Rom[Pc & 0x07];
+		}
+
+		void Branch(uint32_t target) {
+			if (SkipEnabled && target < Pc) {
+				uint32_t stateHash = (uint32_t)IdleLoopDetector::HashState(R, 4, Zero);
+				if (Detector.ProcessBranch(Pc * 2, target * 2, stateHash, SideEffects, Sys.MasterClock)) {
+					Pc = target;
+					Skip();
+					return;
+				}
+			}
+			Pc = target;
+		}
+
+		void Skip() {
+			uint32_t quietCycles = Sys.GetQuietCycles();
+			Sys.FastForward(quietCycles);
+			Detector.ProcessSkippedCycles(quietCycles);
+		}
+
+		void LogicAlu() { R[2] = R[2] * 3 + 1; Pc++; Tick(1); }
+		void LogicStore() { SideEffects++; Pc++; Tick(2); }
+		void LogicBranch() {
+			Tick(3);
+			if (++R[3] < 4500) {
+				Branch(0);
+			} else {
+				R[3] = 0;
+				Pc = 3;
+			}
+		}
+		void LoadVcount() { R[0] = Sys.Scanline; Pc++; Tick(4); }
+		void Compare() { Zero = R[0] == R[1]; Pc++; Tick(1); }
+		void BranchNotEqual() {
+			Tick(3);
+			if (!Zero) {
+				Branch(3);
+			} else {
+				Pc++;
+			}
+		}
+		void NextWait() {
+			Tick(1);
+			// Wait for VBlank, then for line 0 and run the next frame's logic
+			if (R[1] == 160) {
+				R[1] = 0;
+				Pc = 3;
+			} else {
+				R[1] = 160;
+				Pc = 0;
+			}
+		}
+
+		void RunFrame() {
+			uint32_t frameCount = Sys.FrameCount;
+			while (frameCount == Sys.FrameCount) {
+				benchmark::DoNotOptimize(Fetch());
+				(this->*Program[Pc])();
+				Instructions++;
+			}
+		}
+	};
+}
+
+static void BM_GbaIdleLoop_Frame(benchmark::State& state) {
+	MockSystem sys;
+	MockCpu cpu(sys);
+	cpu.SkipEnabled = state.range(0) != 0;
+
+	for (auto _ : state) {
+		cpu.RunFrame();
+	}
+	state.counters["fps"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+	state.counters["instr/frame"] = (double)cpu.Instructions / state.iterations();
+}
+BENCHMARK(BM_GbaIdleLoop_Frame)->ArgName("skip")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Cost of reporting branches for code that is never idle (e.g. game logic loops with writes)
+static void BM_GbaIdleLoop_DetectorOverhead(benchmark::State& state) {
+	IdleLoopDetector detector;
+	uint64_t clock = 0;
+	uint32_t sideEffects = 0;
+	uint32_t regs[15] = {};
+
+	for (auto _ : state) {
+		clock += 12;
+		sideEffects++;
+		regs[0]++;
+		uint64_t hash = IdleLoopDetector::HashState(regs, 15, 0x1F);
+		benchmark::DoNotOptimize(detector.ProcessBranch(0x08000120, 0x08000100, hash, sideEffects, clock));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GbaIdleLoop_DetectorOverhead);
+
+namespace {
+	vector<uint8_t> BuildIdleLoopRom() {
+		vector<uint8_t> rom(0x1000, 0);
+		auto writeArm = [&](size_t offset, std::initializer_list<uint32_t> opCodes) {
+			for (uint32_t opCode : opCodes) {
+				for (int i = 0; i < 4; i++) {
+					rom[offset++] = (uint8_t)(opCode >> (i * 8));
+				}
+			}
+		};
+
+		writeArm(0, {0xEA00002E}); // b $080000C0
+		rom[0xB2] = 0x96;          // Fixed header value
+
+		writeArm(0xC0, {
+			0xE3A00301, // mov r0, #$04000000
+			0xE3A01B01, // mov r1, #$400
+			0xE3811003, // orr r1, r1, #3 (mode 3, bg2 on)
+			0xE1C010B0, // strh r1, [r0] (DISPCNT)
+			0xE3A02A01, // frame: mov r2, #$1000
+			0xE2522001, // logic: subs r2, r2, #1
+			0x1AFFFFFD, // bne logic
+			0xE1D030B6, // vblank: ldrh r3, [r0, #6] (VCOUNT)
+			0xE35300A0, // cmp r3, #160
+			0x1AFFFFFC, // bne vblank
+			0xE1D030B6, // line0: ldrh r3, [r0, #6]
+			0xE3530000, // cmp r3, #0
+			0x1AFFFFFC, // bne line0
+			0xEAFFFFF5  // b frame
+		});
+		return rom;
+	}
+}
+
+static void BM_GbaIdleLoop_Console(benchmark::State& state) {
+	string homeFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks").string();
+	FolderUtilities::SetHomeFolder(homeFolder);
+
+	vector<uint8_t> rom = BuildIdleLoopRom();
+	Emulator emu;
+	emu.InitializeHeadless();
+	emu.GetSettings()->GetGbaConfig().SkipBootScreen = true;
+	emu.GetSettings()->GetEmulationConfig().SkipIdleLoops = state.range(0) != 0;
+	if (!emu.LoadRom(VirtualFile(rom.data(), rom.size(), "idle.gba"), VirtualFile())) {
+		emu.Release();
+		state.SkipWithError("failed to load benchmark ROM");
+		return;
+	}
+
+	for (auto _ : state) {
+		emu.RunHeadlessFrame();
+	}
+
+	uint64_t skippedCycles = ((GbaConsole*)emu.GetConsoleUnsafe())->GetCpu()->GetIdleLoopSkippedCycles();
+	state.counters["fps"] = benchmark::Counter((double)state.iterations(), benchmark::Counter::kIsRate);
+	state.counters["skipped"] = (double)skippedCycles / ((double)state.iterations() * CyclesPerLine * LinesPerFrame);
+
+	emu.Stop(false, true, false);
+	emu.Release();
+}
+BENCHMARK(BM_GbaIdleLoop_Console)->ArgName("skip")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,79 @@
+#include "pch.h"
+#include <filesystem>
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/MemoryType.h"
+#include "GBA/GbaConsole.h"
+#include "GBA/GbaMemoryManager.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+
+// =============================================================================
+// GBA Opcode Fetch Benchmarks
+// =============================================================================
+// Calls GbaMemoryManager::Read and ReadCode (the CPU's opcode fetch) on the
+// memory manager of a headless GbaConsole, for a loop of 16 sequential Thumb or
+// ARM opcodes in ROM or IWRAM. Both run the same wait state, prefetch buffer,
+// open bus and debugger steps (the system is ticked by the wait states) - Read
+// assembles the opcode byte by byte through InternalRead, ReadCode reads it
+// directly from ROM/IWRAM.
+//
+// Args: iwram (0 = ROM loop at $08000200, 1 = IWRAM loop at $03000100)
+// =============================================================================
+
+namespace {
+	template <uint8_t size, bool readCode>
+	void RunFetchLoop(benchmark::State& state) {
+		string homeFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks").string();
+		FolderUtilities::SetHomeFolder(homeFolder);
+
+		vector<uint8_t> rom(0x10000);
+		const uint8_t code[] = {
+			0x2E, 0x00, 0x00, 0xEA // b $080000C0
+		};
+		const uint8_t loop[] = {
+			0xFE, 0xFF, 0xFF, 0xEA // loop: b loop
+		};
+		std::copy(std::begin(code), std::end(code), rom.begin());
+		std::copy(std::begin(loop), std::end(loop), rom.begin() + 0xC0);
+		rom[0xB2] = 0x96; // Fixed header value
+		for (uint32_t i = 0x200; i < 0x300; i++) {
+			rom[i] = (uint8_t)i;
+		}
+
+		Emulator emu;
+		emu.InitializeHeadless();
+		emu.GetSettings()->GetGbaConfig().SkipBootScreen = true;
+		if (!emu.LoadRom(VirtualFile(rom.data(), rom.size(), "fetch.gba"), VirtualFile())) {
+			emu.Release();
+			state.SkipWithError("failed to load benchmark ROM");
+			return;
+		}
+		emu.RunHeadlessFrame();
+
+		GbaMemoryManager* memoryManager = ((GbaConsole*)emu.GetConsoleUnsafe())->GetMemoryManager();
+		constexpr GbaAccessModeVal mode = GbaAccessMode::Prefetch | GbaAccessMode::Sequential | (size == 4 ? GbaAccessMode::Word : GbaAccessMode::HalfWord);
+		uint32_t start = state.range(0) ? 0x03000100 : 0x08000200;
+		uint32_t pc = start;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(readCode ? memoryManager->ReadCode(mode, pc) : memoryManager->Read(mode, pc));
+			pc += size;
+			if (pc == start + 16 * size) {
+				pc = start;
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+
+		emu.Stop(false, true, false);
+		emu.Release();
+	}
+}
+
+static void BM_GbaThumb_FetchRead(benchmark::State& state) { RunFetchLoop<2, false>(state); }
+static void BM_GbaThumb_FetchReadCode(benchmark::State& state) { RunFetchLoop<2, true>(state); }
+static void BM_GbaArm_FetchRead(benchmark::State& state) { RunFetchLoop<4, false>(state); }
+static void BM_GbaArm_FetchReadCode(benchmark::State& state) { RunFetchLoop<4, true>(state); }
+BENCHMARK(BM_GbaThumb_FetchRead)->ArgName("iwram")->Arg(0)->Arg(1);
+BENCHMARK(BM_GbaThumb_FetchReadCode)->ArgName("iwram")->Arg(0)->Arg(1);
+BENCHMARK(BM_GbaArm_FetchRead)->ArgName("iwram")->Arg(0)->Arg(1);
+BENCHMARK(BM_GbaArm_FetchReadCode)->ArgName("iwram")->Arg(0)->Arg(1);
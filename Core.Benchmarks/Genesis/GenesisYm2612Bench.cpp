@@ -0,0 +1,108 @@
+#include "pch.h"
+#include "Genesis/GenesisYm2612.h"
+
+// =============================================================================
+// YM2612 Synthesis Benchmarks
+// =============================================================================
+// One NTSC frame (127840 68000 clocks, ~888 samples) of FM music register
+// writes, with or without PCM streamed through the DAC register.
+//
+// PerClock drives the chip like Epsm::Exec: a loop over every YM clock that
+// outputs one sample every 144 clocks and applies each write as it happens.
+// Batched records the writes with their clock and applies them at the end of
+// the frame, generating the samples between writes with one generate() call.
+
+namespace {
+	constexpr uint64_t FrameClocks = 127840;
+
+	struct BenchWrite {
+		uint64_t Clock;
+		uint8_t Port;
+		uint8_t Value;
+	};
+
+	vector<BenchWrite> BuildFrameWrites(bool dacStream) {
+		vector<BenchWrite> writes;
+		auto addWrite = [&](uint64_t clock, uint8_t reg, uint8_t value) {
+			writes.push_back({ clock, 0, reg });
+			writes.push_back({ clock + 3, 1, value });
+		};
+
+		// ~20 register writes per channel for note changes (typical sound driver tick)
+		for (uint8_t ch = 0; ch < 6; ch++) {
+			uint64_t clock = 2000 + ch * 500;
+			uint8_t reg = ch % 3;
+			addWrite(clock, 0x28, (uint8_t)(ch < 3 ? ch : ch + 1));
+			for (uint8_t op = 0; op < 4; op++) {
+				addWrite(clock + 20 + op * 40, (uint8_t)(0x40 + op * 4 + reg), 0x20);
+				addWrite(clock + 30 + op * 40, (uint8_t)(0x50 + op * 4 + reg), 0x1F);
+			}
+			addWrite(clock + 300, (uint8_t)(0xA4 + reg), 0x22);
+			addWrite(clock + 310, (uint8_t)(0xA0 + reg), 0x69);
+			addWrite(clock + 320, 0x28, (uint8_t)(0xF0 | (ch < 3 ? ch : ch + 1)));
+		}
+
+		if (dacStream) {
+			// ~8 kHz PCM
+			writes.push_back({ 10000, 0, 0x2A });
+			for (uint64_t clock = 10000; clock < FrameClocks; clock += 960) {
+				writes.push_back({ clock, 1, (uint8_t)(clock >> 4) });
+			}
+		}
+		return writes;
+	}
+}
+
+static void BM_GenesisYm2612_Frame_PerClock(benchmark::State& state) {
+	vector<BenchWrite> writes = BuildFrameWrites(state.range(0) != 0);
+	ymfm::ymfm_interface intf;
+	ymfm::ym2612 chip(intf);
+	chip.reset();
+	vector<int16_t> samples;
+	uint64_t clock = 0;
+	uint32_t sampleClockCounter = 0;
+
+	for (auto _ : state) {
+		uint64_t frameStart = clock;
+		size_t writeIndex = 0;
+		samples.clear();
+		while (clock < frameStart + FrameClocks) {
+			while (writeIndex < writes.size() && frameStart + writes[writeIndex].Clock <= clock) {
+				chip.write(writes[writeIndex].Port, writes[writeIndex].Value);
+				writeIndex++;
+			}
+
+			clock++;
+			if (++sampleClockCounter == GenesisYm2612::ClocksPerSample) {
+				sampleClockCounter = 0;
+				ymfm::ym2612::output_data output;
+				chip.generate(&output, 1);
+				samples.push_back((int16_t)std::clamp<int32_t>(output.data[0], INT16_MIN, INT16_MAX));
+				samples.push_back((int16_t)std::clamp<int32_t>(output.data[1], INT16_MIN, INT16_MAX));
+			}
+		}
+		benchmark::DoNotOptimize(samples.data());
+	}
+	state.counters["samples"] = (double)samples.size() / 2;
+}
+BENCHMARK(BM_GenesisYm2612_Frame_PerClock)->ArgName("dac")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+static void BM_GenesisYm2612_Frame_Batched(benchmark::State& state) {
+	vector<BenchWrite> writes = BuildFrameWrites(state.range(0) != 0);
+	GenesisYm2612 ym(nullptr);
+	uint64_t clock = 0;
+	size_t sampleCount = 0;
+
+	for (auto _ : state) {
+		for (BenchWrite& write : writes) {
+			ym.Write(clock + write.Clock, write.Port, write.Value);
+		}
+		clock += FrameClocks;
+		ym.Run(clock);
+		sampleCount = ym.GetSamples().size() / 2;
+		benchmark::DoNotOptimize(ym.GetSamples().data());
+		ym.GetSamples().clear();
+	}
+	state.counters["samples"] = (double)sampleCount;
+}
+BENCHMARK(BM_GenesisYm2612_Frame_Batched)->ArgName("dac")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
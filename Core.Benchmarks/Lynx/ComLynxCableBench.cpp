@@ -1,5 +1,7 @@
 ﻿#include "pch.h"
 #include "Lynx/LynxTypes.h"
+#include "Lynx/ComLynxCable.h"
+#include "Lynx/LynxMikey.h"
 
 // =============================================================================
 // ComLynx Cable Benchmarks
@@ -367,3 +369,82 @@ static void BM_ComLynxCable_TickIdle_WithCable(benchmark::State& state) {
 	state.SetItemsProcessed(state.iterations());
 }
 BENCHMARK(BM_ComLynxCable_TickIdle_WithCable);
+
+// =============================================================================
+// SCALING: linked units run serially vs. one thread per unit (lockstep)
+// =============================================================================
+
+// Each unit runs one frame of mock emulation work, split in lockstep windows,
+// and transmits a byte every 16 windows. Serial runs every unit's window on
+// one thread (EndWindow/ReceivePending), threaded runs each unit on its own
+// thread and synchronizes them with SyncWindow at each window boundary.
+namespace {
+	constexpr uint32_t WindowsPerFrame = LynxConstants::CpuCyclesPerFrame / ComLynxCable::LockstepWindowCycles;
+
+	struct LockstepBenchUnit {
+		LynxMikey Mikey;
+		uint64_t WorkState = 0x9E3779B97F4A7C15;
+	};
+
+	void RunBenchWindow(ComLynxCable& cable, LockstepBenchUnit& unit, uint32_t window) {
+		// Stand-in for the CPU/Mikey/Suzy work done for each CPU cycle
+		uint64_t x = unit.WorkState;
+		for (uint32_t i = 0; i < ComLynxCable::LockstepWindowCycles * 8; i++) {
+			x ^= x << 13;
+			x ^= x >> 7;
+			x ^= x << 17;
+		}
+		unit.WorkState = x;
+
+		if ((window & 0x0F) == 0) {
+			cable.Broadcast(&unit.Mikey, (uint16_t)(x & 0xFF));
+		}
+	}
+}
+
+static void BM_ComLynxCable_Lockstep_Frame(benchmark::State& state) {
+	uint32_t unitCount = (uint32_t)state.range(0);
+	bool threaded = state.range(1) != 0;
+
+	ComLynxCable cable;
+	vector<unique_ptr<LockstepBenchUnit>> units;
+	for (uint32_t i = 0; i < unitCount; i++) {
+		units.push_back(std::make_unique<LockstepBenchUnit>());
+		cable.Connect(&units.back()->Mikey);
+	}
+	cable.SetLockstep(true);
+
+	for (auto _ : state) {
+		if (threaded) {
+			vector<std::thread> threads;
+			for (auto& unit : units) {
+				threads.emplace_back([&cable, &unit]() {
+					for (uint32_t window = 0; window < WindowsPerFrame; window++) {
+						RunBenchWindow(cable, *unit, window);
+						cable.SyncWindow(&unit->Mikey);
+					}
+					cable.ReceivePending(&unit->Mikey);
+				});
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		} else {
+			for (uint32_t window = 0; window < WindowsPerFrame; window++) {
+				for (auto& unit : units) {
+					RunBenchWindow(cable, *unit, window);
+					cable.EndWindow(&unit->Mikey);
+				}
+				for (auto& unit : units) {
+					cable.ReceivePending(&unit->Mikey);
+				}
+			}
+		}
+	}
+	state.counters["unit-fps"] = benchmark::Counter((double)state.iterations() * unitCount, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ComLynxCable_Lockstep_Frame)
+	->ArgNames({ "units", "threaded" })
+	->ArgsProduct({ { 1, 2, 4, 8, 18 }, { 0, 1 } })
+	->UseRealTime()
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,132 @@
+#include "pch.h"
+#include <filesystem>
+#include "Shared/Emulator.h"
+#include "NES/NesConsole.h"
+#include "NES/HdPacks/HdNesPack.h"
+#include "NES/HdPacks/HdPackLoader.h"
+#include "Utilities/PNGHelper.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+
+// =============================================================================
+// HD Pack Frame Rendering Benchmarks
+// =============================================================================
+// HdNesPack::Process for a full 2x frame with a small pack (tiles with tile,
+// sprite and position conditions, a scrolling background), on 1 thread (the
+// lines are drawn in order, like before parallel rendering) and on 2/4 threads
+// (the lines are drawn in chunks pulled by each thread).
+//
+// Args: threads (render threads, including the calling thread)
+// =============================================================================
+
+namespace {
+	constexpr uint32_t Scale = 2;
+
+	void WritePack(const string& folder) {
+		std::filesystem::create_directories(folder);
+
+		vector<uint32_t> tiles(128 * 16);
+		for (uint32_t i = 0; i < tiles.size(); i++) {
+			tiles[i] = ((i & 0x0F) == 0 ? 0x00000000 : 0xFF000000) | (i * 0x01030507);
+		}
+		PNGHelper::WritePNG(folder + "/tiles.png", tiles.data(), 128, 16, 32);
+
+		vector<uint32_t> background(256 * Scale * 240 * Scale);
+		for (uint32_t i = 0; i < background.size(); i++) {
+			background[i] = 0xFF000000 | (i * 0x00010203);
+		}
+		PNGHelper::WritePNG(folder + "/bg.png", background.data(), 256 * Scale, 240 * Scale, 32);
+
+		ofstream definition(folder + "/hires.txt");
+		definition << "<ver>106\n"
+		              "<scale>2\n"
+		              "<img>tiles.png\n"
+		              "<condition>rightIsTile2,tileNearby,8,0,2,0F162738\n"
+		              "<condition>spriteAbove,spriteNearby,0,-8,3,FF0F1020\n"
+		              "<condition>lowerHalf,positionCheckY,>,120\n"
+		              "<tile>0,0,0F162738,0,0,1,N\n"
+		              "[rightIsTile2]<tile>0,1,0F162738,32,0,0.5,N\n"
+		              "<tile>0,1,0F162738,16,0,1,N\n"
+		              "<tile>0,2,0F162738,48,0,1,Y\n"
+		              "[lowerHalf]<tile>0,0,0F1A2B3C,80,0,1.5,N\n"
+		              "<tile>0,0,0F1A2B3C,64,0,1,N\n"
+		              "<tile>0,3,FF0F1020,96,0,1,N\n"
+		              "[spriteAbove]<tile>0,4,0F162738,112,0,1,N\n"
+		              "<background>bg.png,0.75,0.5,0.25,5\n";
+	}
+
+	void FillScreen(HdScreenInfo& screen) {
+		for (uint32_t y = 0; y < 240; y++) {
+			for (uint32_t x = 0; x < 256; x++) {
+				HdPpuPixelInfo& pixel = screen.ScreenTiles[y * 256 + x];
+				uint32_t tile = (x / 8 * 5 + y / 8 * 3) % 6;
+				pixel.Tile.TileIndex = tile;
+				pixel.Tile.PaletteColors = (x / 8 + y / 8) % 3 ? 0x0F162738 : 0x0F1A2B3C;
+				pixel.Tile.OffsetX = x & 0x07;
+				pixel.Tile.OffsetY = y & 0x07;
+				pixel.Tile.BgColorIndex = (x + y) & 0x03;
+				pixel.Tile.BgColor = (uint8_t)((x + y + tile) & 0x3F);
+				pixel.Tile.PpuBackgroundColor = 0x0F;
+
+				pixel.SpriteCount = 0;
+				if (((x / 8) + (y / 8) * 3) % 7 == 0) {
+					HdPpuTileInfo& sprite = pixel.Sprite[pixel.SpriteCount++];
+					sprite.TileIndex = 3;
+					sprite.PaletteColors = 0xFF0F1020;
+					sprite.OffsetX = x & 0x07;
+					sprite.OffsetY = y & 0x07;
+					sprite.SpriteColorIndex = (x ^ y) & 0x03;
+					sprite.SpriteColor = (uint8_t)((x * 3 + y) & 0x3F);
+				}
+				pixel.TmpVideoRamAddr = (uint16_t)(y * 37);
+			}
+		}
+	}
+}
+
+static void BM_HdNesPack_RenderFrame(benchmark::State& state) {
+	string homeFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks").string();
+	FolderUtilities::SetHomeFolder(homeFolder);
+
+	// iNES header: 32KB PRG ROM, 8KB CHR ROM, mapper 0
+	vector<uint8_t> rom(16 + 0x8000 + 0x2000);
+	const uint8_t header[] = {'N', 'E', 'S', 0x1A, 2, 1, 0, 0};
+	std::copy(std::begin(header), std::end(header), rom.begin());
+	rom[16 + 0x7FFD] = 0x80;
+
+	Emulator emu;
+	emu.InitializeHeadless();
+	if (!emu.LoadRom(VirtualFile(rom.data(), rom.size(), "hd.nes"), VirtualFile())) {
+		emu.Release();
+		state.SkipWithError("failed to load benchmark ROM");
+		return;
+	}
+
+	string packFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks" / "HdPack").string();
+	WritePack(packFolder);
+	HdPackData hdData;
+	if (!HdPackLoader::LoadHdNesPack(packFolder + "/hires.txt", hdData)) {
+		emu.Release();
+		state.SkipWithError("failed to load benchmark HD pack");
+		return;
+	}
+	hdData.LoadAsync();
+
+	{
+		HdNesPack<Scale> hdPack((NesConsole*)emu.GetConsoleUnsafe(), emu.GetSettings(), &hdData, (uint32_t)state.range(0));
+		HdScreenInfo screen(false);
+		FillScreen(screen);
+		OverscanDimensions overscan = {};
+		vector<uint32_t> output(256 * Scale * 240 * Scale);
+		for (auto _ : state) {
+			hdPack.Process(&screen, output.data(), overscan);
+			benchmark::DoNotOptimize(output.data());
+			screen.FrameNumber++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	emu.Stop(false, true, false);
+	emu.Release();
+}
+BENCHMARK(BM_HdNesPack_RenderFrame)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
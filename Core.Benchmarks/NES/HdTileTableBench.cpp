@@ -0,0 +1,78 @@
+#include "pch.h"
+#include <random>
+#include "NES/HdPacks/HdData.h"
+
+// =============================================================================
+// HD Pack Tile Lookup Benchmarks
+// =============================================================================
+// HdNesPack::GetMatchingTile looks up the tile under every HD pixel that isn't
+// cached (at least once per 8 pixels, plus sprites), and usually a 2nd time with
+// the default key (no palette) when the first lookup misses.
+//
+// Compares the previous unordered_map<HdTileKey, vector<HdPackTileInfo*>> with
+// HdTileTable for a 4000-tile pack, for CHR ROM (index-based) and CHR RAM
+// (data-based) keys, with a mix of hits and misses like a real screen.
+
+namespace {
+	struct LookupData {
+		unordered_map<HdTileKey, vector<HdPackTileInfo*>> Map;
+		HdTileTable Table;
+		vector<HdTileKey> Lookups;
+	};
+
+	LookupData CreateLookupData(bool chrRam) {
+		LookupData data;
+		std::mt19937 rng(1234);
+
+		auto createKey = [&](uint32_t i) {
+			HdTileKey key = {};
+			key.PaletteColors = 0x0F000000 | (rng() & 0x3F3F3F);
+			if (chrRam) {
+				key.IsChrRamTile = true;
+				key.TileIndex = HdTileKey::NoTile;
+				for (uint8_t& b : key.TileData) {
+					b = (uint8_t)rng();
+				}
+			} else {
+				key.TileIndex = i;
+			}
+			return key;
+		};
+
+		vector<HdTileKey> keys;
+		for (uint32_t i = 0; i < 4000; i++) {
+			HdTileKey key = createKey(i);
+			keys.push_back(key);
+			data.Map[key].push_back((HdPackTileInfo*)(uintptr_t)((i + 1) * 16));
+		}
+		data.Table.Build(data.Map);
+
+		// 3/4 of the lookups hit, the rest are tiles that aren't in the pack
+		for (uint32_t i = 0; i < 4096; i++) {
+			data.Lookups.push_back(i % 4 ? keys[rng() % keys.size()] : createKey(10000 + i));
+		}
+		return data;
+	}
+}
+
+static void BM_HdTileLookup_UnorderedMap(benchmark::State& state) {
+	LookupData data = CreateLookupData(state.range(0) != 0);
+	size_t i = 0;
+	for (auto _ : state) {
+		auto result = data.Map.find(data.Lookups[i++ & 4095]);
+		benchmark::DoNotOptimize(result == data.Map.end() ? nullptr : result->second[0]);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HdTileLookup_UnorderedMap)->ArgName("chrRam")->Arg(0)->Arg(1);
+
+static void BM_HdTileLookup_TileTable(benchmark::State& state) {
+	LookupData data = CreateLookupData(state.range(0) != 0);
+	size_t i = 0;
+	for (auto _ : state) {
+		std::span<HdPackTileInfo* const> result = data.Table.Find(data.Lookups[i++ & 4095]);
+		benchmark::DoNotOptimize(result.empty() ? nullptr : result[0]);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HdTileLookup_TileTable)->ArgName("chrRam")->Arg(0)->Arg(1);
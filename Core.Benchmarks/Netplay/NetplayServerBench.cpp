@@ -0,0 +1,165 @@
+#include "pch.h"
+#include <atomic>
+#include "Utilities/Socket.h"
+#include "Netplay/MovieDataMessage.h"
+
+// =============================================================================
+// Netplay Server Load Benchmarks
+// =============================================================================
+// Loopback clients connected to a server socket loop, like GameServer::Exec:
+//
+// WakeLatency: round trip of 1 byte sent by one of N clients and echoed by the
+// server, with the previous loop (scan all connections, sleep 1ms) and with
+// Socket::Poll (the server only wakes up when data is received).
+//
+// Broadcast: cost of sending one frame of input (4 ports) to N spectators, by
+// serializing a MovieDataMessage per port for each connection (previous
+// GameServer::RecordInput) or serializing the frame once and sending the same
+// packet to every connection. Spectators are drained on another thread.
+// =============================================================================
+
+namespace {
+	std::atomic<uint16_t> _nextPort = 47100;
+
+	struct LoopbackServer {
+		Socket Listener;
+		vector<unique_ptr<Socket>> ServerSide;
+		vector<unique_ptr<Socket>> Clients;
+
+		bool Open(uint32_t clientCount) {
+			uint16_t port = _nextPort++;
+			Listener.Bind(port);
+			Listener.Listen(64);
+			for (uint32_t i = 0; i < clientCount; i++) {
+				Clients.push_back(std::make_unique<Socket>());
+				if (!Clients.back()->Connect("127.0.0.1", port)) {
+					return false;
+				}
+
+				unique_ptr<Socket> socket;
+				do {
+					socket = Listener.Accept();
+				} while (socket->ConnectionError());
+				ServerSide.push_back(std::move(socket));
+			}
+			return !Listener.ConnectionError();
+		}
+
+		vector<Socket*> GetServerSockets() {
+			vector<Socket*> sockets;
+			for (unique_ptr<Socket>& socket : ServerSide) {
+				sockets.push_back(socket.get());
+			}
+			return sockets;
+		}
+	};
+
+	void RunEchoServer(LoopbackServer& server, bool usePoll, std::atomic<bool>& stop) {
+		vector<Socket*> sockets = server.GetServerSockets();
+		vector<bool> readable(sockets.size(), true);
+		char buffer[16];
+		while (!stop) {
+			if (usePoll) {
+				Socket::Poll(sockets, readable, 50);
+			}
+			for (size_t i = 0; i < sockets.size(); i++) {
+				if (readable[i]) {
+					int received = sockets[i]->Recv(buffer, sizeof(buffer), 0);
+					if (received > 0) {
+						sockets[i]->Send(buffer, received, 0);
+					}
+				}
+			}
+			if (!usePoll) {
+				std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+			}
+		}
+	}
+}
+
+static void BM_NetplayServer_WakeLatency(benchmark::State& state) {
+	bool usePoll = state.range(0) != 0;
+	uint32_t clientCount = (uint32_t)state.range(1);
+
+	LoopbackServer server;
+	if (!server.Open(clientCount)) {
+		state.SkipWithError("Could not open loopback connections");
+		return;
+	}
+
+	std::atomic<bool> stop = false;
+	std::thread serverThread([&]() { RunEchoServer(server, usePoll, stop); });
+
+	char data = 0x55;
+	uint32_t client = 0;
+	for (auto _ : state) {
+		Socket& socket = *server.Clients[client];
+		client = (client + 1) % clientCount;
+		socket.Send(&data, 1, 0);
+		if (socket.BlockingRecv(&data, 1, 3) != 1) {
+			state.SkipWithError("Echo not received");
+			break;
+		}
+	}
+
+	stop = true;
+	serverThread.join();
+}
+BENCHMARK(BM_NetplayServer_WakeLatency)->ArgNames({ "poll", "clients" })->ArgsProduct({ { 0, 1 }, { 1, 32 } })->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_NetplayServer_Broadcast(benchmark::State& state) {
+	bool sharedPacket = state.range(0) != 0;
+	uint32_t clientCount = (uint32_t)state.range(1);
+
+	LoopbackServer server;
+	if (!server.Open(clientCount)) {
+		state.SkipWithError("Could not open loopback connections");
+		return;
+	}
+
+	std::atomic<bool> stop = false;
+	std::thread drainThread([&]() {
+		vector<Socket*> clients;
+		for (unique_ptr<Socket>& socket : server.Clients) {
+			clients.push_back(socket.get());
+		}
+		vector<bool> readable;
+		vector<char> buffer(0x10000);
+		while (!stop) {
+			Socket::Poll(clients, readable, 50);
+			for (size_t i = 0; i < clients.size(); i++) {
+				if (readable[i]) {
+					clients[i]->Recv(buffer.data(), (int)buffer.size(), 0);
+				}
+			}
+		}
+	});
+
+	ControlDeviceState input;
+	input.State = { 0x12, 0x34 };
+
+	for (auto _ : state) {
+		if (sharedPacket) {
+			string packet;
+			for (uint8_t port = 0; port < 4; port++) {
+				MovieDataMessage message(input, port);
+				packet += message.GetPacket();
+			}
+			for (unique_ptr<Socket>& socket : server.ServerSide) {
+				socket->Send((char*)packet.data(), (int)packet.size(), 0);
+			}
+		} else {
+			for (uint8_t port = 0; port < 4; port++) {
+				for (unique_ptr<Socket>& socket : server.ServerSide) {
+					MovieDataMessage message(input, port);
+					message.Send(*socket);
+				}
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	stop = true;
+	drainThread.join();
+}
+BENCHMARK(BM_NetplayServer_Broadcast)->ArgNames({ "shared", "clients" })->ArgsProduct({ { 0, 1 }, { 8, 32 } })->Unit(benchmark::kMicrosecond);
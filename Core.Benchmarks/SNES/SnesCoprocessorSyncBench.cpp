@@ -0,0 +1,156 @@
+#include "pch.h"
+
+// =============================================================================
+// SNES Coprocessor Synchronization Benchmarks
+// =============================================================================
+// The SA-1/GSU/Cx4/SGB are run by catching up to the SNES master clock.
+// Previously, they were synchronized after every 2 master clocks (in
+// SnesMemoryManager::Exec). They are now synchronized only when the SNES CPU
+// can observe them: before each bus access and at the end of each CPU cycle.
+//
+// Simulates 1 frame's worth of CPU cycles (mix of 8-clock reads, 8-clock
+// writes and 6-clock idle cycles) with a coprocessor running at half the
+// master clock (like the SA-1), executing 2-6 cycle instructions.
+// =============================================================================
+
+namespace {
+	constexpr uint32_t CpuCyclesPerFrame = 357366 / 8;
+
+	class FakeCoprocessor {
+	public:
+		uint64_t MasterClock = 0;
+		uint64_t CycleCount = 0;
+		uint32_t Pc = 0;
+		bool Waiting = false;
+
+		virtual ~FakeCoprocessor() = default;
+
+		virtual void Run() {
+			uint64_t targetCycle = MasterClock / 2;
+			while (CycleCount < targetCycle) {
+				if (Waiting) {
+					CycleCount++;
+				} else {
+					Pc = Pc * 1103515245 + 12345;
+					CycleCount += 2 + ((Pc >> 16) & 0x03);
+				}
+			}
+		}
+	};
+
+	class FakeCoprocessorSkipWait : public FakeCoprocessor {
+	public:
+		void Run() override {
+			uint64_t targetCycle = MasterClock / 2;
+			while (CycleCount < targetCycle) {
+				if (Waiting) {
+					CycleCount = targetCycle;
+				} else {
+					Pc = Pc * 1103515245 + 12345;
+					CycleCount += 2 + ((Pc >> 16) & 0x03);
+				}
+			}
+		}
+	};
+
+	// Per-tick sync: Run() after every 2 master clocks
+	__forceinline void TickSync(FakeCoprocessor* coprocessor, uint32_t clocks) {
+		for (uint32_t i = 0; i < clocks; i += 2) {
+			coprocessor->MasterClock += 2;
+			coprocessor->Run();
+		}
+	}
+
+	// On-demand sync: advance the clock, Run() only at the sync points
+	__forceinline void Advance(FakeCoprocessor* coprocessor, uint32_t clocks) {
+		coprocessor->MasterClock += clocks;
+	}
+
+	void RunFramePerTick(FakeCoprocessor* coprocessor) {
+		for (uint32_t i = 0; i < CpuCyclesPerFrame; i++) {
+			switch (i % 3) {
+				case 0: TickSync(coprocessor, 8); break; // Read
+				case 1: TickSync(coprocessor, 8); break; // Write
+				case 2: TickSync(coprocessor, 6); break; // Idle
+			}
+		}
+	}
+
+	void RunFrameOnDemand(FakeCoprocessor* coprocessor) {
+		for (uint32_t i = 0; i < CpuCyclesPerFrame; i++) {
+			switch (i % 3) {
+				case 0:
+					// Read: sync before the bus access and at the end of the cycle
+					Advance(coprocessor, 4);
+					coprocessor->Run();
+					Advance(coprocessor, 4);
+					coprocessor->Run();
+					break;
+
+				case 1:
+					// Write: the bus access is at the end of the cycle
+					Advance(coprocessor, 8);
+					coprocessor->Run();
+					break;
+
+				case 2:
+					// Idle: sync at the end of the cycle
+					Advance(coprocessor, 6);
+					coprocessor->Run();
+					break;
+			}
+		}
+	}
+}
+
+static void BM_SnesCoprocSync_PerTick(benchmark::State& state) {
+	FakeCoprocessor coprocessor;
+	FakeCoprocessor* ptr = &coprocessor;
+	benchmark::DoNotOptimize(ptr);
+	for (auto _ : state) {
+		RunFramePerTick(ptr);
+		benchmark::DoNotOptimize(coprocessor.CycleCount);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SnesCoprocSync_PerTick)->Unit(benchmark::kMicrosecond);
+
+static void BM_SnesCoprocSync_OnDemand(benchmark::State& state) {
+	FakeCoprocessor coprocessor;
+	FakeCoprocessor* ptr = &coprocessor;
+	benchmark::DoNotOptimize(ptr);
+	for (auto _ : state) {
+		RunFrameOnDemand(ptr);
+		benchmark::DoNotOptimize(coprocessor.CycleCount);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SnesCoprocSync_OnDemand)->Unit(benchmark::kMicrosecond);
+
+// Coprocessor waiting for the SNES CPU (e.g. SA-1 with SA-1 wait set), stepping 1 cycle at a time
+static void BM_SnesCoprocSync_Waiting_StepCycles(benchmark::State& state) {
+	FakeCoprocessor coprocessor;
+	coprocessor.Waiting = true;
+	FakeCoprocessor* ptr = &coprocessor;
+	benchmark::DoNotOptimize(ptr);
+	for (auto _ : state) {
+		RunFrameOnDemand(ptr);
+		benchmark::DoNotOptimize(coprocessor.CycleCount);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SnesCoprocSync_Waiting_StepCycles)->Unit(benchmark::kMicrosecond);
+
+// Same, skipping directly to the target cycle
+static void BM_SnesCoprocSync_Waiting_SkipToTarget(benchmark::State& state) {
+	FakeCoprocessorSkipWait coprocessor;
+	coprocessor.Waiting = true;
+	FakeCoprocessor* ptr = &coprocessor;
+	benchmark::DoNotOptimize(ptr);
+	for (auto _ : state) {
+		RunFrameOnDemand(ptr);
+		benchmark::DoNotOptimize(coprocessor.CycleCount);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SnesCoprocSync_Waiting_SkipToTarget)->Unit(benchmark::kMicrosecond);
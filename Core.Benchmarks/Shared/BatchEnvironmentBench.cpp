@@ -0,0 +1,87 @@
+#include "pch.h"
+#include <filesystem>
+#include "Shared/BatchEnvironment.h"
+#include "Shared/MemoryType.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+
+// =============================================================================
+// Batch Environment Benchmarks
+// =============================================================================
+// Steps N headless NES instances in lockstep (1 frame per step) and reports
+// the total number of emulated frames per second, with the frames and 2KB of
+// RAM copied to the observation arrays on every step.
+//
+// Args: instance count, thread count (0 = one per core)
+// =============================================================================
+
+namespace {
+	vector<uint8_t> BuildNesRom() {
+		// NROM, 16KB PRG ($8000, mirrored at $C000) + 8KB CHR - turns on the display and loops
+		constexpr size_t prg = 16;
+		vector<uint8_t> rom(prg + 0x4000 + 0x2000, 0);
+		const uint8_t header[] = {'N', 'E', 'S', 0x1A, 0x01, 0x01};
+		std::copy(std::begin(header), std::end(header), rom.begin());
+
+		const uint8_t code[] = {
+			0x78,             // sei
+			0xA9, 0x1E,       // lda #$1E
+			0x8D, 0x01, 0x20, // sta $2001 (show bg+sprites)
+			0xA9, 0x80,       // lda #$80
+			0x8D, 0x00, 0x20, // sta $2000 (nmi on)
+			0x4C, 0x0B, 0x80  // jmp *
+		};
+		std::copy(std::begin(code), std::end(code), rom.begin() + prg);
+		rom[prg + 0x20] = 0x40; // rti
+
+		const uint16_t vectors[] = {0x8020, 0x8000, 0x8020}; // NMI, Reset, IRQ
+		for (int i = 0; i < 3; i++) {
+			rom[prg + 0x3FFA + i * 2] = (uint8_t)vectors[i];
+			rom[prg + 0x3FFB + i * 2] = (uint8_t)(vectors[i] >> 8);
+		}
+		return rom;
+	}
+
+	void BM_BatchEnvironment_Step(benchmark::State& state) {
+		string homeFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks").string();
+		FolderUtilities::SetHomeFolder(homeFolder);
+
+		BatchEnvironmentConfig config = {};
+		config.InstanceCount = (uint32_t)state.range(0);
+		config.ThreadCount = (uint32_t)state.range(1);
+		config.FrameStride = 256 * 240;
+		config.RamRanges.push_back({MemoryType::NesInternalRam, 0, 0x800});
+
+		vector<uint8_t> rom = BuildNesRom();
+		BatchEnvironment env(config);
+		if (!env.LoadRom(VirtualFile(rom.data(), rom.size(), "bench.nes"), VirtualFile())) {
+			state.SkipWithError("failed to load benchmark ROM");
+			return;
+		}
+
+		vector<uint32_t> inputs(config.InstanceCount);
+		vector<uint16_t> frames((size_t)config.InstanceCount * config.FrameStride);
+		vector<BatchStepInfo> info(config.InstanceCount);
+		vector<uint8_t> ram((size_t)config.InstanceCount * env.GetRamStride());
+
+		uint32_t step = 0;
+		for (auto _ : state) {
+			for (uint32_t i = 0; i < config.InstanceCount; i++) {
+				inputs[i] = (step + i) & 0xFF;
+			}
+			env.Step(inputs.data(), frames.data(), info.data(), ram.data());
+			benchmark::DoNotOptimize(frames.data());
+			step++;
+		}
+
+		state.SetItemsProcessed((int64_t)state.iterations() * config.InstanceCount);
+		state.counters["fps"] = benchmark::Counter((double)state.iterations() * config.InstanceCount, benchmark::Counter::kIsRate);
+	}
+}
+
+BENCHMARK(BM_BatchEnvironment_Step)
+	->Args({1, 1})
+	->Args({16, 1})
+	->Args({16, 0})
+	->Args({64, 0})
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,402 @@
+#include "pch.h"
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <thread>
+#include "Shared/Emulator.h"
+#include "Shared/EmulatorLock.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/DebuggerRequest.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/ITraceLogger.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+
+// =============================================================================
+// Console Frame Throughput Benchmarks
+// =============================================================================
+// Boots each console headlessly (same flow as the PGO runner: Initialize,
+// LoadRom, emulation thread at maximum speed) on a small generated ROM and
+// reports the number of emulated frames per second.
+//
+// The ROMs are minimal homebrew programs generated below: they turn on the
+// display (where needed) and loop forever, so the results mostly reflect the
+// cost of the CPU/PPU/APU emulation loop and of the frame-level subsystems.
+//
+// Each console is measured with 5 configurations:
+// - Plain: no debugger, rewind or run-ahead
+// - Debugger: debugger attached (no breakpoints)
+// - TraceLogger: debugger attached + trace logger enabled for all CPUs
+// - Rewind: rewind buffer enabled (default size)
+// - RunAhead: 1 frame of run-ahead
+//
+// Run-ahead is only used at speeds up to 100%, so the RunAhead configuration
+// runs at normal speed (fps is capped at the console's frame rate) - compare
+// the cpu_ms_per_frame counter (process CPU time per emulated frame) instead.
+// The other configurations run at maximum speed.
+//
+// Run with e.g. --benchmark_filter=BM_ConsoleFps/Nes/ to limit to 1 console.
+// =============================================================================
+
+namespace {
+	constexpr auto MeasureWindow = std::chrono::milliseconds(100);
+	constexpr auto BootTimeout = std::chrono::seconds(5);
+
+	enum class BenchConfig {
+		Plain,
+		Debugger,
+		TraceLogger,
+		Rewind,
+		RunAhead
+	};
+
+	struct BenchRom {
+		string Name;
+		vector<uint8_t> Data;
+	};
+
+	void Write(vector<uint8_t>& rom, size_t offset, std::initializer_list<uint8_t> data) {
+		std::copy(data.begin(), data.end(), rom.begin() + offset);
+	}
+
+	void Write16(vector<uint8_t>& rom, size_t offset, uint16_t value) {
+		rom[offset] = (uint8_t)value;
+		rom[offset + 1] = (uint8_t)(value >> 8);
+	}
+
+	BenchRom BuildNesRom() {
+		// NROM, 16KB PRG ($8000, mirrored at $C000) + 8KB CHR
+		constexpr size_t prg = 16;
+		vector<uint8_t> rom(prg + 0x4000 + 0x2000, 0);
+		Write(rom, 0, {'N', 'E', 'S', 0x1A, 0x01, 0x01});
+
+		Write(rom, prg, {
+			0x78,             // sei
+			0xA9, 0x1E,       // lda #$1E
+			0x8D, 0x01, 0x20, // sta $2001 (show bg+sprites)
+			0xA9, 0x80,       // lda #$80
+			0x8D, 0x00, 0x20, // sta $2000 (nmi on)
+			0x4C, 0x0B, 0x80  // jmp *
+		});
+		rom[prg + 0x20] = 0x40; // rti
+
+		Write16(rom, prg + 0x3FFA, 0x8020); // NMI
+		Write16(rom, prg + 0x3FFC, 0x8000); // Reset
+		Write16(rom, prg + 0x3FFE, 0x8020); // IRQ
+		return {"bench.nes", rom};
+	}
+
+	BenchRom BuildSnesRom() {
+		// 32KB LoROM
+		vector<uint8_t> rom(0x8000, 0);
+		Write(rom, 0, {
+			0x78,             // sei
+			0x18,             // clc
+			0xFB,             // xce (native mode)
+			0xA9, 0x0F,       // lda #$0F
+			0x8D, 0x00, 0x21, // sta $2100 (screen on, full brightness)
+			0xA9, 0x81,       // lda #$81
+			0x8D, 0x00, 0x42, // sta $4200 (nmi + auto-joypad read)
+			0x80, 0xFE        // bra *
+		});
+		rom[0x40] = 0x40; // rti
+
+		string title = "NEXEN BENCHMARK";
+		title.resize(21, ' ');
+		std::copy(title.begin(), title.end(), rom.begin() + 0x7FC0);
+		rom[0x7FD5] = 0x20; // LoROM
+		rom[0x7FD7] = 0x05; // 32KB
+		rom[0x7FD9] = 0x01; // North America
+
+		Write16(rom, 0x7FEA, 0x8040); // NMI (native)
+		Write16(rom, 0x7FEE, 0x8040); // IRQ (native)
+		Write16(rom, 0x7FFC, 0x8000); // Reset
+		Write16(rom, 0x7FFE, 0x8040); // IRQ (emulation)
+
+		// Checksum + complement (the complement+checksum pair always adds 0x1FE to the sum)
+		Write16(rom, 0x7FDC, 0xFFFF);
+		Write16(rom, 0x7FDE, 0x0000);
+		uint16_t checksum = 0;
+		for (uint8_t value : rom) {
+			checksum += value;
+		}
+		Write16(rom, 0x7FDC, checksum ^ 0xFFFF);
+		Write16(rom, 0x7FDE, checksum);
+		return {"bench.sfc", rom};
+	}
+
+	BenchRom BuildGameboyRom() {
+		vector<uint8_t> rom(0x8000, 0);
+		Write(rom, 0x100, {0x00, 0xC3, 0x50, 0x01}); // nop, jp $0150
+
+		string title = "NEXENBENCH";
+		std::copy(title.begin(), title.end(), rom.begin() + 0x134);
+
+		uint8_t headerChecksum = 0;
+		for (size_t i = 0x134; i <= 0x14C; i++) {
+			headerChecksum = headerChecksum - rom[i] - 1;
+		}
+		rom[0x14D] = headerChecksum;
+
+		Write(rom, 0x150, {
+			0x3E, 0x91, // ld a, $91
+			0xE0, 0x40, // ldh [$40], a (lcd on)
+			0x18, 0xFE  // jr *
+		});
+		return {"bench.gb", rom};
+	}
+
+	BenchRom BuildGbaRom() {
+		vector<uint8_t> rom(0x10000, 0);
+		auto writeArm = [&](size_t offset, uint32_t opCode) {
+			for (int i = 0; i < 4; i++) {
+				rom[offset + i] = (uint8_t)(opCode >> (i * 8));
+			}
+		};
+
+		writeArm(0, 0xEA00002E); // b $080000C0
+		rom[0xB2] = 0x96;        // Fixed header value
+
+		writeArm(0xC0, 0xE3A00301); // mov r0, #$04000000
+		writeArm(0xC4, 0xE3A01B01); // mov r1, #$400
+		writeArm(0xC8, 0xE3811003); // orr r1, r1, #3 (mode 3, bg2 on)
+		writeArm(0xCC, 0xE1C010B0); // strh r1, [r0] (DISPCNT)
+		writeArm(0xD0, 0xEAFFFFFE); // b *
+		return {"bench.gba", rom};
+	}
+
+	BenchRom BuildSmsRom() {
+		vector<uint8_t> rom(0x8000, 0);
+		Write(rom, 0, {
+			0xF3,       // di
+			0x3E, 0x40, // ld a, $40
+			0xD3, 0xBF, // out ($BF), a
+			0x3E, 0x81, // ld a, $81
+			0xD3, 0xBF, // out ($BF), a (VDP reg 1 = $40, display on)
+			0x18, 0xFE  // jr *
+		});
+		return {"bench.sms", rom};
+	}
+
+	BenchRom BuildPceRom() {
+		// Bank 0 is mapped at $E000 on reset
+		vector<uint8_t> rom(0x8000, 0);
+		Write(rom, 0, {
+			0x78,      // sei
+			0xD4,      // csh (high speed)
+			0x80, 0xFE // bra *
+		});
+		rom[0x10] = 0x40; // rti
+
+		for (size_t offset = 0x1FF6; offset < 0x1FFE; offset += 2) {
+			Write16(rom, offset, 0xE010);
+		}
+		Write16(rom, 0x1FFE, 0xE000);
+		return {"bench.pce", rom};
+	}
+
+	BenchRom BuildWsRom() {
+		// The last 16 bytes are the footer - the CPU starts at $FFFF:0000 (the footer's jmp far)
+		vector<uint8_t> rom(0x10000, 0);
+		Write(rom, 0, {
+			0xFA,      // cli
+			0xEB, 0xFE // jmp short *
+		});
+		Write(rom, 0xFFF0, {0xEA, 0x00, 0x00, 0x00, 0xF0}); // jmp far $F000:0000
+		rom[rom.size() - 5] = 0; // No save
+		return {"bench.ws", rom};
+	}
+
+	BenchRom BuildLynxRom() {
+		// LNX header + BLL-style executable (loaded and started by the HLE boot)
+		vector<uint8_t> rom(64 + 0x400, 0);
+		Write(rom, 0, {'L', 'Y', 'N', 'X'});
+		Write16(rom, 4, 0x400); // Bank 0 page size
+		Write16(rom, 8, 1);     // Version
+
+		size_t bll = 64;
+		rom[bll] = 0x80;
+		Write16(rom, bll + 1, 0x0200); // Load address
+		Write16(rom, bll + 3, 0x0010); // Size
+		Write16(rom, bll + 5, 0x0000); // Entry point (= load address)
+		Write(rom, bll + 10, {0x4C, 0x00, 0x02}); // jmp *
+		return {"bench.lnx", rom};
+	}
+
+	BenchRom BuildGenesisRom() {
+		vector<uint8_t> rom(0x4000, 0);
+		for (size_t i = 0; i < rom.size(); i += 2) {
+			rom[i] = 0x4E; // nop
+			rom[i + 1] = 0x71;
+		}
+		Write(rom, 0, {0x00, 0xFF, 0xFE, 0x00}); // Initial SP
+		Write(rom, 4, {0x00, 0x00, 0x02, 0x00}); // Initial PC
+		Write(rom, 0x100, {'S', 'E', 'G', 'A'});
+		Write(rom, 0x200, {0x60, 0xFE}); // bra.s *
+		return {"bench.md", rom};
+	}
+
+	BenchRom BuildAtari2600Rom() {
+		// 4KB cart at $F000, 259-line frames with VSYNC
+		vector<uint8_t> rom(0x1000, 0xEA);
+		Write(rom, 0, {
+			0x78,             // sei
+			0xD8,             // cld
+			0xA9, 0x02,       // frame: lda #2
+			0x85, 0x00,       // sta VSYNC
+			0x85, 0x02,       // sta WSYNC
+			0x85, 0x02,       // sta WSYNC
+			0x85, 0x02,       // sta WSYNC
+			0xA9, 0x00,       // lda #0
+			0x85, 0x00,       // sta VSYNC
+			0xA2, 0x00,       // ldx #0
+			0x85, 0x02,       // line: sta WSYNC
+			0xCA,             // dex
+			0xD0, 0xFB,       // bne line
+			0x4C, 0x02, 0xF0  // jmp frame
+		});
+		Write16(rom, 0xFFC, 0xF000);
+		Write16(rom, 0xFFE, 0xF000);
+		return {"bench.a26", rom};
+	}
+
+	BenchRom BuildChannelFRom() {
+		// Runs the built-in BIOS (no cartridge program)
+		return {"bench.chf", vector<uint8_t>(0x800, 0)};
+	}
+
+	void ApplySettings(Emulator& emu, BenchConfig config) {
+		EmuSettings* settings = emu.GetSettings();
+		settings->GetPreferences().RewindBufferSize = config == BenchConfig::Rewind ? 300 : 0;
+		settings->GetEmulationConfig().RunAheadFrames = config == BenchConfig::RunAhead ? 1 : 0;
+		settings->GetGameboyConfig().Model = GameboyModel::Gameboy;
+		settings->GetGbaConfig().SkipBootScreen = true;
+		// 0 = no frame limit (the MaximumSpeed flag is cleared by LoadRom)
+		settings->GetEmulationConfig().EmulationSpeed = config == BenchConfig::RunAhead ? 100 : 0;
+	}
+
+	void AttachDebugger(Emulator& emu, BenchConfig config) {
+		if (config != BenchConfig::Debugger && config != BenchConfig::TraceLogger) {
+			return;
+		}
+
+		DebuggerRequest request = emu.GetDebugger(true);
+		Debugger* debugger = request.GetDebugger();
+		if (!debugger || config != BenchConfig::TraceLogger) {
+			return;
+		}
+
+		TraceLoggerOptions options = {};
+		options.Enabled = true;
+		string format = "[PC,h] [ByteCode,h] [Disassembly]";
+		memcpy(options.Format, format.c_str(), format.size() + 1);
+		// Hold the emulator lock while changing the options: SetOptions breaks the emulation
+		// thread, which never happens on CPUs that don't report their instructions to the debugger
+		auto lock = emu.AcquireLock(false);
+		for (CpuType cpuType : emu.GetCpuTypes()) {
+			if (ITraceLogger* logger = debugger->GetTraceLogger(cpuType)) {
+				logger->SetOptions(options);
+			}
+		}
+	}
+
+	void BM_ConsoleFps(benchmark::State& state, BenchRom (*buildRom)(), BenchConfig config) {
+		string homeFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks").string();
+		FolderUtilities::SetHomeFolder(homeFolder);
+
+		BenchRom rom = buildRom();
+		unique_ptr<Emulator> emu(new Emulator());
+		emu->Initialize(false);
+		ApplySettings(*emu, config);
+
+		if (!emu->LoadRom(VirtualFile(rom.Data.data(), rom.Data.size(), rom.Name), VirtualFile())) {
+			emu->Release();
+			state.SkipWithError("failed to load benchmark ROM");
+			return;
+		}
+
+		// Wait for the first frames before attaching the debugger (the emulation thread must
+		// be running frames to be paused by the emulator lock) and measuring
+		auto bootStart = std::chrono::steady_clock::now();
+		while (emu->GetFrameCount() < 2 && std::chrono::steady_clock::now() - bootStart < BootTimeout) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if (emu->GetFrameCount() < 2) {
+			emu->Stop(false, true, false);
+			emu->Release();
+			state.SkipWithError("console did not produce any frames");
+			return;
+		}
+		AttachDebugger(*emu, config);
+
+		uint64_t totalFrames = 0;
+		double totalTime = 0;
+		double totalCpuTime = 0;
+		for (auto _ : state) {
+			uint32_t startFrame = emu->GetFrameCount();
+			auto start = std::chrono::steady_clock::now();
+			std::clock_t cpuStart = std::clock();
+			std::this_thread::sleep_for(MeasureWindow);
+			uint32_t endFrame = emu->GetFrameCount();
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+			state.SetIterationTime(elapsed);
+			totalFrames += endFrame - startFrame;
+			totalTime += elapsed;
+			totalCpuTime += (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+		}
+
+		emu->Stop(false, true, false);
+		emu->Release();
+
+		state.SetItemsProcessed((int64_t)totalFrames);
+		state.counters["fps"] = totalTime > 0 ? totalFrames / totalTime : 0;
+		state.counters["cpu_ms_per_frame"] = totalFrames > 0 ? totalCpuTime * 1000 / totalFrames : 0;
+	}
+
+	struct ConsoleEntry {
+		const char* Name;
+		BenchRom (*BuildRom)();
+	};
+
+	struct ConfigEntry {
+		const char* Name;
+		BenchConfig Config;
+	};
+
+	[[maybe_unused]] const bool _registered = []() {
+		const ConsoleEntry consoles[] = {
+			{"Nes", BuildNesRom},
+			{"Snes", BuildSnesRom},
+			{"Gameboy", BuildGameboyRom},
+			{"Gba", BuildGbaRom},
+			{"Sms", BuildSmsRom},
+			{"Pce", BuildPceRom},
+			{"Ws", BuildWsRom},
+			{"Lynx", BuildLynxRom},
+			{"Genesis", BuildGenesisRom},
+			{"Atari2600", BuildAtari2600Rom},
+			{"ChannelF", BuildChannelFRom}
+		};
+
+		const ConfigEntry configs[] = {
+			{"Plain", BenchConfig::Plain},
+			{"Debugger", BenchConfig::Debugger},
+			{"TraceLogger", BenchConfig::TraceLogger},
+			{"Rewind", BenchConfig::Rewind},
+			{"RunAhead", BenchConfig::RunAhead}
+		};
+
+		for (const ConsoleEntry& console : consoles) {
+			for (const ConfigEntry& config : configs) {
+				string name = string("BM_ConsoleFps/") + console.Name + "/" + config.Name;
+				benchmark::RegisterBenchmark(name.c_str(), BM_ConsoleFps, console.BuildRom, config.Config)
+					->Iterations(10)
+					->UseManualTime()
+					->Unit(benchmark::kMillisecond);
+			}
+		}
+		return true;
+	}();
+}
@@ -0,0 +1,83 @@
+#include "pch.h"
+#include <filesystem>
+#include <vector>
+#include "Utilities/Video/GifRecorder.h"
+
+// =============================================================================
+// GIF Encoding Benchmarks
+// =============================================================================
+// Throughput of GifRecorder at 256x240 (AddFrame blocks once the encoder is
+// VideoFrameQueue::MaxQueuedFrames behind, so this measures the encoder's speed):
+//   - Console-like frames (few colors, small moving parts): exact palette,
+//     only the changed rectangle is written
+//   - Photo-like frames (every pixel changes, thousands of colors): k-d tree
+//     quantization of the whole frame (gif.h's original path)
+// =============================================================================
+
+namespace {
+	constexpr uint32_t Width = 256;
+	constexpr uint32_t Height = 240;
+
+	std::vector<uint32_t> MakeConsoleFrame(uint32_t frameNumber) {
+		std::vector<uint32_t> frame(Width * Height);
+		for (uint32_t y = 0; y < Height; y++) {
+			for (uint32_t x = 0; x < Width; x++) {
+				// Static background with 16 colors, a scrolling status bar
+				uint32_t color = ((x / 16 + y / 16) & 0x0F) * 0x0F0A05;
+				if (y < 16) {
+					color = (((x + frameNumber) / 8) & 0x03) * 0x303030;
+				}
+				frame[y * Width + x] = 0xFF000000 | color;
+			}
+		}
+		// Moving sprite
+		for (uint32_t y = 100; y < 132; y++) {
+			for (uint32_t x = 0; x < 32; x++) {
+				frame[y * Width + (frameNumber * 2 + x) % Width] = 0xFFE0A060 + (x / 8);
+			}
+		}
+		return frame;
+	}
+
+	std::vector<uint32_t> MakeNoisyFrame(uint32_t frameNumber) {
+		std::vector<uint32_t> frame(Width * Height);
+		uint32_t seed = frameNumber * 0x9E3779B9;
+		for (uint32_t& pixel : frame) {
+			seed = seed * 1664525 + 1013904223;
+			pixel = 0xFF000000 | (seed >> 8);
+		}
+		return frame;
+	}
+
+	template <typename TFrameGenerator>
+	void RecordFrames(benchmark::State& state, TFrameGenerator makeFrame) {
+		std::vector<std::vector<uint32_t>> frames;
+		for (uint32_t i = 0; i < 16; i++) {
+			frames.push_back(makeFrame(i));
+		}
+
+		string filename = (std::filesystem::temp_directory_path() / "nexen_gif_bench.gif").string();
+		GifRecorder recorder;
+		recorder.Init(filename);
+		recorder.StartRecording(Width, Height, 4, 0, 50.0);
+
+		size_t frame = 0;
+		for (auto _ : state) {
+			recorder.AddFrame(frames[frame % frames.size()].data(), Width, Height, 50.0);
+			frame++;
+		}
+		recorder.StopRecording();
+		state.SetItemsProcessed(state.iterations());
+		std::filesystem::remove(filename);
+	}
+}
+
+static void BM_GifEncode_ConsoleFrames(benchmark::State& state) {
+	RecordFrames(state, MakeConsoleFrame);
+}
+BENCHMARK(BM_GifEncode_ConsoleFrames)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_GifEncode_QuantizedFrames(benchmark::State& state) {
+	RecordFrames(state, MakeNoisyFrame);
+}
+BENCHMARK(BM_GifEncode_QuantizedFrames)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include <filesystem>
+#include <thread>
+#include "Shared/Emulator.h"
+#include "Shared/Movies/InputSearch.h"
+#include "Utilities/VirtualFile.h"
+#include "Utilities/FolderUtilities.h"
+
+// =============================================================================
+// Input Search Benchmarks
+// =============================================================================
+// Runs an exhaustive search (4 candidates, depth 5, goal never reached) from
+// the power-on state of a NES ROM, to measure its scaling with the thread
+// count.
+//
+// Args: thread count (0 = one per core)
+// =============================================================================
+
+namespace {
+	vector<uint8_t> BuildNesRom() {
+		// NROM, 16KB PRG ($8000, mirrored at $C000) + 8KB CHR - turns on the display and loops
+		constexpr size_t prg = 16;
+		vector<uint8_t> rom(prg + 0x4000 + 0x2000, 0);
+		const uint8_t header[] = {'N', 'E', 'S', 0x1A, 0x01, 0x01};
+		std::copy(std::begin(header), std::end(header), rom.begin());
+
+		const uint8_t code[] = {
+			0x78,             // sei
+			0xA9, 0x1E,       // lda #$1E
+			0x8D, 0x01, 0x20, // sta $2001 (show bg+sprites)
+			0xA9, 0x80,       // lda #$80
+			0x8D, 0x00, 0x20, // sta $2000 (nmi on)
+			0x4C, 0x0B, 0x80  // jmp *
+		};
+		std::copy(std::begin(code), std::end(code), rom.begin() + prg);
+		rom[prg + 0x20] = 0x40; // rti
+
+		const uint16_t vectors[] = {0x8020, 0x8000, 0x8020}; // NMI, Reset, IRQ
+		for (int i = 0; i < 3; i++) {
+			rom[prg + 0x3FFA + i * 2] = (uint8_t)vectors[i];
+			rom[prg + 0x3FFB + i * 2] = (uint8_t)(vectors[i] >> 8);
+		}
+		return rom;
+	}
+
+	void BM_InputSearch_Exhaustive(benchmark::State& state) {
+		string homeFolder = (std::filesystem::temp_directory_path() / "NexenBenchmarks").string();
+		FolderUtilities::SetHomeFolder(homeFolder);
+
+		// The search's instances reload the game from its path - the ROM must be a file
+		vector<uint8_t> rom = BuildNesRom();
+		std::filesystem::create_directories(homeFolder);
+		string romPath = (std::filesystem::path(homeFolder) / "InputSearch.nes").string();
+		ofstream romFile(romPath, std::ios::binary);
+		romFile.write((char*)rom.data(), rom.size());
+		romFile.close();
+
+		Emulator emu;
+		emu.InitializeHeadless();
+		if (!emu.LoadRom(VirtualFile(romPath), VirtualFile())) {
+			state.SkipWithError("failed to load benchmark ROM");
+			return;
+		}
+
+		InputSearchConfig config = {};
+		config.Depth = 5;
+		config.Candidates = {0x00, 0x01, 0x02, 0x80}; // none, A, B, right
+		config.Cpu = CpuType::Nes;
+		config.GoalExpression = "[$10] == $FF"; // never written by the ROM
+		config.ThreadCount = (uint32_t)state.range(0);
+
+		InputSearch search(&emu);
+		uint64_t sequenceCount = 0;
+		for (auto _ : state) {
+			if (!search.Start(config)) {
+				state.SkipWithError("failed to start the search");
+				break;
+			}
+			while (search.GetProgress().Running) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			sequenceCount += search.GetProgress().SequenceCount;
+		}
+		search.Stop();
+		emu.Stop(false, true, false);
+		emu.Release();
+
+		state.counters["sequences/s"] = benchmark::Counter((double)sequenceCount, benchmark::Counter::kIsRate);
+	}
+}
+
+BENCHMARK(BM_InputSearch_Exhaustive)
+	->Arg(1)
+	->Arg(2)
+	->Arg(4)
+	->Arg(0)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
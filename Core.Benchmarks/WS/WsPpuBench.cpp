@@ -132,7 +132,7 @@ BENCHMARK(BM_WsPpu_Palette_Mono);
 static void BM_WsPpu_Palette_Color(benchmark::State& state) {
 	alignas(16) uint8_t vram[0x10000] = {};
 	// Fill palette RAM with test values
-	for (uint16_t i = 0xfe00; i < 0x10000; i++) {
+	for (uint32_t i = 0xfe00; i < 0x10000; i++) {
 		vram[i] = static_cast<uint8_t>(i & 0xff);
 	}
 
@@ -303,7 +303,7 @@ BENCHMARK(BM_WsPpu_ScanlineFull_MonoExtractAndPalette);
 static void BM_WsPpu_ScanlineFull_Color4bppExtractAndPalette(benchmark::State& state) {
 	uint8_t tileRows[28][4];
 	alignas(16) uint8_t vram[0x10000] = {};
-	for (uint16_t i = 0xfe00; i < 0x10000; i++) {
+	for (uint32_t i = 0xfe00; i < 0x10000; i++) {
 		vram[i] = static_cast<uint8_t>(i & 0xff);
 	}
 	for (int i = 0; i < 28; i++) {
@@ -0,0 +1,156 @@
+#include "pch.h"
+#include "Debugger/DebuggerRefreshSnapshot.h"
+
+// =============================================================================
+// DebuggerRefreshSnapshot Unit Tests
+// =============================================================================
+// Capturing requires a live debugger, so these tests feed section data directly
+// and verify the buffer layout and generation-based skipping of GetSnapshot.
+
+namespace {
+	class TestRefreshSnapshot : public DebuggerRefreshSnapshot {
+	public:
+		TestRefreshSnapshot() : DebuggerRefreshSnapshot(nullptr, nullptr) {}
+
+		void Set(DebuggerRefreshSection section, const vector<uint8_t>& data) {
+			UpdateSection(section, data.data(), (uint32_t)data.size());
+		}
+
+		uint32_t Write(vector<uint8_t>& buffer) {
+			return WriteSnapshot(buffer.data(), (uint32_t)buffer.size());
+		}
+
+		uint64_t GetGeneration(DebuggerRefreshSection section) {
+			return _sections[(int)section].Generation;
+		}
+	};
+
+	DebuggerRefreshHeader& GetHeader(vector<uint8_t>& buffer) {
+		return *(DebuggerRefreshHeader*)buffer.data();
+	}
+
+	vector<uint8_t> GetSectionData(vector<uint8_t>& buffer, DebuggerRefreshSection section) {
+		DebuggerRefreshSectionInfo& info = GetHeader(buffer).Sections[(int)section];
+		return vector<uint8_t>(buffer.begin() + info.Offset, buffer.begin() + info.Offset + info.Size);
+	}
+
+	void FillAll(TestRefreshSnapshot& snapshot) {
+		snapshot.Set(DebuggerRefreshSection::CpuState, vector<uint8_t>(20, 1));
+		snapshot.Set(DebuggerRefreshSection::PpuState, vector<uint8_t>(30, 2));
+		snapshot.Set(DebuggerRefreshSection::Disassembly, vector<uint8_t>(100, 3));
+		snapshot.Set(DebuggerRefreshSection::Memory, vector<uint8_t>(64, 4));
+	}
+
+	constexpr uint32_t AllSections = (1 << (int)DebuggerRefreshSection::Count) - 1;
+}
+
+TEST(DebuggerRefreshSnapshotTests, FirstWrite_CopiesAllSections) {
+	TestRefreshSnapshot snapshot;
+	FillAll(snapshot);
+
+	vector<uint8_t> buffer;
+	uint32_t size = snapshot.Write(buffer);
+	buffer.resize(size, 0);
+	ASSERT_EQ(snapshot.Write(buffer), size);
+
+	DebuggerRefreshHeader& header = GetHeader(buffer);
+	EXPECT_EQ(header.Version, DebuggerRefreshSnapshot::FormatVersion);
+	EXPECT_EQ(header.TotalSize, size);
+	EXPECT_EQ(header.UpdatedSections, AllSections);
+	EXPECT_EQ(GetSectionData(buffer, DebuggerRefreshSection::CpuState), vector<uint8_t>(20, 1));
+	EXPECT_EQ(GetSectionData(buffer, DebuggerRefreshSection::Memory), vector<uint8_t>(64, 4));
+
+	for (const DebuggerRefreshSectionInfo& info : header.Sections) {
+		EXPECT_EQ(info.Offset % 8, 0u);
+		EXPECT_NE(info.Generation, 0u);
+	}
+}
+
+TEST(DebuggerRefreshSnapshotTests, BufferTooSmall_ReturnsRequiredSizeWithoutWriting) {
+	TestRefreshSnapshot snapshot;
+	FillAll(snapshot);
+
+	vector<uint8_t> buffer(16, 0xAA);
+	uint32_t size = snapshot.Write(buffer);
+	EXPECT_GT(size, 16u);
+	EXPECT_EQ(buffer, vector<uint8_t>(16, 0xAA));
+}
+
+TEST(DebuggerRefreshSnapshotTests, UnchangedContent_KeepsGenerationAndSkipsCopy) {
+	TestRefreshSnapshot snapshot;
+	FillAll(snapshot);
+	vector<uint8_t> buffer(4096, 0);
+	snapshot.Write(buffer);
+	uint64_t generation = snapshot.GetGeneration(DebuggerRefreshSection::Disassembly);
+
+	// Re-capturing identical data must not look like a change
+	FillAll(snapshot);
+	EXPECT_EQ(snapshot.GetGeneration(DebuggerRefreshSection::Disassembly), generation);
+
+	// Scribble over the section in the caller's buffer - an unchanged section must not be re-copied
+	DebuggerRefreshSectionInfo info = GetHeader(buffer).Sections[(int)DebuggerRefreshSection::Disassembly];
+	buffer[info.Offset] = 0xFF;
+	snapshot.Write(buffer);
+	EXPECT_EQ(GetHeader(buffer).UpdatedSections, 0u);
+	EXPECT_EQ(buffer[info.Offset], 0xFF);
+}
+
+TEST(DebuggerRefreshSnapshotTests, ChangedSection_OnlyThatSectionIsUpdated) {
+	TestRefreshSnapshot snapshot;
+	FillAll(snapshot);
+	vector<uint8_t> buffer(4096, 0);
+	snapshot.Write(buffer);
+
+	vector<uint8_t> cpuState(20, 1);
+	cpuState[5] = 9;
+	snapshot.Set(DebuggerRefreshSection::CpuState, cpuState);
+	snapshot.Write(buffer);
+
+	EXPECT_EQ(GetHeader(buffer).UpdatedSections, 1u << (int)DebuggerRefreshSection::CpuState);
+	EXPECT_EQ(GetSectionData(buffer, DebuggerRefreshSection::CpuState), cpuState);
+}
+
+TEST(DebuggerRefreshSnapshotTests, LayoutChange_RewritesAllSections) {
+	TestRefreshSnapshot snapshot;
+	FillAll(snapshot);
+	vector<uint8_t> buffer(4096, 0);
+	snapshot.Write(buffer);
+
+	// A longer memory section changes the total size and invalidates the buffer
+	snapshot.Set(DebuggerRefreshSection::Memory, vector<uint8_t>(128, 4));
+	snapshot.Write(buffer);
+	EXPECT_EQ(GetHeader(buffer).UpdatedSections, AllSections);
+	EXPECT_EQ(GetSectionData(buffer, DebuggerRefreshSection::Memory), vector<uint8_t>(128, 4));
+}
+
+TEST(DebuggerRefreshSnapshotTests, SeparateBuffers_AreTrackedIndependently) {
+	TestRefreshSnapshot snapshot;
+	FillAll(snapshot);
+	vector<uint8_t> bufferA(4096, 0);
+	vector<uint8_t> bufferB(4096, 0);
+	snapshot.Write(bufferA);
+
+	snapshot.Set(DebuggerRefreshSection::PpuState, vector<uint8_t>(30, 7));
+	snapshot.Write(bufferB);
+	EXPECT_EQ(GetHeader(bufferB).UpdatedSections, AllSections);
+
+	snapshot.Write(bufferA);
+	EXPECT_EQ(GetHeader(bufferA).UpdatedSections, 1u << (int)DebuggerRefreshSection::PpuState);
+}
+
+TEST(DebuggerRefreshSnapshotTests, GetRequiredSize_MatchesRequestLayout) {
+	DebuggerRefreshRequest request = {};
+	request.CpuStateSize = 20;
+	request.PpuStateSize = 30;
+	request.DisassemblyRowCount = 2;
+	request.MemoryLength = 64;
+
+	TestRefreshSnapshot snapshot;
+	snapshot.Set(DebuggerRefreshSection::CpuState, vector<uint8_t>(20));
+	snapshot.Set(DebuggerRefreshSection::PpuState, vector<uint8_t>(30));
+	snapshot.Set(DebuggerRefreshSection::Disassembly, vector<uint8_t>(2 * sizeof(CodeLineData)));
+	snapshot.Set(DebuggerRefreshSection::Memory, vector<uint8_t>(64));
+
+	vector<uint8_t> empty;
+	EXPECT_EQ(snapshot.Write(empty), DebuggerRefreshSnapshot::GetRequiredSize(request));
+}
@@ -0,0 +1,235 @@
+#include "pch.h"
+#include <random>
+#include "Debugger/MemorySearch.h"
+
+// =============================================================================
+// MemorySearch Unit Tests
+// =============================================================================
+// The search session is fed memory contents directly (no MemoryDumper), and the
+// bitset kernels are checked against a straightforward per-address reference
+// implementation (same semantics as the UI's MemorySearchViewModel.IsMatch).
+
+namespace {
+	constexpr MemoryType TestMemType = MemoryType::SnesWorkRam;
+
+	int64_t RefValue(const vector<uint8_t>& mem, uint32_t addr, const MemorySearchFilter& f) {
+		uint32_t size = (uint32_t)f.ValueSize;
+		uint32_t value = 0;
+		for (uint32_t i = 0; i < size; i++) {
+			uint8_t b = addr + i < mem.size() ? mem[addr + i] : 0;
+			if (f.BigEndian) {
+				value = (value << 8) | b;
+			} else {
+				value |= (uint32_t)b << (i * 8);
+			}
+		}
+		if (!f.IsSigned) {
+			return value;
+		}
+		switch (f.ValueSize) {
+			case MemorySearchValueSize::Byte: return (int8_t)value;
+			case MemorySearchValueSize::Word: return (int16_t)value;
+			default: return (int32_t)value;
+		}
+	}
+
+	bool RefMatch(int64_t a, int64_t b, MemorySearchOperator op) {
+		switch (op) {
+			case MemorySearchOperator::Equal: return a == b;
+			case MemorySearchOperator::NotEqual: return a != b;
+			case MemorySearchOperator::LessThan: return a < b;
+			case MemorySearchOperator::LessThanOrEqual: return a <= b;
+			case MemorySearchOperator::GreaterThan: return a > b;
+			default: return a >= b;
+		}
+	}
+
+	MemorySearchFilter MakeFilter(MemorySearchCompareTo compareTo, MemorySearchOperator op, int64_t value = 0) {
+		MemorySearchFilter filter = {};
+		filter.ValueSize = MemorySearchValueSize::Byte;
+		filter.CompareTo = compareTo;
+		filter.Operator = op;
+		filter.SpecificValue = value;
+		return filter;
+	}
+
+	vector<uint32_t> GetAllAddresses(MemorySearch& search) {
+		vector<MemorySearchResult> results(search.GetCandidateCount());
+		uint32_t count = search.GetResults(0, results.data(), (uint32_t)results.size(), MemorySearchValueSize::Byte, false);
+		vector<uint32_t> addresses;
+		for (uint32_t i = 0; i < count; i++) {
+			addresses.push_back(results[i].Address);
+		}
+		return addresses;
+	}
+}
+
+TEST(MemorySearchTests, Reset_AllAddressesAreCandidates) {
+	vector<uint8_t> mem(100, 0);
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+
+	EXPECT_EQ(search.GetCandidateCount(), 100u);
+	EXPECT_FALSE(search.CanUndo());
+	vector<uint32_t> addresses = GetAllAddresses(search);
+	ASSERT_EQ(addresses.size(), 100u);
+	EXPECT_EQ(addresses.front(), 0u);
+	EXPECT_EQ(addresses.back(), 99u);
+}
+
+TEST(MemorySearchTests, SpecificValue_Equal_FindsMatches) {
+	vector<uint8_t> mem(300, 0);
+	mem[5] = 42;
+	mem[130] = 42;
+	mem[299] = 42;
+
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+	EXPECT_EQ(search.ApplyFilter(MakeFilter(MemorySearchCompareTo::SpecificValue, MemorySearchOperator::Equal, 42)), 3u);
+	EXPECT_EQ(GetAllAddresses(search), (vector<uint32_t> { 5, 130, 299 }));
+}
+
+TEST(MemorySearchTests, PreviousSearchValue_Decreased_NarrowsAcrossPasses) {
+	vector<uint8_t> mem(64, 10);
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+
+	mem[3] = 9;
+	mem[7] = 9;
+	search.Refresh(mem.data());
+	EXPECT_EQ(search.ApplyFilter(MakeFilter(MemorySearchCompareTo::PreviousSearchValue, MemorySearchOperator::LessThan)), 2u);
+
+	// Second pass compares against the snapshot taken by the first filter
+	mem[7] = 8;
+	search.Refresh(mem.data());
+	EXPECT_EQ(search.ApplyFilter(MakeFilter(MemorySearchCompareTo::PreviousSearchValue, MemorySearchOperator::LessThan)), 1u);
+	EXPECT_EQ(GetAllAddresses(search), (vector<uint32_t> { 7 }));
+}
+
+TEST(MemorySearchTests, PreviousRefreshValue_UsesLastRefresh) {
+	vector<uint8_t> mem(16, 0);
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+
+	mem[1] = 1;
+	search.Refresh(mem.data());
+	mem[2] = 1;
+	search.Refresh(mem.data());
+
+	// Only address 2 changed between the last two refreshes
+	EXPECT_EQ(search.ApplyFilter(MakeFilter(MemorySearchCompareTo::PreviousRefreshValue, MemorySearchOperator::NotEqual)), 1u);
+	EXPECT_EQ(GetAllAddresses(search), (vector<uint32_t> { 2 }));
+}
+
+TEST(MemorySearchTests, Undo_RestoresCandidatesAndSnapshot) {
+	vector<uint8_t> mem(200, 0);
+	mem[50] = 1;
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+
+	search.ApplyFilter(MakeFilter(MemorySearchCompareTo::SpecificValue, MemorySearchOperator::Equal, 1));
+	EXPECT_EQ(search.GetCandidateCount(), 1u);
+	ASSERT_TRUE(search.Undo());
+	EXPECT_EQ(search.GetCandidateCount(), 200u);
+	EXPECT_FALSE(search.Undo());
+}
+
+TEST(MemorySearchTests, GetResults_PagesInAddressOrder) {
+	vector<uint8_t> mem(1000, 0);
+	for (uint32_t i = 0; i < 1000; i += 3) {
+		mem[i] = 1;
+	}
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+	uint32_t count = search.ApplyFilter(MakeFilter(MemorySearchCompareTo::SpecificValue, MemorySearchOperator::Equal, 1));
+	ASSERT_EQ(count, 334u);
+
+	MemorySearchResult page[50];
+	for (uint32_t offset = 0; offset < count; offset += 50) {
+		uint32_t pageCount = search.GetResults(offset, page, 50, MemorySearchValueSize::Byte, false);
+		EXPECT_EQ(pageCount, std::min(50u, count - offset));
+		for (uint32_t i = 0; i < pageCount; i++) {
+			EXPECT_EQ(page[i].Address, (offset + i) * 3);
+			EXPECT_EQ(page[i].Value, 1u);
+		}
+	}
+	EXPECT_EQ(search.GetResults(count, page, 50, MemorySearchValueSize::Byte, false), 0u);
+}
+
+TEST(MemorySearchTests, GetResults_ReturnsMultiByteValues) {
+	vector<uint8_t> mem = { 0x12, 0x34, 0x56, 0x78 };
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+
+	MemorySearchResult results[4];
+	ASSERT_EQ(search.GetResults(0, results, 4, MemorySearchValueSize::Dword, false), 4u);
+	EXPECT_EQ(results[0].Value, 0x78563412u);
+	EXPECT_EQ(results[3].Value, 0x78u); // Bytes past the end read as 0
+
+	ASSERT_EQ(search.GetResults(0, results, 4, MemorySearchValueSize::Word, true), 4u);
+	EXPECT_EQ(results[0].Value, 0x1234u);
+	EXPECT_EQ(results[3].Value, 0x7800u);
+}
+
+TEST(MemorySearchTests, SpecificAddress_ComparesAgainstCurrentValueAtAddress) {
+	vector<uint8_t> mem = { 5, 3, 7, 5, 9 };
+	MemorySearch search(nullptr);
+	search.Reset(TestMemType, mem.data(), (uint32_t)mem.size());
+
+	MemorySearchFilter filter = MakeFilter(MemorySearchCompareTo::SpecificAddress, MemorySearchOperator::GreaterThanOrEqual);
+	filter.SpecificAddress = 0;
+	EXPECT_EQ(search.ApplyFilter(filter), 4u);
+	EXPECT_EQ(GetAllAddresses(search), (vector<uint32_t> { 0, 2, 3, 4 }));
+}
+
+TEST(MemorySearchTests, AllFilterCombinations_MatchReference) {
+	std::mt19937 rng(1234);
+	const uint32_t size = 1000;
+	vector<uint8_t> before(size);
+	vector<uint8_t> after(size);
+	for (uint32_t i = 0; i < size; i++) {
+		// Small value range so equality/ordering filters all have matches
+		before[i] = (uint8_t)(rng() % 4 == 0 ? rng() : 0x80 + rng() % 3);
+		after[i] = rng() % 2 ? before[i] : (uint8_t)(before[i] + (rng() % 3) - 1);
+	}
+
+	for (MemorySearchValueSize valueSize : { MemorySearchValueSize::Byte, MemorySearchValueSize::Word, MemorySearchValueSize::Dword }) {
+		for (int isSigned = 0; isSigned < 2; isSigned++) {
+			for (int bigEndian = 0; bigEndian < 2; bigEndian++) {
+				for (int compareTo = 0; compareTo <= (int)MemorySearchCompareTo::SpecificAddress; compareTo++) {
+					for (int op = 0; op <= (int)MemorySearchOperator::GreaterThanOrEqual; op++) {
+						MemorySearchFilter filter = {};
+						filter.ValueSize = valueSize;
+						filter.IsSigned = isSigned;
+						filter.BigEndian = bigEndian;
+						filter.CompareTo = (MemorySearchCompareTo)compareTo;
+						filter.Operator = (MemorySearchOperator)op;
+						filter.SpecificValue = RefValue(after, 17, filter);
+						filter.SpecificAddress = 999;
+
+						MemorySearch search(nullptr);
+						search.Reset(TestMemType, before.data(), size);
+						search.Refresh(after.data());
+						search.ApplyFilter(filter);
+
+						vector<uint32_t> expected;
+						for (uint32_t addr = 0; addr < size; addr++) {
+							int64_t reference = 0;
+							switch (filter.CompareTo) {
+								case MemorySearchCompareTo::PreviousSearchValue:
+								case MemorySearchCompareTo::PreviousRefreshValue: reference = RefValue(before, addr, filter); break;
+								case MemorySearchCompareTo::SpecificValue: reference = filter.SpecificValue; break;
+								case MemorySearchCompareTo::SpecificAddress: reference = RefValue(after, filter.SpecificAddress, filter); break;
+							}
+							if (RefMatch(RefValue(after, addr, filter), reference, filter.Operator)) {
+								expected.push_back(addr);
+							}
+						}
+
+						EXPECT_EQ(GetAllAddresses(search), expected) << "size=" << (int)valueSize << " signed=" << isSigned << " be=" << bigEndian << " compareTo=" << compareTo << " op=" << op;
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/MemoryType.h"
+#include "GBA/GbaConsole.h"
+#include "GBA/GbaCpu.h"
+#include "Utilities/VirtualFile.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+// =============================================================================
+// GBA idle loop skipping - IRQ timing
+// =============================================================================
+// The ROM enables the VBlank IRQ and timer 0 (1 tick per master clock), then
+// polls a RAM counter incremented by the IRQ handler (an idle loop). The
+// handler stores timer 0's value for every IRQ, so the timing of the IRQs
+// can be compared with and without idle loop skipping.
+// =============================================================================
+
+namespace {
+	constexpr uint32_t FrameCount = 10;
+	constexpr uint32_t CyclesPerFrame = 308 * 4 * 228;
+
+	void WriteArm(uint8_t* data, uint32_t offset, std::initializer_list<uint32_t> opCodes) {
+		for (uint32_t opCode : opCodes) {
+			for (int i = 0; i < 4; i++) {
+				data[offset++] = (uint8_t)(opCode >> (i * 8));
+			}
+		}
+	}
+
+	std::vector<uint8_t> BuildRom() {
+		std::vector<uint8_t> rom(0x1000, 0);
+		WriteArm(rom.data(), 0, {0xEA00002E}); // b $080000C0
+		rom[0xB2] = 0x96;                      // Fixed header value
+
+		WriteArm(rom.data(), 0xC0, {
+			0xE3A00301, // mov r0, #$04000000
+			0xE3A01008, // mov r1, #8
+			0xE1C010B4, // strh r1, [r0, #4] (DISPSTAT: vblank irq)
+			0xE3A01001, // mov r1, #1
+			0xE2802C02, // add r2, r0, #$200
+			0xE1C210B0, // strh r1, [r2] (IE: vblank)
+			0xE1C210B8, // strh r1, [r2, #8] (IME)
+			0xE2803C01, // add r3, r0, #$100
+			0xE3A01080, // mov r1, #$80
+			0xE1C310B2, // strh r1, [r3, #2] (TM0CNT_H: enabled, prescaler 1)
+			0xE321F01F, // msr cpsr_c, #$1F (irqs on)
+			0xE3A05403, // mov r5, #$03000000
+			0xE3A06000, // mov r6, #0
+			0xE5954000, // loop: ldr r4, [r5]
+			0xE1540006, // cmp r4, r6
+			0x0AFFFFFC, // beq loop
+			0xE1A06004, // mov r6, r4
+			0xEAFFFFFA  // b loop
+		});
+		return rom;
+	}
+
+	void PatchBios(uint8_t* bios) {
+		WriteArm(bios, 0x18, {0xEA000038}); // IRQ vector: b $100
+		WriteArm(bios, 0x100, {
+			0xE3A00301, // mov r0, #$04000000
+			0xE2803C01, // add r3, r0, #$100
+			0xE1D310B0, // ldrh r1, [r3] (TM0CNT_L)
+			0xE3A02403, // mov r2, #$03000000
+			0xE5923000, // ldr r3, [r2]
+			0xE2833001, // add r3, r3, #1
+			0xE5823000, // str r3, [r2] (irq counter)
+			0xE0823103, // add r3, r2, r3, lsl #2
+			0xE5831000, // str r1, [r3] (timer value for this irq)
+			0xE3A01001, // mov r1, #1
+			0xE2803C02, // add r3, r0, #$200
+			0xE1C310B2, // strh r1, [r3, #2] (IF: ack vblank)
+			0xE25EF004  // subs pc, lr, #4
+		});
+	}
+
+	struct IrqLog {
+		uint32_t Count = 0;
+		std::vector<uint16_t> Times;
+		uint64_t SkippedCycles = 0;
+	};
+
+	IrqLog RunRom(bool skipIdleLoops) {
+		TestHomeFolder home("nexen_gba_idle_loop_test");
+		IrqLog log;
+
+		Emulator emu;
+		emu.InitializeHeadless();
+		emu.GetSettings()->GetGbaConfig().SkipBootScreen = true;
+		emu.GetSettings()->GetEmulationConfig().SkipIdleLoops = skipIdleLoops;
+
+		std::vector<uint8_t> rom = BuildRom();
+		if (!emu.LoadRom(VirtualFile(rom.data(), rom.size(), "idle.gba"), VirtualFile())) {
+			ADD_FAILURE() << "failed to load test ROM";
+			emu.Release();
+			return log;
+		}
+		PatchBios((uint8_t*)emu.GetMemory(MemoryType::GbaBootRom).Memory);
+
+		for (uint32_t i = 0; i < FrameCount; i++) {
+			emu.RunHeadlessFrame();
+		}
+
+		uint8_t* iwram = (uint8_t*)emu.GetMemory(MemoryType::GbaIntWorkRam).Memory;
+		memcpy(&log.Count, iwram, sizeof(log.Count));
+		for (uint32_t i = 1; i <= log.Count && i < 0x100; i++) {
+			log.Times.push_back((uint16_t)(iwram[i * 4] | (iwram[i * 4 + 1] << 8)));
+		}
+		log.SkippedCycles = ((GbaConsole*)emu.GetConsoleUnsafe())->GetCpu()->GetIdleLoopSkippedCycles();
+
+		emu.Stop(false, true, false);
+		emu.Release();
+		return log;
+	}
+}
+
+TEST(GbaIdleLoopTest, SkipDoesNotChangeIrqTiming) {
+	IrqLog normal = RunRom(false);
+	IrqLog skipped = RunRom(true);
+
+	ASSERT_GE(normal.Count, FrameCount - 1);
+	EXPECT_EQ(normal.SkippedCycles, 0u);
+	EXPECT_EQ(skipped.Count, normal.Count);
+	ASSERT_EQ(skipped.Times.size(), normal.Times.size());
+
+	// The loop is left on the first access after the IRQ is raised in both cases, so the IRQ
+	// can only be taken at a different point of the same loop iteration
+	for (size_t i = 0; i < normal.Times.size(); i++) {
+		int16_t delta = (int16_t)(skipped.Times[i] - normal.Times[i]);
+		EXPECT_LE(std::abs(delta), 32) << "irq " << i;
+	}
+
+	// One frame apart, give or take an iteration of the loop
+	for (size_t i = 1; i < skipped.Times.size(); i++) {
+		int16_t frameDelta = (int16_t)(uint16_t)(skipped.Times[i] - skipped.Times[i - 1] - (uint16_t)CyclesPerFrame);
+		EXPECT_LE(std::abs(frameDelta), 32) << "irq " << i;
+	}
+}
+
+TEST(GbaIdleLoopTest, SkipsMostOfTheIdleTime) {
+	IrqLog skipped = RunRom(true);
+
+	// Almost all of the frame is spent in the idle loop
+	EXPECT_GT(skipped.SkippedCycles, (uint64_t)CyclesPerFrame * (FrameCount - 1) / 2);
+}
@@ -0,0 +1,221 @@
+#include "pch.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/MemoryType.h"
+#include "Shared/SaveStateManager.h"
+#include "GBA/GbaConsole.h"
+#include "GBA/GbaMemoryManager.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/MemoryAccessCounter.h"
+#include "Utilities/Serializer.h"
+#include "Utilities/VirtualFile.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+// =============================================================================
+// GbaMemoryManager::ReadCode vs Read
+// =============================================================================
+// ReadCode is the CPU's opcode fetch fast path - it must return the same value
+// and leave the console in the same state as Read (wait states, prefetch
+// buffer, open bus, BIOS lock, cart GPIO) for every region of the memory map,
+// with and without the debugger's exec hook. Each access is done with Read,
+// then with ReadCode from the same save state, and the results are compared.
+// =============================================================================
+
+namespace {
+	constexpr uint32_t RomSize = 0x1000;
+
+	struct AccessResult {
+		uint32_t Value = 0;
+		uint32_t BiosValue = 0;
+		uint64_t MasterClock = 0;
+		vector<uint8_t> State;
+		uint32_t ExecCount = 0; ///< Exec hook calls for the address (with the debugger)
+		uint64_t ExecStamp = 0;
+	};
+
+	class GbaReadCodeTest : public ::testing::TestWithParam<bool> {
+	protected:
+		TestHomeFolder _home{"nexen_gba_read_code_test"};
+		Emulator _emu;
+		GbaMemoryManager* _memoryManager = nullptr;
+
+		void SetUp() override {
+			_emu.InitializeHeadless();
+			_emu.GetSettings()->GetGbaConfig().SkipBootScreen = true;
+			_emu.GetSettings()->GetGbaConfig().RtcType = GbaRtcType::Enabled;
+
+			vector<uint8_t> rom(RomSize);
+			for (uint32_t i = 0; i < RomSize; i++) {
+				rom[i] = (uint8_t)(i * 7 + 3);
+			}
+			rom[0] = 0x2E; // b $080000C0
+			rom[1] = 0x00;
+			rom[2] = 0x00;
+			rom[3] = 0xEA;
+			rom[0xB2] = 0x96; // Fixed header value
+			rom[0xC0] = 0xFE; // loop: b loop
+			rom[0xC1] = 0xFF;
+			rom[0xC2] = 0xFF;
+			rom[0xC3] = 0xEA;
+			ASSERT_TRUE(_emu.LoadRom(VirtualFile(rom.data(), rom.size(), "fetch.gba"), VirtualFile()));
+
+			for (MemoryType type : {MemoryType::GbaExtWorkRam, MemoryType::GbaIntWorkRam}) {
+				ConsoleMemoryInfo mem = _emu.GetMemory(type);
+				for (uint32_t i = 0; i < mem.Size; i++) {
+					((uint8_t*)mem.Memory)[i] = (uint8_t)(i * 13 + 5);
+				}
+			}
+
+			if (GetParam()) {
+				_emu.InitDebugger();
+			}
+			_memoryManager = ((GbaConsole*)_emu.GetConsoleUnsafe())->GetMemoryManager();
+			_emu.RunHeadlessFrame();
+		}
+
+		void TearDown() override {
+			_emu.Stop(false, true, false);
+			_emu.Release();
+		}
+
+		vector<uint8_t> SaveState() {
+			Serializer s;
+			s.ResetForFastSave(SaveStateManager::FileFormatVersion);
+			_emu.StreamHeadlessState(s);
+			return s.GetData();
+		}
+
+		void LoadState(const vector<uint8_t>& state) {
+			Serializer s;
+			s.ResetForFastSave(SaveStateManager::FileFormatVersion);
+			s.ResetForFastLoad(state);
+			_emu.StreamHeadlessState(s);
+		}
+
+		AddressCounters GetCounters(uint32_t addr) {
+			AddressCounters counts = {};
+			AddressInfo absAddr = _memoryManager->GetAbsoluteAddress(addr & ~0x03);
+			if (Debugger* debugger = _emu.InternalGetDebugger(); debugger && absAddr.Address >= 0) {
+				debugger->GetMemoryAccessCounter()->GetAccessCounts(absAddr.Address, 1, absAddr.Type, &counts);
+			}
+			return counts;
+		}
+
+		AccessResult Access(bool readCode, GbaAccessModeVal mode, uint32_t addr) {
+			// The debugger's counters aren't part of the save state - compare what the access added
+			uint32_t execCount = GetCounters(addr).ExecCounter;
+
+			AccessResult result;
+			result.Value = readCode ? _memoryManager->ReadCode(mode, addr) : _memoryManager->Read(mode, addr);
+			result.MasterClock = _memoryManager->GetMasterClock();
+			result.State = SaveState();
+
+			AddressCounters counts = GetCounters(addr);
+			result.ExecCount = counts.ExecCounter - execCount;
+			result.ExecStamp = counts.ExecStamp;
+
+			// Reading the BIOS shows whether the fetch locked it
+			result.BiosValue = _memoryManager->Read(GbaAccessMode::Word, 0x100);
+			return result;
+		}
+
+		void CompareAccess(GbaAccessModeVal mode, uint32_t addr) {
+			vector<uint8_t> start = SaveState();
+			AccessResult read = Access(false, mode, addr);
+
+			LoadState(start);
+			AccessResult readCode = Access(true, mode, addr);
+
+			SCOPED_TRACE(std::format("mode ${:02X}, address ${:08X}", (int)mode, addr));
+			EXPECT_EQ(readCode.Value, read.Value);
+			EXPECT_EQ(readCode.BiosValue, read.BiosValue);
+			EXPECT_EQ(readCode.MasterClock, read.MasterClock);
+			EXPECT_TRUE(readCode.State == read.State);
+			EXPECT_EQ(readCode.ExecCount, read.ExecCount);
+			EXPECT_EQ(readCode.ExecStamp, read.ExecStamp);
+			LoadState(start);
+		}
+
+		void CompareFetches(uint32_t addr) {
+			for (GbaAccessModeVal size : {GbaAccessMode::HalfWord, GbaAccessMode::Word}) {
+				CompareAccess(GbaAccessMode::Prefetch | size, addr);
+				CompareAccess(GbaAccessMode::Prefetch | GbaAccessMode::Sequential | size, addr);
+			}
+		}
+	};
+}
+
+TEST_P(GbaReadCodeTest, Rom) {
+	CompareFetches(0x08000200);
+	CompareFetches(0x0A000200); // Wait state 1 mirror
+	CompareFetches(0x0C000200); // Wait state 2 mirror
+	CompareFetches(0x08000000 + RomSize - 2);
+}
+
+TEST_P(GbaReadCodeTest, Rom_OutOfBounds_OpenBus) {
+	CompareFetches(0x08000000 + RomSize);
+	CompareFetches(0x08000000 + RomSize + 0x1234);
+	CompareFetches(0x09FFFFFC);
+}
+
+TEST_P(GbaReadCodeTest, Rom_Gpio) {
+	// Write-only GPIO - reads return the ROM's data
+	for (uint32_t addr = 0x080000C0; addr <= 0x080000CC; addr += 2) {
+		CompareFetches(addr);
+	}
+
+	// Readable GPIO - reads return the RTC's pins
+	_memoryManager->Write(GbaAccessMode::HalfWord, 0x080000C8, 1);
+	for (uint32_t addr = 0x080000C0; addr <= 0x080000CC; addr += 2) {
+		CompareFetches(addr);
+	}
+}
+
+TEST_P(GbaReadCodeTest, WorkRam) {
+	CompareFetches(0x02000100);
+	CompareFetches(0x0203FFFC);
+	CompareFetches(0x02F00100); // Mirror
+	CompareFetches(0x03000100);
+	CompareFetches(0x03007FFC);
+	CompareFetches(0x03FF0100); // Mirror
+}
+
+TEST_P(GbaReadCodeTest, Misaligned) {
+	CompareAccess(GbaAccessMode::Prefetch | GbaAccessMode::HalfWord, 0x08000201);
+	CompareAccess(GbaAccessMode::Prefetch | GbaAccessMode::Word, 0x08000202);
+	CompareAccess(GbaAccessMode::Prefetch | GbaAccessMode::Word, 0x03000102);
+	CompareAccess(GbaAccessMode::Prefetch | GbaAccessMode::Word, 0x02000103);
+}
+
+TEST_P(GbaReadCodeTest, Bios_Lock) {
+	// Fetching from the BIOS unlocks it, fetching from anywhere else locks it
+	CompareFetches(0x00000100);
+	CompareFetches(0x00003FFC);
+	_memoryManager->Read(GbaAccessMode::Prefetch | GbaAccessMode::Word, 0x00000100);
+	CompareFetches(0x08000200);
+	CompareFetches(0x03000100);
+	CompareFetches(0x00004000); // Past the BIOS
+}
+
+TEST_P(GbaReadCodeTest, OtherRegions_OpenBus) {
+	CompareFetches(0x01000000); // Unmapped
+	CompareFetches(0x04000000); // I/O
+	CompareFetches(0x04000800); // Unmapped I/O
+	CompareFetches(0x05000100); // Palette
+	CompareFetches(0x06000100); // VRAM
+	CompareFetches(0x07000100); // OAM
+	CompareFetches(0x0D000100); // EEPROM range
+	CompareFetches(0x0E000100); // SRAM
+	CompareFetches(0x10000000); // Unmapped
+	CompareFetches(0xFFFFFFFC);
+}
+
+TEST_P(GbaReadCodeTest, Byte_NotPrefetch) {
+	CompareAccess(GbaAccessMode::Byte, 0x08000201);
+	CompareAccess(GbaAccessMode::HalfWord, 0x08000200);
+	CompareAccess(GbaAccessMode::Word, 0x03000100);
+}
+
+INSTANTIATE_TEST_SUITE_P(Debugger, GbaReadCodeTest, ::testing::Bool(), [](const ::testing::TestParamInfo<bool>& info) {
+	return info.param ? "WithDebugger" : "NoDebugger";
+});
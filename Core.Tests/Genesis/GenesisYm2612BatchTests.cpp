@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "Genesis/GenesisYm2612.h"
+
+// =============================================================================
+// GenesisYm2612 Batched Synthesis Tests
+// =============================================================================
+// Writes are applied in batches at catch-up points, but must produce exactly
+// the same samples as a chip clocked one sample at a time with each write
+// applied as soon as it happens.
+
+namespace {
+	struct TimedWrite {
+		uint64_t Clock;
+		uint8_t Port;
+		uint8_t Value;
+	};
+
+	void AddRegWrite(vector<TimedWrite>& writes, uint64_t clock, uint8_t reg, uint8_t value) {
+		writes.push_back({ clock, 0, reg });
+		writes.push_back({ clock + 3, 1, value });
+	}
+
+	// Channel 1 tone with key on/off and a pitch change, plus PCM streamed through the DAC
+	vector<TimedWrite> BuildWrites() {
+		vector<TimedWrite> writes;
+		AddRegWrite(writes, 10, 0xB0, 0x07);   // Algorithm 7 (all operators output)
+		AddRegWrite(writes, 20, 0xB4, 0xC0);   // Left + right
+		for (uint8_t op = 0; op < 4; op++) {
+			AddRegWrite(writes, 30 + op * 40, 0x30 + op * 4, 0x01);  // MUL=1
+			AddRegWrite(writes, 31 + op * 40, 0x40 + op * 4, 0x10);  // TL
+			AddRegWrite(writes, 32 + op * 40, 0x50 + op * 4, 0x1F);  // AR
+			AddRegWrite(writes, 33 + op * 40, 0x80 + op * 4, 0x0F);  // SL/RR
+		}
+		AddRegWrite(writes, 400, 0xA4, 0x22);
+		AddRegWrite(writes, 410, 0xA0, 0x69);
+		AddRegWrite(writes, 1000, 0x28, 0xF0); // Key on
+		AddRegWrite(writes, 30000, 0xA4, 0x1A);
+		AddRegWrite(writes, 30010, 0xA0, 0x40);
+		AddRegWrite(writes, 60001, 0x28, 0x00); // Key off
+
+		AddRegWrite(writes, 70000, 0x2B, 0x80); // DAC on
+		for (uint32_t i = 0; i < 300; i++) {
+			AddRegWrite(writes, 70100 + i * 157, 0x2A, (uint8_t)(0x80 + ((i * 37) & 0x3F)));
+		}
+		return writes;
+	}
+
+	vector<int16_t> RunPerSample(const vector<TimedWrite>& writes, uint64_t endClock) {
+		ymfm::ymfm_interface intf;
+		ymfm::ym2612 chip(intf);
+		chip.reset();
+
+		vector<int16_t> samples;
+		size_t writeIndex = 0;
+		for (uint64_t sampleClock = GenesisYm2612::ClocksPerSample; sampleClock <= endClock; sampleClock += GenesisYm2612::ClocksPerSample) {
+			while (writeIndex < writes.size() && writes[writeIndex].Clock < sampleClock) {
+				chip.write(writes[writeIndex].Port, writes[writeIndex].Value);
+				writeIndex++;
+			}
+
+			ymfm::ym2612::output_data output;
+			chip.generate(&output, 1);
+			samples.push_back((int16_t)std::clamp<int32_t>(output.data[0], INT16_MIN, INT16_MAX));
+			samples.push_back((int16_t)std::clamp<int32_t>(output.data[1], INT16_MIN, INT16_MAX));
+		}
+		return samples;
+	}
+}
+
+TEST(GenesisYm2612BatchTests, Batched_MatchesPerSampleClocking) {
+	vector<TimedWrite> writes = BuildWrites();
+	uint64_t endClock = 127840 + 5;
+	vector<int16_t> expected = RunPerSample(writes, endClock);
+
+	GenesisYm2612 ym(nullptr);
+	for (size_t i = 0; i < writes.size(); i++) {
+		ym.Write(writes[i].Clock, writes[i].Port, writes[i].Value);
+		if (i == writes.size() / 2) {
+			// Catch-up in the middle of the DAC stream
+			ym.Run(writes[i].Clock + 50);
+		}
+	}
+	ym.Run(endClock);
+
+	ASSERT_EQ(ym.GetSamples().size(), expected.size());
+	EXPECT_EQ(ym.GetSamples(), expected);
+	EXPECT_NE(std::count(expected.begin(), expected.end(), (int16_t)0), (ptrdiff_t)expected.size());
+}
+
+TEST(GenesisYm2612BatchTests, WritesDeferredUntilCatchUp) {
+	GenesisYm2612 ym(nullptr);
+	ym.Write(100, 0, 0x2B);
+	ym.Write(103, 1, 0x80);
+	EXPECT_EQ(ym.GetPendingWriteCount(), 2u);
+	EXPECT_TRUE(ym.GetSamples().empty());
+
+	ym.Run(GenesisYm2612::ClocksPerSample * 10 - 1);
+	EXPECT_EQ(ym.GetPendingWriteCount(), 0u);
+	EXPECT_EQ(ym.GetSamples().size(), 9u * 2);
+
+	ym.Run(GenesisYm2612::ClocksPerSample * 10);
+	EXPECT_EQ(ym.GetSamples().size(), 10u * 2);
+}
+
+TEST(GenesisYm2612BatchTests, FullWriteLog_CatchesUp) {
+	GenesisYm2612 ym(nullptr);
+	for (uint32_t i = 0; i <= GenesisYm2612::MaxPendingWrites; i++) {
+		ym.Write(i * 10, 0, 0x2A);
+	}
+	EXPECT_EQ(ym.GetPendingWriteCount(), 1u);
+	EXPECT_EQ(ym.GetSamples().size(), (GenesisYm2612::MaxPendingWrites * 10 / GenesisYm2612::ClocksPerSample) * 2);
+}
+
+TEST(GenesisYm2612BatchTests, Reset_AlignsToCurrentClock) {
+	GenesisYm2612 ym(nullptr);
+	ym.Reset(1000000);
+	ym.Run(1000000 + GenesisYm2612::ClocksPerSample * 3);
+	EXPECT_EQ(ym.GetSamples().size(), 3u * 2);
+}
@@ -540,3 +540,205 @@ TEST_F(ComLynxCableTest, NinthBit_PropagatesAcrossCable) {
 	EXPECT_EQ(_unitB.UartRxData, dataWith9thBit);
 	EXPECT_TRUE(_unitB.UartRxData & 0x0100); // 9th bit preserved
 }
+
+// =============================================================================
+// 11. Lockstep (units on separate threads)
+// =============================================================================
+
+namespace {
+	vector<uint16_t> GetRxQueue(const LynxMikey& mikey) {
+		vector<uint16_t> queue;
+		for (uint32_t i = 0; i < mikey.GetUartRxWaiting(); i++) {
+			queue.push_back(mikey.GetUartRxQueueEntry(i));
+		}
+		return queue;
+	}
+
+	// Bytes sent by each unit in each window - every receiver gets ~10 bytes (fits in the RX queue)
+	void RunLockstepWindow(ComLynxCable& cable, LynxMikey& mikey, uint32_t unitIndex, uint32_t window) {
+		if ((window * 7 + unitIndex * 3) % 5 == 0) {
+			cable.Broadcast(&mikey, (uint16_t)((unitIndex << 8) | window));
+		}
+		if ((window + unitIndex) % 6 == 0) {
+			cable.Broadcast(&mikey, (uint16_t)(0x80 | unitIndex));
+		}
+	}
+}
+
+TEST(ComLynxLockstepTest, BytesHeldUntilWindowEnds) {
+	ComLynxCable cable;
+	LynxMikey mikeyA;
+	LynxMikey mikeyB;
+	cable.Connect(&mikeyA);
+	cable.Connect(&mikeyB);
+	cable.SetLockstep(true);
+
+	cable.Broadcast(&mikeyA, 0x42);
+	EXPECT_EQ(mikeyB.GetUartRxWaiting(), 0u);
+
+	EXPECT_FALSE(cable.EndWindow(&mikeyA));
+	EXPECT_FALSE(cable.EndWindow(&mikeyA));
+	EXPECT_TRUE(cable.EndWindow(&mikeyB));
+	EXPECT_EQ(cable.GetWindowCount(), 1u);
+	EXPECT_EQ(mikeyB.GetUartRxWaiting(), 0u);
+
+	cable.ReceivePending(&mikeyB);
+	EXPECT_EQ(GetRxQueue(mikeyB), vector<uint16_t>({ 0x42 }));
+	cable.ReceivePending(&mikeyA);
+	EXPECT_EQ(mikeyA.GetUartRxWaiting(), 0u);
+}
+
+TEST(ComLynxLockstepTest, DeliveryOrder_IndependentOfArrivalOrder) {
+	auto run = [](bool reverse) {
+		ComLynxCable cable;
+		LynxMikey mikeys[3];
+		for (LynxMikey& mikey : mikeys) {
+			cable.Connect(&mikey);
+		}
+		cable.SetLockstep(true);
+
+		cable.Broadcast(&mikeys[2], 0x03);
+		cable.Broadcast(&mikeys[0], 0x01);
+		cable.Broadcast(&mikeys[2], 0x04);
+		for (int i = 0; i < 3; i++) {
+			cable.EndWindow(&mikeys[reverse ? 2 - i : i]);
+		}
+		cable.ReceivePending(&mikeys[1]);
+		return GetRxQueue(mikeys[1]);
+	};
+
+	EXPECT_EQ(run(false), vector<uint16_t>({ 0x01, 0x03, 0x04 }));
+	EXPECT_EQ(run(true), vector<uint16_t>({ 0x01, 0x03, 0x04 }));
+}
+
+TEST(ComLynxLockstepTest, Threaded_MatchesSerial) {
+	constexpr uint32_t UnitCount = 4;
+	constexpr uint32_t WindowCount = 24;
+
+	// Serial reference: all units on one thread, one window at a time
+	vector<vector<uint16_t>> expected;
+	{
+		ComLynxCable cable;
+		LynxMikey mikeys[UnitCount];
+		for (LynxMikey& mikey : mikeys) {
+			cable.Connect(&mikey);
+		}
+		cable.SetLockstep(true);
+		for (uint32_t window = 0; window < WindowCount; window++) {
+			for (uint32_t i = 0; i < UnitCount; i++) {
+				RunLockstepWindow(cable, mikeys[i], i, window);
+				cable.EndWindow(&mikeys[i]);
+			}
+			for (LynxMikey& mikey : mikeys) {
+				cable.ReceivePending(&mikey);
+			}
+		}
+		for (LynxMikey& mikey : mikeys) {
+			expected.push_back(GetRxQueue(mikey));
+			EXPECT_FALSE(expected.back().empty());
+		}
+	}
+
+	for (int run = 0; run < 20; run++) {
+		ComLynxCable cable;
+		LynxMikey mikeys[UnitCount];
+		for (LynxMikey& mikey : mikeys) {
+			cable.Connect(&mikey);
+		}
+		cable.SetLockstep(true);
+
+		vector<std::thread> threads;
+		for (uint32_t i = 0; i < UnitCount; i++) {
+			threads.emplace_back([&, i]() {
+				for (uint32_t window = 0; window < WindowCount; window++) {
+					RunLockstepWindow(cable, mikeys[i], i, window);
+					cable.SyncWindow(&mikeys[i]);
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		EXPECT_EQ(cable.GetWindowCount(), WindowCount);
+		for (uint32_t i = 0; i < UnitCount; i++) {
+			EXPECT_EQ(GetRxQueue(mikeys[i]), expected[i]);
+		}
+	}
+}
+
+TEST(ComLynxLockstepTest, Disconnect_ReleasesWaitingUnits) {
+	ComLynxCable cable;
+	LynxMikey mikeyA;
+	LynxMikey mikeyB;
+	cable.Connect(&mikeyA);
+	cable.Connect(&mikeyB);
+	cable.SetLockstep(true);
+
+	std::thread thread([&]() { cable.SyncWindow(&mikeyA); });
+	cable.Disconnect(&mikeyB);
+	thread.join();
+	EXPECT_EQ(cable.GetWindowCount(), 1u);
+}
+
+TEST(ComLynxLockstepTest, Disable_DeliversPendingBytes) {
+	ComLynxCable cable;
+	LynxMikey mikeyA;
+	LynxMikey mikeyB;
+	cable.Connect(&mikeyA);
+	cable.Connect(&mikeyB);
+	cable.SetLockstep(true);
+
+	cable.Broadcast(&mikeyB, 0x55);
+	cable.SetLockstep(false);
+	EXPECT_EQ(GetRxQueue(mikeyA), vector<uint16_t>({ 0x55 }));
+
+	// Immediate mode
+	cable.Broadcast(&mikeyB, 0x66);
+	EXPECT_EQ(GetRxQueue(mikeyA), vector<uint16_t>({ 0x55, 0x66 }));
+}
+
+TEST(ComLynxLockstepTest, SlowUnit_HoldsOthersAtBoundary) {
+	ComLynxCable cable;
+	LynxMikey mikeyA;
+	LynxMikey mikeyB;
+	cable.Connect(&mikeyA);
+	cable.Connect(&mikeyB);
+	cable.SetLockstep(true);
+
+	// A must not run ahead of B, no matter how long B takes to end the window
+	std::atomic<bool> done = false;
+	cable.Broadcast(&mikeyB, 0x42);
+	std::thread thread([&]() {
+		cable.SyncWindow(&mikeyA);
+		done = true;
+	});
+	std::this_thread::sleep_for(ComLynxCable::StopCheckInterval * 3);
+	EXPECT_FALSE(done);
+	EXPECT_EQ(cable.GetWindowCount(), 0u);
+
+	EXPECT_TRUE(cable.EndWindow(&mikeyB));
+	thread.join();
+	EXPECT_EQ(cable.GetWindowCount(), 1u);
+	EXPECT_EQ(GetRxQueue(mikeyA), vector<uint16_t>({ 0x42 }));
+}
+
+TEST(ComLynxLockstepTest, Stopping_LeavesWindowWithoutCompletingIt) {
+	ComLynxCable cable;
+	LynxMikey mikeyA;
+	LynxMikey mikeyB;
+	cable.Connect(&mikeyA);
+	cable.Connect(&mikeyB);
+	cable.SetLockstep(true);
+
+	std::atomic<bool> stopping = false;
+	std::thread thread([&]() { cable.SyncWindow(&mikeyA, [&]() { return (bool)stopping; }); });
+	stopping = true;
+	thread.join();
+
+	// A left the window - B alone can't complete it
+	EXPECT_EQ(cable.GetWindowCount(), 0u);
+	EXPECT_FALSE(cable.EndWindow(&mikeyB));
+	EXPECT_TRUE(cable.EndWindow(&mikeyA));
+	EXPECT_EQ(cable.GetWindowCount(), 1u);
+}
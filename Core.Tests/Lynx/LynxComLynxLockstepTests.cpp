@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "Shared/Emulator.h"
+#include "Lynx/LynxConsole.h"
+#include "Lynx/LynxCpu.h"
+#include "Lynx/ComLynxCable.h"
+#include "Utilities/Serializer.h"
+#include "Utilities/VirtualFile.h"
+#include "Shared/SaveStateManager.h"
+#include "Core.Tests/Lynx/LynxUartTestRom.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+/// <summary>
+/// Tests for the console side of the ComLynx lockstep mode: the window boundaries
+/// a console syncs at are multiples of LockstepWindowCycles, so a console on a
+/// lockstep cable ends exactly one window per boundary it crosses - including
+/// after loading an older or a newer save state.
+/// </summary>
+class LynxComLynxLockstepTest : public ::testing::Test {
+protected:
+	TestHomeFolder _home{"nexen_lynx_lockstep_test"};
+	ComLynxCable _cable;
+	Emulator _emu;
+	LynxConsole* _console = nullptr;
+
+	void SetUp() override {
+		_emu.InitializeHeadless();
+		vector<uint8_t> rom = BuildLynxUartTestRom();
+		ASSERT_TRUE(_emu.LoadRom(VirtualFile(rom.data(), rom.size(), "uart.lnx"), VirtualFile()));
+		_console = (LynxConsole*)_emu.GetConsoleUnsafe();
+
+		// A single unit on the cable completes each window as soon as it reaches it
+		_cable.SetLockstep(true);
+		_console->SetComLynxCable(&_cable);
+	}
+
+	void TearDown() override {
+		if (_console) {
+			_console->SetComLynxCable(nullptr);
+		}
+		_emu.Stop(false, true, false);
+		_emu.Release();
+	}
+
+	[[nodiscard]] uint64_t GetCycleCount() {
+		return _console->GetCpu()->GetCycleCount();
+	}
+
+	vector<uint8_t> SaveState() {
+		Serializer s;
+		s.ResetForFastSave(SaveStateManager::FileFormatVersion);
+		_emu.StreamHeadlessState(s);
+		return s.GetData();
+	}
+
+	void LoadState(const vector<uint8_t>& state) {
+		Serializer s;
+		s.ResetForFastSave(SaveStateManager::FileFormatVersion);
+		s.ResetForFastLoad(state);
+		_emu.StreamHeadlessState(s);
+	}
+
+	/// <summary>Run a frame, check that one window was ended per boundary crossed</summary>
+	void RunFrameAndCheckWindows() {
+		uint64_t startCycle = GetCycleCount();
+		uint64_t startWindows = _cable.GetWindowCount();
+		_emu.RunHeadlessFrame();
+
+		uint64_t expected = GetCycleCount() / ComLynxCable::LockstepWindowCycles - startCycle / ComLynxCable::LockstepWindowCycles;
+		EXPECT_EQ(_cable.GetWindowCount() - startWindows, expected);
+		EXPECT_NEAR((double)expected, (double)LynxConstants::CpuCyclesPerFrame / ComLynxCable::LockstepWindowCycles, 1.0);
+	}
+};
+
+TEST_F(LynxComLynxLockstepTest, OneWindowPerBoundary) {
+	for (int i = 0; i < 5; i++) {
+		RunFrameAndCheckWindows();
+	}
+}
+
+TEST_F(LynxComLynxLockstepTest, LoadOlderState_KeepsSyncing) {
+	for (int i = 0; i < 3; i++) {
+		_emu.RunHeadlessFrame();
+	}
+	vector<uint8_t> olderState = SaveState();
+	for (int i = 0; i < 5; i++) {
+		_emu.RunHeadlessFrame();
+	}
+
+	// The cycle count goes back by 5 frames - syncing must not stop until it catches up
+	LoadState(olderState);
+	for (int i = 0; i < 3; i++) {
+		RunFrameAndCheckWindows();
+	}
+}
+
+TEST_F(LynxComLynxLockstepTest, LoadNewerState_DoesNotBurstWindows) {
+	_emu.RunHeadlessFrame();
+	vector<uint8_t> olderState = SaveState();
+	for (int i = 0; i < 8; i++) {
+		_emu.RunHeadlessFrame();
+	}
+	vector<uint8_t> newerState = SaveState();
+
+	LoadState(olderState);
+	RunFrameAndCheckWindows();
+
+	// The cycle count jumps 7 frames forward - the boundaries in between must not all be synced at once
+	LoadState(newerState);
+	for (int i = 0; i < 3; i++) {
+		RunFrameAndCheckWindows();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// Builds a small LNX test program (BLL executable, started by the HLE boot) that echoes the
+/// joystick over ComLynx, for tests of consoles running in parallel or on a cable.
+/// </summary>
+/// <remarks>
+/// Zero page results:
+/// - $10: last joystick value sent (sent every time the joystick changes)
+/// - $11: last byte received (including the console's own bytes, looped back by the UART)
+/// - $12: number of bytes received
+/// </remarks>
+inline std::vector<uint8_t> BuildLynxUartTestRom() {
+	std::vector<uint8_t> rom(64 + 0x400, 0);
+	const uint8_t header[] = { 'L', 'Y', 'N', 'X', 0x00, 0x04, 0x00, 0x00, 0x01, 0x00 }; // Bank 0 page size $400, version 1
+	std::copy(std::begin(header), std::end(header), rom.begin());
+
+	const uint8_t program[] = {
+		0x80, 0x00, 0x02, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // BLL header: load at $0200, $30 bytes
+		0xA9, 0x01,       // lda #1
+		0x8D, 0x10, 0xFD, // sta $FD10 (timer 4 backup - UART baud rate)
+		0xA9, 0x18,       // lda #$18
+		0x8D, 0x11, 0xFD, // sta $FD11 (timer 4 CTLA: reload + count)
+		0xAD, 0xB0, 0xFC, // loop: lda $FCB0 (joystick)
+		0xC5, 0x10,       // cmp $10
+		0xF0, 0x05,       // beq receive
+		0x85, 0x10,       // sta $10
+		0x8D, 0x8D, 0xFD, // sta $FD8D (SERDAT)
+		0xAD, 0x8C, 0xFD, // receive: lda $FD8C (SERCTL)
+		0x29, 0x40,       // and #$40 (RXRDY)
+		0xF0, 0xED,       // beq loop
+		0xAD, 0x8D, 0xFD, // lda $FD8D
+		0x85, 0x11,       // sta $11
+		0xE6, 0x12,       // inc $12
+		0x80, 0xE4        // bra loop
+	};
+	std::copy(std::begin(program), std::end(program), rom.begin() + 64);
+	return rom;
+}
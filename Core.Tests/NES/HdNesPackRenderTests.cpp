@@ -0,0 +1,163 @@
+#include "pch.h"
+#include <filesystem>
+#include <random>
+#include "Shared/Emulator.h"
+#include "NES/NesConsole.h"
+#include "NES/HdPacks/HdNesPack.h"
+#include "NES/HdPacks/HdPackLoader.h"
+#include "Utilities/PNGHelper.h"
+#include "Utilities/VirtualFile.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+// =============================================================================
+// HdNesPack Parallel Rendering Tests
+// =============================================================================
+// HdNesPack renders the scanlines of a frame on several threads (in chunks of
+// lines pulled by each thread). Each line only depends on its own render band,
+// so the output must be bit-identical to rendering the lines in order on one
+// thread - checked on frames with tile, sprite and position conditions (some
+// of which disable the tile cache), default tiles and a scrolling background.
+// =============================================================================
+
+namespace {
+	constexpr uint32_t Scale = 2;
+	constexpr uint32_t FrameCount = 4;
+
+	vector<uint8_t> BuildNromRom() {
+		// iNES header: 32KB PRG ROM, 8KB CHR ROM, mapper 0
+		vector<uint8_t> rom(16 + 0x8000 + 0x2000);
+		const uint8_t header[] = {'N', 'E', 'S', 0x1A, 2, 1, 0, 0};
+		std::copy(std::begin(header), std::end(header), rom.begin());
+		rom[16 + 0x7FFC] = 0x00; // Reset vector: $8000 (brk loop, never run)
+		rom[16 + 0x7FFD] = 0x80;
+		return rom;
+	}
+
+	void WritePack(const string& folder) {
+		std::filesystem::create_directories(folder);
+
+		vector<uint32_t> tiles(128 * 16);
+		for (uint32_t i = 0; i < tiles.size(); i++) {
+			tiles[i] = ((i & 0x0F) == 0 ? 0x00000000 : 0xFF000000) | (i * 0x01030507);
+		}
+		PNGHelper::WritePNG(folder + "/tiles.png", tiles.data(), 128, 16, 32);
+
+		vector<uint32_t> background(256 * Scale * 240 * Scale);
+		for (uint32_t i = 0; i < background.size(); i++) {
+			background[i] = 0xFF000000 | (i * 0x00010203);
+		}
+		PNGHelper::WritePNG(folder + "/bg.png", background.data(), 256 * Scale, 240 * Scale, 32);
+
+		ofstream definition(folder + "/hires.txt");
+		definition << "<ver>106\n"
+		              "<scale>2\n"
+		              "<img>tiles.png\n"
+		              "<condition>rightIsTile2,tileNearby,8,0,2,0F162738\n"
+		              "<condition>spriteAbove,spriteNearby,0,-8,3,FF0F1020\n"
+		              "<condition>lowerHalf,positionCheckY,>,120\n"
+		              "<tile>0,0,0F162738,0,0,1,N\n"
+		              "[rightIsTile2]<tile>0,1,0F162738,32,0,0.5,N\n"
+		              "<tile>0,1,0F162738,16,0,1,N\n"
+		              "<tile>0,2,0F162738,48,0,1,Y\n"
+		              "[lowerHalf]<tile>0,0,0F1A2B3C,80,0,1.5,N\n"
+		              "<tile>0,0,0F1A2B3C,64,0,1,N\n"
+		              "<tile>0,3,FF0F1020,96,0,1,N\n"
+		              "[spriteAbove]<tile>0,4,0F162738,112,0,1,N\n"
+		              "<background>bg.png,0.75,0.5,0.25,5\n";
+	}
+
+	void FillScreen(HdScreenInfo& screen, uint32_t frame) {
+		std::mt19937 rng(frame);
+		screen.FrameNumber = frame;
+		for (uint32_t y = 0; y < 240; y++) {
+			uint32_t lineTile = rng();
+			for (uint32_t x = 0; x < 256; x++) {
+				HdPpuPixelInfo& pixel = screen.ScreenTiles[y * 256 + x];
+				uint32_t tile = (lineTile + x / 8 + y / 8) % 6;
+				pixel.Tile.TileIndex = tile;
+				pixel.Tile.PaletteColors = (x / 8 + y / 8 + frame) % 3 ? 0x0F162738 : 0x0F1A2B3C;
+				pixel.Tile.OffsetX = x & 0x07;
+				pixel.Tile.OffsetY = y & 0x07;
+				pixel.Tile.BgColorIndex = (x + y) & 0x03;
+				pixel.Tile.BgColor = (uint8_t)((x + y + tile) & 0x3F);
+				pixel.Tile.PpuBackgroundColor = 0x0F;
+
+				pixel.SpriteCount = 0;
+				if (((x / 8) + (y / 8) * 3 + frame) % 7 == 0) {
+					HdPpuTileInfo& sprite = pixel.Sprite[pixel.SpriteCount++];
+					sprite.TileIndex = 3;
+					sprite.PaletteColors = 0xFF0F1020;
+					sprite.OffsetX = x & 0x07;
+					sprite.OffsetY = y & 0x07;
+					sprite.SpriteColorIndex = (x ^ y) & 0x03;
+					sprite.SpriteColor = (uint8_t)((x * 3 + y) & 0x3F);
+					sprite.BackgroundPriority = (x & 0x20) != 0;
+				}
+
+				pixel.TmpVideoRamAddr = (uint16_t)((y * 37 + frame * 11) & 0x7FFF);
+				pixel.XScroll = (uint8_t)(frame & 0x07);
+				pixel.EmphasisBits = 0;
+				pixel.Grayscale = false;
+			}
+		}
+	}
+
+	class HdNesPackRenderTest : public ::testing::Test {
+	protected:
+		TestHomeFolder _home{"nexen_hd_nes_pack_render_test"};
+		Emulator _emu;
+		HdPackData _hdData;
+
+		void SetUp() override {
+			_emu.InitializeHeadless();
+			vector<uint8_t> rom = BuildNromRom();
+			ASSERT_TRUE(_emu.LoadRom(VirtualFile(rom.data(), rom.size(), "hd.nes"), VirtualFile()));
+
+			string packFolder = (std::filesystem::temp_directory_path() / "nexen_hd_nes_pack_render_test_pack").string();
+			WritePack(packFolder);
+			ASSERT_TRUE(HdPackLoader::LoadHdNesPack(packFolder + "/hires.txt", _hdData));
+			_hdData.LoadAsync();
+			std::filesystem::remove_all(packFolder);
+		}
+
+		void TearDown() override {
+			_emu.Stop(false, true, false);
+			_emu.Release();
+		}
+
+		vector<vector<uint32_t>> Render(uint32_t renderThreads) {
+			NesConsole* console = (NesConsole*)_emu.GetConsoleUnsafe();
+			HdNesPack<Scale> hdPack(console, _emu.GetSettings(), &_hdData, renderThreads);
+			HdScreenInfo screen(false);
+			OverscanDimensions overscan = {};
+
+			vector<vector<uint32_t>> frames;
+			for (uint32_t frame = 0; frame < FrameCount; frame++) {
+				FillScreen(screen, frame);
+				vector<uint32_t> output(256 * Scale * 240 * Scale);
+				hdPack.Process(&screen, output.data(), overscan);
+				frames.push_back(std::move(output));
+			}
+			return frames;
+		}
+	};
+}
+
+TEST_F(HdNesPackRenderTest, Parallel_MatchesSerial) {
+	ASSERT_EQ(_hdData.Tiles.size(), 8u);
+	ASSERT_EQ(_hdData.BackgroundFileData.size(), 1u);
+
+	vector<vector<uint32_t>> serial = Render(1);
+	for (uint32_t threads : {2u, 4u}) {
+		vector<vector<uint32_t>> parallel = Render(threads);
+		for (uint32_t frame = 0; frame < FrameCount; frame++) {
+			SCOPED_TRACE(std::format("{} threads, frame {}", threads, frame));
+			ASSERT_TRUE(parallel[frame] == serial[frame]);
+		}
+	}
+
+	// The pack's tiles, conditions and background are all drawn
+	std::unordered_set<uint32_t> colors(serial[0].begin(), serial[0].end());
+	EXPECT_GT(colors.size(), 1000u);
+	EXPECT_TRUE(serial[0] != serial[1]);
+}
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "NES/HdPacks/HdData.h"
+#include "Utilities/PNGHelper.h"
+
+// =============================================================================
+// HD Pack Image Loading Unit Tests
+// =============================================================================
+// HdPackData::LoadAsync decodes the pack's PNG files on worker threads, while
+// the renderer only uses bitmaps that are already decoded (IsLoaded) and asks
+// for the others to be decoded first (RequestLoad).
+
+namespace {
+	unique_ptr<HdPackBitmapInfo> CreateBitmap(uint32_t width, uint32_t height, uint32_t color) {
+		vector<uint32_t> pixels(width * height, color);
+		std::stringstream stream;
+		PNGHelper::WritePNG(stream, pixels.data(), width, height, 32);
+		string pngData = stream.str();
+
+		auto bitmap = std::make_unique<HdPackBitmapInfo>();
+		bitmap->FileData = vector<uint8_t>(pngData.begin(), pngData.end());
+		return bitmap;
+	}
+
+	void AddImages(HdPackData& data, uint32_t count) {
+		for (uint32_t i = 0; i < count; i++) {
+			data.ImageFileData.push_back(CreateBitmap(16 + i, 8, 0xFF000000 | i));
+		}
+	}
+}
+
+TEST(HdPackLoadTests, LoadAsync_DecodesAllImages) {
+	HdPackData data;
+	AddImages(data, 20);
+	data.BackgroundFileData.push_back(CreateBitmap(256, 240, 0xFF123456));
+
+	EXPECT_EQ(data.GetLoadProgress().LoadedImages, 0u);
+	EXPECT_EQ(data.GetLoadProgress().TotalImages, 21u);
+	data.LoadAsync();
+
+	EXPECT_EQ(data.GetLoadProgress().LoadedImages, 21u);
+	for (uint32_t i = 0; i < 20; i++) {
+		HdPackBitmapInfo& bitmap = *data.ImageFileData[i];
+		ASSERT_TRUE(bitmap.IsLoaded());
+		EXPECT_EQ(bitmap.Width, 16 + i);
+		EXPECT_EQ(bitmap.Height, 8u);
+		EXPECT_EQ(bitmap.PixelData[0], 0xFF000000 | i);
+		EXPECT_TRUE(bitmap.FileData.empty());
+	}
+	EXPECT_EQ(data.BackgroundFileData[0]->PixelData.size(), 256u * 240u);
+}
+
+TEST(HdPackLoadTests, Init_OnlyDecodesOnce) {
+	auto bitmap = CreateBitmap(8, 8, 0xFF00FF00);
+	EXPECT_FALSE(bitmap->IsLoaded());
+	EXPECT_TRUE(bitmap->Init());
+	EXPECT_TRUE(bitmap->IsLoaded());
+	EXPECT_FALSE(bitmap->Init());
+}
+
+TEST(HdPackLoadTests, RequestLoad_OnlyQueuedOnce) {
+	auto bitmap = CreateBitmap(8, 8, 0xFF00FF00);
+	EXPECT_TRUE(bitmap->MarkRequested());
+	EXPECT_FALSE(bitmap->MarkRequested());
+}
+
+TEST(HdPackLoadTests, RequestedBitmap_DecodedBeforeOthers) {
+	HdPackData data;
+	AddImages(data, 10);
+	HdPackBitmapInfo* last = data.ImageFileData.back().get();
+	data.RequestLoad(last);
+
+	// Cancel as soon as the first bitmap is decoded - the requested one must be among the decoded ones
+	std::thread watcher([&]() {
+		while (data.GetLoadProgress().LoadedImages == 0) {
+			std::this_thread::yield();
+		}
+		data.CancelLoad();
+	});
+	data.LoadAsync();
+	watcher.join();
+
+	EXPECT_TRUE(last->IsLoaded());
+}
+
+TEST(HdPackLoadTests, CancelLoad_StopsDecoding) {
+	HdPackData data;
+	AddImages(data, 10);
+	data.CancelLoad();
+	data.LoadAsync();
+	EXPECT_EQ(data.GetLoadProgress().LoadedImages, 0u);
+}
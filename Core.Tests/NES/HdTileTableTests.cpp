@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "NES/HdPacks/HdData.h"
+
+// =============================================================================
+// HdTileTable Unit Tests
+// =============================================================================
+// The table must return exactly what the unordered_map it is built from would
+// (same tiles, same order), including for keys whose hashes collide.
+
+namespace {
+	HdTileKey ChrRomKey(int32_t tileIndex, uint32_t paletteColors) {
+		HdTileKey key = {};
+		key.TileIndex = tileIndex;
+		key.PaletteColors = paletteColors;
+		return key;
+	}
+
+	HdTileKey ChrRamKey(uint8_t seed, uint32_t paletteColors) {
+		HdTileKey key = {};
+		key.IsChrRamTile = true;
+		key.TileIndex = HdTileKey::NoTile;
+		key.PaletteColors = paletteColors;
+		for (int i = 0; i < 16; i++) {
+			key.TileData[i] = (uint8_t)(seed * 31 + i);
+		}
+		return key;
+	}
+
+	HdPackTileInfo* FakeTile(uintptr_t id) {
+		return (HdPackTileInfo*)(id * 16);
+	}
+}
+
+TEST(HdTileTableTests, EmptyTable_FindsNothing) {
+	HdTileTable table;
+	EXPECT_TRUE(table.Find(ChrRomKey(0, 0)).empty());
+
+	table.Build({});
+	EXPECT_TRUE(table.Find(ChrRomKey(0, 0)).empty());
+}
+
+TEST(HdTileTableTests, Find_ReturnsTilesInDefinitionOrder) {
+	unordered_map<HdTileKey, vector<HdPackTileInfo*>> tilesByKey;
+	tilesByKey[ChrRomKey(5, 0x0F161A30)] = { FakeTile(3), FakeTile(1), FakeTile(2) };
+	tilesByKey[ChrRomKey(6, 0x0F161A30)] = { FakeTile(4) };
+
+	HdTileTable table;
+	table.Build(tilesByKey);
+	EXPECT_EQ(table.GetKeyCount(), 2u);
+
+	std::span<HdPackTileInfo* const> tiles = table.Find(ChrRomKey(5, 0x0F161A30));
+	ASSERT_EQ(tiles.size(), 3u);
+	EXPECT_EQ(tiles[0], FakeTile(3));
+	EXPECT_EQ(tiles[1], FakeTile(1));
+	EXPECT_EQ(tiles[2], FakeTile(2));
+
+	EXPECT_TRUE(table.Find(ChrRomKey(5, 0x0F161A31)).empty());
+	EXPECT_TRUE(table.Find(ChrRomKey(7, 0x0F161A30)).empty());
+}
+
+TEST(HdTileTableTests, CollidingHashes_ResolvedByKey) {
+	// CHR ROM keys hash to TileIndex ^ PaletteColors - these all have the same hash
+	unordered_map<HdTileKey, vector<HdPackTileInfo*>> tilesByKey;
+	for (uint32_t i = 0; i < 8; i++) {
+		tilesByKey[ChrRomKey(i, i ^ 0x1234)] = { FakeTile(i + 1) };
+	}
+
+	HdTileTable table;
+	table.Build(tilesByKey);
+	for (uint32_t i = 0; i < 8; i++) {
+		std::span<HdPackTileInfo* const> tiles = table.Find(ChrRomKey(i, i ^ 0x1234));
+		ASSERT_EQ(tiles.size(), 1u);
+		EXPECT_EQ(tiles[0], FakeTile(i + 1));
+	}
+	EXPECT_TRUE(table.Find(ChrRomKey(8, 8 ^ 0x1234)).empty());
+}
+
+TEST(HdTileTableTests, MatchesUnorderedMap_ForManyKeys) {
+	unordered_map<HdTileKey, vector<HdPackTileInfo*>> tilesByKey;
+	uintptr_t id = 1;
+	for (uint32_t i = 0; i < 3000; i++) {
+		HdTileKey key = i % 2 ? ChrRamKey((uint8_t)i, 0x0F000000 | i) : ChrRomKey(i, 0x0F2030 + i);
+		tilesByKey[key].push_back(FakeTile(id++));
+		tilesByKey[key.GetKey(true)].push_back(FakeTile(id++));
+	}
+
+	HdTileTable table;
+	table.Build(tilesByKey);
+	EXPECT_EQ(table.GetKeyCount(), tilesByKey.size());
+
+	for (auto& [key, tiles] : tilesByKey) {
+		std::span<HdPackTileInfo* const> result = table.Find(key);
+		ASSERT_EQ(vector<HdPackTileInfo*>(result.begin(), result.end()), tiles);
+	}
+	for (uint32_t i = 0; i < 3000; i++) {
+		EXPECT_TRUE(table.Find(ChrRomKey(i + 5000, 0x0F2030 + i)).empty());
+	}
+}
@@ -0,0 +1,123 @@
+#include "pch.h"
+#include <random>
+#include "Netplay/SaveStateMessage.h"
+#include "Netplay/StateHashMessage.h"
+
+// =============================================================================
+// Netplay State Sync Unit Tests
+// =============================================================================
+// Save states are sent as XOR deltas against the last state sent on the
+// connection (NetplayStateBase on both sides), and desyncs are detected by
+// comparing per-region hashes (StateHashMessage) instead of full states.
+
+namespace {
+	vector<uint8_t> CreateState(size_t size, uint32_t seed) {
+		std::mt19937 rng(seed);
+		vector<uint8_t> state(size);
+		for (uint8_t& b : state) {
+			b = (uint8_t)rng();
+		}
+		return state;
+	}
+
+	// Serializes the message to its wire format and parses it back, like GameConnection does
+	unique_ptr<SaveStateMessage> Transfer(SaveStateMessage& message, size_t* packetSize = nullptr) {
+		string packet = message.GetPacket();
+		if (packetSize) {
+			*packetSize = packet.size();
+		}
+		auto received = std::make_unique<SaveStateMessage>((void*)(packet.data() + 4), (uint32_t)packet.size() - 4);
+		received->Initialize();
+		return received;
+	}
+
+	unique_ptr<SaveStateMessage> Send(vector<uint8_t> state, NetplayStateBase& serverBase, size_t* packetSize = nullptr) {
+		SaveStateMessage message(std::move(state), {}, serverBase);
+		return Transfer(message, packetSize);
+	}
+}
+
+TEST(NetplayStateSyncTests, FirstState_SentInFull) {
+	NetplayStateBase serverBase;
+	NetplayStateBase clientBase;
+	vector<uint8_t> state = CreateState(100000, 1);
+
+	auto received = Send(state, serverBase);
+	EXPECT_FALSE(received->IsDelta());
+	ASSERT_TRUE(received->DecodeState(clientBase));
+	EXPECT_EQ(received->GetStateData(), state);
+	EXPECT_EQ(clientBase.Id, serverBase.Id);
+}
+
+TEST(NetplayStateSyncTests, NextStates_SentAsSmallDeltas) {
+	NetplayStateBase serverBase;
+	NetplayStateBase clientBase;
+	vector<uint8_t> state = CreateState(100000, 1);
+
+	size_t fullSize = 0;
+	auto received = Send(state, serverBase, &fullSize);
+	ASSERT_TRUE(received->DecodeState(clientBase));
+
+	for (int i = 0; i < 5; i++) {
+		// A few hundred bytes change between states (a few frames of RAM/register updates)
+		for (int j = 0; j < 300; j++) {
+			state[(j * 331 + i * 7919) % state.size()] ^= (uint8_t)(j + 1);
+		}
+
+		size_t deltaSize = 0;
+		received = Send(state, serverBase, &deltaSize);
+		EXPECT_TRUE(received->IsDelta());
+		EXPECT_LT(deltaSize, fullSize / 20);
+
+		ASSERT_TRUE(received->DecodeState(clientBase));
+		EXPECT_EQ(received->GetStateData(), state);
+	}
+}
+
+TEST(NetplayStateSyncTests, StateSizeChange_DecodedCorrectly) {
+	NetplayStateBase serverBase;
+	NetplayStateBase clientBase;
+	ASSERT_TRUE(Send(CreateState(5000, 1), serverBase)->DecodeState(clientBase));
+
+	for (size_t size : { 7000, 3000 }) {
+		vector<uint8_t> state = CreateState(size, (uint32_t)size);
+		auto received = Send(state, serverBase);
+		ASSERT_TRUE(received->DecodeState(clientBase));
+		EXPECT_EQ(received->GetStateData(), state);
+	}
+}
+
+TEST(NetplayStateSyncTests, DeltaAgainstUnknownBase_Rejected) {
+	NetplayStateBase serverBase;
+	NetplayStateBase clientBase;
+	Send(CreateState(1000, 1), serverBase);
+
+	// Client never received the first state
+	auto received = Send(CreateState(1000, 2), serverBase);
+	EXPECT_FALSE(received->DecodeState(clientBase));
+	EXPECT_EQ(clientBase.Id, 0u);
+
+	// Full state (after a resync request) is accepted
+	serverBase = {};
+	vector<uint8_t> state = CreateState(1000, 3);
+	received = Send(state, serverBase);
+	ASSERT_TRUE(received->DecodeState(clientBase));
+	EXPECT_EQ(received->GetStateData(), state);
+}
+
+TEST(NetplayStateSyncTests, RegionHashes_LocateDifferences) {
+	vector<uint8_t> state = CreateState(StateHashMessage::RegionSize * 10 + 100, 1);
+	vector<uint32_t> hashes = StateHashMessage::GetRegionHashes(state);
+	ASSERT_EQ(hashes.size(), 11u);
+	EXPECT_EQ(StateHashMessage::GetMismatchCount(hashes, StateHashMessage::GetRegionHashes(state)), 0u);
+
+	state[StateHashMessage::RegionSize * 3 + 5] ^= 1;
+	state[StateHashMessage::RegionSize * 10 + 99] ^= 1;
+	vector<uint32_t> changed = StateHashMessage::GetRegionHashes(state);
+	EXPECT_EQ(StateHashMessage::GetMismatchCount(hashes, changed), 2u);
+	EXPECT_NE(hashes[3], changed[3]);
+	EXPECT_NE(hashes[10], changed[10]);
+
+	state.resize(StateHashMessage::RegionSize * 8);
+	EXPECT_EQ(StateHashMessage::GetMismatchCount(hashes, StateHashMessage::GetRegionHashes(state)), 4u);
+}
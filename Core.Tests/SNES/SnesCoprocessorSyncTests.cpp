@@ -0,0 +1,469 @@
+#include "pch.h"
+#include <stdexcept>
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/MemoryType.h"
+#include "Shared/SaveStateManager.h"
+#include "SNES/SnesConsole.h"
+#include "SNES/SnesMemoryManager.h"
+#include "SNES/BaseCartridge.h"
+#include "SNES/Coprocessors/BaseCoprocessor.h"
+#include "Utilities/Serializer.h"
+#include "Utilities/VirtualFile.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+// =============================================================================
+// SNES Coprocessor Sync Point Tests
+// =============================================================================
+// The SA-1, Cx4 and GSU catch up to the SNES master clock at the points where
+// the SNES CPU can observe them (SnesMemoryManager::SyncCoprocessors), instead
+// of after every master clock tick. Each test runs a generated ROM that makes
+// the SNES CPU and the coprocessor interact (IRQs, status polling, wait/reset,
+// suspend, DMA, restarts) and shows the results on the backdrop color, then
+// compares the framebuffer, the coprocessor's state and the console's state
+// after every frame with a run that also syncs on every tick (the old sync
+// points, see SnesMemoryManager::SetSyncCoprocessorsEveryTick).
+// =============================================================================
+
+namespace {
+	constexpr uint32_t RomSize = 0x8000;
+	constexpr int FrameCount = 30;
+
+	/// <summary>Minimal 65816 code writer for the test ROMs (LoROM bank $00)</summary>
+	class SnesAsm {
+	private:
+		vector<uint8_t>& _rom;
+		uint16_t _address;
+
+	public:
+		SnesAsm(vector<uint8_t>& rom, uint16_t address) : _rom(rom), _address(address) {}
+
+		[[nodiscard]] uint16_t GetAddress() const { return _address; }
+
+		void Emit(std::initializer_list<uint8_t> bytes) {
+			for (uint8_t value : bytes) {
+				_rom[_address++ & 0x7FFF] = value;
+			}
+		}
+
+		void Imm(uint8_t opCode, uint8_t value) { Emit({opCode, value}); }
+		void Abs(uint8_t opCode, uint16_t addr) { Emit({opCode, (uint8_t)addr, (uint8_t)(addr >> 8)}); }
+
+		void Branch(uint8_t opCode, uint16_t target) {
+			int offset = (int)target - (_address + 2);
+			if (offset < -128 || offset > 127) {
+				throw std::out_of_range("branch target out of range");
+			}
+			Emit({opCode, (uint8_t)offset});
+		}
+
+		/// <summary>Branch to a label that isn't written yet - returns the operand to pass to SetBranchTarget</summary>
+		[[nodiscard]] uint16_t BranchForward(uint8_t opCode) {
+			Emit({opCode, 0});
+			return _address - 1;
+		}
+
+		void SetBranchTarget(uint16_t operand) {
+			int offset = _address - (operand + 1);
+			if (offset > 127) {
+				throw std::out_of_range("branch target out of range");
+			}
+			_rom[operand & 0x7FFF] = (uint8_t)offset;
+		}
+	};
+
+	namespace Op {
+		constexpr uint8_t Sei = 0x78;
+		constexpr uint8_t Cli = 0x58;
+		constexpr uint8_t Clc = 0x18;
+		constexpr uint8_t Xce = 0xFB;
+		constexpr uint8_t Sep = 0xE2;
+		constexpr uint8_t Pha = 0x48;
+		constexpr uint8_t Pla = 0x68;
+		constexpr uint8_t Rti = 0x40;
+		constexpr uint8_t Wai = 0xCB;
+		constexpr uint8_t Dex = 0xCA;
+		constexpr uint8_t LdaImm = 0xA9;
+		constexpr uint8_t LdaAbs = 0xAD;
+		constexpr uint8_t LdaAbsX = 0xBD;
+		constexpr uint8_t LdxImm = 0xA2;
+		constexpr uint8_t StaAbs = 0x8D;
+		constexpr uint8_t StaAbsX = 0x9D;
+		constexpr uint8_t StzAbs = 0x9C;
+		constexpr uint8_t IncAbs = 0xEE;
+		constexpr uint8_t AndImm = 0x29;
+		constexpr uint8_t OraImm = 0x09;
+		constexpr uint8_t CmpImm = 0xC9;
+		constexpr uint8_t Jmp = 0x4C;
+		constexpr uint8_t Bne = 0xD0;
+		constexpr uint8_t Beq = 0xF0;
+		constexpr uint8_t Bpl = 0x10;
+		constexpr uint8_t Bra = 0x80;
+	}
+
+	void Write16(vector<uint8_t>& rom, size_t offset, uint16_t value) {
+		rom[offset] = (uint8_t)value;
+		rom[offset + 1] = (uint8_t)(value >> 8);
+	}
+
+	/// <summary>Native mode, 8-bit registers, display on (the backdrop color shows the results)</summary>
+	void WriteInit(SnesAsm& a) {
+		a.Emit({Op::Sei, Op::Clc, Op::Xce});
+		a.Imm(Op::Sep, 0x30);
+		a.Imm(Op::LdaImm, 0x0F);
+		a.Abs(Op::StaAbs, 0x2100);
+		a.Abs(Op::StzAbs, 0x0000);
+		a.Abs(Op::StzAbs, 0x0001);
+	}
+
+	/// <summary>Writes 2 values (loaded from the given addresses) to the backdrop color</summary>
+	void WriteBackdrop(SnesAsm& a, uint16_t lowSrc, uint16_t highSrc) {
+		a.Abs(Op::StzAbs, 0x2121);
+		a.Abs(Op::LdaAbs, lowSrc);
+		a.Abs(Op::StaAbs, 0x2122);
+		a.Abs(Op::LdaAbs, highSrc);
+		a.Abs(Op::StaAbs, 0x2122);
+	}
+
+	void WriteHeader(vector<uint8_t>& rom, uint8_t mapMode, uint8_t romType, uint8_t cartridgeType, uint16_t irqHandler) {
+		string title = "NEXEN COPROC SYNC";
+		title.resize(21, ' ');
+		std::copy(title.begin(), title.end(), rom.begin() + 0x7FC0);
+		rom[0x7FBF] = cartridgeType;
+		rom[0x7FD5] = mapMode;
+		rom[0x7FD6] = romType;
+		rom[0x7FD7] = 0x05; // 32KB
+		rom[0x7FD9] = 0x01; // North America
+
+		// NMIs are never enabled
+		rom[0x7F00] = Op::Rti;
+		Write16(rom, 0x7FEA, 0xFF00); // NMI (native)
+		Write16(rom, 0x7FEE, irqHandler);
+		Write16(rom, 0x7FFA, 0xFF00); // NMI (emulation)
+		Write16(rom, 0x7FFC, 0x8000); // Reset
+		Write16(rom, 0x7FFE, irqHandler);
+
+		// Checksum + complement (the complement+checksum pair always adds 0x1FE to the sum)
+		Write16(rom, 0x7FDC, 0xFFFF);
+		Write16(rom, 0x7FDE, 0x0000);
+		uint16_t checksum = 0;
+		for (uint8_t value : rom) {
+			checksum += value;
+		}
+		Write16(rom, 0x7FDC, checksum ^ 0xFFFF);
+		Write16(rom, 0x7FDE, checksum);
+	}
+
+	vector<uint8_t> BuildSa1Rom() {
+		vector<uint8_t> rom(RomSize, 0);
+
+		// SA-1: count to 256 in I-RAM, then send an IRQ (with a message) to the SNES CPU
+		constexpr uint16_t sa1Program = 0x8100;
+		SnesAsm sa1(rom, sa1Program);
+		sa1.Imm(Op::LdaImm, 0xFF);
+		sa1.Abs(Op::StaAbs, 0x222A); // CIWP - I-RAM writable by the SA-1
+		uint16_t sa1Loop = sa1.GetAddress();
+		sa1.Abs(Op::IncAbs, 0x3010);
+		sa1.Branch(Op::Bne, sa1Loop);
+		sa1.Abs(Op::IncAbs, 0x3011);
+		sa1.Abs(Op::LdaAbs, 0x3011);
+		sa1.Imm(Op::AndImm, 0x0F);
+		sa1.Imm(Op::OraImm, 0x80);
+		sa1.Abs(Op::StaAbs, 0x2209); // SCNT - IRQ to the SNES CPU
+		sa1.Branch(Op::Bra, sa1Loop);
+
+		// SNES IRQ handler: acknowledge the IRQ, show the message and the SA-1's counter
+		constexpr uint16_t irqHandler = 0x8200;
+		SnesAsm irq(rom, irqHandler);
+		irq.Emit({Op::Pha});
+		irq.Imm(Op::LdaImm, 0x80);
+		irq.Abs(Op::StaAbs, 0x2202); // SIC
+		WriteBackdrop(irq, 0x2300, 0x3011);
+		irq.Abs(Op::IncAbs, 0x0000);
+		irq.Emit({Op::Pla, Op::Rti});
+
+		// SNES: start the SA-1, write to I-RAM in a loop and every 64 iterations, put the
+		// SA-1 in the wait state (iterations 0-127) or reset it (128-255) for a moment
+		SnesAsm a(rom, 0x8000);
+		WriteInit(a);
+		a.Imm(Op::LdaImm, (uint8_t)sa1Program);
+		a.Abs(Op::StaAbs, 0x2203); // CRV - SA-1 reset vector
+		a.Imm(Op::LdaImm, sa1Program >> 8);
+		a.Abs(Op::StaAbs, 0x2204);
+		a.Imm(Op::LdaImm, 0xFF);
+		a.Abs(Op::StaAbs, 0x2229); // SIWP - I-RAM writable by the SNES CPU
+		a.Imm(Op::LdaImm, 0x80);
+		a.Abs(Op::StaAbs, 0x2201); // SIE - SA-1 IRQs enabled
+		a.Abs(Op::StzAbs, 0x2200); // CCNT - release the SA-1 from reset
+		a.Emit({Op::Cli});
+
+		uint16_t main = a.GetAddress();
+		a.Abs(Op::IncAbs, 0x0001);
+		a.Abs(Op::LdaAbs, 0x0001);
+		a.Abs(Op::StaAbs, 0x3020);
+		a.Imm(Op::AndImm, 0x3F);
+		a.Branch(Op::Bne, main);
+		a.Abs(Op::LdaAbs, 0x0001);
+		uint16_t toWait = a.BranchForward(Op::Bpl);
+		a.Imm(Op::LdaImm, 0x20);
+		a.Abs(Op::StaAbs, 0x2200); // Reset
+		uint16_t toRelease = a.BranchForward(Op::Bra);
+		a.SetBranchTarget(toWait);
+		a.Imm(Op::LdaImm, 0x40);
+		a.Abs(Op::StaAbs, 0x2200); // Wait
+		a.SetBranchTarget(toRelease);
+		a.Imm(Op::LdxImm, 0x20);
+		uint16_t delay = a.GetAddress();
+		a.Emit({Op::Dex});
+		a.Branch(Op::Bne, delay);
+		a.Abs(Op::StzAbs, 0x2200); // Resume, or restart the SA-1 program
+		a.Abs(Op::Jmp, main);
+
+		WriteHeader(rom, 0x23, 0x35, 0x00, irqHandler);
+		return rom;
+	}
+
+	vector<uint8_t> BuildCx4Rom() {
+		vector<uint8_t> rom(RomSize, 0);
+
+		// Cx4 program ($00:A000): count to 200, then stop
+		const uint16_t cx4Program[] = {
+			0x6400, // ld A, #$00
+			0x8401, // loop: add A, #$01
+			0x54C8, // cmp A, #$C8
+			0x0C05, // bz end
+			0x0801, // bra loop
+			0xFC00  // end: stop
+		};
+		for (size_t i = 0; i < std::size(cx4Program); i++) {
+			Write16(rom, 0x2000 + i * 2, cx4Program[i]);
+		}
+
+		// SNES: poll the Cx4's status - while it runs, suspend it now and then. Each time
+		// it's stopped, show the status and start one of: the program, a DMA, an invalid
+		// DMA (locks the chip) or an unlock.
+		SnesAsm a(rom, 0x8000);
+		WriteInit(a);
+		a.Imm(Op::LdaImm, 0x01);
+		a.Abs(Op::StaAbs, 0x7F51); // IRQs disabled
+		a.Abs(Op::StzAbs, 0x7F49); // Program cache base = $00A000
+		a.Imm(Op::LdaImm, 0xA0);
+		a.Abs(Op::StaAbs, 0x7F4A);
+		a.Abs(Op::StzAbs, 0x7F4B);
+		a.Abs(Op::StzAbs, 0x7F4D); // Program bank = 0
+		a.Abs(Op::StzAbs, 0x7F4E);
+
+		uint16_t main = a.GetAddress();
+		a.Abs(Op::LdaAbs, 0x7F5E);
+		a.Imm(Op::AndImm, 0x40);
+		uint16_t toStopped = a.BranchForward(Op::Beq);
+		a.Abs(Op::IncAbs, 0x0001);
+		a.Abs(Op::LdaAbs, 0x0001);
+		a.Imm(Op::AndImm, 0x0F);
+		a.Branch(Op::Bne, main);
+		a.Abs(Op::StaAbs, 0x7F57); // Suspend for 64 cycles
+		a.Branch(Op::Bra, main);
+
+		a.SetBranchTarget(toStopped);
+		WriteBackdrop(a, 0x0000, 0x7F5E);
+		a.Abs(Op::IncAbs, 0x0000);
+		a.Abs(Op::LdaAbs, 0x0000);
+		a.Imm(Op::AndImm, 0x03);
+		uint16_t toStart = a.BranchForward(Op::Beq);
+		a.Imm(Op::CmpImm, 0x01);
+		uint16_t toDma = a.BranchForward(Op::Beq);
+		a.Imm(Op::CmpImm, 0x02);
+		uint16_t toInvalidDma = a.BranchForward(Op::Beq);
+		a.Abs(Op::StaAbs, 0x7F53); // Unlock
+		a.Abs(Op::Jmp, main);
+
+		a.SetBranchTarget(toStart);
+		a.Abs(Op::StzAbs, 0x7F4F); // Start at PC 0
+		a.Abs(Op::Jmp, main);
+
+		auto writeDma = [&](uint16_t length, uint16_t dest) {
+			a.Abs(Op::StzAbs, 0x7F40); // Source = $008000
+			a.Imm(Op::LdaImm, 0x80);
+			a.Abs(Op::StaAbs, 0x7F41);
+			a.Abs(Op::StzAbs, 0x7F42);
+			a.Imm(Op::LdaImm, (uint8_t)length);
+			a.Abs(Op::StaAbs, 0x7F43);
+			a.Imm(Op::LdaImm, length >> 8);
+			a.Abs(Op::StaAbs, 0x7F44);
+			a.Imm(Op::LdaImm, (uint8_t)dest);
+			a.Abs(Op::StaAbs, 0x7F45);
+			a.Imm(Op::LdaImm, dest >> 8);
+			a.Abs(Op::StaAbs, 0x7F46);
+			a.Abs(Op::StzAbs, 0x7F47); // Starts the transfer
+			a.Abs(Op::Jmp, main);
+		};
+
+		a.SetBranchTarget(toDma);
+		writeDma(0x100, 0x6000); // ROM to data RAM
+
+		a.SetBranchTarget(toInvalidDma);
+		writeDma(0x10, 0x8100); // ROM to ROM
+
+		WriteHeader(rom, 0x20, 0xF3, 0x10, 0xFF00);
+		return rom;
+	}
+
+	vector<uint8_t> BuildGsuRom() {
+		vector<uint8_t> rom(RomSize, 0);
+
+		// GSU program (copied to its cache, at R15 = 0): count to 64 in R0, store R0 to RAM, stop
+		constexpr uint16_t gsuProgram = 0x8100;
+		const uint8_t program[16] = {
+			0xA1, 0x40, // ibt r1, #$40
+			0xD0,       // loop: inc r0
+			0xE1,       // dec r1
+			0x08, 0xFC, // bne loop
+			0x01,       // nop
+			0x33,       // stw (r3)
+			0x00,       // stop
+			0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01
+		};
+		std::copy(std::begin(program), std::end(program), rom.begin() + (gsuProgram & 0x7FFF));
+
+		// SNES: start the program, wait for it to stop (with WAI or by polling SFR), show R0
+		// and the value it stored, and switch the GSU's clock speed every other run
+		SnesAsm a(rom, 0x8000);
+		WriteInit(a);
+		a.Imm(Op::LdxImm, 0x0F);
+		uint16_t copy = a.GetAddress();
+		a.Abs(Op::LdaAbsX, gsuProgram);
+		a.Abs(Op::StaAbsX, 0x3100); // Cache
+		a.Emit({Op::Dex});
+		a.Branch(Op::Bpl, copy);
+		a.Imm(Op::LdaImm, 0x08);
+		a.Abs(Op::StaAbs, 0x303A); // SCMR - the GSU owns its RAM
+
+		uint16_t main = a.GetAddress();
+		a.Abs(Op::StzAbs, 0x301E);
+		a.Abs(Op::StzAbs, 0x301F); // R15 = 0, starts the GSU
+		a.Abs(Op::LdaAbs, 0x0000);
+		a.Imm(Op::AndImm, 0x02);
+		uint16_t toWai = a.BranchForward(Op::Beq);
+		uint16_t poll = a.GetAddress();
+		a.Abs(Op::LdaAbs, 0x3030);
+		a.Imm(Op::AndImm, 0x20);
+		a.Branch(Op::Bne, poll);
+		uint16_t toDone = a.BranchForward(Op::Bra);
+		a.SetBranchTarget(toWai);
+		a.Emit({Op::Wai}); // Ends on the IRQ sent by STOP
+		a.SetBranchTarget(toDone);
+		a.Abs(Op::LdaAbs, 0x3031); // Acknowledge the IRQ
+		WriteBackdrop(a, 0x3000, 0x6000);
+		a.Abs(Op::IncAbs, 0x0000);
+		a.Abs(Op::LdaAbs, 0x0000);
+		a.Imm(Op::AndImm, 0x01);
+		a.Abs(Op::StaAbs, 0x3039); // CLSR
+		a.Abs(Op::Jmp, main);
+
+		WriteHeader(rom, 0x20, 0x13, 0x00, 0xFF00);
+		return rom;
+	}
+
+	uint64_t Hash(const uint8_t* data, size_t size) {
+		uint64_t hash = 0xCBF29CE484222325;
+		for (size_t i = 0; i < size; i++) {
+			hash = (hash ^ data[i]) * 0x100000001B3;
+		}
+		return hash;
+	}
+
+	struct FrameHashes {
+		uint64_t FrameBuffer = 0;
+		uint64_t Coprocessor = 0;
+		uint64_t Console = 0;
+		uint8_t EventCount = 0; ///< Events the SNES CPU handled (WRAM $0000)
+
+		bool operator==(const FrameHashes& other) const = default;
+	};
+
+	class SnesCoprocessorSyncTest : public ::testing::Test {
+	protected:
+		TestHomeFolder _home{"nexen_snes_coprocessor_sync_test"};
+
+		vector<FrameHashes> Run(const vector<uint8_t>& rom, CoprocessorType type, bool syncEveryTick) {
+			Emulator emu;
+			emu.InitializeHeadless();
+			emu.GetSettings()->GetSnesConfig().RamPowerOnState = RamState::AllZeros;
+
+			vector<FrameHashes> frames;
+			if (!emu.LoadRom(VirtualFile(rom.data(), rom.size(), "sync.sfc"), VirtualFile())) {
+				ADD_FAILURE() << "failed to load the ROM";
+				emu.Release();
+				return frames;
+			}
+
+			SnesConsole* console = (SnesConsole*)emu.GetConsoleUnsafe();
+			BaseCartridge* cart = console->GetCartridge();
+			switch (type) {
+				case CoprocessorType::SA1: EXPECT_NE(cart->GetSa1(), nullptr); break;
+				case CoprocessorType::CX4: EXPECT_NE(cart->GetCx4(), nullptr); break;
+				case CoprocessorType::GSU: EXPECT_NE(cart->GetGsu(), nullptr); break;
+				default: break;
+			}
+			console->GetMemoryManager()->SetSyncCoprocessorsEveryTick(syncEveryTick);
+
+			for (int i = 0; i < FrameCount; i++) {
+				emu.RunHeadlessFrame();
+
+				FrameHashes hashes;
+				PpuFrameInfo frame = emu.GetPpuFrame();
+				hashes.FrameBuffer = Hash(frame.FrameBuffer, frame.FrameBufferSize);
+
+				Serializer coprocessorState;
+				coprocessorState.ResetForFastSave(SaveStateManager::FileFormatVersion);
+				coprocessorState.Stream(*cart->GetCoprocessor(), "coprocessor", -1);
+				vector<uint8_t> data = coprocessorState.GetData();
+				hashes.Coprocessor = Hash(data.data(), data.size());
+
+				Serializer consoleState;
+				consoleState.ResetForFastSave(SaveStateManager::FileFormatVersion);
+				emu.StreamHeadlessState(consoleState);
+				data = consoleState.GetData();
+				hashes.Console = Hash(data.data(), data.size());
+
+				hashes.EventCount = ((uint8_t*)emu.GetMemory(MemoryType::SnesWorkRam).Memory)[0];
+				frames.push_back(hashes);
+			}
+
+			emu.Stop(false, true, false);
+			emu.Release();
+			return frames;
+		}
+
+		void CompareWithPerTickSync(const vector<uint8_t>& rom, CoprocessorType type) {
+			vector<FrameHashes> expected = Run(rom, type, true);
+			vector<FrameHashes> frames = Run(rom, type, false);
+			ASSERT_EQ(frames.size(), (size_t)FrameCount);
+			ASSERT_EQ(expected.size(), (size_t)FrameCount);
+
+			// The SNES CPU must have seen the coprocessor's activity (and the backdrop color changed)
+			EXPECT_NE(frames.back().EventCount, 0);
+			EXPECT_NE(frames.front().FrameBuffer, frames.back().FrameBuffer);
+
+			for (int i = 0; i < FrameCount; i++) {
+				SCOPED_TRACE(std::format("frame {}", i));
+				EXPECT_EQ(frames[i].EventCount, expected[i].EventCount);
+				EXPECT_EQ(frames[i].FrameBuffer, expected[i].FrameBuffer);
+				EXPECT_EQ(frames[i].Coprocessor, expected[i].Coprocessor);
+				ASSERT_EQ(frames[i].Console, expected[i].Console);
+			}
+		}
+	};
+}
+
+TEST_F(SnesCoprocessorSyncTest, Sa1_MatchesPerTickSync) {
+	CompareWithPerTickSync(BuildSa1Rom(), CoprocessorType::SA1);
+}
+
+TEST_F(SnesCoprocessorSyncTest, Cx4_MatchesPerTickSync) {
+	CompareWithPerTickSync(BuildCx4Rom(), CoprocessorType::CX4);
+}
+
+TEST_F(SnesCoprocessorSyncTest, Gsu_MatchesPerTickSync) {
+	CompareWithPerTickSync(BuildGsuRom(), CoprocessorType::GSU);
+}
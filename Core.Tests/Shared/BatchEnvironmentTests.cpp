@@ -0,0 +1,106 @@
+#include "pch.h"
+#include <thread>
+#include "Shared/BatchEnvironment.h"
+#include "Shared/Emulator.h"
+#include "Shared/MemoryType.h"
+#include "Lynx/LynxConsole.h"
+#include "Utilities/VirtualFile.h"
+#include "Core.Tests/Lynx/LynxUartTestRom.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+// =============================================================================
+// BatchEnvironment Tests
+// =============================================================================
+// Instances are headless emulators run by the environment's threads - they
+// must not share any state with each other, with other environments or with
+// the player's instance (e.g. the process-wide ComLynx cable).
+// =============================================================================
+
+namespace {
+	constexpr uint32_t LynxButtonA = 0x10;
+	constexpr uint32_t LynxButtonRight = 0x08;
+
+	struct LynxEnvironment {
+		unique_ptr<BatchEnvironment> Env;
+		vector<uint8_t> Ram;
+
+		LynxEnvironment() {
+			BatchEnvironmentConfig config = {};
+			config.InstanceCount = 4;
+			config.ThreadCount = 2;
+			config.RamRanges.push_back({MemoryType::LynxWorkRam, 0x10, 3});
+			Env = std::make_unique<BatchEnvironment>(config);
+
+			vector<uint8_t> rom = BuildLynxUartTestRom();
+			EXPECT_TRUE(Env->LoadRom(VirtualFile(rom.data(), rom.size(), "uart.lnx"), VirtualFile()));
+			Ram.resize(Env->GetInstanceCount() * Env->GetRamStride());
+		}
+
+		void Run(uint32_t buttons) {
+			vector<uint32_t> inputs(Env->GetInstanceCount(), buttons);
+			for (int i = 0; i < 20; i++) {
+				Env->Step(inputs.data(), nullptr, nullptr, Ram.data());
+			}
+		}
+	};
+}
+
+TEST(BatchEnvironmentTest, Lynx_ParallelEnvironmentsAreIndependent) {
+	TestHomeFolder home("nexen_batch_environment_test");
+	LynxEnvironment envA;
+	LynxEnvironment envB;
+	ASSERT_EQ(envA.Env->GetInstanceCount(), 4u);
+	ASSERT_EQ(envB.Env->GetInstanceCount(), 4u);
+
+	// Each instance sends its joystick state once - on a shared cable, every instance would also
+	// receive the bytes of all the other instances
+	std::thread threadB([&]() { envB.Run(LynxButtonRight); });
+	envA.Run(LynxButtonA);
+	threadB.join();
+
+	for (uint32_t i = 0; i < 4; i++) {
+		const uint8_t* ramA = envA.Ram.data() + i * 3;
+		EXPECT_EQ(ramA[0], 0x7F) << "instance " << i;
+		EXPECT_EQ(ramA[1], 0x7F) << "instance " << i;
+		EXPECT_EQ(ramA[2], 1) << "instance " << i;
+
+		const uint8_t* ramB = envB.Ram.data() + i * 3;
+		EXPECT_EQ(ramB[0], 0xFE) << "instance " << i;
+		EXPECT_EQ(ramB[1], 0xFE) << "instance " << i;
+		EXPECT_EQ(ramB[2], 1) << "instance " << i;
+
+		for (LynxEnvironment* env : {&envA, &envB}) {
+			LynxConsole* console = (LynxConsole*)env->Env->GetEmulator(i)->GetConsoleUnsafe();
+			EXPECT_EQ(console->GetComLynxCable(), nullptr);
+			EXPECT_FALSE(console->GetMikey()->HasComLynxCable());
+		}
+	}
+}
+
+TEST(BatchEnvironmentTest, Step_ResultsDontDependOnThreadCount) {
+	TestHomeFolder home("nexen_batch_environment_test");
+	vector<uint8_t> rom = BuildLynxUartTestRom();
+
+	auto run = [&](uint32_t threadCount) {
+		BatchEnvironmentConfig config = {};
+		config.InstanceCount = 6;
+		config.ThreadCount = threadCount;
+		config.RamRanges.push_back({MemoryType::LynxWorkRam, 0x10, 3});
+		BatchEnvironment env(config);
+		EXPECT_TRUE(env.LoadRom(VirtualFile(rom.data(), rom.size(), "uart.lnx"), VirtualFile()));
+
+		vector<uint8_t> ram(config.InstanceCount * env.GetRamStride());
+		vector<uint32_t> inputs(config.InstanceCount);
+		for (uint32_t step = 0; step < 10; step++) {
+			for (uint32_t i = 0; i < config.InstanceCount; i++) {
+				inputs[i] = (step + i) % 3 == 0 ? LynxButtonA : 0;
+			}
+			env.Step(inputs.data(), nullptr, nullptr, ram.data());
+		}
+		return ram;
+	};
+
+	vector<uint8_t> expected = run(1);
+	EXPECT_EQ(run(3), expected);
+	EXPECT_EQ(run(6), expected);
+}
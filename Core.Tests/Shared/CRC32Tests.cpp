@@ -106,3 +106,18 @@ TEST_F(CRC32Test, GetCRC_OrderMatters) {
 	std::vector<uint8_t> data2 = {0x34, 0x12};
 	EXPECT_NE(CRC32::GetCRC(data1), CRC32::GetCRC(data2));
 }
+
+TEST_F(CRC32Test, GetCRC_Incremental_MatchesSinglePass) {
+	std::vector<uint8_t> data(100000);
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<uint8_t>(i * 31 + (i >> 8));
+	}
+
+	// Odd split points, to test the unaligned start/end of each part
+	uint32_t crc = 0;
+	size_t splits[] = {0, 1, 7, 1000, 4097, 65536, 99999, data.size()};
+	for (size_t i = 1; i < std::size(splits); i++) {
+		crc = CRC32::GetCRC(data.data() + splits[i - 1], splits[i] - splits[i - 1], crc);
+	}
+	EXPECT_EQ(crc, CRC32::GetCRC(data));
+}
@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "Shared/Video/DebugHud.h"
+
+namespace {
+	constexpr uint32_t Width = 32;
+	constexpr uint32_t Height = 16;
+
+	// Draws the queued HUD commands for one frame into a fresh buffer
+	std::vector<uint32_t> DrawFrame(DebugHud& hud, uint32_t frameNumber = 0, HudScaleFactors scale = {}, uint32_t width = Width, uint32_t height = Height) {
+		std::vector<uint32_t> buffer(width * height, 0);
+		hud.Draw(buffer.data(), {width, height}, {}, frameNumber, scale);
+		return buffer;
+	}
+
+	int CountPixels(const std::vector<uint32_t>& buffer) {
+		return (int)std::count_if(buffer.begin(), buffer.end(), [](uint32_t c) { return c != 0; });
+	}
+}
+
+TEST(DebugHudTests, DrawPixel_WritesOpaqueColor) {
+	DebugHud hud;
+	hud.DrawPixel(3, 2, 0x00FF0000, 1);
+	auto buffer = DrawFrame(hud);
+
+	EXPECT_EQ(buffer[2 * Width + 3], 0xFFFF0000u);
+	EXPECT_EQ(CountPixels(buffer), 1);
+}
+
+TEST(DebugHudTests, DrawPixel_FullyTransparentIsSkipped) {
+	DebugHud hud;
+	hud.DrawPixel(3, 2, (int)0xFFFF0000, 1);
+	auto buffer = DrawFrame(hud);
+
+	EXPECT_EQ(CountPixels(buffer), 0);
+}
+
+TEST(DebugHudTests, DrawRectangle_OutlineOnlyDrawsBorder) {
+	DebugHud hud;
+	hud.DrawRectangle(1, 1, 4, 3, 0x0000FF00, false, 1);
+	auto buffer = DrawFrame(hud);
+
+	EXPECT_EQ(CountPixels(buffer), 10);
+	EXPECT_EQ(buffer[1 * Width + 1], 0xFF00FF00u);
+	EXPECT_EQ(buffer[3 * Width + 4], 0xFF00FF00u);
+	EXPECT_EQ(buffer[2 * Width + 2], 0u);
+}
+
+TEST(DebugHudTests, DrawRectangle_NegativeSizeIsNormalized) {
+	DebugHud hud;
+	hud.DrawRectangle(4, 3, -4, -3, 0x0000FF00, true, 1);
+	auto buffer = DrawFrame(hud);
+
+	EXPECT_EQ(CountPixels(buffer), 12);
+	EXPECT_EQ(buffer[1 * Width + 1], 0xFF00FF00u);
+	EXPECT_EQ(buffer[3 * Width + 4], 0xFF00FF00u);
+}
+
+TEST(DebugHudTests, DrawRectangle_IsClippedToScreen) {
+	DebugHud hud;
+	hud.DrawRectangle(-5, -5, 100, 100, 0x000000FF, true, 1);
+	auto buffer = DrawFrame(hud);
+
+	EXPECT_EQ(CountPixels(buffer), (int)(Width * Height));
+}
+
+TEST(DebugHudTests, DrawLine_DiagonalVisitsEachRowOnce) {
+	DebugHud hud;
+	hud.DrawLine(0, 0, 5, 5, 0x00FFFFFF, 1);
+	auto buffer = DrawFrame(hud);
+
+	EXPECT_EQ(CountPixels(buffer), 6);
+	for (uint32_t i = 0; i <= 5; i++) {
+		EXPECT_EQ(buffer[i * Width + i], 0xFFFFFFFFu);
+	}
+}
+
+TEST(DebugHudTests, DrawLine_ShallowLineMergesSpans) {
+	DebugHud hud;
+	hud.DrawLine(10, 4, 0, 5, 0x00FFFFFF, 1);
+	auto buffer = DrawFrame(hud);
+
+	// 11 pixels wide, split across two scanlines
+	EXPECT_EQ(CountPixels(buffer), 11);
+	EXPECT_EQ(buffer[4 * Width + 10], 0xFFFFFFFFu);
+	EXPECT_EQ(buffer[5 * Width + 0], 0xFFFFFFFFu);
+}
+
+TEST(DebugHudTests, DrawRectangle_ScaledCoversScaledArea) {
+	DebugHud hud;
+	hud.DrawRectangle(1, 1, 2, 2, 0x00FF00FF, true, 1);
+	auto buffer = DrawFrame(hud, 0, {2, 2});
+
+	EXPECT_EQ(CountPixels(buffer), 16);
+	EXPECT_EQ(buffer[2 * Width + 2], 0xFFFF00FFu);
+	EXPECT_EQ(buffer[5 * Width + 5], 0xFFFF00FFu);
+	EXPECT_EQ(buffer[6 * Width + 6], 0u);
+}
+
+TEST(DebugHudTests, SemiTransparentOverlap_BlendsInDrawOrder) {
+	DebugHud hud;
+	hud.DrawPixel(0, 0, 0x00FF0000, 1);
+	hud.DrawPixel(0, 0, 0x7F0000FF, 1);
+	auto buffer = DrawFrame(hud);
+
+	uint32_t color = buffer[0];
+	EXPECT_EQ(color >> 24, 0xFFu);
+	EXPECT_NE(color & 0xFF, 0u);
+	EXPECT_NE(color & 0xFF0000, 0u);
+}
+
+TEST(DebugHudTests, FrameCount_ExpiresAfterFrames) {
+	DebugHud hud;
+	hud.DrawPixel(0, 0, 0x00FF0000, 2);
+	EXPECT_TRUE(hud.HasCommands());
+
+	EXPECT_EQ(CountPixels(DrawFrame(hud, 0)), 1);
+	EXPECT_EQ(CountPixels(DrawFrame(hud, 1)), 1);
+	EXPECT_FALSE(hud.HasCommands());
+}
+
+TEST(DebugHudTests, StartFrame_DelaysDrawing) {
+	DebugHud hud;
+	hud.DrawPixel(0, 0, 0x00FF0000, 1, 5);
+
+	EXPECT_EQ(CountPixels(DrawFrame(hud, 4)), 0);
+	EXPECT_TRUE(hud.HasCommands());
+	EXPECT_EQ(CountPixels(DrawFrame(hud, 5)), 1);
+	EXPECT_FALSE(hud.HasCommands());
+}
+
+TEST(DebugHudTests, DrawString_KeepsOrderWithPrimitives) {
+	DebugHud hud;
+	hud.DrawRectangle(0, 0, 20, 12, 0x00FF0000, true, 1);
+	hud.DrawString(1, 2, "A", 0x0000FF00, 0x000000FF, 1);
+	hud.DrawPixel(0, 0, 0x00FFFFFF, 1);
+	auto buffer = DrawFrame(hud);
+
+	// String pixels (fg or bg) overwrite the rectangle, and the pixel drawn last wins
+	EXPECT_EQ(buffer[0], 0xFFFFFFFFu);
+	EXPECT_EQ(buffer[2 * Width + 1], 0xFF0000FFu);
+	EXPECT_EQ(buffer[11 * Width + 19], 0xFFFF0000u);
+}
+
+TEST(DebugHudTests, DrawString_ScaledGlyphMatchesUnscaledShape) {
+	DebugHud hud;
+	hud.DrawString(0, 1, "I", 0x00FFFFFF, (int)0xFF000000, 1);
+	int unscaled = CountPixels(DrawFrame(hud));
+
+	DebugHud scaledHud;
+	scaledHud.DrawString(0, 1, "I", 0x00FFFFFF, (int)0xFF000000, 1);
+	int scaled = CountPixels(DrawFrame(scaledHud, 0, {2, 2}));
+
+	EXPECT_GT(unscaled, 0);
+	EXPECT_EQ(scaled, unscaled * 4);
+}
+
+TEST(DebugHudTests, ClearScreen_RemovesAllCommands) {
+	DebugHud hud;
+	hud.DrawPixel(0, 0, 0x00FF0000, 10);
+	hud.DrawString(0, 0, "Test", 0x00FFFFFF, 0, 10);
+	hud.ClearScreen();
+
+	EXPECT_FALSE(hud.HasCommands());
+	EXPECT_EQ(CountPixels(DrawFrame(hud)), 0);
+}
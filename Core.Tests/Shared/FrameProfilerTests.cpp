@@ -0,0 +1,140 @@
+#include "pch.h"
+#include <thread>
+#include "Shared/FrameProfiler.h"
+
+// =============================================================================
+// Frame Profiler Unit Tests
+// =============================================================================
+// The probes record exclusive times: a nested probe's time is only counted in
+// its own section, so the emulation thread's sections add up to the total.
+
+namespace {
+	void SpinFor(std::chrono::microseconds duration) {
+		auto end = std::chrono::steady_clock::now() + duration;
+		while (std::chrono::steady_clock::now() < end) {
+		}
+	}
+
+	double SumSections(const FrameProfilerStats& stats) {
+		double total = 0;
+		for (int i = 0; i < (int)FrameProfilerSection::Count; i++) {
+			if (i != (int)FrameProfilerSection::Total && i != (int)FrameProfilerSection::VideoDecode) {
+				total += stats.Sections[i].LastMs;
+			}
+		}
+		return total;
+	}
+}
+
+TEST(FrameProfilerTests, Disabled_RecordsNothing) {
+	FrameProfiler profiler;
+	{
+		FrameProfilerScope frame(&profiler, FrameProfilerSection::Other, true);
+		FrameProfilerScope console(&profiler, FrameProfilerSection::Console);
+		SpinFor(std::chrono::microseconds(100));
+	}
+
+	FrameProfilerStats stats = profiler.GetStats();
+	EXPECT_EQ(stats.FrameCount, 0u);
+	EXPECT_EQ(stats.Sections[(int)FrameProfilerSection::Console].LastMs, 0.0);
+}
+
+TEST(FrameProfilerTests, NestedScopes_AreExclusive) {
+	FrameProfiler profiler;
+	profiler.SetEnabled(FrameProfiler::Client::Api, true);
+	{
+		FrameProfilerScope frame(&profiler, FrameProfilerSection::Other, true);
+		SpinFor(std::chrono::microseconds(500));
+		{
+			FrameProfilerScope console(&profiler, FrameProfilerSection::Console);
+			SpinFor(std::chrono::microseconds(2000));
+			{
+				FrameProfilerScope audio(&profiler, FrameProfilerSection::Audio);
+				SpinFor(std::chrono::microseconds(1000));
+			}
+		}
+	}
+
+	FrameProfilerStats stats = profiler.GetStats();
+	ASSERT_EQ(stats.FrameCount, 1u);
+
+	double other = stats.Sections[(int)FrameProfilerSection::Other].LastMs;
+	double console = stats.Sections[(int)FrameProfilerSection::Console].LastMs;
+	double audio = stats.Sections[(int)FrameProfilerSection::Audio].LastMs;
+	double total = stats.Sections[(int)FrameProfilerSection::Total].LastMs;
+
+	EXPECT_GE(other, 0.5);
+	EXPECT_GE(console, 2.0);
+	EXPECT_LT(console, 3.0); // Audio's time isn't counted twice
+	EXPECT_GE(audio, 1.0);
+	EXPECT_NEAR(SumSections(stats), total, 0.01);
+}
+
+TEST(FrameProfilerTests, OtherThreads_AddToCurrentFrame) {
+	FrameProfiler profiler;
+	profiler.SetEnabled(FrameProfiler::Client::Hud, true);
+
+	std::thread decodeThread([&]() {
+		FrameProfilerScope decode(&profiler, FrameProfilerSection::VideoDecode);
+		SpinFor(std::chrono::microseconds(500));
+	});
+	decodeThread.join();
+
+	{
+		FrameProfilerScope frame(&profiler, FrameProfilerSection::Other, true);
+	}
+
+	FrameProfilerStats stats = profiler.GetStats();
+	EXPECT_GE(stats.Sections[(int)FrameProfilerSection::VideoDecode].LastMs, 0.5);
+	EXPECT_LT(stats.Sections[(int)FrameProfilerSection::Total].LastMs, 0.5);
+}
+
+TEST(FrameProfilerTests, Stats_WindowAndHistogram) {
+	FrameProfiler profiler;
+	profiler.SetEnabled(FrameProfiler::Client::Api, true);
+
+	// 1 frame of 4ms followed by 100 frames of 1ms - the 4ms frame is outside of the 60-frame window
+	profiler.AddTime(FrameProfilerSection::Console, 4000000);
+	profiler.EndFrame();
+	for (int i = 0; i < 100; i++) {
+		profiler.AddTime(FrameProfilerSection::Console, 1000000);
+		profiler.EndFrame();
+	}
+
+	FrameProfilerStats stats = profiler.GetStats();
+	FrameProfilerSectionStats& console = stats.Sections[(int)FrameProfilerSection::Console];
+	EXPECT_EQ(stats.FrameCount, 101u);
+	EXPECT_DOUBLE_EQ(console.LastMs, 1.0);
+	EXPECT_DOUBLE_EQ(console.AverageMs, 1.0);
+	EXPECT_DOUBLE_EQ(console.MaxMs, 1.0);
+
+	// The histogram covers all frames since the last reset
+	EXPECT_EQ(console.Histogram[FrameProfiler::GetBucket(1000000)], 100u);
+	EXPECT_EQ(console.Histogram[FrameProfiler::GetBucket(4000000)], 1u);
+	EXPECT_EQ(stats.Sections[(int)FrameProfilerSection::Rewind].Histogram[0], 101u);
+
+	profiler.Reset();
+	stats = profiler.GetStats();
+	EXPECT_EQ(stats.FrameCount, 0u);
+	EXPECT_EQ(stats.Sections[(int)FrameProfilerSection::Console].Histogram[FrameProfiler::GetBucket(1000000)], 0u);
+}
+
+TEST(FrameProfilerTests, GetBucket_Log2Microseconds) {
+	EXPECT_EQ(FrameProfiler::GetBucket(0), 0u);
+	EXPECT_EQ(FrameProfiler::GetBucket(999), 0u);
+	EXPECT_EQ(FrameProfiler::GetBucket(1000), 1u);
+	EXPECT_EQ(FrameProfiler::GetBucket(2000), 2u);
+	EXPECT_EQ(FrameProfiler::GetBucket(3999), 2u);
+	EXPECT_EQ(FrameProfiler::GetBucket(16667000), 15u);
+	EXPECT_EQ(FrameProfiler::GetBucket(10000000000ull), FrameProfilerBucketCount - 1);
+}
+
+TEST(FrameProfilerTests, Clients_StayEnabledUntilAllDisabled) {
+	FrameProfiler profiler;
+	profiler.SetEnabled(FrameProfiler::Client::Api, true);
+	profiler.SetEnabled(FrameProfiler::Client::Hud, true);
+	profiler.SetEnabled(FrameProfiler::Client::Hud, false);
+	EXPECT_TRUE(profiler.IsEnabled());
+	profiler.SetEnabled(FrameProfiler::Client::Api, false);
+	EXPECT_FALSE(profiler.IsEnabled());
+}
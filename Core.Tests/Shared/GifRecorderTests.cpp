@@ -0,0 +1,231 @@
+#include "pch.h"
+#include <filesystem>
+#include <random>
+#include "Utilities/Video/GifRecorder.h"
+
+// =============================================================================
+// GifRecorder Unit Tests
+// =============================================================================
+// Records frames, then decodes the GIF (minimal decoder below) and checks that
+// every frame is displayed exactly - frames with 255 colors or less are written
+// with an exact palette, and only the rectangle that changed.
+
+namespace {
+	constexpr uint32_t Width = 64;
+	constexpr uint32_t Height = 48;
+
+	string GetTempFile() {
+		return (std::filesystem::temp_directory_path() / "nexen_gifrecorder_test.gif").string();
+	}
+
+	/// <summary>Decodes a GIF's frames (composited on the canvas), enough for the files gif.h writes</summary>
+	class GifDecoder {
+	private:
+		vector<uint8_t> _data;
+		size_t _pos = 0;
+
+		uint8_t Read8() { return _pos < _data.size() ? _data[_pos++] : 0; }
+		uint16_t Read16() {
+			uint16_t value = Read8();
+			return value | (Read8() << 8);
+		}
+
+		vector<uint8_t> ReadSubBlocks() {
+			vector<uint8_t> result;
+			while (uint8_t size = Read8()) {
+				result.insert(result.end(), _data.begin() + _pos, _data.begin() + _pos + size);
+				_pos += size;
+			}
+			return result;
+		}
+
+		static vector<uint8_t> DecodeLzw(const vector<uint8_t>& data, int minCodeSize, size_t pixelCount) {
+			uint32_t clearCode = 1 << minCodeSize;
+			vector<vector<uint8_t>> table;
+			auto reset = [&]() {
+				table.clear();
+				for (uint32_t i = 0; i < clearCode + 2; i++) {
+					table.push_back({(uint8_t)i});
+				}
+			};
+			reset();
+
+			vector<uint8_t> output;
+			uint32_t codeSize = minCodeSize + 1;
+			size_t bitPos = 0;
+			int32_t prev = -1;
+			while (bitPos + codeSize <= data.size() * 8) {
+				uint32_t code = 0;
+				for (uint32_t i = 0; i < codeSize; i++, bitPos++) {
+					code |= ((data[bitPos / 8] >> (bitPos % 8)) & 1) << i;
+				}
+
+				if (code == clearCode) {
+					reset();
+					codeSize = minCodeSize + 1;
+					prev = -1;
+					continue;
+				} else if (code == clearCode + 1) {
+					break;
+				}
+
+				vector<uint8_t> entry;
+				if (code < table.size()) {
+					entry = table[code];
+					if (prev >= 0) {
+						vector<uint8_t> newEntry = table[prev];
+						newEntry.push_back(entry[0]);
+						table.push_back(newEntry);
+					}
+				} else {
+					entry = table[prev];
+					entry.push_back(entry[0]);
+					table.push_back(entry);
+				}
+				output.insert(output.end(), entry.begin(), entry.end());
+				prev = code;
+
+				if (table.size() >= (1u << codeSize) && codeSize < 12) {
+					codeSize++;
+				}
+			}
+			output.resize(pixelCount);
+			return output;
+		}
+
+	public:
+		vector<vector<uint32_t>> Frames;
+
+		bool Decode(const string& filename) {
+			ifstream file(filename, std::ios::binary);
+			_data.assign(std::istreambuf_iterator<char>(file), {});
+			if (_data.size() < 13 || memcmp(_data.data(), "GIF89a", 6) != 0) {
+				return false;
+			}
+
+			_pos = 6;
+			uint32_t width = Read16();
+			uint32_t height = Read16();
+			uint8_t flags = Read8();
+			_pos += 2;
+			if (flags & 0x80) {
+				_pos += 3 * (2 << (flags & 0x07));
+			}
+
+			vector<uint32_t> canvas(width * height);
+			bool hasTransparency = false;
+			uint8_t transparentIndex = 0;
+			while (_pos < _data.size()) {
+				uint8_t block = Read8();
+				if (block == 0x3B) {
+					return true;
+				} else if (block == 0x21) {
+					uint8_t label = Read8();
+					vector<uint8_t> ext = ReadSubBlocks();
+					if (label == 0xF9 && ext.size() >= 4) {
+						hasTransparency = ext[0] & 0x01;
+						transparentIndex = ext[3];
+					}
+				} else if (block == 0x2C) {
+					uint32_t left = Read16();
+					uint32_t top = Read16();
+					uint32_t w = Read16();
+					uint32_t h = Read16();
+					uint8_t imageFlags = Read8();
+					vector<uint32_t> palette;
+					if (imageFlags & 0x80) {
+						for (int i = 0; i < (2 << (imageFlags & 0x07)); i++) {
+							uint32_t r = Read8();
+							uint32_t g = Read8();
+							uint32_t b = Read8();
+							palette.push_back(0xFF000000 | (r << 16) | (g << 8) | b);
+						}
+					}
+					int minCodeSize = Read8();
+					vector<uint8_t> indexes = DecodeLzw(ReadSubBlocks(), minCodeSize, w * h);
+					for (uint32_t y = 0; y < h; y++) {
+						for (uint32_t x = 0; x < w; x++) {
+							uint8_t index = indexes[y * w + x];
+							if ((!hasTransparency || index != transparentIndex) && index < palette.size()) {
+								canvas[(top + y) * width + left + x] = palette[index];
+							}
+						}
+					}
+					Frames.push_back(canvas);
+				} else {
+					return false;
+				}
+			}
+			return false;
+		}
+	};
+
+	// Scrolling stripes (few colors) with a moving box
+	vector<uint32_t> MakeFrame(uint32_t frameNumber) {
+		vector<uint32_t> frame(Width * Height);
+		for (uint32_t y = 0; y < Height; y++) {
+			for (uint32_t x = 0; x < Width; x++) {
+				frame[y * Width + x] = 0xFF000000 | (((x + frameNumber) / 4 % 8) * 0x200810);
+			}
+		}
+		for (uint32_t y = 10; y < 20; y++) {
+			for (uint32_t x = frameNumber * 3; x < frameNumber * 3 + 10; x++) {
+				frame[y * Width + x % Width] = 0xFFFFC040;
+			}
+		}
+		return frame;
+	}
+}
+
+TEST(GifRecorderTests, ExactPalette_FramesDecodeExactly) {
+	string filename = GetTempFile();
+	vector<vector<uint32_t>> frames;
+	{
+		GifRecorder recorder;
+		ASSERT_TRUE(recorder.Init(filename));
+		ASSERT_TRUE(recorder.StartRecording(Width, Height, 4, 0, 50.0));
+		for (uint32_t i = 0; i < 20; i++) {
+			// Frame 8 is the same as frame 7 (nothing changed)
+			frames.push_back(MakeFrame(i == 8 ? 7 : i));
+			ASSERT_TRUE(recorder.AddFrame(frames.back().data(), Width, Height, 50.0));
+		}
+		recorder.StopRecording();
+	}
+
+	GifDecoder decoder;
+	ASSERT_TRUE(decoder.Decode(filename));
+	ASSERT_EQ(decoder.Frames.size(), frames.size());
+	for (size_t i = 0; i < frames.size(); i++) {
+		EXPECT_EQ(decoder.Frames[i], frames[i]) << "frame " << i;
+	}
+	std::filesystem::remove(filename);
+}
+
+TEST(GifRecorderTests, TooManyColors_FallsBackToQuantization) {
+	string filename = GetTempFile();
+	vector<uint32_t> lastFrame = MakeFrame(3);
+	{
+		GifRecorder recorder;
+		ASSERT_TRUE(recorder.Init(filename));
+		ASSERT_TRUE(recorder.StartRecording(Width, Height, 4, 0, 50.0));
+
+		vector<uint32_t> frame = MakeFrame(0);
+		ASSERT_TRUE(recorder.AddFrame(frame.data(), Width, Height, 50.0));
+
+		// Every pixel has a different color
+		std::mt19937 rng(42);
+		for (uint32_t& pixel : frame) {
+			pixel = 0xFF000000 | (rng() & 0xFFFFFF);
+		}
+		ASSERT_TRUE(recorder.AddFrame(frame.data(), Width, Height, 50.0));
+		ASSERT_TRUE(recorder.AddFrame(lastFrame.data(), Width, Height, 50.0));
+		recorder.StopRecording();
+	}
+
+	// The frame after the quantized one is exact again
+	GifDecoder decoder;
+	ASSERT_TRUE(decoder.Decode(filename));
+	ASSERT_EQ(decoder.Frames.size(), 3u);
+	EXPECT_EQ(decoder.Frames[2], lastFrame);
+	std::filesystem::remove(filename);
+}
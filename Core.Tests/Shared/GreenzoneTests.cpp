@@ -0,0 +1,220 @@
+#include "pch.h"
+#include <random>
+#include "Shared/Movies/Greenzone.h"
+
+// =============================================================================
+// Greenzone Unit Tests
+// =============================================================================
+// A mock console whose state is a large RAM array that changes a little every
+// frame (like a real game), so states go through all 3 tiers: raw, keyframe
+// (compressed) and delta (compressed XOR against the keyframe).
+
+namespace {
+	class MockConsole : public ISerializable {
+	public:
+		uint32_t FrameCount = 0;
+		vector<uint8_t> Ram = vector<uint8_t>(0x10000);
+
+		MockConsole() {
+			// Random content - doesn't compress, like most of a real game's state
+			std::mt19937 rng(1234);
+			for (uint8_t& value : Ram) {
+				value = (uint8_t)rng();
+			}
+		}
+
+		void RunFrame() {
+			FrameCount++;
+			for (uint32_t i = 0; i < 64; i++) {
+				Ram[(FrameCount * 97 + i * 613) & 0xFFFF] += (uint8_t)(FrameCount + i);
+			}
+		}
+
+		void Serialize(Serializer& s) override {
+			SV(FrameCount);
+			SVArray(Ram.data(), (uint32_t)Ram.size());
+		}
+	};
+
+	GreenzoneConfig SmallConfig() {
+		GreenzoneConfig config;
+		config.RawStateCount = 10;
+		config.KeyframeInterval = 8;
+		return config;
+	}
+
+	// Runs the console to the given frame, capturing a state after every frame
+	void RunAndCapture(Greenzone& greenzone, MockConsole& console, uint32_t lastFrame) {
+		while (console.FrameCount < lastFrame) {
+			console.RunFrame();
+			if (greenzone.IsCaptureFrame(console.FrameCount)) {
+				greenzone.Capture(console, console.FrameCount, 1);
+			}
+		}
+	}
+}
+
+TEST(GreenzoneTests, LoadNearest_RestoresExactStateFromAllTiers) {
+	Greenzone greenzone;
+	greenzone.SetConfig(SmallConfig());
+
+	MockConsole console;
+	vector<vector<uint8_t>> ramByFrame = { console.Ram };
+	while (console.FrameCount < 60) {
+		console.RunFrame();
+		ramByFrame.push_back(console.Ram);
+		greenzone.Capture(console, console.FrameCount, 1);
+	}
+
+	GreenzoneInfo info = greenzone.GetInfo();
+	EXPECT_EQ(info.StateCount, 60u);
+	EXPECT_EQ(info.RawStateCount, 10u);
+	EXPECT_GT(info.KeyframeCount, 0u);
+	EXPECT_GT(info.DeltaCount, 0u);
+
+	// Load in a mixed order (deltas based on different keyframes, raw states, etc.)
+	for (uint32_t frame : { 1u, 45u, 9u, 60u, 17u, 16u, 51u, 2u, 33u }) {
+		MockConsole loaded;
+		optional<uint32_t> result = greenzone.LoadNearest(loaded, frame);
+		ASSERT_EQ(result, frame);
+		EXPECT_EQ(loaded.FrameCount, frame);
+		EXPECT_EQ(loaded.Ram, ramByFrame[frame]) << "frame " << frame;
+	}
+}
+
+TEST(GreenzoneTests, CaptureInterval_LoadsNearestEarlierState) {
+	Greenzone greenzone;
+	GreenzoneConfig config = SmallConfig();
+	config.CaptureInterval = 5;
+	greenzone.SetConfig(config);
+
+	MockConsole console;
+	RunAndCapture(greenzone, console, 50);
+	EXPECT_EQ(greenzone.GetInfo().StateCount, 10u);
+
+	MockConsole loaded;
+	EXPECT_EQ(greenzone.LoadNearest(loaded, 23), 20u);
+	EXPECT_EQ(loaded.FrameCount, 20u);
+	EXPECT_EQ(greenzone.LoadNearest(loaded, 4), std::nullopt);
+}
+
+TEST(GreenzoneTests, InvalidateFrom_DropsLaterStates) {
+	Greenzone greenzone;
+	greenzone.SetConfig(SmallConfig());
+
+	MockConsole console;
+	RunAndCapture(greenzone, console, 40);
+	greenzone.InvalidateFrom(25);
+
+	EXPECT_TRUE(greenzone.HasState(24));
+	EXPECT_FALSE(greenzone.HasState(25));
+	EXPECT_EQ(greenzone.GetNearestFrame(100), 24u);
+	EXPECT_EQ(greenzone.GetInfo().LastFrame, 24);
+
+	// Re-record from the edit point with different input
+	MockConsole edited;
+	ASSERT_EQ(greenzone.LoadNearest(edited, 24), 24u);
+	edited.Ram[0] = 0xAA;
+	RunAndCapture(greenzone, edited, 40);
+
+	MockConsole loaded;
+	ASSERT_EQ(greenzone.LoadNearest(loaded, 30), 30u);
+	EXPECT_EQ(loaded.Ram[0], 0xAA);
+	ASSERT_EQ(greenzone.LoadNearest(loaded, 20), 20u);
+	EXPECT_NE(loaded.Ram[0], 0xAA);
+}
+
+TEST(GreenzoneTests, MemoryBudget_DropsLeastRecentlyUsedStates) {
+	Greenzone greenzone;
+	GreenzoneConfig config = SmallConfig();
+	config.MaxMemoryBytes = 0x10000 * 14;
+	greenzone.SetConfig(config);
+
+	MockConsole console;
+	RunAndCapture(greenzone, console, 200);
+
+	GreenzoneInfo info = greenzone.GetInfo();
+	EXPECT_LE(info.MemoryUsage, config.MaxMemoryBytes);
+	EXPECT_LT(info.StateCount, 200u);
+	EXPECT_EQ(info.LastFrame, 200);
+
+	// Every remaining state can still be restored (no delta without its keyframe)
+	for (int64_t frame = info.FirstFrame; frame <= info.LastFrame; frame++) {
+		if (greenzone.HasState((uint32_t)frame)) {
+			MockConsole loaded;
+			ASSERT_EQ(greenzone.LoadNearest(loaded, (uint32_t)frame), (uint32_t)frame);
+			EXPECT_EQ(loaded.FrameCount, (uint32_t)frame);
+		}
+	}
+}
+
+TEST(GreenzoneTests, Recapture_ReplacesState) {
+	Greenzone greenzone;
+	greenzone.SetConfig(SmallConfig());
+
+	MockConsole console;
+	RunAndCapture(greenzone, console, 30);
+
+	console.FrameCount = 5;
+	console.Ram[100] = 0x55;
+	greenzone.Capture(console, 5, 1);
+	EXPECT_EQ(greenzone.GetInfo().StateCount, 30u);
+
+	MockConsole loaded;
+	ASSERT_EQ(greenzone.LoadNearest(loaded, 5), 5u);
+	EXPECT_EQ(loaded.Ram[100], 0x55);
+}
+
+TEST(GreenzoneTests, RecaptureKeyframe_RebasesItsDeltas) {
+	Greenzone greenzone;
+	greenzone.SetConfig(SmallConfig());
+
+	MockConsole console;
+	vector<vector<uint8_t>> ramByFrame = { console.Ram };
+	while (console.FrameCount < 40) {
+		console.RunFrame();
+		ramByFrame.push_back(console.Ram);
+		greenzone.Capture(console, console.FrameCount, 1);
+	}
+
+	// Frame 1 is the first keyframe - frames 2 to 8 are deltas based on it
+	MockConsole replayed;
+	ASSERT_EQ(greenzone.LoadNearest(replayed, 1), 1u);
+	replayed.Ram[100] = 0x55;
+	greenzone.Capture(replayed, 1, 1);
+
+	EXPECT_EQ(greenzone.GetInfo().StateCount, 40u);
+
+	for (uint32_t frame = 2; frame <= 8; frame++) {
+		MockConsole loaded;
+		ASSERT_EQ(greenzone.LoadNearest(loaded, frame), frame);
+		EXPECT_EQ(loaded.Ram, ramByFrame[frame]) << "frame " << frame;
+	}
+
+	MockConsole loaded;
+	ASSERT_EQ(greenzone.LoadNearest(loaded, 1), 1u);
+	EXPECT_EQ(loaded.Ram[100], 0x55);
+}
+
+TEST(GreenzoneTests, MemoryBudget_KeepsRecentlyLoadedStates) {
+	Greenzone greenzone;
+	GreenzoneConfig config = SmallConfig();
+	greenzone.SetConfig(config);
+
+	MockConsole console;
+	RunAndCapture(greenzone, console, 60);
+
+	// Frame 3 (a delta) and its keyframe are used last - the other compressed states go first
+	MockConsole loaded;
+	ASSERT_EQ(greenzone.LoadNearest(loaded, 3), 3u);
+	config.MaxMemoryBytes = greenzone.GetInfo().MemoryUsage - 0x10000 * 2;
+	greenzone.SetConfig(config);
+
+	EXPECT_LE(greenzone.GetInfo().MemoryUsage, config.MaxMemoryBytes);
+	EXPECT_TRUE(greenzone.HasState(1));
+	EXPECT_TRUE(greenzone.HasState(3));
+	EXPECT_FALSE(greenzone.HasState(9));
+	EXPECT_TRUE(greenzone.HasState(60));
+	ASSERT_EQ(greenzone.LoadNearest(loaded, 3), 3u);
+	EXPECT_EQ(loaded.FrameCount, 3u);
+}
@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "Shared/IdleLoopDetector.h"
+
+// =============================================================================
+// IdleLoopDetector Unit Tests
+// =============================================================================
+// The detector is fed the branches a CPU core would report for a polling loop
+// (branch address, target, register hash, side-effect counter, master clock).
+
+namespace {
+	constexpr uint32_t LoopStart = 0x08000100;
+	constexpr uint32_t LoopBranch = 0x08000108;
+	constexpr uint32_t IterationCycles = 14;
+
+	struct LoopRunner {
+		IdleLoopDetector Detector;
+		uint64_t Clock = 1000;
+		uint32_t SideEffects = 0;
+		uint64_t StateHash = 0x1234;
+
+		bool RunIteration(uint32_t cycles = IterationCycles) {
+			Clock += cycles;
+			return Detector.ProcessBranch(LoopBranch, LoopStart, StateHash, SideEffects, Clock);
+		}
+
+		// Returns the iteration on which the loop was first reported as idle (0 = never)
+		uint32_t RunUntilIdle(uint32_t maxIterations) {
+			for (uint32_t i = 1; i <= maxIterations; i++) {
+				if (RunIteration()) {
+					return i;
+				}
+			}
+			return 0;
+		}
+	};
+}
+
+TEST(IdleLoopDetectorTests, IdenticalIterations_DetectedAfterConfirmation) {
+	LoopRunner runner;
+	uint32_t iteration = runner.RunUntilIdle(10);
+
+	// 1 iteration to start tracking, 1 to measure the iteration length, then ConfirmIterations matches
+	EXPECT_EQ(iteration, 2 + IdleLoopDetector::ConfirmIterations);
+	EXPECT_EQ(runner.Detector.GetIterationCycles(), IterationCycles);
+	EXPECT_EQ(runner.Detector.GetLoopStart(), LoopStart);
+}
+
+TEST(IdleLoopDetectorTests, WritesInLoop_NeverDetected) {
+	LoopRunner runner;
+	for (int i = 0; i < 20; i++) {
+		runner.SideEffects++;
+		EXPECT_FALSE(runner.RunIteration());
+	}
+}
+
+TEST(IdleLoopDetectorTests, ChangingRegisters_NeverDetected) {
+	// e.g. a delay loop decrementing a counter
+	LoopRunner runner;
+	for (uint32_t counter = 20; counter > 0; counter--) {
+		runner.StateHash = IdleLoopDetector::HashState(&counter, 1, 0);
+		EXPECT_FALSE(runner.RunIteration());
+	}
+}
+
+TEST(IdleLoopDetectorTests, VaryingIterationLength_NotDetected) {
+	LoopRunner runner;
+	for (int i = 0; i < 20; i++) {
+		EXPECT_FALSE(runner.RunIteration(i % 2 ? 14 : 16));
+	}
+}
+
+TEST(IdleLoopDetectorTests, ForwardOrDistantBranch_Ignored) {
+	IdleLoopDetector detector;
+	uint64_t clock = 0;
+	for (int i = 0; i < 10; i++) {
+		clock += 10;
+		EXPECT_FALSE(detector.ProcessBranch(0x08000100, 0x08000110, 0, 0, clock));
+	}
+	for (int i = 0; i < 10; i++) {
+		clock += 10;
+		EXPECT_FALSE(detector.ProcessBranch(0x08000100, 0x08000100 - IdleLoopDetector::MaxLoopSize - 2, 0, 0, clock));
+	}
+}
+
+TEST(IdleLoopDetectorTests, OtherBranchInBetween_RestartsConfirmation) {
+	LoopRunner runner;
+	ASSERT_NE(runner.RunUntilIdle(10), 0u);
+
+	// A branch outside the loop (e.g. the IRQ handler's) means the loop must be confirmed again
+	runner.Clock += 50;
+	EXPECT_FALSE(runner.Detector.ProcessBranch(0x08000200, 0x08000300, 0, runner.SideEffects, runner.Clock));
+	EXPECT_FALSE(runner.RunIteration());
+	EXPECT_NE(runner.RunUntilIdle(10), 0u);
+}
+
+TEST(IdleLoopDetectorTests, SkippedCycles_NextIterationStillMatches) {
+	LoopRunner runner;
+	ASSERT_NE(runner.RunUntilIdle(10), 0u);
+
+	// The core skips 10 iterations, then runs one normally
+	runner.Clock += IterationCycles * 10;
+	runner.Detector.ProcessSkippedCycles(IterationCycles * 10);
+	EXPECT_TRUE(runner.RunIteration());
+}
+
+TEST(IdleLoopDetectorTests, Reset_ForgetsLoop) {
+	LoopRunner runner;
+	ASSERT_NE(runner.RunUntilIdle(10), 0u);
+
+	runner.Detector.Reset();
+	EXPECT_FALSE(runner.RunIteration());
+	EXPECT_EQ(runner.RunUntilIdle(10), 1 + IdleLoopDetector::ConfirmIterations);
+}
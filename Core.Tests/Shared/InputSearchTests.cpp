@@ -0,0 +1,91 @@
+#include "pch.h"
+#include <thread>
+#include "Shared/Emulator.h"
+#include "Shared/Movies/InputSearch.h"
+#include "Utilities/VirtualFile.h"
+#include "Core.Tests/Lynx/LynxUartTestRom.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+// =============================================================================
+// InputSearch Tests
+// =============================================================================
+// The Lynx test ROM sends its joystick state over ComLynx each time it changes
+// and stores the last byte received (looped back by the UART) at $11 - the
+// goal "[$11] == $7F" is reached on the frame A is pressed after a release.
+// =============================================================================
+
+namespace {
+	constexpr uint32_t LynxButtonA = 0x10;
+	constexpr uint32_t LynxButtonRight = 0x08;
+
+	class InputSearchTest : public ::testing::Test {
+	protected:
+		TestHomeFolder _home{"nexen_input_search_test"};
+		Emulator _emu;
+
+		void SetUp() override {
+			// The search's instances reload the game from its path - the ROM must be a file
+			vector<uint8_t> rom = BuildLynxUartTestRom();
+			string romPath = (_home.GetPath() / "uart.lnx").string();
+			ofstream romFile(romPath, std::ios::binary);
+			romFile.write((char*)rom.data(), rom.size());
+			romFile.close();
+
+			_emu.InitializeHeadless();
+			ASSERT_TRUE(_emu.LoadRom(VirtualFile(romPath), VirtualFile()));
+
+			// Let the program start and send the released joystick state
+			for (int i = 0; i < 5; i++) {
+				_emu.RunHeadlessFrame();
+			}
+		}
+
+		void TearDown() override {
+			_emu.Stop(false, true, false);
+			_emu.Release();
+		}
+
+		vector<InputSearchResult> Search(uint32_t threadCount) {
+			InputSearchConfig config = {};
+			config.Cpu = CpuType::Lynx;
+			config.Depth = 2;
+			config.Candidates = {0, LynxButtonA, LynxButtonRight};
+			config.GoalExpression = "[$11] == $7F";
+			config.ThreadCount = threadCount;
+
+			InputSearch search(&_emu);
+			EXPECT_TRUE(search.Start(config));
+			while (search.GetProgress().Running) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+
+			InputSearchProgress progress = search.GetProgress();
+			EXPECT_EQ(progress.DoneTasks, progress.TotalTasks);
+			return search.GetResults();
+		}
+	};
+}
+
+TEST_F(InputSearchTest, Lynx_FindsAllSequencesReachingTheGoal) {
+	vector<InputSearchResult> results = Search(1);
+	ASSERT_EQ(results.size(), 3u);
+
+	// Shortest first, then by button masks - sequences stop at the goal
+	EXPECT_EQ(results[0].Inputs, (vector<uint32_t>{LynxButtonA}));
+	EXPECT_EQ(results[0].FrameCount, 1u);
+	EXPECT_EQ(results[1].Inputs, (vector<uint32_t>{0, LynxButtonA}));
+	EXPECT_EQ(results[1].FrameCount, 2u);
+	EXPECT_EQ(results[2].Inputs, (vector<uint32_t>{LynxButtonRight, LynxButtonA}));
+	EXPECT_EQ(results[2].FrameCount, 2u);
+}
+
+TEST_F(InputSearchTest, Lynx_ResultsDontDependOnThreadCount) {
+	vector<InputSearchResult> expected = Search(1);
+	vector<InputSearchResult> results = Search(4);
+	ASSERT_EQ(results.size(), expected.size());
+	for (size_t i = 0; i < results.size(); i++) {
+		EXPECT_EQ(results[i].Inputs, expected[i].Inputs) << "result " << i;
+		EXPECT_EQ(results[i].FrameCount, expected[i].FrameCount) << "result " << i;
+		EXPECT_EQ(results[i].Score, expected[i].Score) << "result " << i;
+	}
+}
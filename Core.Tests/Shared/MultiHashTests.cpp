@@ -0,0 +1,102 @@
+#include "pch.h"
+#include <filesystem>
+#include "Utilities/MultiHash.h"
+#include "Utilities/CRC32.h"
+#include "Utilities/md5.h"
+#include "Utilities/sha1.h"
+
+class MultiHashTest : public ::testing::Test {
+protected:
+	static std::vector<uint8_t> MakeData(size_t size) {
+		std::vector<uint8_t> data(size);
+		for (size_t i = 0; i < size; i++) {
+			data[i] = static_cast<uint8_t>(i * 131 + (i >> 9));
+		}
+		return data;
+	}
+};
+
+// ===== Known Test Vectors =====
+
+TEST_F(MultiHashTest, Compute_Abc_KnownVectors) {
+	std::string data = "abc";
+	MultiHashResult result = MultiHash::Compute(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+	EXPECT_EQ(result.Crc32, 0x352441C2u);
+	EXPECT_EQ(result.Md5, "900150983CD24FB0D6963F7D28E17F72");
+	EXPECT_EQ(result.Sha1, "A9993E364706816ABA3E25717850C26C9CD0D89D");
+}
+
+TEST_F(MultiHashTest, Compute_Empty_KnownVectors) {
+	MultiHashResult result = MultiHash::Compute(nullptr, 0);
+	EXPECT_EQ(result.Crc32, 0u);
+	EXPECT_EQ(result.Md5, "D41D8CD98F00B204E9800998ECF8427E");
+	EXPECT_EQ(result.Sha1, "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709");
+}
+
+TEST_F(MultiHashTest, Compute_MillionA_KnownVectors) {
+	// Spans many blocks of each hash
+	std::vector<uint8_t> data(1000000, 'a');
+	MultiHashResult result = MultiHash::Compute(data.data(), data.size());
+	EXPECT_EQ(result.Md5, "7707D6AE4E027C70EEA2A935C2296F21");
+	EXPECT_EQ(result.Sha1, "34AA973CD4C4DAA4F61EEB2BDBAD27316534016F");
+	EXPECT_EQ(SHA1::GetHash(data), "34AA973CD4C4DAA4F61EEB2BDBAD27316534016F");
+}
+
+// ===== Consistency With The Individual Hashes =====
+
+TEST_F(MultiHashTest, Compute_LargeData_MatchesIndividualHashes) {
+	std::vector<uint8_t> data = MakeData(300000);
+	MultiHashResult result = MultiHash::Compute(data.data(), data.size());
+	EXPECT_EQ(result.Crc32, CRC32::GetCRC(data));
+	EXPECT_EQ(result.Md5, GetMd5Sum(data.data(), data.size()));
+	EXPECT_EQ(result.Sha1, SHA1::GetHash(data));
+}
+
+TEST_F(MultiHashTest, Update_SplitPoints_SameResult) {
+	std::vector<uint8_t> data = MakeData(70000);
+	MultiHashResult expected = MultiHash::Compute(data.data(), data.size());
+
+	MultiHash hash;
+	size_t splits[] = {0, 1, 63, 64, 65, 16384, 16385, 50000, data.size()};
+	for (size_t i = 1; i < std::size(splits); i++) {
+		hash.Update(data.data() + splits[i - 1], splits[i] - splits[i - 1]);
+	}
+	MultiHashResult result = hash.Finalize();
+	EXPECT_EQ(result.Crc32, expected.Crc32);
+	EXPECT_EQ(result.Md5, expected.Md5);
+	EXPECT_EQ(result.Sha1, expected.Sha1);
+}
+
+TEST_F(MultiHashTest, Finalize_ResetsState) {
+	std::string data = "abc";
+	MultiHash hash;
+	hash.Update(reinterpret_cast<const uint8_t*>("xyz"), 3);
+	(void)hash.Finalize();
+	hash.Update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+	EXPECT_EQ(hash.Finalize().Sha1, "A9993E364706816ABA3E25717850C26C9CD0D89D");
+}
+
+// ===== Files =====
+
+TEST_F(MultiHashTest, ComputeFile_MatchesCompute) {
+	std::vector<uint8_t> data = MakeData(2500000);
+	std::string path = (std::filesystem::temp_directory_path() / "nexen_multihash_test.bin").string();
+	{
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+
+	MultiHashResult result;
+	ASSERT_TRUE(MultiHash::ComputeFile(path, result));
+	std::filesystem::remove(path);
+
+	MultiHashResult expected = MultiHash::Compute(data.data(), data.size());
+	EXPECT_EQ(result.Crc32, expected.Crc32);
+	EXPECT_EQ(result.Md5, expected.Md5);
+	EXPECT_EQ(result.Sha1, expected.Sha1);
+}
+
+TEST_F(MultiHashTest, ComputeFile_MissingFile_ReturnsFalse) {
+	MultiHashResult result;
+	EXPECT_FALSE(MultiHash::ComputeFile((std::filesystem::temp_directory_path() / "nexen_multihash_missing.bin").string(), result));
+}
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include <filesystem>
+#include "Shared/Video/RawVideoCapture.h"
+#include "Shared/RenderedFrame.h"
+
+// =============================================================================
+// RawVideoCapture Unit Tests
+// =============================================================================
+// Frames/audio written by RawVideoCapture must be read back exactly (in the
+// same order) by RawVideoCaptureReader - the offline render depends on it.
+
+namespace {
+	string GetTempFile() {
+		return (std::filesystem::temp_directory_path() / "nexen_rawcapture_test.nxrc").string();
+	}
+
+	vector<uint16_t> MakeFrame(uint32_t width, uint32_t height, uint32_t frameNumber) {
+		vector<uint16_t> buffer(width * height);
+		for (uint32_t i = 0; i < buffer.size(); i++) {
+			// Mostly static, with a moving part
+			buffer[i] = (uint16_t)((i / width) * 3 + (i % width));
+			if ((i % width) / 8 == frameNumber % (width / 8)) {
+				buffer[i] = (uint16_t)(frameNumber * 0x123);
+			}
+		}
+		return buffer;
+	}
+}
+
+TEST(RawVideoCaptureTests, RoundTrip_FramesAndAudioInOrder) {
+	string filename = GetTempFile();
+	vector<vector<uint16_t>> frames;
+	{
+		RawVideoCapture capture;
+		ASSERT_TRUE(capture.Start(filename, ConsoleType::Nes, 48000, 60.0988));
+		for (uint32_t i = 0; i < 30; i++) {
+			// Resolution change halfway through (e.g. SNES hi-res)
+			uint32_t width = i < 15 ? 256 : 512;
+			frames.push_back(MakeFrame(width, 240, i));
+			RenderedFrame frame(frames.back().data(), width, 240, 1.0, i, {}, i % 3);
+			EXPECT_TRUE(capture.AddFrame(frame));
+
+			vector<int16_t> samples(800 * 2, (int16_t)i);
+			EXPECT_TRUE(capture.AddSound(samples.data(), 800, 48000));
+		}
+		EXPECT_FALSE(capture.AddSound(nullptr, 0, 44100));
+		capture.Stop();
+	}
+
+	RawVideoCaptureReader reader;
+	ASSERT_TRUE(reader.Open(filename));
+	EXPECT_EQ(reader.GetHeader().Console, ConsoleType::Nes);
+	EXPECT_EQ(reader.GetHeader().SampleRate, 48000u);
+	EXPECT_DOUBLE_EQ(reader.GetHeader().Fps, 60.0988);
+
+	RawCaptureChunkType type;
+	RawCaptureFrame frame;
+	vector<int16_t> samples;
+	for (uint32_t i = 0; i < 30; i++) {
+		ASSERT_TRUE(reader.ReadChunk(type, frame, samples));
+		ASSERT_EQ(type, RawCaptureChunkType::Frame);
+		EXPECT_EQ(frame.FrameNumber, i);
+		EXPECT_EQ(frame.VideoPhaseOffset, i % 3);
+		EXPECT_EQ(frame.Width, i < 15 ? 256u : 512u);
+		EXPECT_EQ(frame.Height, 240u);
+		EXPECT_EQ(frame.Buffer, frames[i]) << "frame " << i;
+
+		ASSERT_TRUE(reader.ReadChunk(type, frame, samples));
+		ASSERT_EQ(type, RawCaptureChunkType::Audio);
+		ASSERT_EQ(samples.size(), 1600u);
+		EXPECT_EQ(samples[0], (int16_t)i);
+	}
+	EXPECT_FALSE(reader.ReadChunk(type, frame, samples));
+
+	std::filesystem::remove(filename);
+}
+
+TEST(RawVideoCaptureTests, Open_RejectsOtherFiles) {
+	string filename = GetTempFile();
+	{
+		ofstream file(filename, std::ios::binary);
+		file << "RIFF1234AVI LIST";
+	}
+
+	RawVideoCaptureReader reader;
+	EXPECT_FALSE(reader.Open(filename));
+	std::filesystem::remove(filename);
+}
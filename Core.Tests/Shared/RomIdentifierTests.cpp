@@ -0,0 +1,142 @@
+#include "pch.h"
+#include <filesystem>
+#include "Shared/RomIdentifier.h"
+#include "Utilities/CRC32.h"
+#include "Utilities/sha1.h"
+#include "Core.Tests/Shared/TestHomeFolder.h"
+
+class RomIdentifierTest : public ::testing::Test {
+protected:
+	// The NES database is loaded from the home folder (there's none here, so no NES game is known)
+	TestHomeFolder _home{"nexen_rom_identifier_test"};
+	std::filesystem::path _folder = _home.GetPath();
+
+	std::string WriteFile(const std::string& name, const std::vector<uint8_t>& data) {
+		std::string path = (_folder / name).string();
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(data.data()), data.size());
+		return path;
+	}
+
+	static std::vector<uint8_t> MakeRom(const char* magic, size_t headerSize, size_t romSize) {
+		std::vector<uint8_t> data(headerSize + romSize);
+		memcpy(data.data(), magic, 4);
+		for (size_t i = headerSize; i < data.size(); i++) {
+			data[i] = static_cast<uint8_t>(i * 7 + (i >> 10));
+		}
+		return data;
+	}
+
+	/// <summary>Append 4 bytes to the data so that its CRC32 becomes the target CRC</summary>
+	static void ForgeCrc(std::vector<uint8_t>& data, uint32_t target) {
+		uint32_t table[256];
+		uint8_t topByteIndex[256];
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320 : 0);
+			}
+			table[i] = crc;
+			topByteIndex[crc >> 24] = (uint8_t)i;
+		}
+
+		// After 4 bytes, the CRC register only depends on the 4 table entries that were used - find
+		// them from the target (the top byte of each entry is unique), then pick the bytes that select them
+		uint8_t indexes[4];
+		uint32_t state = ~target;
+		for (int i = 3; i >= 0; i--) {
+			indexes[i] = topByteIndex[state >> 24];
+			state = (state ^ table[indexes[i]]) << 8;
+		}
+
+		state = ~CRC32::GetCRC(data);
+		for (int i = 0; i < 4; i++) {
+			data.push_back((uint8_t)(state ^ indexes[i]));
+			state = (state >> 8) ^ table[indexes[i]];
+		}
+	}
+};
+
+TEST_F(RomIdentifierTest, Identify_INes_ContentCrcSkipsHeader) {
+	std::vector<uint8_t> data = MakeRom("NES\x1A", 16, 0x8000 + 0x2000);
+	RomIdentification result = RomIdentifier::Identify(WriteFile("game.nes", data));
+
+	ASSERT_TRUE(result.Valid);
+	EXPECT_EQ(result.Size, data.size());
+	EXPECT_EQ(result.HeaderSize, 16u);
+	EXPECT_EQ(result.Hashes.Crc32, CRC32::GetCRC(data));
+	EXPECT_EQ(result.Hashes.Sha1, SHA1::GetHash(data));
+	EXPECT_EQ(result.ContentCrc32, CRC32::GetCRC(data.data() + 16, data.size() - 16));
+}
+
+TEST_F(RomIdentifierTest, Identify_INesTrainer_ContentCrcSkipsTrainer) {
+	std::vector<uint8_t> data = MakeRom("NES\x1A", 16 + 512, 0x4000);
+	data[6] = 0x04;
+	RomIdentification result = RomIdentifier::Identify(WriteFile("trainer.nes", data));
+
+	ASSERT_TRUE(result.Valid);
+	EXPECT_EQ(result.HeaderSize, 528u);
+	EXPECT_EQ(result.ContentCrc32, CRC32::GetCRC(data.data() + 528, data.size() - 528));
+}
+
+TEST_F(RomIdentifierTest, Identify_Lnx_ContentCrcSkipsHeader) {
+	// Larger than a read chunk, so the content CRC spans several chunks
+	std::vector<uint8_t> data = MakeRom("LYNX", 64, 512 * 1024);
+	RomIdentification result = RomIdentifier::Identify(WriteFile("game.lnx", data));
+
+	ASSERT_TRUE(result.Valid);
+	EXPECT_EQ(result.HeaderSize, 64u);
+	EXPECT_EQ(result.Hashes.Crc32, CRC32::GetCRC(data));
+	EXPECT_EQ(result.ContentCrc32, CRC32::GetCRC(data.data() + 64, data.size() - 64));
+}
+
+TEST_F(RomIdentifierTest, Identify_Lnx_KnownGame) {
+	// Content CRC of "APB - All Points Bulletin" in the Lynx database
+	constexpr uint32_t apbCrc = 0x5ad1d1f5;
+	std::vector<uint8_t> data = MakeRom("LYNX", 64, 0x1000);
+	std::vector<uint8_t> content(data.begin() + 64, data.end());
+	ForgeCrc(content, apbCrc);
+	data.resize(64);
+	data.insert(data.end(), content.begin(), content.end());
+
+	RomIdentification result = RomIdentifier::Identify(WriteFile("apb.lnx", data));
+
+	ASSERT_TRUE(result.Valid);
+	EXPECT_EQ(result.ContentCrc32, apbCrc);
+	EXPECT_TRUE(result.KnownGame);
+	EXPECT_EQ(result.DbSystem, "Lynx");
+	EXPECT_EQ(result.DbName, "APB - All Points Bulletin");
+}
+
+TEST_F(RomIdentifierTest, Identify_Headerless_ContentCrcIsFileCrc) {
+	std::vector<uint8_t> data = MakeRom("\x00\x01\x02\x03", 0, 4096);
+	RomIdentification result = RomIdentifier::Identify(WriteFile("game.sfc", data));
+
+	ASSERT_TRUE(result.Valid);
+	EXPECT_EQ(result.HeaderSize, 0u);
+	EXPECT_EQ(result.ContentCrc32, result.Hashes.Crc32);
+	EXPECT_FALSE(result.KnownGame);
+}
+
+TEST_F(RomIdentifierTest, Identify_MissingFile_NotValid) {
+	RomIdentification result = RomIdentifier::Identify((_folder / "missing.nes").string());
+	EXPECT_FALSE(result.Valid);
+	EXPECT_FALSE(result.KnownGame);
+}
+
+TEST_F(RomIdentifierTest, Identify_Batch_SameOrderAsPaths) {
+	std::vector<std::string> paths;
+	for (int i = 0; i < 10; i++) {
+		paths.push_back(WriteFile(std::format("rom{}.bin", i), std::vector<uint8_t>(1000 + i * 100, static_cast<uint8_t>(i))));
+	}
+	paths.push_back((_folder / "missing.bin").string());
+
+	std::vector<RomIdentification> results = RomIdentifier::Identify(paths, 4);
+	ASSERT_EQ(results.size(), paths.size());
+	for (size_t i = 0; i < paths.size(); i++) {
+		EXPECT_EQ(results[i].Path, paths[i]);
+		EXPECT_EQ(results[i].Hashes.Crc32, RomIdentifier::Identify(paths[i]).Hashes.Crc32);
+	}
+	EXPECT_EQ(results[3].Size, 1300u);
+	EXPECT_FALSE(results.back().Valid);
+}
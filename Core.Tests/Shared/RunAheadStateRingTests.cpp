@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "Shared/RunAheadStateRing.h"
+
+// =============================================================================
+// RunAheadStateRing Unit Tests
+// =============================================================================
+// Runs a mock console (whose state is a function of all the input it received)
+// with regular run-ahead (Emulator::RunFrameWithRunAhead) and preemptive
+// run-ahead (Emulator::RunFrameWithPreemptiveRunAhead): both must display the
+// exact same frames, while preemptive run-ahead only runs the frames again when
+// the input changes.
+
+namespace {
+	class MockConsole : public ISerializable {
+	public:
+		uint64_t State = 1;
+		uint32_t FrameCount = 0;
+		uint32_t Input = 0;
+		uint32_t FramesRun = 0;
+
+		void RunFrame() {
+			State = State * 0x100000001B3 ^ (Input + 1);
+			FrameCount++;
+			FramesRun++;
+		}
+
+		void Serialize(Serializer& s) override {
+			SV(State);
+			SV(FrameCount);
+		}
+	};
+
+	uint64_t RunRegular(MockConsole& console, Serializer& serializer, uint32_t runAheadFrames) {
+		serializer.ResetForFastSave(1);
+		console.RunFrame();
+		serializer.Stream(console, "", -1);
+		for (uint32_t i = 1; i < runAheadFrames; i++) {
+			console.RunFrame();
+		}
+		console.RunFrame();
+		uint64_t displayed = console.State;
+		serializer.ResetForFastLoad();
+		serializer.Stream(console, "", -1);
+		return displayed;
+	}
+
+	uint64_t RunPreemptive(MockConsole& console, RunAheadStateRing& ring, uint32_t runAheadFrames) {
+		uint64_t inputHash = console.Input;
+		bool runFramesAhead = false;
+		if (!ring.IsValid(runAheadFrames, console.FrameCount)) {
+			ring.Reset(runAheadFrames);
+			runFramesAhead = true;
+		} else if (ring.GetInputHash() != inputHash) {
+			runFramesAhead = ring.LoadOldest(console);
+		}
+
+		if (runFramesAhead) {
+			for (uint32_t i = 0; i < runAheadFrames; i++) {
+				ring.Save(console, 1);
+				console.RunFrame();
+			}
+		}
+		ring.Save(console, 1);
+		console.RunFrame();
+		ring.EndFrame(inputHash, console.FrameCount);
+		return console.State;
+	}
+
+	// Input held for several frames at a time, like a player would
+	uint32_t GetInput(uint32_t frame) {
+		return (frame / 7) % 3 == 0 ? 0 : (frame / 7) % 5;
+	}
+}
+
+TEST(RunAheadStateRingTests, Preemptive_MatchesRegularRunAhead) {
+	for (uint32_t runAheadFrames = 1; runAheadFrames <= 4; runAheadFrames++) {
+		MockConsole regular;
+		MockConsole preemptive;
+		Serializer serializer;
+		RunAheadStateRing ring;
+
+		for (uint32_t frame = 0; frame < 200; frame++) {
+			regular.Input = preemptive.Input = GetInput(frame);
+			ASSERT_EQ(RunRegular(regular, serializer, runAheadFrames), RunPreemptive(preemptive, ring, runAheadFrames))
+				<< "runAheadFrames=" << runAheadFrames << " frame=" << frame;
+		}
+	}
+}
+
+TEST(RunAheadStateRingTests, Preemptive_OnlyRunsFramesAgainOnInputChange) {
+	constexpr uint32_t RunAheadFrames = 3;
+	MockConsole console;
+	RunAheadStateRing ring;
+
+	// First frame runs the frames ahead
+	RunPreemptive(console, ring, RunAheadFrames);
+	EXPECT_EQ(console.FramesRun, RunAheadFrames + 1);
+
+	// Same input: 1 frame per host frame
+	for (int i = 0; i < 10; i++) {
+		RunPreemptive(console, ring, RunAheadFrames);
+	}
+	EXPECT_EQ(console.FramesRun, RunAheadFrames + 1 + 10);
+
+	// Input change: back to the confirmed frame, runs the frames ahead again
+	console.Input = 1;
+	uint32_t frameCount = console.FrameCount;
+	RunPreemptive(console, ring, RunAheadFrames);
+	EXPECT_EQ(console.FramesRun, RunAheadFrames + 1 + 10 + RunAheadFrames + 1);
+	EXPECT_EQ(console.FrameCount, frameCount + 1);
+}
+
+TEST(RunAheadStateRingTests, StateChange_InvalidatesRing) {
+	constexpr uint32_t RunAheadFrames = 2;
+	MockConsole console;
+	RunAheadStateRing ring;
+	RunPreemptive(console, ring, RunAheadFrames);
+	EXPECT_TRUE(ring.IsValid(RunAheadFrames, console.FrameCount));
+
+	// Loaded state/reset (frame count mismatch) or setting change
+	EXPECT_FALSE(ring.IsValid(RunAheadFrames, console.FrameCount + 5));
+	EXPECT_FALSE(ring.IsValid(RunAheadFrames + 1, console.FrameCount));
+
+	ring.Clear();
+	EXPECT_FALSE(ring.IsValid(RunAheadFrames, console.FrameCount));
+	EXPECT_FALSE(ring.LoadOldest(console));
+}
+
+TEST(RunAheadStateRingTests, LoadOldest_RestoresConfirmedFrame) {
+	MockConsole console;
+	RunAheadStateRing ring;
+	ring.Reset(3);
+
+	vector<uint64_t> states;
+	for (int i = 0; i < 5; i++) {
+		states.push_back(console.State);
+		ring.Save(console, 1);
+		console.RunFrame();
+	}
+	EXPECT_EQ(ring.GetCount(), 3u);
+
+	ASSERT_TRUE(ring.LoadOldest(console));
+	EXPECT_EQ(console.State, states[2]);
+	EXPECT_EQ(console.FrameCount, 2u);
+}
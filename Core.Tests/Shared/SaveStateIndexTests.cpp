@@ -0,0 +1,225 @@
+#include "pch.h"
+#include "Shared/SaveStateIndex.h"
+#include "Shared/SaveStateManager.h"
+#include <filesystem>
+#include <fstream>
+
+// =============================================================================
+// SaveStateIndex Unit Tests
+// =============================================================================
+// Tests for the per-folder save state sidecar index: persistence, stale entry
+// detection, pruning and thumbnail caching. Also covers the filename origin
+// parser shared by the index and GetSaveStateList.
+
+class SaveStateIndexTest : public ::testing::Test {
+protected:
+	std::filesystem::path _folder;
+
+	void SetUp() override {
+		_folder = std::filesystem::temp_directory_path() / "nexen_savestate_index_test";
+		std::filesystem::remove_all(_folder);
+		std::filesystem::create_directories(_folder);
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(_folder);
+	}
+
+	std::string MakeFile(const std::string& name, size_t size) {
+		std::string path = (_folder / name).string();
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		std::string data(size, 'x');
+		file.write(data.data(), data.size());
+		return path;
+	}
+
+	static SaveStateIndexEntry MakeEntry(uint64_t size, int64_t mtime) {
+		SaveStateIndexEntry entry;
+		entry.FileSize = size;
+		entry.LastWriteTime = mtime;
+		entry.Timestamp = 1234567890;
+		entry.Origin = SaveStateOrigin::Designated;
+		entry.SlotNumber = 7;
+		entry.IsPaused = true;
+		return entry;
+	}
+};
+
+// =============================================================================
+// Lookup & Persistence
+// =============================================================================
+
+TEST_F(SaveStateIndexTest, TryGet_MissingEntry_ReturnsFalse) {
+	SaveStateIndex index;
+	SaveStateIndexEntry entry;
+	EXPECT_FALSE(index.TryGet((_folder / "Rom_1.nexen-save").string(), 10, 20, entry));
+}
+
+TEST_F(SaveStateIndexTest, SetThenTryGet_ReturnsEntry) {
+	SaveStateIndex index;
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	index.Set(path, MakeEntry(10, 20));
+
+	SaveStateIndexEntry entry;
+	ASSERT_TRUE(index.TryGet(path, 10, 20, entry));
+	EXPECT_EQ(entry.Timestamp, 1234567890);
+	EXPECT_EQ(entry.Origin, SaveStateOrigin::Designated);
+	EXPECT_EQ(entry.SlotNumber, 7);
+	EXPECT_TRUE(entry.IsPaused);
+}
+
+TEST_F(SaveStateIndexTest, TryGet_SizeOrTimeChanged_ReturnsFalse) {
+	SaveStateIndex index;
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	index.Set(path, MakeEntry(10, 20));
+
+	SaveStateIndexEntry entry;
+	EXPECT_FALSE(index.TryGet(path, 11, 20, entry));
+	EXPECT_FALSE(index.TryGet(path, 10, 21, entry));
+}
+
+TEST_F(SaveStateIndexTest, Flush_RoundTripsThroughSidecarFile) {
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', 1, 2, 3 };
+	{
+		SaveStateIndex index;
+		SaveStateIndexEntry entry = MakeEntry(10, 20);
+		entry.ThumbnailPng = png;
+		index.Set(path, entry);
+		index.Flush();
+	}
+	EXPECT_TRUE(std::filesystem::exists(_folder / SaveStateIndex::IndexFilename));
+
+	SaveStateIndex reloaded;
+	SaveStateIndexEntry entry;
+	ASSERT_TRUE(reloaded.TryGet(path, 10, 20, entry));
+	EXPECT_EQ(entry.SlotNumber, 7);
+	EXPECT_TRUE(entry.IsPaused);
+	EXPECT_EQ(entry.ThumbnailPng, png);
+}
+
+TEST_F(SaveStateIndexTest, CorruptSidecar_IsIgnored) {
+	{
+		std::ofstream file(_folder / SaveStateIndex::IndexFilename, std::ios::binary);
+		file << "garbage";
+	}
+	SaveStateIndex index;
+	SaveStateIndexEntry entry;
+	EXPECT_FALSE(index.TryGet((_folder / "Rom_1.nexen-save").string(), 10, 20, entry));
+}
+
+// =============================================================================
+// Thumbnails
+// =============================================================================
+
+TEST_F(SaveStateIndexTest, Set_WithoutThumbnail_KeepsExistingThumbnail) {
+	SaveStateIndex index;
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	index.Set(path, MakeEntry(10, 20));
+	index.SetThumbnail(path, 10, 20, { 1, 2, 3 });
+	index.Set(path, MakeEntry(10, 20));
+
+	SaveStateIndexEntry entry;
+	ASSERT_TRUE(index.TryGet(path, 10, 20, entry));
+	EXPECT_EQ(entry.ThumbnailPng.size(), 3u);
+}
+
+TEST_F(SaveStateIndexTest, Set_FileChanged_DropsThumbnail) {
+	SaveStateIndex index;
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	index.Set(path, MakeEntry(10, 20));
+	index.SetThumbnail(path, 10, 20, { 1, 2, 3 });
+	index.Set(path, MakeEntry(10, 30));
+
+	SaveStateIndexEntry entry;
+	ASSERT_TRUE(index.TryGet(path, 10, 30, entry));
+	EXPECT_TRUE(entry.ThumbnailPng.empty());
+}
+
+TEST_F(SaveStateIndexTest, SetThumbnail_StaleStamp_IsIgnored) {
+	SaveStateIndex index;
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	index.Set(path, MakeEntry(10, 20));
+	index.SetThumbnail(path, 10, 99, { 1, 2, 3 });
+
+	SaveStateIndexEntry entry;
+	ASSERT_TRUE(index.TryGet(path, 10, 20, entry));
+	EXPECT_TRUE(entry.ThumbnailPng.empty());
+}
+
+// =============================================================================
+// Remove & Prune
+// =============================================================================
+
+TEST_F(SaveStateIndexTest, Remove_DeletesEntry) {
+	SaveStateIndex index;
+	std::string path = (_folder / "Rom_1.nexen-save").string();
+	index.Set(path, MakeEntry(10, 20));
+	index.Remove(path);
+
+	SaveStateIndexEntry entry;
+	EXPECT_FALSE(index.TryGet(path, 10, 20, entry));
+}
+
+TEST_F(SaveStateIndexTest, Prune_RemovesMissingFilesOnly) {
+	SaveStateIndex index;
+	std::string kept = (_folder / "Rom_1.nexen-save").string();
+	std::string removed = (_folder / "Rom_2.nexen-save").string();
+	index.Set(kept, MakeEntry(10, 20));
+	index.Set(removed, MakeEntry(10, 20));
+
+	index.Prune(_folder.string(), { "Rom_1.nexen-save" });
+
+	SaveStateIndexEntry entry;
+	EXPECT_TRUE(index.TryGet(kept, 10, 20, entry));
+	EXPECT_FALSE(index.TryGet(removed, 10, 20, entry));
+}
+
+TEST_F(SaveStateIndexTest, GetFileStamp_ReflectsFileChanges) {
+	std::string path = MakeFile("Rom_1.nexen-save", 16);
+	uint64_t size = 0;
+	int64_t mtime = 0;
+	ASSERT_TRUE(SaveStateIndex::GetFileStamp(path, size, mtime));
+	EXPECT_EQ(size, 16u);
+
+	MakeFile("Rom_1.nexen-save", 32);
+	uint64_t newSize = 0;
+	ASSERT_TRUE(SaveStateIndex::GetFileStamp(path, newSize, mtime));
+	EXPECT_EQ(newSize, 32u);
+
+	EXPECT_FALSE(SaveStateIndex::GetFileStamp((_folder / "missing.nexen-save").string(), size, mtime));
+}
+
+// =============================================================================
+// SaveStateManager::ParseOriginFromFilename
+// =============================================================================
+
+TEST(SaveStateOriginTests, ParsesAllFilenamePatterns) {
+	SaveStateOrigin origin;
+	uint8_t slot = 0;
+
+	SaveStateManager::ParseOriginFromFilename("Rom_auto.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Auto);
+	SaveStateManager::ParseOriginFromFilename("Rom_auto_2026-04-08_14-30-00.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Auto);
+	SaveStateManager::ParseOriginFromFilename("Rom_recent_03.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Recent);
+	SaveStateManager::ParseOriginFromFilename("Rom_lua_2026-04-08_14-30-00.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Lua);
+	SaveStateManager::ParseOriginFromFilename("Rom_2026-04-08_14-30-00.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Save);
+	EXPECT_EQ(slot, 0);
+}
+
+TEST(SaveStateOriginTests, ParsesDesignatedSlotNumbers) {
+	SaveStateOrigin origin;
+	uint8_t slot = 0;
+
+	SaveStateManager::ParseOriginFromFilename("Rom_[slot12]_2026-04-08_14-30-00.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Designated);
+	EXPECT_EQ(slot, 12);
+
+	SaveStateManager::ParseOriginFromFilename("Rom_designated_4_2026-04-08_14-30-00.nexen-save", origin, slot);
+	EXPECT_EQ(origin, SaveStateOrigin::Designated);
+	EXPECT_EQ(slot, 4);
+}
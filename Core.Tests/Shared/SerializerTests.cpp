@@ -632,3 +632,35 @@ TEST_F(SerializerTest, Array_Uint32Array) {
 
 	EXPECT_EQ(original, loaded);
 }
+
+// =============================================================================
+// FastBinary Tests
+// =============================================================================
+
+TEST_F(SerializerTest, FastBinary_LoadSharedSnapshot) {
+	MockConsoleState original;
+	original.cpu.pc = 0x8000;
+	original.cpu.cycles = -5;
+	original.ppu.scanline = 241;
+	original.ram[0x10] = 0x42;
+	original.frameCount = 60;
+
+	Serializer saver;
+	saver.ResetForFastSave(1);
+	saver.Stream(original, "", -1);
+	std::vector<uint8_t> snapshot = saver.GetData();
+
+	// Each loader takes a copy, so the snapshot can be loaded again (and by other loaders)
+	Serializer loader1;
+	Serializer loader2;
+	for (int i = 0; i < 2; i++) {
+		MockConsoleState loaded1;
+		MockConsoleState loaded2;
+		loader1.ResetForFastLoad(snapshot);
+		loader1.Stream(loaded1, "", -1);
+		loader2.ResetForFastLoad(snapshot);
+		loader2.Stream(loaded2, "", -1);
+		EXPECT_EQ(original, loaded1);
+		EXPECT_EQ(original, loaded2);
+	}
+}
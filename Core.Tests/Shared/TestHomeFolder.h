@@ -0,0 +1,39 @@
+#pragma once
+#include <filesystem>
+#include <stdexcept>
+#include "Utilities/FolderUtilities.h"
+
+/// <summary>
+/// Points the home folder at an empty temporary folder for the lifetime of the object
+/// (for tests that load ROMs or databases), then restores the previous home folder.
+/// </summary>
+class TestHomeFolder {
+private:
+	std::filesystem::path _folder;
+	std::string _previousFolder;
+
+public:
+	explicit TestHomeFolder(const std::string& name) {
+		try {
+			_previousFolder = FolderUtilities::GetHomeFolder();
+		} catch (std::runtime_error&) {
+			// No home folder set yet
+		}
+
+		_folder = std::filesystem::temp_directory_path() / name;
+		std::filesystem::remove_all(_folder);
+		std::filesystem::create_directories(_folder);
+		FolderUtilities::SetHomeFolder(_folder.string());
+	}
+
+	~TestHomeFolder() {
+		FolderUtilities::SetHomeFolder(_previousFolder);
+		std::error_code ec;
+		std::filesystem::remove_all(_folder, ec);
+	}
+
+	TestHomeFolder(const TestHomeFolder&) = delete;
+	TestHomeFolder& operator=(const TestHomeFolder&) = delete;
+
+	[[nodiscard]] const std::filesystem::path& GetPath() const { return _folder; }
+};
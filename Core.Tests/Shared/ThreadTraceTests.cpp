@@ -0,0 +1,98 @@
+#include "pch.h"
+#include <thread>
+#include "Utilities/ThreadTrace.h"
+
+// =============================================================================
+// Thread Trace Unit Tests
+// =============================================================================
+// The trace is global (like the threads it records), so each test starts a new
+// recording - events recorded before that are excluded from the output.
+
+namespace {
+	size_t CountOccurrences(const string& text, const string& pattern) {
+		size_t count = 0;
+		for (size_t pos = text.find(pattern); pos != string::npos; pos = text.find(pattern, pos + 1)) {
+			count++;
+		}
+		return count;
+	}
+}
+
+TEST(ThreadTraceTests, Disabled_RecordsNothing) {
+	ThreadTrace::SetEnabled(true);
+	ThreadTrace::SetEnabled(false);
+	{
+		ThreadTraceScope scope("DisabledSpan");
+	}
+	ThreadTrace::FlowStart("DisabledFlow", 1);
+
+	string trace = ThreadTrace::GetChromeTrace();
+	EXPECT_EQ(trace.find("DisabledSpan"), string::npos);
+	EXPECT_EQ(trace.find("DisabledFlow"), string::npos);
+}
+
+TEST(ThreadTraceTests, SpansAndFlows_AcrossThreads) {
+	ThreadTrace::SetEnabled(true);
+
+	std::thread producer([]() {
+		ThreadTrace::SetThreadName("Test Producer");
+		ThreadTraceScope scope("Produce");
+		ThreadTrace::FlowStart("TestItem", 42);
+	});
+	producer.join();
+
+	std::thread consumer([]() {
+		ThreadTrace::SetThreadName("Test Consumer");
+		ThreadTraceScope scope("Consume");
+		ThreadTrace::FlowEnd("TestItem", 42);
+	});
+	consumer.join();
+
+	ThreadTrace::SetEnabled(false);
+	string trace = ThreadTrace::GetChromeTrace();
+
+	// The threads ended, but their events are kept until the next recording starts
+	EXPECT_NE(trace.find("\"args\":{\"name\":\"Test Producer\"}"), string::npos);
+	EXPECT_NE(trace.find("\"args\":{\"name\":\"Test Consumer\"}"), string::npos);
+	EXPECT_NE(trace.find("\"name\":\"Produce\",\"cat\":\"nexen\",\"ph\":\"X\""), string::npos);
+	EXPECT_NE(trace.find("\"name\":\"Consume\",\"cat\":\"nexen\",\"ph\":\"X\""), string::npos);
+	EXPECT_NE(trace.find("\"cat\":\"TestItem\",\"ph\":\"s\",\"id\":42"), string::npos);
+	EXPECT_NE(trace.find("\"cat\":\"TestItem\",\"ph\":\"f\",\"bp\":\"e\",\"id\":42"), string::npos);
+
+	ThreadTrace::SetEnabled(true);
+	trace = ThreadTrace::GetChromeTrace();
+	EXPECT_EQ(trace.find("Test Producer"), string::npos);
+	EXPECT_EQ(trace.find("Produce"), string::npos);
+	ThreadTrace::SetEnabled(false);
+}
+
+TEST(ThreadTraceTests, Ring_KeepsLatestEvents) {
+	ThreadTrace::SetEnabled(true);
+	std::thread thread([]() {
+		for (uint32_t i = 0; i < ThreadTrace::RingSize + 100; i++) {
+			ThreadTrace::FlowStart(i < 100 ? "OldEvent" : "NewEvent", i);
+		}
+	});
+	thread.join();
+	ThreadTrace::SetEnabled(false);
+
+	string trace = ThreadTrace::GetChromeTrace();
+	EXPECT_EQ(CountOccurrences(trace, "\"name\":\"OldEvent\""), 0u);
+
+	// The oldest slot is skipped - the owner thread could be overwriting it while it's read
+	EXPECT_EQ(CountOccurrences(trace, "\"name\":\"NewEvent\""), ThreadTrace::RingSize - 1);
+}
+
+TEST(ThreadTraceTests, Output_IsValidJsonStructure) {
+	ThreadTrace::SetEnabled(true);
+	{
+		ThreadTraceScope scope("Quote\"Name");
+	}
+	ThreadTrace::SetEnabled(false);
+
+	string trace = ThreadTrace::GetChromeTrace();
+	EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+	EXPECT_NE(trace.find("\"name\":\"Quote\\\"Name\""), string::npos);
+	EXPECT_EQ(CountOccurrences(trace, "{"), CountOccurrences(trace, "}"));
+	EXPECT_EQ(trace.find(",\n]"), string::npos);
+}
@@ -0,0 +1,101 @@
+#include "pch.h"
+#include <atomic>
+#include "Utilities/Video/VideoFrameQueue.h"
+
+// =============================================================================
+// VideoFrameQueue Unit Tests
+// =============================================================================
+// The frame queue shared by the video recorders: frames must be written in
+// order, as they were when AddFrame was called, and Stop must write every
+// frame that is still queued.
+
+namespace {
+	constexpr uint32_t FrameSize = 64;
+
+	vector<uint8_t> MakeFrame(uint32_t index) {
+		vector<uint8_t> frame(FrameSize);
+		for (uint32_t i = 0; i < FrameSize; i++) {
+			frame[i] = (uint8_t)(index * 31 + i);
+		}
+		return frame;
+	}
+}
+
+TEST(VideoFrameQueueTests, Stop_WritesAllFramesInOrder) {
+	vector<vector<uint8_t>> written;
+	VideoFrameQueue queue;
+	queue.Start(FrameSize, "Test Writer", [&](uint8_t* frameBuffer) {
+		written.emplace_back(frameBuffer, frameBuffer + FrameSize);
+	});
+
+	constexpr uint32_t FrameCount = 100;
+	for (uint32_t i = 0; i < FrameCount; i++) {
+		vector<uint8_t> frame = MakeFrame(i);
+		queue.AddFrame(frame.data());
+		// The queue copies the frame - the caller's buffer can be reused right away
+		std::fill(frame.begin(), frame.end(), 0xFF);
+	}
+	queue.Stop();
+
+	ASSERT_EQ(written.size(), FrameCount);
+	for (uint32_t i = 0; i < FrameCount; i++) {
+		EXPECT_EQ(written[i], MakeFrame(i)) << "frame " << i;
+	}
+}
+
+TEST(VideoFrameQueueTests, AddFrame_BlocksWhenWriterIsBehind) {
+	std::mutex writerMutex;
+	std::atomic<uint32_t> writtenCount = 0;
+	std::unique_lock<std::mutex> blockWriter(writerMutex);
+
+	VideoFrameQueue queue;
+	queue.Start(FrameSize, "Test Writer", [&](uint8_t*) {
+		std::lock_guard<std::mutex> lock(writerMutex);
+		writtenCount++;
+	});
+
+	// The writer takes the first frame and blocks, MaxQueuedFrames more fill the queue
+	std::atomic<uint32_t> addedCount = 0;
+	std::thread producer([&]() {
+		for (uint32_t i = 0; i < VideoFrameQueue::MaxQueuedFrames + 2; i++) {
+			vector<uint8_t> frame = MakeFrame(i);
+			queue.AddFrame(frame.data());
+			addedCount++;
+		}
+	});
+
+	for (int i = 0; i < 500 && addedCount < VideoFrameQueue::MaxQueuedFrames + 1; i++) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(writtenCount.load(), 0u);
+	EXPECT_EQ(addedCount.load(), VideoFrameQueue::MaxQueuedFrames + 1);
+
+	blockWriter.unlock();
+	producer.join();
+	queue.Stop();
+	EXPECT_EQ(writtenCount.load(), VideoFrameQueue::MaxQueuedFrames + 2);
+}
+
+TEST(VideoFrameQueueTests, Restart_StartsWithEmptyQueue) {
+	uint32_t writtenCount = 0;
+	VideoFrameQueue queue;
+	vector<uint8_t> frame = MakeFrame(0);
+
+	queue.Start(FrameSize, "Test Writer", [&](uint8_t*) { writtenCount++; });
+	queue.AddFrame(frame.data());
+	queue.AddFrame(frame.data());
+	queue.Stop();
+	EXPECT_EQ(writtenCount, 2u);
+
+	// Stopping twice is a no-op, the next recording can use a different frame size
+	queue.Stop();
+	vector<uint8_t> largeFrame(FrameSize * 2, 0x42);
+	vector<uint8_t> written;
+	queue.Start(FrameSize * 2, "Test Writer", [&](uint8_t* frameBuffer) {
+		written.assign(frameBuffer, frameBuffer + FrameSize * 2);
+	});
+	queue.AddFrame(largeFrame.data());
+	queue.Stop();
+	EXPECT_EQ(written, largeFrame);
+}
@@ -0,0 +1,89 @@
+#include "pch.h"
+#include "Utilities/Video/ZmbvCodec.h"
+
+// =============================================================================
+// ZmbvCodec Unit Tests
+// =============================================================================
+// The motion search is split across threads, but the output must be identical
+// to the single-threaded encoder (same vectors, same xor data, same stream).
+
+namespace {
+	constexpr int Width = 512;
+	constexpr int Height = 448;
+
+	// Scrolling pattern with a moving sprite, so the motion search finds vectors
+	void DrawFrame(vector<uint32_t>& frame, int frameNumber) {
+		for (int y = 0; y < Height; y++) {
+			for (int x = 0; x < Width; x++) {
+				int sx = x + frameNumber * 3;
+				int sy = y + frameNumber;
+				frame[y * Width + x] = ((sx / 8 + sy / 8) & 1) ? 0xFF204080 : (0xFF000000 | (uint32_t)(sx * 7 + sy * 13));
+			}
+		}
+		for (int y = 0; y < 24; y++) {
+			for (int x = 0; x < 24; x++) {
+				frame[(100 + y) * Width + (frameNumber * 5 + x) % Width] = 0xFFFFFFFF;
+			}
+		}
+	}
+
+	vector<vector<uint8_t>> EncodeFrames(ZmbvCodec& codec, int frameCount) {
+		vector<uint32_t> frame(Width * Height);
+		vector<vector<uint8_t>> output;
+		for (int i = 0; i < frameCount; i++) {
+			DrawFrame(frame, i);
+			uint8_t* compressedData = nullptr;
+			int size = codec.CompressFrame(i % 30 == 0, (uint8_t*)frame.data(), &compressedData);
+			EXPECT_GT(size, 0);
+			output.emplace_back(compressedData, compressedData + size);
+		}
+		return output;
+	}
+
+	vector<vector<uint8_t>> EncodeFrames(uint32_t searchThreadCount, int frameCount) {
+		ZmbvCodec codec(searchThreadCount);
+		EXPECT_TRUE(codec.SetupCompress(Width, Height, 1));
+		return EncodeFrames(codec, frameCount);
+	}
+}
+
+TEST(ZmbvCodecTests, ParallelMotionSearch_MatchesSingleThreadedOutput) {
+	vector<vector<uint8_t>> expected = EncodeFrames(1, 40);
+	for (uint32_t threads : { 2u, 3u, 8u }) {
+		vector<vector<uint8_t>> output = EncodeFrames(threads, 40);
+		ASSERT_EQ(output.size(), expected.size());
+		for (size_t i = 0; i < output.size(); i++) {
+			ASSERT_EQ(output[i], expected[i]) << "threads=" << threads << " frame=" << i;
+		}
+	}
+}
+
+TEST(ZmbvCodecTests, ParallelMotionSearch_RestartedWorkersWaitForNextFrame) {
+	// The second setup restarts the workers after some searches were done, they must not run a search
+	// for an old generation
+	vector<vector<uint8_t>> expected = EncodeFrames(1, 10);
+	ZmbvCodec codec(4);
+	ASSERT_TRUE(codec.SetupCompress(Width, Height, 1));
+	EncodeFrames(codec, 5);
+	ASSERT_TRUE(codec.SetupCompress(Width, Height, 1));
+
+	vector<vector<uint8_t>> output = EncodeFrames(codec, 10);
+	ASSERT_EQ(output.size(), expected.size());
+	for (size_t i = 0; i < output.size(); i++) {
+		ASSERT_EQ(output[i], expected[i]) << "frame=" << i;
+	}
+}
+
+TEST(ZmbvCodecTests, UnchangedFrame_ProducesSmallDelta) {
+	ZmbvCodec codec(4);
+	ASSERT_TRUE(codec.SetupCompress(Width, Height, 1));
+
+	vector<uint32_t> frame(Width * Height);
+	DrawFrame(frame, 0);
+	uint8_t* compressedData = nullptr;
+	int keyframeSize = codec.CompressFrame(true, (uint8_t*)frame.data(), &compressedData);
+	int deltaSize = codec.CompressFrame(false, (uint8_t*)frame.data(), &compressedData);
+
+	EXPECT_EQ(compressedData[0] & 0x01, 0); // Not a keyframe
+	EXPECT_LT(deltaSize, keyframeSize / 20);
+}
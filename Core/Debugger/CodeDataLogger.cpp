@@ -14,6 +14,7 @@ CodeDataLogger::CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t
 	_cpuType = cpuType;
 	_memSize = memSize;
 	_romCrc32 = romCrc32;
+	_readOnlyFile = debugger->GetEmulator()->IsCdlFileSavingDisabled();
 	_cdlData = std::make_unique<uint8_t[]>(memSize);
 	Reset();
 
@@ -68,6 +69,10 @@ bool CodeDataLogger::LoadCdlFile(const string& cdlFilepath, bool autoResetCdl) {
 }
 
 bool CodeDataLogger::SaveCdlFile(const string& cdlFilepath) {
+	if (_readOnlyFile) {
+		return false;
+	}
+
 	ofstream cdlFile(cdlFilepath, ios::out | ios::binary);
 	if (cdlFile) {
 		cdlFile.write("CDLv2", 5);
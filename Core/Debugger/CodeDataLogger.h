@@ -48,6 +48,7 @@ protected:
 	MemoryType _memType = {};            ///< Memory type being tracked
 	uint32_t _memSize = 0;               ///< Memory size
 	uint32_t _romCrc32 = 0;              ///< ROM CRC32 for file validation
+	bool _readOnlyFile = false;          ///< Never save the CDL file (see Emulator::DisableCdlFileSaving)
 
 	/// <summary>
 	/// Load platform-specific CDL data.
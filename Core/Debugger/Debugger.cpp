@@ -7,6 +7,8 @@
 #include "Debugger/CodeDataLogger.h"
 #include "Debugger/Disassembler.h"
 #include "Debugger/DisassemblySearch.h"
+#include "Debugger/MemorySearch.h"
+#include "Debugger/DebuggerRefreshSnapshot.h"
 #include "Debugger/BreakpointManager.h"
 #include "Debugger/PpuTools.h"
 #include "Debugger/DebugBreakHelper.h"
@@ -91,6 +93,8 @@ Debugger::Debugger(Emulator* emu, IConsole* console) {
 	_memoryDumper = std::make_unique<MemoryDumper>(this);          // Memory viewing/editing
 	_disassembler = std::make_unique<Disassembler>(console, this); // Code disassembly
 	_disassemblySearch = std::make_unique<DisassemblySearch>(_disassembler.get(), _labelManager.get());  // Search in disassembly
+	_memorySearch = std::make_unique<MemorySearch>(_memoryDumper.get()); // RAM search
+	_refreshSnapshot = std::make_unique<DebuggerRefreshSnapshot>(this, emu); // Batched window refresh
 	_memoryAccessCounter = std::make_unique<MemoryAccessCounter>(this);  // Memory access tracking
 	_scriptManager = std::make_unique<ScriptManager>(this);        // Lua scripting
 	_traceLogSaver = std::make_unique<TraceLogFileSaver>();        // Trace log file output
@@ -865,6 +869,10 @@ void Debugger::ProcessEvent(EventType type, std::optional<CpuType> cpuTypeOpt) {
 			break;
 		}
 
+		case EventType::EndFrame:
+			_refreshSnapshot->ProcessEndFrame();
+			break;
+
 		case EventType::Reset:
 			Reset();
 			break;
@@ -22,6 +22,8 @@ class MemoryDumper;
 class MemoryAccessCounter;
 class Disassembler;
 class DisassemblySearch;
+class MemorySearch;
+class DebuggerRefreshSnapshot;
 class BreakpointManager;
 class PpuTools;
 class CodeDataLogger;
@@ -117,6 +119,8 @@ private:
 	unique_ptr<CodeDataLogger> _codeDataLogger;         ///< Code/data classification
 	unique_ptr<Disassembler> _disassembler;             ///< Multi-CPU disassembly
 	unique_ptr<DisassemblySearch> _disassemblySearch;   ///< Search disassembly
+	unique_ptr<MemorySearch> _memorySearch;             ///< RAM search (cheat finder)
+	unique_ptr<DebuggerRefreshSnapshot> _refreshSnapshot; ///< Batched debugger window refresh data
 	unique_ptr<LabelManager> _labelManager;             ///< Symbol/label database
 	unique_ptr<CdlManager> _cdlManager;                 ///< CDL file management
 
@@ -255,6 +259,8 @@ public:
 	[[nodiscard]] MemoryAccessCounter* GetMemoryAccessCounter() { return _memoryAccessCounter.get(); }
 	[[nodiscard]] Disassembler* GetDisassembler() { return _disassembler.get(); }
 	[[nodiscard]] DisassemblySearch* GetDisassemblySearch() { return _disassemblySearch.get(); }
+	[[nodiscard]] MemorySearch* GetMemorySearch() { return _memorySearch.get(); }
+	[[nodiscard]] DebuggerRefreshSnapshot* GetRefreshSnapshot() { return _refreshSnapshot.get(); }
 	[[nodiscard]] LabelManager* GetLabelManager() { return _labelManager.get(); }
 	[[nodiscard]] CdlManager* GetCdlManager() { return _cdlManager.get(); }
 	[[nodiscard]] ScriptManager* GetScriptManager() { return _scriptManager.get(); }
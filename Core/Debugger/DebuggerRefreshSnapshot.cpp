@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "Debugger/DebuggerRefreshSnapshot.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/Disassembler.h"
+#include "Debugger/MemoryDumper.h"
+#include "Shared/Emulator.h"
+
+namespace {
+	constexpr uint32_t AlignSection(uint32_t offset) {
+		return (offset + 7) & ~7u;
+	}
+}
+
+DebuggerRefreshSnapshot::DebuggerRefreshSnapshot(Debugger* debugger, Emulator* emu) {
+	_debugger = debugger;
+	_emu = emu;
+	_stateBuffer.resize(MaxStateSize / sizeof(uint64_t));
+}
+
+uint32_t DebuggerRefreshSnapshot::GetRequiredSize(const DebuggerRefreshRequest& request) {
+	uint32_t size = AlignSection(sizeof(DebuggerRefreshHeader));
+	size = AlignSection(size + std::min(request.CpuStateSize, MaxStateSize));
+	size = AlignSection(size + std::min(request.PpuStateSize, MaxStateSize));
+	size = AlignSection(size + request.DisassemblyRowCount * (uint32_t)sizeof(CodeLineData));
+	size = AlignSection(size + request.MemoryLength);
+	return size;
+}
+
+void DebuggerRefreshSnapshot::SetRequest(const DebuggerRefreshRequest& request) {
+	auto lock = _lock.AcquireSafe();
+	_request = request;
+	_hasRequest = true;
+	_hasFrameCapture = false;
+}
+
+void DebuggerRefreshSnapshot::ClearRequest() {
+	auto lock = _lock.AcquireSafe();
+	_hasRequest = false;
+	_hasFrameCapture = false;
+	for (Section& section : _sections) {
+		section.Data = {};
+	}
+	_codeLines = {};
+	_memoryBuffer = {};
+}
+
+void DebuggerRefreshSnapshot::ProcessEndFrame() {
+	// Unlocked check so frames don't touch the lock while the debugger windows are closed
+	if (!_hasRequest) {
+		return;
+	}
+
+	// Never stall emulation - if the UI is copying the previous snapshot, this frame is skipped
+	if (!_lock.TryAcquire(0)) {
+		return;
+	}
+
+	if (_hasRequest) {
+		Capture();
+		_hasFrameCapture = true;
+	}
+	_lock.Release();
+}
+
+void DebuggerRefreshSnapshot::UpdateSection(DebuggerRefreshSection type, const void* data, uint32_t size) {
+	Section& section = _sections[(int)type];
+	if (section.Generation != 0 && section.Data.size() == size && memcmp(section.Data.data(), data, size) == 0) {
+		return;
+	}
+
+	section.Data.assign((const uint8_t*)data, (const uint8_t*)data + size);
+	section.Generation = ++_lastGeneration;
+}
+
+void DebuggerRefreshSnapshot::Capture() {
+	_frameCount = _emu->GetFrameCount();
+
+	BaseState& state = *(BaseState*)_stateBuffer.data();
+	uint32_t cpuStateSize = std::min(_request.CpuStateSize, MaxStateSize);
+	if (cpuStateSize > 0) {
+		memset(_stateBuffer.data(), 0, MaxStateSize);
+		_debugger->GetCpuState(state, _request.Cpu);
+	}
+	UpdateSection(DebuggerRefreshSection::CpuState, _stateBuffer.data(), cpuStateSize);
+
+	uint32_t ppuStateSize = std::min(_request.PpuStateSize, MaxStateSize);
+	if (ppuStateSize > 0) {
+		memset(_stateBuffer.data(), 0, MaxStateSize);
+		_debugger->GetPpuState(state, _request.Cpu);
+	}
+	UpdateSection(DebuggerRefreshSection::PpuState, _stateBuffer.data(), ppuStateSize);
+
+	_codeLines.resize(_request.DisassemblyRowCount);
+	_disassemblyRowCount = 0;
+	if (_request.DisassemblyRowCount > 0) {
+		// Unused rows/characters are zeroed so an unchanged view always compares equal
+		memset((void*)_codeLines.data(), 0, _codeLines.size() * sizeof(CodeLineData));
+		_disassemblyRowCount = _debugger->GetDisassembler()->GetDisassemblyOutput(_request.Cpu, _request.DisassemblyLineIndex, _codeLines.data(), _request.DisassemblyRowCount);
+	}
+	UpdateSection(DebuggerRefreshSection::Disassembly, _codeLines.data(), (uint32_t)(_codeLines.size() * sizeof(CodeLineData)));
+
+	_memoryBuffer.resize(_request.MemoryLength);
+	if (_request.MemoryLength > 0) {
+		_debugger->GetMemoryDumper()->GetMemoryValues(_request.MemType, _request.MemoryStart, _request.MemoryStart + _request.MemoryLength - 1, _memoryBuffer.data());
+	}
+	UpdateSection(DebuggerRefreshSection::Memory, _memoryBuffer.data(), _request.MemoryLength);
+}
+
+uint32_t DebuggerRefreshSnapshot::GetSnapshot(uint8_t* buffer, uint32_t bufferSize) {
+	auto lock = _lock.AcquireSafe();
+	if (!_hasRequest) {
+		return 0;
+	}
+
+	// While execution is stopped, the state changes without frames ending (stepping, memory edits, etc.)
+	// Consoles that don't report frame ends to the debugger also fall back to capturing here.
+	if (!_hasFrameCapture || _debugger->IsExecutionStopped()) {
+		Capture();
+	}
+	_hasFrameCapture = false;
+
+	return WriteSnapshot(buffer, bufferSize);
+}
+
+uint32_t DebuggerRefreshSnapshot::WriteSnapshot(uint8_t* buffer, uint32_t bufferSize) {
+	uint32_t requiredSize = AlignSection(sizeof(DebuggerRefreshHeader));
+	for (Section& section : _sections) {
+		requiredSize = AlignSection(requiredSize + (uint32_t)section.Data.size());
+	}
+
+	if (!buffer || bufferSize < requiredSize) {
+		return requiredSize;
+	}
+
+	DebuggerRefreshHeader* header = (DebuggerRefreshHeader*)buffer;
+	bool validBuffer = header->Version == FormatVersion && header->TotalSize == requiredSize;
+
+	header->UpdatedSections = 0;
+	uint32_t offset = AlignSection(sizeof(DebuggerRefreshHeader));
+	for (int i = 0; i < (int)DebuggerRefreshSection::Count; i++) {
+		Section& section = _sections[i];
+		DebuggerRefreshSectionInfo& info = header->Sections[i];
+		uint32_t size = (uint32_t)section.Data.size();
+
+		if (!validBuffer || info.Generation != section.Generation || info.Offset != offset || info.Size != size) {
+			if (size > 0) {
+				memcpy(buffer + offset, section.Data.data(), size);
+			}
+			info.Generation = section.Generation;
+			info.Offset = offset;
+			info.Size = size;
+			header->UpdatedSections |= 1 << i;
+		}
+		offset = AlignSection(offset + size);
+	}
+
+	header->Version = FormatVersion;
+	header->TotalSize = requiredSize;
+	header->FrameCount = _frameCount;
+	header->DisassemblyRowCount = _disassemblyRowCount;
+	header->Reserved = 0;
+	return requiredSize;
+}
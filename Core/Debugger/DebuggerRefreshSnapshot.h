@@ -0,0 +1,142 @@
+#pragma once
+#include "pch.h"
+#include "Debugger/DebugTypes.h"
+#include "Shared/MemoryType.h"
+#include "Utilities/SimpleLock.h"
+
+class Debugger;
+class Emulator;
+enum class CpuType : uint8_t;
+
+/// <summary>
+/// Sections of a debugger refresh snapshot (bit index in DebuggerRefreshHeader::UpdatedSections).
+/// </summary>
+enum class DebuggerRefreshSection : uint32_t {
+	CpuState,
+	PpuState,
+	Disassembly,
+	Memory,
+
+	Count
+};
+
+/// <summary>
+/// Describes what a debugger view set needs on each refresh.
+/// </summary>
+/// <remarks>
+/// A size/count of 0 disables the corresponding section.
+/// </remarks>
+struct DebuggerRefreshRequest {
+	CpuType Cpu;                   ///< CPU whose state/disassembly is captured
+	uint32_t CpuStateSize;         ///< Size of the CPU state structure for Cpu
+	uint32_t PpuStateSize;         ///< Size of the PPU state structure for Cpu
+	uint32_t DisassemblyLineIndex; ///< First disassembly row (same as GetDisassemblyOutput's lineIndex)
+	uint32_t DisassemblyRowCount;  ///< Number of disassembly rows
+	MemoryType MemType;            ///< Memory type for the memory section
+	uint32_t MemoryStart;          ///< First address of the memory section
+	uint32_t MemoryLength;         ///< Number of bytes in the memory section
+};
+
+/// <summary>
+/// Location and version of one section inside a refresh snapshot buffer.
+/// </summary>
+struct DebuggerRefreshSectionInfo {
+	uint64_t Generation; ///< Incremented each time the section's content changes (0 = never captured)
+	uint32_t Offset;     ///< Offset of the section data from the start of the buffer
+	uint32_t Size;       ///< Size of the section data in bytes
+};
+
+/// <summary>
+/// Header at the start of a refresh snapshot buffer - the section data follows it.
+/// </summary>
+struct DebuggerRefreshHeader {
+	uint32_t Version;             ///< DebuggerRefreshSnapshot::FormatVersion once the buffer has been filled
+	uint32_t TotalSize;           ///< Size of the header + all sections
+	uint32_t FrameCount;          ///< Frame number at the time of the capture
+	uint32_t UpdatedSections;     ///< Bitmask of the sections written by the last call
+	uint32_t DisassemblyRowCount; ///< Number of valid rows in the disassembly section
+	uint32_t Reserved;
+	DebuggerRefreshSectionInfo Sections[(int)DebuggerRefreshSection::Count];
+};
+
+/// <summary>
+/// Captures everything a debugger view set needs into one buffer, once per frame.
+/// </summary>
+/// <remarks>
+/// Refreshing the debugger windows used to take one interop call (and one debugger request)
+/// for each of the CPU state, PPU state, disassembly rows and memory ranges.
+/// Instead, the UI registers a DebuggerRefreshRequest and then calls GetSnapshot() to fill a
+/// buffer it keeps between refreshes:
+/// - The sections are captured on the emulation thread at the end of each frame (or on demand
+///   while execution is stopped, since stepping and editing don't end frames)
+/// - Each section has a generation counter that only changes when its content changes
+/// - GetSnapshot() compares the generations already in the caller's buffer and only copies the
+///   sections that changed (UpdatedSections tells the caller which ones to re-parse)
+///
+/// Labels and comments are part of the disassembly rows, so label edits show up as a new
+/// disassembly generation.
+///
+/// The caller's buffer must be zero-initialized before its first use.
+/// </remarks>
+class DebuggerRefreshSnapshot {
+private:
+	/// <summary>Upper bound for any CPU/PPU state structure (the largest are a few hundred bytes)</summary>
+	static constexpr uint32_t MaxStateSize = 0x4000;
+
+	Debugger* _debugger = nullptr;
+	Emulator* _emu = nullptr;
+
+	bool _hasFrameCapture = false; ///< A capture was taken at the end of a frame and hasn't been read yet
+
+	vector<uint64_t> _stateBuffer;   ///< Scratch buffer for CPU/PPU states (8-byte aligned)
+	vector<CodeLineData> _codeLines; ///< Scratch buffer for disassembly rows
+	vector<uint8_t> _memoryBuffer;   ///< Scratch buffer for the memory section
+
+	void Capture();
+
+protected:
+	struct Section {
+		vector<uint8_t> Data;
+		uint64_t Generation = 0;
+	};
+
+	SimpleLock _lock;
+	DebuggerRefreshRequest _request = {};
+	atomic<bool> _hasRequest = false; ///< Written under the lock, also read without it by ProcessEndFrame's early exit
+
+	uint64_t _lastGeneration = 0; ///< Shared by all sections so a generation is never reused, even across requests
+	uint32_t _frameCount = 0;
+	uint32_t _disassemblyRowCount = 0;
+	Section _sections[(int)DebuggerRefreshSection::Count];
+
+	/// <summary>Stores a newly captured section, bumping its generation if the content changed</summary>
+	void UpdateSection(DebuggerRefreshSection section, const void* data, uint32_t size);
+
+	/// <summary>Copies the captured sections into the caller's buffer (lock must be held)</summary>
+	uint32_t WriteSnapshot(uint8_t* buffer, uint32_t bufferSize);
+
+public:
+	static constexpr uint32_t FormatVersion = 1;
+
+	DebuggerRefreshSnapshot(Debugger* debugger, Emulator* emu);
+
+	/// <summary>Sets what the snapshot contains (replaces any previous request)</summary>
+	void SetRequest(const DebuggerRefreshRequest& request);
+
+	/// <summary>Stops capturing (e.g. when the debugger windows are closed)</summary>
+	void ClearRequest();
+
+	/// <summary>Called on the emulation thread at the end of each frame</summary>
+	void ProcessEndFrame();
+
+	/// <summary>
+	/// Fills the caller's buffer with the latest snapshot, skipping the sections the buffer is already up to date for.
+	/// </summary>
+	/// <param name="buffer">Caller-owned buffer, kept between calls (may be null to query the size)</param>
+	/// <param name="bufferSize">Size of the buffer in bytes</param>
+	/// <returns>Required buffer size (nothing is written if bufferSize is smaller), or 0 if no request is set</returns>
+	uint32_t GetSnapshot(uint8_t* buffer, uint32_t bufferSize);
+
+	/// <summary>Returns the buffer size needed for the given request</summary>
+	[[nodiscard]] static uint32_t GetRequiredSize(const DebuggerRefreshRequest& request);
+};
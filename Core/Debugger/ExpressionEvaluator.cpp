@@ -293,10 +293,12 @@ string ExpressionEvaluator::GetNextToken(const string& expression, size_t& pos,
 		size_t opLen = 0;
 		for (size_t len = expression.size(); pos < len; pos++) {
 			c = static_cast<char>(std::tolower(static_cast<unsigned char>(expression[pos])));
-			if (opLen < sizeof(opBuf) - 1) {
-				opBuf[opLen] = c;
-				opLen++;
+			if (opLen == sizeof(opBuf) - 1) {
+				// No operator is longer than 2 characters
+				break;
 			}
+			opBuf[opLen] = c;
+			opLen++;
 			std::string_view operatorToken(opBuf, opLen);
 			if (output.empty() || std::binary_search(_operators.begin(), _operators.end(), operatorToken)) {
 				// If appending the next char results in a valid operator, append it (or if this is the first character)
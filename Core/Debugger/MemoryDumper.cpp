@@ -27,6 +27,8 @@
 #include "WS/WsMemoryManager.h"
 #include "Genesis/GenesisConsole.h"
 #include "Genesis/GenesisMemoryManager.h"
+#include "Lynx/LynxConsole.h"
+#include "Lynx/LynxMemoryManager.h"
 #include "Shared/Video/VideoDecoder.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugBreakHelper.h"
@@ -59,6 +61,8 @@ MemoryDumper::MemoryDumper(Debugger* debugger) {
 		_wsConsole = ws;
 	} else if (GenesisConsole* genesis = dynamic_cast<GenesisConsole*>(console)) {
 		_genesisConsole = genesis;
+	} else if (LynxConsole* lynx = dynamic_cast<LynxConsole*>(console)) {
+		_lynxConsole = lynx;
 	}
 
 	for (int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
@@ -120,6 +124,8 @@ uint32_t MemoryDumper::GetMemorySize(MemoryType type) {
 			return 0x100000;
 		case MemoryType::GenesisMemory:
 			return 0x1000000;
+		case MemoryType::LynxMemory:
+			return 0x10000;
 		case MemoryType::SnesRegister:
 			return 0x10000;
 		case MemoryType::SmsPort:
@@ -261,6 +267,16 @@ void MemoryDumper::GetMemoryState(MemoryType type, uint8_t* buffer) {
 			break;
 		}
 
+		case MemoryType::LynxMemory: {
+			if (_lynxConsole) {
+				LynxMemoryManager* memManager = _lynxConsole->GetMemoryManager();
+				for (int i = 0; i <= 0xFFFF; i++) {
+					buffer[i] = memManager->DebugRead(i);
+				}
+			}
+			break;
+		}
+
 		default:
 			uint8_t* src = GetMemoryBuffer(type);
 			if (src) {
@@ -343,6 +359,9 @@ void MemoryDumper::InternalSetMemoryValues(MemoryType originalMemoryType, uint32
 			case MemoryType::GenesisMemory:
 				_genesisConsole->GetMemoryManager()->DebugWrite8(address, value);
 				break;
+			case MemoryType::LynxMemory:
+				_lynxConsole->GetMemoryManager()->DebugWrite(address, value);
+				break;
 			case MemoryType::SpcDspRegisters:
 				_spc->DebugWriteDspReg(address, value);
 				break;
@@ -468,6 +487,8 @@ uint8_t MemoryDumper::InternalGetMemoryValue(MemoryType memoryType, uint32_t add
 			return _wsConsole->GetMemoryManager()->DebugRead(address);
 		case MemoryType::GenesisMemory:
 			return _genesisConsole->GetMemoryManager()->DebugRead8(address);
+		case MemoryType::LynxMemory:
+			return _lynxConsole->GetMemoryManager()->DebugRead(address);
 		case MemoryType::WsPort:
 			return _wsConsole->GetMemoryManager()->DebugReadPort<uint8_t>(address);
 
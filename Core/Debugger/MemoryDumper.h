@@ -16,6 +16,7 @@ class SmsConsole;
 class GbaConsole;
 class WsConsole;
 class GenesisConsole;
+class LynxConsole;
 class Emulator;
 class Debugger;
 
@@ -87,6 +88,7 @@ private:
 	GbaConsole* _gbaConsole = nullptr;                                  ///< Game Boy Advance console
 	WsConsole* _wsConsole = nullptr;                                    ///< WonderSwan console
 	GenesisConsole* _genesisConsole = nullptr;                          ///< Sega Genesis console
+	LynxConsole* _lynxConsole = nullptr;                                ///< Atari Lynx console
 	BaseCartridge* _cartridge = nullptr;                                ///< Active cartridge
 	Debugger* _debugger = nullptr;                                      ///< Main debugger
 	bool _isMemorySupported[DebugUtilities::GetMemoryTypeCount()] = {}; ///< Supported memory types
@@ -0,0 +1,296 @@
+#include "pch.h"
+#include <bit>
+#include "Debugger/MemorySearch.h"
+#include "Debugger/MemoryDumper.h"
+
+namespace {
+	template <typename T, bool bigEndian>
+	__forceinline T LoadValue(const uint8_t* src) {
+		if constexpr (sizeof(T) <= 2) {
+			// Assembled from bytes (rather than an unaligned load + byteswap) so the
+			// 64-lane kernels below auto-vectorize
+			using U = std::make_unsigned_t<T>;
+			U value = 0;
+			for (size_t i = 0; i < sizeof(T); i++) {
+				value |= (U)((U)src[bigEndian ? sizeof(T) - 1 - i : i] << (i * 8));
+			}
+			return (T)value;
+		} else {
+			uint32_t value;
+			memcpy(&value, src, sizeof(value));
+			if constexpr (bigEndian) {
+				value = std::byteswap(value);
+			}
+			return (T)value;
+		}
+	}
+
+	template <typename Func>
+	void DispatchOperator(MemorySearchOperator op, Func&& func) {
+		switch (op) {
+			case MemorySearchOperator::Equal: func(std::equal_to<>()); break;
+			case MemorySearchOperator::NotEqual: func(std::not_equal_to<>()); break;
+			case MemorySearchOperator::LessThan: func(std::less<>()); break;
+			case MemorySearchOperator::LessThanOrEqual: func(std::less_equal<>()); break;
+			case MemorySearchOperator::GreaterThan: func(std::greater<>()); break;
+			case MemorySearchOperator::GreaterThanOrEqual: func(std::greater_equal<>()); break;
+		}
+	}
+
+	__forceinline uint64_t PackMatches(const uint8_t (&matches)[64]) {
+		// Each byte is 0 or 1 - the multiply gathers the 8 bytes of a group into the top byte
+		uint64_t mask = 0;
+		for (int i = 0; i < 8; i++) {
+			uint64_t group;
+			memcpy(&group, matches + i * 8, 8);
+			mask |= ((group * 0x0102040810204080ULL) >> 56) << (i * 8);
+		}
+		return mask;
+	}
+
+	/// <summary>
+	/// Narrowest type that can hold every value of T plus the values just outside its range.
+	/// </summary>
+	/// <remarks>
+	/// Clamping the reference value to [min - 1, max + 1] doesn't change any comparison result,
+	/// and lets 8/16-bit kernels compare in 32-bit lanes instead of 64-bit ones.
+	/// </remarks>
+	template <typename T>
+	using CompareType = std::conditional_t<sizeof(T) < 4, int32_t, int64_t>;
+
+	template <typename T>
+	CompareType<T> ClampReference(int64_t value) {
+		constexpr int64_t minValue = (int64_t)std::numeric_limits<T>::min() - 1;
+		constexpr int64_t maxValue = (int64_t)std::numeric_limits<T>::max() + 1;
+		return (CompareType<T>)std::clamp(value, minValue, maxValue);
+	}
+}
+
+MemorySearch::MemorySearch(MemoryDumper* memoryDumper) {
+	_memoryDumper = memoryDumper;
+}
+
+void MemorySearch::TakeSnapshot(vector<uint8_t>& dst, const uint8_t* data) {
+	// Snapshots cover every address of the last candidate word plus a few bytes, so the
+	// kernels can always load 64 full values without bounds checks. The padding stays 0.
+	dst.assign(_candidates.size() * 64 + SnapshotPadding, 0);
+	if (_size > 0) {
+		memcpy(dst.data(), data, _size);
+	}
+}
+
+void MemorySearch::Reset(MemoryType memoryType) {
+	uint32_t size = _memoryDumper->GetMemorySize(memoryType);
+	vector<uint8_t> data(size);
+	if (size > 0) {
+		_memoryDumper->GetMemoryState(memoryType, data.data());
+	}
+	Reset(memoryType, data.data(), size);
+}
+
+void MemorySearch::Reset(MemoryType memoryType, const uint8_t* data, uint32_t size) {
+	_memoryType = memoryType;
+	_size = size;
+
+	_candidates.assign((size + 63) / 64, ~0ULL);
+	if (size & 63) {
+		_candidates.back() = (1ULL << (size & 63)) - 1;
+	}
+	_candidateCount = size;
+	UpdateCandidatePrefix();
+
+	TakeSnapshot(_current, data);
+	_prevRefresh = _current;
+	_searchSnapshot = _current;
+	_undoHistory.clear();
+}
+
+void MemorySearch::Refresh() {
+	if (_memoryDumper->GetMemorySize(_memoryType) != _size) {
+		// Memory size changed (e.g. a different game was loaded)
+		Reset(_memoryType);
+		return;
+	}
+
+	std::swap(_prevRefresh, _current);
+	if (_size > 0) {
+		_memoryDumper->GetMemoryState(_memoryType, _current.data());
+	}
+}
+
+void MemorySearch::Refresh(const uint8_t* data) {
+	std::swap(_prevRefresh, _current);
+	if (_size > 0) {
+		memcpy(_current.data(), data, _size);
+	}
+}
+
+void MemorySearch::UpdateCandidatePrefix() {
+	_candidatePrefix.resize(_candidates.size());
+	uint32_t count = 0;
+	for (size_t i = 0; i < _candidates.size(); i++) {
+		_candidatePrefix[i] = count;
+		count += std::popcount(_candidates[i]);
+	}
+	_candidateCount = count;
+}
+
+template <typename T, bool bigEndian, typename Compare>
+void MemorySearch::FilterAgainstSnapshot(const uint8_t* reference, Compare cmp) {
+	const uint8_t* current = _current.data();
+	for (size_t w = 0; w < _candidates.size(); w++) {
+		uint64_t candidates = _candidates[w];
+		if (candidates == 0) {
+			continue;
+		}
+
+		size_t base = w * 64;
+		uint8_t matches[64];
+		for (int i = 0; i < 64; i++) {
+			matches[i] = cmp(LoadValue<T, bigEndian>(current + base + i), LoadValue<T, bigEndian>(reference + base + i));
+		}
+		_candidates[w] = candidates & PackMatches(matches);
+	}
+}
+
+template <typename T, bool bigEndian, typename Compare>
+void MemorySearch::FilterAgainstValue(int64_t value, Compare cmp) {
+	const uint8_t* current = _current.data();
+	CompareType<T> reference = ClampReference<T>(value);
+	for (size_t w = 0; w < _candidates.size(); w++) {
+		uint64_t candidates = _candidates[w];
+		if (candidates == 0) {
+			continue;
+		}
+
+		size_t base = w * 64;
+		uint8_t matches[64];
+		for (int i = 0; i < 64; i++) {
+			matches[i] = cmp((CompareType<T>)LoadValue<T, bigEndian>(current + base + i), reference);
+		}
+		_candidates[w] = candidates & PackMatches(matches);
+	}
+}
+
+template <typename T, bool bigEndian>
+void MemorySearch::ApplyFilter(const MemorySearchFilter& filter) {
+	DispatchOperator(filter.Operator, [&](auto cmp) {
+		switch (filter.CompareTo) {
+			case MemorySearchCompareTo::PreviousSearchValue:
+				FilterAgainstSnapshot<T, bigEndian>(_undoHistory.back().SearchSnapshot.data(), cmp);
+				break;
+
+			case MemorySearchCompareTo::PreviousRefreshValue:
+				FilterAgainstSnapshot<T, bigEndian>(_prevRefresh.data(), cmp);
+				break;
+
+			case MemorySearchCompareTo::SpecificValue:
+				FilterAgainstValue<T, bigEndian>(filter.SpecificValue, cmp);
+				break;
+
+			case MemorySearchCompareTo::SpecificAddress: {
+				int64_t value = 0;
+				if (filter.SpecificAddress < _size) {
+					value = LoadValue<T, bigEndian>(_current.data() + filter.SpecificAddress);
+				}
+				FilterAgainstValue<T, bigEndian>(value, cmp);
+				break;
+			}
+		}
+	});
+}
+
+uint32_t MemorySearch::ApplyFilter(const MemorySearchFilter& filter) {
+	// The undo step takes ownership of the search snapshot, which is replaced by _current below
+	_undoHistory.push_back({ _candidates, std::move(_searchSnapshot) });
+
+	switch (filter.ValueSize) {
+		default:
+		case MemorySearchValueSize::Byte:
+			if (filter.IsSigned) {
+				ApplyFilter<int8_t, false>(filter);
+			} else {
+				ApplyFilter<uint8_t, false>(filter);
+			}
+			break;
+
+		case MemorySearchValueSize::Word:
+			if (filter.IsSigned) {
+				filter.BigEndian ? ApplyFilter<int16_t, true>(filter) : ApplyFilter<int16_t, false>(filter);
+			} else {
+				filter.BigEndian ? ApplyFilter<uint16_t, true>(filter) : ApplyFilter<uint16_t, false>(filter);
+			}
+			break;
+
+		case MemorySearchValueSize::Dword:
+			if (filter.IsSigned) {
+				filter.BigEndian ? ApplyFilter<int32_t, true>(filter) : ApplyFilter<int32_t, false>(filter);
+			} else {
+				filter.BigEndian ? ApplyFilter<uint32_t, true>(filter) : ApplyFilter<uint32_t, false>(filter);
+			}
+			break;
+	}
+
+	UpdateCandidatePrefix();
+	_searchSnapshot = _current;
+	return _candidateCount;
+}
+
+bool MemorySearch::Undo() {
+	if (_undoHistory.empty()) {
+		return false;
+	}
+
+	UndoStep& step = _undoHistory.back();
+	_candidates = std::move(step.Candidates);
+	_searchSnapshot = std::move(step.SearchSnapshot);
+	_undoHistory.pop_back();
+	UpdateCandidatePrefix();
+	return true;
+}
+
+uint32_t MemorySearch::ReadValue(const vector<uint8_t>& snapshot, uint32_t address, MemorySearchValueSize size, bool bigEndian) const {
+	const uint8_t* src = snapshot.data() + address;
+	switch (size) {
+		default:
+		case MemorySearchValueSize::Byte: return *src;
+		case MemorySearchValueSize::Word: return bigEndian ? LoadValue<uint16_t, true>(src) : LoadValue<uint16_t, false>(src);
+		case MemorySearchValueSize::Dword: return bigEndian ? LoadValue<uint32_t, true>(src) : LoadValue<uint32_t, false>(src);
+	}
+}
+
+uint32_t MemorySearch::GetResults(uint32_t offset, MemorySearchResult results[], uint32_t maxCount, MemorySearchValueSize valueSize, bool bigEndian) const {
+	if (offset >= _candidateCount || maxCount == 0) {
+		return 0;
+	}
+
+	// Find the word that contains the offset-th candidate
+	auto it = std::upper_bound(_candidatePrefix.begin(), _candidatePrefix.end(), offset);
+	size_t w = (it - _candidatePrefix.begin()) - 1;
+	uint64_t bits = _candidates[w];
+
+	// Skip the candidates of that word that are before the offset
+	for (uint32_t skip = offset - _candidatePrefix[w]; skip > 0; skip--) {
+		bits &= bits - 1;
+	}
+
+	uint32_t count = 0;
+	while (count < maxCount) {
+		while (bits == 0) {
+			if (++w >= _candidates.size()) {
+				return count;
+			}
+			bits = _candidates[w];
+		}
+
+		uint32_t address = (uint32_t)(w * 64) + std::countr_zero(bits);
+		bits &= bits - 1;
+
+		MemorySearchResult& result = results[count++];
+		result.Address = address;
+		result.Value = ReadValue(_current, address, valueSize, bigEndian);
+		result.PrevRefreshValue = ReadValue(_prevRefresh, address, valueSize, bigEndian);
+		result.PrevSearchValue = ReadValue(_searchSnapshot, address, valueSize, bigEndian);
+	}
+	return count;
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include "pch.h"
+#include "Shared/MemoryType.h"
+
+class MemoryDumper;
+
+/// <summary>
+/// Size of the values compared by a memory search filter (matches the UI's MemorySearchValueSize).
+/// </summary>
+enum class MemorySearchValueSize : uint8_t {
+	Byte = 1,
+	Word = 2,
+	Dword = 4
+};
+
+/// <summary>
+/// Value a memory search filter compares the current value against.
+/// </summary>
+enum class MemorySearchCompareTo : uint8_t {
+	PreviousSearchValue,  ///< Value when the last filter was applied
+	PreviousRefreshValue, ///< Value before the last Refresh()
+	SpecificValue,        ///< Constant value
+	SpecificAddress       ///< Current value at another address
+};
+
+/// <summary>
+/// Comparison operator for memory search filters.
+/// </summary>
+enum class MemorySearchOperator : uint8_t {
+	Equal,
+	NotEqual,
+	LessThan,
+	LessThanOrEqual,
+	GreaterThan,
+	GreaterThanOrEqual
+};
+
+/// <summary>
+/// Parameters for a single narrowing pass.
+/// </summary>
+struct MemorySearchFilter {
+	MemorySearchValueSize ValueSize; ///< Value width
+	bool IsSigned;                   ///< Compare values as signed integers
+	bool BigEndian;                  ///< Multi-byte values are stored big-endian
+	MemorySearchCompareTo CompareTo; ///< Comparison target
+	MemorySearchOperator Operator;   ///< Comparison operator
+	int64_t SpecificValue;           ///< Used with CompareTo::SpecificValue
+	uint32_t SpecificAddress;        ///< Used with CompareTo::SpecificAddress
+};
+
+/// <summary>
+/// Single row of memory search results.
+/// </summary>
+struct MemorySearchResult {
+	uint32_t Address;
+	uint32_t Value;            ///< Current value
+	uint32_t PrevRefreshValue; ///< Value before the last Refresh()
+	uint32_t PrevSearchValue;  ///< Value when the last filter was applied
+};
+
+/// <summary>
+/// Native RAM search (cheat finder) session over a single memory type.
+/// </summary>
+/// <remarks>
+/// Architecture:
+/// - Three snapshots of the memory type: current, previous refresh and last search
+/// - Candidate addresses are stored as a bitset (1 bit per address)
+/// - Each filter clears the bits of candidates that do not match, and records an undo step
+///
+/// Performance:
+/// - Filters are evaluated 64 addresses at a time into a match mask, using branch-free
+///   kernels specialized per value type/endianness/operator (auto-vectorized)
+/// - 64-address blocks with no remaining candidates are skipped, so narrowing passes get
+///   cheaper as the candidate list shrinks
+/// - Results are paged: a per-word prefix count locates the Nth candidate without scanning
+///
+/// Values that extend past the end of memory read the missing bytes as 0 (same as the UI).
+/// </remarks>
+class MemorySearch {
+private:
+	/// <summary>Extra snapshot bytes so multi-byte loads at the last address stay in bounds</summary>
+	static constexpr uint32_t SnapshotPadding = 3;
+
+	struct UndoStep {
+		vector<uint64_t> Candidates;
+		vector<uint8_t> SearchSnapshot;
+	};
+
+	MemoryDumper* _memoryDumper = nullptr;
+	MemoryType _memoryType = {};
+	uint32_t _size = 0;
+
+	vector<uint8_t> _current;        ///< Latest memory snapshot
+	vector<uint8_t> _prevRefresh;    ///< Snapshot before the latest Refresh()
+	vector<uint8_t> _searchSnapshot; ///< Snapshot at the time of the last filter
+
+	vector<uint64_t> _candidates;      ///< 1 bit per address, set if the address is still a candidate
+	vector<uint32_t> _candidatePrefix; ///< Number of candidates before each word of _candidates
+	uint32_t _candidateCount = 0;
+
+	vector<UndoStep> _undoHistory;
+
+	void UpdateCandidatePrefix();
+	void TakeSnapshot(vector<uint8_t>& dst, const uint8_t* data);
+	[[nodiscard]] uint32_t ReadValue(const vector<uint8_t>& snapshot, uint32_t address, MemorySearchValueSize size, bool bigEndian) const;
+
+	template <typename T, bool bigEndian>
+	void ApplyFilter(const MemorySearchFilter& filter);
+
+	template <typename T, bool bigEndian, typename Compare>
+	void FilterAgainstSnapshot(const uint8_t* reference, Compare cmp);
+
+	template <typename T, bool bigEndian, typename Compare>
+	void FilterAgainstValue(int64_t value, Compare cmp);
+
+public:
+	MemorySearch(MemoryDumper* memoryDumper);
+
+	/// <summary>Starts a new search over the given memory type (all addresses are candidates)</summary>
+	void Reset(MemoryType memoryType);
+
+	/// <summary>Starts a new search using the given memory contents</summary>
+	void Reset(MemoryType memoryType, const uint8_t* data, uint32_t size);
+
+	/// <summary>Takes a new snapshot of the memory (the previous one becomes the "previous refresh" values)</summary>
+	void Refresh();
+
+	/// <summary>Refreshes using the given memory contents (must be GetMemorySize() bytes)</summary>
+	void Refresh(const uint8_t* data);
+
+	/// <summary>
+	/// Removes all candidates that do not match the filter, then makes the current
+	/// snapshot the "previous search" values.
+	/// </summary>
+	/// <returns>Number of remaining candidates</returns>
+	uint32_t ApplyFilter(const MemorySearchFilter& filter);
+
+	/// <summary>Reverts the last ApplyFilter call</summary>
+	/// <returns>False if there is nothing to undo</returns>
+	bool Undo();
+
+	[[nodiscard]] bool CanUndo() const { return !_undoHistory.empty(); }
+	[[nodiscard]] MemoryType GetMemoryType() const { return _memoryType; }
+	[[nodiscard]] uint32_t GetMemorySize() const { return _size; }
+	[[nodiscard]] uint32_t GetCandidateCount() const { return _candidateCount; }
+
+	/// <summary>
+	/// Gets a page of candidates, in address order.
+	/// </summary>
+	/// <param name="offset">Index of the first candidate to return</param>
+	/// <param name="results">Output array</param>
+	/// <param name="maxCount">Size of the output array</param>
+	/// <param name="valueSize">Size of the values to return</param>
+	/// <param name="bigEndian">Multi-byte values are stored big-endian</param>
+	/// <returns>Number of results written</returns>
+	uint32_t GetResults(uint32_t offset, MemorySearchResult results[], uint32_t maxCount, MemorySearchValueSize valueSize, bool bigEndian) const;
+};
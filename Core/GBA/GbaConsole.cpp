@@ -311,6 +311,8 @@ void GbaConsole::RunFrame() {
 	uint32_t frameCount = _ppu->GetFrameCount();
 	uint32_t& newCount = _ppu->GetState().FrameCount;
 
+	_cpu->SetIdleLoopSkip(_emu->IsIdleLoopSkipAllowed());
+
 	if (_emu->IsDebugging()) {
 		if (_memoryManager->UseInlineHalt()) {
 			while (frameCount == newCount) {
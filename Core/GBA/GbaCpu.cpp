@@ -123,6 +123,26 @@ void GbaCpu::ReloadPipeline() {
 	pipe.Fetch.OpCode = ReadCode(pipe.Mode, pipe.Fetch.Address);
 }
 
+void GbaCpu::ProcessIdleLoopBranch() {
+	// Called before the pipeline is reloaded: R15 contains the branch target
+	uint64_t stateHash = IdleLoopDetector::HashState(_state.R, 15, _state.CPSR.ToInt32());
+	_idleLoopDetected = _idleLoopDetector.ProcessBranch(_state.Pipeline.Execute.Address, _state.R[15] & ~0x01, stateHash, _idleLoopSideEffects, _memoryManager->GetMasterClock());
+}
+
+void GbaCpu::SkipIdleLoop() {
+	_idleLoopDetected = false;
+	if (_state.Stopped || (_hasPendingIrq && !_state.CPSR.IrqDisable) || _state.Pipeline.Execute.Address != _idleLoopDetector.GetLoopStart()) {
+		// Halted by the loop's last instruction, or an IRQ is pending/was just processed
+		return;
+	}
+
+	// The pipeline holds the loop's first instruction, which is the state every iteration starts from
+	uint64_t skipped = _memoryManager->SkipIdleLoop(_idleLoopDetector.GetLoopStart());
+	_idleLoopDetector.ProcessSkippedCycles(skipped);
+	_idleLoopSkippedCycles += skipped;
+	_hasPendingIrq = _memoryManager->HasPendingIrq();
+}
+
 void GbaCpu::CheckForIrqs() {
 	uint32_t originalPc = _state.Pipeline.Execute.Address;
 	bool thumb = _state.CPSR.Thumb;
@@ -154,7 +174,7 @@ uint32_t GbaCpu::ReadCode(GbaAccessModeVal mode, uint32_t addr) {
 		_ldmGlitch--;
 	}
 
-	uint32_t value = _memoryManager->Read(mode, addr);
+	uint32_t value = _memoryManager->ReadCode(mode, addr);
 	_hasPendingIrq = _memoryManager->HasPendingIrq();
 
 	// Next access should be sequential
@@ -174,6 +194,14 @@ uint32_t GbaCpu::Read(GbaAccessModeVal mode, uint32_t addr) {
 	if (_ldmGlitch) [[unlikely]] {
 		_ldmGlitch--;
 	}
+	if (_idleLoopSkipEnabled) {
+		// Reads from IO registers (timers, sound, serial, etc.) and save media (EEPROM/flash status) can change
+		// on every access or over time, so a loop that polls them must run normally
+		uint8_t bank = addr >> 24;
+		if ((bank == 0x04 && !IsIdleLoopSafeRegister(addr)) || bank >= 0x0D) {
+			_idleLoopSideEffects++;
+		}
+	}
 	uint32_t value = _memoryManager->Read(mode, addr);
 	_hasPendingIrq = _memoryManager->HasPendingIrq();
 	return value;
@@ -190,6 +218,7 @@ void GbaCpu::Write(GbaAccessModeVal mode, uint32_t addr, uint32_t value) {
 	if (_ldmGlitch) [[unlikely]] {
 		_ldmGlitch--;
 	}
+	_idleLoopSideEffects++;
 	_memoryManager->Write(mode, addr, value);
 	_hasPendingIrq = _memoryManager->HasPendingIrq();
 #else
@@ -434,4 +463,9 @@ void GbaCpu::Serialize(Serializer& s) {
 
 	SV(_ldmGlitch);
 	SV(_hasPendingIrq);
+
+	if (!s.IsSaving()) {
+		_idleLoopDetector.Reset();
+		_idleLoopDetected = false;
+	}
 }
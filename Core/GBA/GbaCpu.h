@@ -10,6 +10,7 @@
 #include "GBA/GbaMemoryManager.h"
 #include "Shared/Emulator.h"
 #include "Debugger/DebugTypes.h"
+#include "Shared/IdleLoopDetector.h"
 #include "Utilities/ISerializable.h"
 
 class GbaMemoryManager;
@@ -65,6 +66,12 @@ private:
 	uint8_t _ldmGlitch = 0;        ///< LDM register banking glitch state
 	bool _hasPendingIrq = false;   ///< Interrupt request pending
 
+	IdleLoopDetector _idleLoopDetector;  ///< Detects polling loops that can be skipped
+	uint32_t _idleLoopSideEffects = 0;   ///< Number of bus accesses with side effects (writes, volatile reads)
+	bool _idleLoopSkipEnabled = false;   ///< Idle loop skipping allowed for this frame
+	bool _idleLoopDetected = false;      ///< The last branch completed an idle loop iteration
+	uint64_t _idleLoopSkippedCycles = 0; ///< Total master clocks skipped (not saved in save states)
+
 	GbaMemoryManager* _memoryManager = nullptr;  ///< Memory bus interface
 	GbaRomPrefetch* _prefetch = nullptr;         ///< ROM prefetch buffer
 	Emulator* _emu = nullptr;                    ///< Emulator for debugger hooks
@@ -177,6 +184,26 @@ private:
 	void ProcessException(GbaCpuMode mode, GbaCpuVector vector);
 	void CheckForIrqs();
 
+	void ProcessIdleLoopBranch();
+	void SkipIdleLoop();
+
+	/// IO registers a polling loop can read without side effects - their value only changes
+	/// on the events that end an idle loop skip (see GbaMemoryManager::SkipIdleLoop)
+	static constexpr bool IsIdleLoopSafeRegister(uint32_t addr) {
+		switch (addr & ~0x01) {
+			case 0x4000004: // DISPSTAT
+			case 0x4000006: // VCOUNT
+			case 0x4000130: // KEYINPUT
+			case 0x4000200: // IE
+			case 0x4000202: // IF
+			case 0x4000208: // IME
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
 	__forceinline bool CheckConditions(uint32_t condCode) {
 		/*Code Suffix Flags Meaning
 		0000 EQ Z set equal
@@ -322,6 +349,11 @@ public:
 
 #ifndef DUMMYCPU
 		if (_state.Pipeline.ReloadRequested) [[unlikely]] {
+			if constexpr (!debuggerEnabled) {
+				if (_idleLoopSkipEnabled) {
+					ProcessIdleLoopBranch();
+				}
+			}
 			ReloadPipeline();
 		}
 
@@ -337,6 +369,12 @@ public:
 		if (!irqDisable && hasPendingIrq) {
 			CheckForIrqs();
 		}
+
+		if constexpr (!debuggerEnabled) {
+			if (_idleLoopDetected) [[unlikely]] {
+				SkipIdleLoop();
+			}
+		}
 #endif
 	}
 
@@ -346,6 +384,18 @@ public:
 		_state.Frozen = freeze;
 	}
 
+	/// <summary>Enables/disables idle loop skipping (see Emulator::IsIdleLoopSkipAllowed)</summary>
+	void SetIdleLoopSkip(bool enabled) {
+		if (!enabled && _idleLoopSkipEnabled) {
+			_idleLoopDetector.Reset();
+			_idleLoopDetected = false;
+		}
+		_idleLoopSkipEnabled = enabled;
+	}
+
+	/// <summary>Total number of master clocks skipped in idle loops since power on</summary>
+	[[nodiscard]] uint64_t GetIdleLoopSkippedCycles() { return _idleLoopSkippedCycles; }
+
 	void ClearSequentialFlag() { _state.Pipeline.Mode &= ~GbaAccessMode::Sequential; }
 	void SetSequentialFlag() { _state.Pipeline.Mode |= GbaAccessMode::Sequential; }
 
@@ -96,6 +96,37 @@ void GbaMemoryManager::ProcessStoppedCycle() {
 	_timer->Exec(_masterClock);
 }
 
+uint64_t GbaMemoryManager::SkipIdleLoop(uint32_t loopStart) {
+	// Polling loops can only read RAM and registers that change on a new scanline/hblank (DISPSTAT, VCOUNT, KEYINPUT)
+	// or when an IRQ flag gets set (IF). Nothing happens until the next PPU event or timer overflow, so the rest of
+	// the system is advanced to the cycle before it in a single step, and the CPU runs normally through the event:
+	// IRQs are taken on the first access after the event, within an instruction of where they'd be taken without the skip.
+	if (_hasPendingUpdates || _hasPendingLateUpdates) {
+		return 0;
+	}
+
+	uint32_t cycles = std::min(_ppu->GetCyclesToNextEvent(), _timer->GetCyclesToNextOverflow(_masterClock)) - 1;
+	if (cycles == 0) {
+		return 0;
+	}
+
+	if (loopStart < 0x8000000 || loopStart >= 0x10000000) {
+		// The prefetcher keeps reading ahead on every cycle of a loop that runs outside of ROM (until its buffer is full).
+		// Loops in ROM fetch their opcodes through it, and the branch at the end of each iteration restarts it, so its
+		// state is the same at the start of every iteration.
+		for (uint32_t remaining = cycles; remaining > 0 && _prefetch->NeedExec(_state.PrefetchEnabled);) {
+			uint8_t clocks = (uint8_t)std::min<uint32_t>(remaining, 255);
+			_prefetch->Exec(clocks, _state.PrefetchEnabled);
+			remaining -= clocks;
+		}
+	}
+
+	_timer->SkipCycles(_masterClock, cycles);
+	_ppu->SkipCycles(cycles);
+	_masterClock += cycles;
+	return cycles;
+}
+
 void GbaMemoryManager::ProcessPendingUpdates(bool allowStartDma) {
 	if (_dmaController->HasPendingDma()) {
 		_dmaController->RunPendingDma(allowStartDma);
@@ -336,6 +367,59 @@ uint32_t GbaMemoryManager::Read(GbaAccessModeVal mode, uint32_t addr) {
 	return value;
 }
 
+uint8_t* GbaMemoryManager::GetCodePointer(uint32_t addr, uint8_t size) {
+	if (addr & (size - 1)) {
+		// Misaligned fetches are rotated like any other read
+		return nullptr;
+	}
+
+	switch (addr >> 24) {
+		case 0x02:
+			return _extWorkRam + (addr & (GbaConsole::ExtWorkRamSize - 1));
+		case 0x03:
+			return _intWorkRam + (addr & (GbaConsole::IntWorkRamSize - 1));
+
+		case 0x08:
+		case 0x09:
+		case 0x0A:
+		case 0x0B:
+		case 0x0C: {
+			// GPIO registers (0x80000C4-0x80000C9) and out of bounds reads go through the cart
+			uint32_t romAddr = addr & 0x1FFFFFF;
+			if (romAddr + size <= _prgRomSize && (romAddr + size <= 0xC4 || romAddr > 0xC9)) {
+				return _prgRom + romAddr;
+			}
+			return nullptr;
+		}
+	}
+
+	// BIOS (locking), EEPROM, I/O, VRAM, etc.
+	return nullptr;
+}
+
+uint32_t GbaMemoryManager::ReadCode(GbaAccessModeVal mode, uint32_t addr) {
+	uint8_t size = (mode & GbaAccessMode::Word) ? 4 : 2;
+	uint8_t* src = (mode & GbaAccessMode::Byte) || !(mode & GbaAccessMode::Prefetch) ? nullptr : GetCodePointer(addr, size);
+	if (!src) {
+		return Read(mode, addr);
+	}
+
+	ProcessWaitStates(mode, addr);
+	_biosLocked = true;
+
+	uint32_t value;
+	if (size == 4) {
+		value = src[0] | (src[1] << 8) | (src[2] << 16) | (src[3] << 24);
+		UpdateOpenBus<4>(addr, value);
+		_emu->ProcessMemoryRead<CpuType::Gba, 4>(addr, value, MemoryOperationType::ExecOpCode);
+	} else {
+		value = src[0] | (src[1] << 8);
+		UpdateOpenBus<2>(addr, value);
+		_emu->ProcessMemoryRead<CpuType::Gba, 2>(addr, value, MemoryOperationType::ExecOpCode);
+	}
+	return value;
+}
+
 template <bool debug>
 uint32_t GbaMemoryManager::RotateValue(GbaAccessModeVal mode, uint32_t addr, uint32_t value, bool isSigned) {
 	uint8_t shift = (addr & ((mode & GbaAccessMode::HalfWord) ? 0x01 : 0x03)) << 3;
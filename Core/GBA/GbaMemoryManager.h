@@ -190,6 +190,12 @@ private:
 	template <bool debug = false>
 	uint32_t RotateValue(GbaAccessModeVal mode, uint32_t addr, uint32_t value, bool isSigned);
 
+	/// <summary>
+	/// Returns a pointer to the opcode at addr when it can be read directly from ROM/EWRAM/IWRAM
+	/// (no GPIO/EEPROM/open bus behavior), nullptr otherwise.
+	/// </summary>
+	__forceinline uint8_t* GetCodePointer(uint32_t addr, uint8_t size);
+
 	/// <summary>Internal memory read.</summary>
 	__forceinline uint8_t InternalRead(GbaAccessModeVal mode, uint32_t addr, uint32_t readAddr);
 
@@ -299,6 +305,13 @@ public:
 	/// <summary>Processes cycle in STOP mode.</summary>
 	void ProcessStoppedCycle();
 
+	/// <summary>
+	/// Skips an idle loop's iterations by running the rest of the system up to the cycle before its next event.
+	/// </summary>
+	/// <param name="loopStart">Address of the loop's first instruction (the CPU is about to run it)</param>
+	/// <returns>Number of cycles skipped (0 if an event is due)</returns>
+	uint64_t SkipIdleLoop(uint32_t loopStart);
+
 	/// <summary>Locks the bus (prevents CPU access).</summary>
 	void LockBus() { _state.BusLocked = true; }
 
@@ -323,6 +336,13 @@ public:
 	/// <summary>Reads from memory.</summary>
 	uint32_t Read(GbaAccessModeVal mode, uint32_t addr);
 
+	/// <summary>
+	/// Reads an opcode (CPU prefetch). Same timing and side effects as Read(), but aligned
+	/// fetches from ROM/EWRAM/IWRAM read the opcode directly from memory instead of
+	/// assembling it byte by byte through InternalRead. Anything else uses Read().
+	/// </summary>
+	uint32_t ReadCode(GbaAccessModeVal mode, uint32_t addr);
+
 	/// <summary>Writes to memory.</summary>
 	void Write(GbaAccessModeVal mode, uint32_t addr, uint32_t value);
 
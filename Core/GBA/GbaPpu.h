@@ -343,6 +343,21 @@ public:
 		_emu->ProcessPpuCycle<CpuType::Gba>();
 	}
 
+	/// <summary>Gets the number of cycles until Exec() reaches the next HBlank/render/end of scanline event.</summary>
+	[[nodiscard]] uint32_t GetCyclesToNextEvent() {
+		if (_state.Cycle < 1006) {
+			return 1006 - _state.Cycle;
+		} else if (_state.Cycle < 1056) {
+			return 1056 - _state.Cycle;
+		}
+		return 308 * 4 - _state.Cycle;
+	}
+
+	/// <summary>Advances the PPU by several cycles at once (must be fewer than GetCyclesToNextEvent()).</summary>
+	void SkipCycles(uint32_t cycles) {
+		_state.Cycle += cycles;
+	}
+
 	/// <summary>Checks if PPU is accessing the specified memory type this cycle.</summary>
 	bool IsAccessingMemory(uint8_t memType) {
 		return _memoryAccess[_state.Cycle] & memType;
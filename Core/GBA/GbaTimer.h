@@ -80,6 +80,38 @@ public:
 		ProcessTimer<3>(masterClock);
 	}
 
+	/// <summary>
+	/// Gets the number of cycles until Exec() overflows one of the running timers.
+	/// </summary>
+	/// <param name="masterClock">Current master clock value.</param>
+	/// <returns>Cycles until the next overflow (UINT32_MAX if no timer is running).</returns>
+	[[nodiscard]] uint32_t GetCyclesToNextOverflow(uint64_t masterClock) {
+		uint64_t minCycles = UINT32_MAX;
+		for (GbaTimerState& timer : _state.Timer) {
+			if (timer.ProcessTimer) {
+				// The timer is incremented on the clocks where (clock & PrescaleMask) == 0
+				uint64_t firstTick = (masterClock | timer.PrescaleMask) + 1;
+				uint64_t overflowClock = firstTick + (uint64_t)(0xFFFF - timer.Timer) * (timer.PrescaleMask + 1);
+				minCycles = std::min(minCycles, overflowClock - masterClock);
+			}
+		}
+		return (uint32_t)minCycles;
+	}
+
+	/// <summary>
+	/// Advances the running timers by several cycles at once (must be fewer than GetCyclesToNextOverflow()).
+	/// </summary>
+	/// <param name="masterClock">Master clock value before the skipped cycles.</param>
+	/// <param name="cycles">Number of cycles to skip.</param>
+	void SkipCycles(uint64_t masterClock, uint32_t cycles) {
+		for (GbaTimerState& timer : _state.Timer) {
+			if (timer.ProcessTimer) {
+				uint64_t period = timer.PrescaleMask + 1;
+				timer.Timer += (uint16_t)((masterClock + cycles) / period - masterClock / period);
+			}
+		}
+	}
+
 	/// <summary>
 	/// Writes to a timer control register.
 	/// </summary>
@@ -5,6 +5,7 @@
 #include "Genesis/GenesisControlManager.h"
 #include "Genesis/GenesisMemoryManager.h"
 #include "Genesis/GenesisPsg.h"
+#include "Genesis/GenesisYm2612.h"
 #include "Genesis/GenesisTypes.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
@@ -1512,6 +1513,7 @@ LoadRomResult GenesisConsole::LoadRom(VirtualFile& romFile) {
 	_memoryManager = std::make_unique<GenesisMemoryManager>();
 	_controlManager = std::make_unique<GenesisControlManager>(_emu, this);
 	_psg = std::make_unique<GenesisPsg>(_emu, this);
+	_ym2612 = std::make_unique<GenesisYm2612>(_emu);
 	_cpu = std::make_unique<GenesisM68k>();
 
 	_memoryManager->Init(_emu, this, romData, _vdp.get(), _controlManager.get(), _psg.get());
@@ -1519,6 +1521,7 @@ LoadRomResult GenesisConsole::LoadRom(VirtualFile& romFile) {
 	_emu->RegisterMemory(MemoryType::GenesisVideoRam, _vdp->GetVramPointer(), 0x10000);
 	_emu->RegisterMemory(MemoryType::GenesisPaletteRam, _vdp->GetCramPointer(), 128);
 	_memoryManager->SetCpu(_cpu.get());
+	_memoryManager->SetYm2612(_ym2612.get());
 	_cpu->Init(_emu, this, _memoryManager.get());
 	_sonicTraceEscalationArmed = false;
 	_sonicTraceEscalationCount = 0;
@@ -1534,6 +1537,7 @@ LoadRomResult GenesisConsole::LoadRom(VirtualFile& romFile) {
 	_memoryManager->LoadBattery();
 
 	_vdp->SetRegion(_region == ConsoleRegion::Pal);
+	_ym2612->SetClockRate(GetMasterClockRate());
 	const char* regionName = "NTSC";
 	if (_region == ConsoleRegion::Pal) {
 		regionName = "PAL";
@@ -1572,6 +1576,9 @@ void GenesisConsole::Reset() {
 	if (_psg) {
 		_psg->Reset();
 	}
+	if (_ym2612) {
+		_ym2612->Reset(_memoryManager ? _memoryManager->GetMasterClock() : 0);
+	}
 	_sonicTraceEscalationArmed = false;
 	_sonicTraceLastArmStartupFrame = 0;
 	_sonicStartupCheckpointCount = 0;
@@ -2126,6 +2133,10 @@ void GenesisConsole::RunFrame() {
 		}
 	}
 
+	if (_ym2612) {
+		_ym2612->EndFrame(_memoryManager->GetMasterClock());
+	}
+
 	ProcessEndOfFrame();
 	_runFrameExitCount++;
 	_runFrameLastExitSummary = std::format("exit={} frameBefore={} frameAfter={} guard={} hardGuardAbort={} stalls={} forcedAdvances={} sonicTraceArms={} sonicTraceLastArmFrame={} sonicCheckpoints={} sonicLastCheckpointFrame={} sonicLastCheckpointPc=${:06x} startupClass={} startupFrame={} pc=${:06x} cycles={} traceDigest={}",
@@ -2300,4 +2311,5 @@ void GenesisConsole::Serialize(Serializer& s) {
 	SV(_controlManager);
 	SV(_memoryManager);
 	SV(_psg);
+	SV(_ym2612);
 }
@@ -13,6 +13,7 @@ class GenesisVdp;
 class GenesisControlManager;
 class GenesisMemoryManager;
 class GenesisPsg;
+class GenesisYm2612;
 
 class GenesisConsole final : public IConsole {
 private:
@@ -22,6 +23,7 @@ private:
 	unique_ptr<GenesisControlManager> _controlManager;
 	unique_ptr<GenesisMemoryManager> _memoryManager;
 	unique_ptr<GenesisPsg> _psg;
+	unique_ptr<GenesisYm2612> _ym2612;
 	ConsoleRegion _region = ConsoleRegion::Ntsc;
 	uint64_t _runFrameStallEventCount = 0;
 	uint64_t _runFrameForcedAdvanceCount = 0;
@@ -5,6 +5,7 @@
 #include "Genesis/GenesisVdp.h"
 #include "Genesis/GenesisControlManager.h"
 #include "Genesis/GenesisPsg.h"
+#include "Genesis/GenesisYm2612.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/BatteryManager.h"
@@ -4697,6 +4698,9 @@ void GenesisMemoryManager::WriteZ80Window8(uint32_t addr, uint8_t value) {
 		bool isAddressWrite = (z80Addr & 0x01u) == 0u;
 		uint64_t alignedClock = ((_masterClock + YmBusyAlignCycles - 1u) / YmBusyAlignCycles) * YmBusyAlignCycles;
 		_ymBusyUntilMclk = alignedClock + YmBusyWindowCycles;
+		if (_ym2612) {
+			_ym2612->Write(_masterClock, (uint8_t)(z80Addr & 0x03u), value);
+		}
 		if (isAddressWrite) {
 			if (part == 0u) {
 				_ymAddressPort0 = value;
@@ -14,6 +14,7 @@ class GenesisConsole;
 class GenesisM68k;
 class GenesisVdp;
 class GenesisPsg;
+class GenesisYm2612;
 
 class GenesisMemoryManager final : public ISerializable {
 private:
@@ -28,6 +29,7 @@ private:
 	GenesisVdp* _vdp = nullptr;
 	GenesisControlManager* _controlManager = nullptr;
 	GenesisPsg* _psg = nullptr;
+	GenesisYm2612* _ym2612 = nullptr;
 
 	uint8_t* _prgRom = nullptr;
 	uint32_t _prgRomSize = 0;
@@ -354,6 +356,7 @@ public:
 	void ResetRuntimeState(bool hardReset);
 
 	void SetCpu(GenesisM68k* cpu) { _cpu = cpu; }
+	void SetYm2612(GenesisYm2612* ym2612) { _ym2612 = ym2612; }
 	void UpdateExecutionHeartbeat(uint32_t instructionProgramCounter, uint64_t cycleCount);
 	void TraceCpuEarlyProbe(uint32_t instructionProgramCounter, const GenesisM68kState& cpuState);
 
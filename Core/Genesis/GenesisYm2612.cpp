@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "Genesis/GenesisYm2612.h"
+#include "Shared/Emulator.h"
+#include "Shared/Audio/SoundMixer.h"
+#include "Utilities/Serializer.h"
+
+GenesisYm2612::GenesisYm2612(Emulator* emu) : _chip(*this) {
+	_soundMixer = emu ? emu->GetSoundMixer() : nullptr;
+	_pendingWrites.reserve(MaxPendingWrites);
+	Reset(0);
+}
+
+void GenesisYm2612::Reset(uint64_t clock) {
+	_chip.reset();
+	_pendingWrites.clear();
+	_samples.clear();
+	_nextSampleClock = clock + ClocksPerSample;
+}
+
+void GenesisYm2612::Write(uint64_t clock, uint8_t port, uint8_t value) {
+	if (_pendingWrites.size() >= MaxPendingWrites) {
+		// e.g. PCM streamed through the DAC register - apply what's queued so far
+		Run(clock);
+	}
+	_pendingWrites.push_back({ clock, (uint8_t)(port & 0x03), value });
+}
+
+void GenesisYm2612::GenerateSamples(uint32_t count) {
+	if (_output.size() < count) {
+		_output.resize(count);
+	}
+	_chip.generate(_output.data(), count);
+
+	size_t start = _samples.size();
+	_samples.resize(start + count * 2);
+	int16_t* out = _samples.data() + start;
+	for (uint32_t i = 0; i < count; i++) {
+		out[i * 2] = (int16_t)std::clamp<int32_t>(_output[i].data[0], INT16_MIN, INT16_MAX);
+		out[i * 2 + 1] = (int16_t)std::clamp<int32_t>(_output[i].data[1], INT16_MIN, INT16_MAX);
+	}
+}
+
+void GenesisYm2612::GenerateUntil(uint64_t clock) {
+	if (clock < _nextSampleClock) {
+		return;
+	}
+	uint32_t count = (uint32_t)((clock - _nextSampleClock) / ClocksPerSample) + 1;
+	GenerateSamples(count);
+	_nextSampleClock += (uint64_t)count * ClocksPerSample;
+}
+
+void GenesisYm2612::Run(uint64_t clock) {
+	for (PendingWrite& write : _pendingWrites) {
+		// Samples output up to (and including) the write's clock don't see it yet
+		GenerateUntil(write.Clock);
+		_chip.write(write.Port, write.Value);
+	}
+	_pendingWrites.clear();
+	GenerateUntil(clock);
+}
+
+void GenesisYm2612::EndFrame(uint64_t clock) {
+	Run(clock);
+	if (_soundMixer && !_samples.empty()) {
+		_soundMixer->PlayAudioBuffer(_samples.data(), (uint32_t)_samples.size() / 2, GetSampleRate());
+	}
+	_samples.clear();
+}
+
+void GenesisYm2612::Serialize(Serializer& s) {
+	if (s.IsSaving() && !_pendingWrites.empty()) {
+		// Only the chip state is saved - apply the writes made since the last catch-up
+		Run(_pendingWrites.back().Clock);
+	}
+
+	SV(_nextSampleClock);
+
+	vector<uint8_t> chipData;
+	ymfm::ymfm_saved_state state(chipData, s.IsSaving());
+	if (s.IsSaving()) {
+		_chip.save_restore(state);
+		SVVector(chipData);
+	} else {
+		SVVector(chipData);
+		_chip.save_restore(state);
+		_pendingWrites.clear();
+	}
+}
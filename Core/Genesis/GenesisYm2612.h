@@ -0,0 +1,68 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/Audio/ymfm/ymfm_opn.h"
+#include "Utilities/ISerializable.h"
+
+class Emulator;
+class SoundMixer;
+
+/// <summary>
+/// YM2612 FM synthesis (ymfm), driven by timestamped register writes.
+/// </summary>
+/// <remarks>
+/// Writes are recorded with the master clock they happened at and applied in
+/// batches at catch-up points (end of frame, write log full): the samples
+/// before each write are generated with a single generate() call, then the
+/// write is applied. Each write still takes effect on the same sample it
+/// would if the chip was clocked one sample at a time.
+///
+/// The status register, busy flag and timers are emulated by
+/// GenesisMemoryManager, so reads never need the synthesized state.
+/// </remarks>
+class GenesisYm2612 final : public ymfm::ymfm_interface, public ISerializable {
+public:
+	/// <summary>The YM2612 is clocked at MCLK/7 (same as the 68000) and outputs a sample every 144 clocks.</summary>
+	static constexpr uint32_t ClocksPerSample = 144;
+	static constexpr uint32_t MaxPendingWrites = 1024;
+
+private:
+	struct PendingWrite {
+		uint64_t Clock;
+		uint8_t Port;
+		uint8_t Value;
+	};
+
+	SoundMixer* _soundMixer = nullptr;
+	ymfm::ym2612 _chip;
+
+	vector<PendingWrite> _pendingWrites;
+	vector<ymfm::ym2612::output_data> _output;
+	vector<int16_t> _samples;
+
+	uint32_t _clockRate = 7670454;
+	uint64_t _nextSampleClock = ClocksPerSample; ///< Master clock at which the next sample is output
+
+	void GenerateSamples(uint32_t count);
+	void GenerateUntil(uint64_t clock);
+
+public:
+	GenesisYm2612(Emulator* emu);
+
+	void Reset(uint64_t clock);
+	void SetClockRate(uint32_t clockRate) { _clockRate = clockRate; }
+	[[nodiscard]] uint32_t GetSampleRate() const { return _clockRate / ClocksPerSample; }
+
+	/// <summary>Record a write to one of the 4 ports ($4000-$4003), applied at the next catch-up.</summary>
+	void Write(uint64_t clock, uint8_t port, uint8_t value);
+
+	/// <summary>Apply the pending writes and generate all samples up to the given master clock.</summary>
+	void Run(uint64_t clock);
+
+	/// <summary>Catch up to the end of the frame and send the frame's samples to the sound mixer.</summary>
+	void EndFrame(uint64_t clock);
+
+	[[nodiscard]] vector<int16_t>& GetSamples() { return _samples; }
+	[[nodiscard]] uint32_t GetPendingWriteCount() const { return (uint32_t)_pendingWrites.size(); }
+
+	void Serialize(Serializer& s) override;
+};
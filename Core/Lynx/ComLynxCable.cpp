@@ -3,41 +3,178 @@
 #include "Lynx/LynxMikey.h"
 #include <algorithm>
 
+ComLynxCable::CableUnit* ComLynxCable::FindUnit(const LynxMikey* unit) {
+	auto it = std::find_if(_connectedUnits.begin(), _connectedUnits.end(), [=](const CableUnit& u) { return u.Unit == unit; });
+	return it != _connectedUnits.end() ? &*it : nullptr;
+}
+
 void ComLynxCable::Connect(LynxMikey* unit) {
 	if (!unit) {
 		return;
 	}
 
 	// Prevent duplicate connections
-	auto it = std::find(_connectedUnits.begin(), _connectedUnits.end(), unit);
-	if (it == _connectedUnits.end()) {
-		_connectedUnits.push_back(unit);
+	std::lock_guard<std::mutex> lock(_lock);
+	if (!FindUnit(unit)) {
+		_connectedUnits.push_back({ unit });
 	}
 }
 
 void ComLynxCable::Disconnect(LynxMikey* unit) {
-	auto it = std::find(_connectedUnits.begin(), _connectedUnits.end(), unit);
-	if (it != _connectedUnits.end()) {
+	std::lock_guard<std::mutex> lock(_lock);
+	CableUnit* cableUnit = FindUnit(unit);
+	if (cableUnit) {
+		if (cableUnit->Arrived) {
+			_arrivedCount--;
+		}
+
 		// Swap-and-pop for O(1) erase (order doesn't matter on bus)
-		std::swap(*it, _connectedUnits.back());
+		std::swap(*cableUnit, _connectedUnits.back());
 		_connectedUnits.pop_back();
+
+		// The other units may all be waiting for the one that was removed
+		if (_lockstep && !_connectedUnits.empty() && _arrivedCount == _connectedUnits.size()) {
+			CompleteWindow();
+		}
 	}
 }
 
 void ComLynxCable::DisconnectAll() {
+	std::lock_guard<std::mutex> lock(_lock);
 	_connectedUnits.clear();
+	_arrivedCount = 0;
+	_windowCount++;
+	_windowDone.notify_all();
 }
 
 void ComLynxCable::Broadcast(LynxMikey* sender, uint16_t data) {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (_lockstep) {
+		// Delivered to the other units when every unit has reached the end of the window
+		if (CableUnit* cableUnit = FindUnit(sender)) {
+			cableUnit->Outbox.push_back(data);
+		}
+		return;
+	}
+
 	// §11: All connected units receive the data except the sender
 	// (sender already got self-loopback via ComLynxTxLoopback)
-	for (LynxMikey* unit : _connectedUnits) {
-		if (unit != sender) {
-			unit->ComLynxRxData(data);
+	for (CableUnit& unit : _connectedUnits) {
+		if (unit.Unit != sender) {
+			unit.Unit->ComLynxRxData(data);
 		}
 	}
 }
 
+void ComLynxCable::SetLockstep(bool enabled) {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (_lockstep == enabled) {
+		return;
+	}
+
+	if (!enabled) {
+		// Flush the current window and wake up any unit that is still waiting
+		CompleteWindow();
+		for (CableUnit& unit : _connectedUnits) {
+			DeliverInbox(unit);
+		}
+	}
+	_lockstep = enabled;
+}
+
+void ComLynxCable::CompleteWindow() {
+	// Bytes are appended to the inboxes in connection order, then in the order
+	// they were sent, regardless of the order the units reached the boundary
+	for (CableUnit& sender : _connectedUnits) {
+		if (sender.Outbox.empty()) {
+			continue;
+		}
+		for (CableUnit& receiver : _connectedUnits) {
+			if (&receiver != &sender) {
+				receiver.Inbox.insert(receiver.Inbox.end(), sender.Outbox.begin(), sender.Outbox.end());
+			}
+		}
+		sender.Outbox.clear();
+	}
+
+	for (CableUnit& unit : _connectedUnits) {
+		unit.Arrived = false;
+	}
+	_arrivedCount = 0;
+	_windowCount++;
+	_windowDone.notify_all();
+}
+
+void ComLynxCable::DeliverInbox(CableUnit& unit) {
+	for (uint16_t data : unit.Inbox) {
+		unit.Unit->ComLynxRxData(data);
+	}
+	unit.Inbox.clear();
+}
+
+bool ComLynxCable::EndWindow(LynxMikey* unit) {
+	std::lock_guard<std::mutex> lock(_lock);
+	CableUnit* cableUnit = FindUnit(unit);
+	if (!_lockstep || !cableUnit || cableUnit->Arrived) {
+		return false;
+	}
+
+	cableUnit->Arrived = true;
+	if (++_arrivedCount == _connectedUnits.size()) {
+		CompleteWindow();
+		return true;
+	}
+	return false;
+}
+
+void ComLynxCable::ReceivePending(LynxMikey* unit) {
+	std::lock_guard<std::mutex> lock(_lock);
+	if (CableUnit* cableUnit = FindUnit(unit)) {
+		DeliverInbox(*cableUnit);
+	}
+}
+
+void ComLynxCable::SyncWindow(LynxMikey* unit, const std::function<bool()>& isStopping) {
+	if (!_lockstep || (isStopping && isStopping())) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(_lock);
+	CableUnit* cableUnit = FindUnit(unit);
+	if (!cableUnit || cableUnit->Arrived) {
+		return;
+	}
+
+	uint64_t window = _windowCount;
+	cableUnit->Arrived = true;
+	if (++_arrivedCount == _connectedUnits.size()) {
+		CompleteWindow();
+	} else {
+		// Wait for all the other units, however long they take - running ahead of a slow
+		// unit would change the window its bytes are delivered in
+		while (!_windowDone.wait_for(lock, StopCheckInterval, [&] { return _windowCount != window; })) {
+			if (isStopping && isStopping()) {
+				if ((cableUnit = FindUnit(unit)) && cableUnit->Arrived) {
+					cableUnit->Arrived = false;
+					_arrivedCount--;
+				}
+				return;
+			}
+		}
+	}
+
+	// Connect/Disconnect may have moved the unit while waiting
+	if ((cableUnit = FindUnit(unit))) {
+		DeliverInbox(*cableUnit);
+	}
+}
+
+size_t ComLynxCable::GetConnectedCount() const {
+	std::lock_guard<std::mutex> lock(_lock);
+	return _connectedUnits.size();
+}
+
 bool ComLynxCable::IsConnected(const LynxMikey* unit) const {
-	return std::find(_connectedUnits.begin(), _connectedUnits.end(), unit) != _connectedUnits.end();
+	std::lock_guard<std::mutex> lock(_lock);
+	return std::any_of(_connectedUnits.begin(), _connectedUnits.end(), [=](const CableUnit& u) { return u.Unit == unit; });
 }
@@ -1,5 +1,9 @@
 #pragma once
 #include "pch.h"
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
 
 class LynxMikey;
 
@@ -14,17 +18,59 @@ class LynxMikey;
 /// when a unit transmits, Broadcast() calls ComLynxRxData() on every other
 /// connected unit (back-insert).
 ///
+/// Lockstep mode (multi-threaded):
+/// - Each unit runs on its own emulation thread and calls SyncWindow() every
+///   LockstepWindowCycles CPU cycles
+/// - Bytes sent during a window go to the sender's outbox instead of being
+///   delivered immediately (no unit touches another unit's Mikey)
+/// - When the last unit reaches the end of the window, every outbox is copied
+///   to the other units' inboxes in connection order, and each unit delivers
+///   its inbox to its own RX queue before running the next window
+/// - The result only depends on the bytes sent in each window, not on thread
+///   scheduling — it is identical to running the units one after the other
+///   for each window (EndWindow + ReceivePending on a single thread)
+/// - Units never run ahead of each other: a unit that is slow, paused or
+///   stopped at a debugger break holds the others at the window boundary
+///   until it catches up or is disconnected
+///
 /// Design notes:
-/// - Single-threaded: all operations assumed on emulation thread
+/// - Immediate mode (default) is single-threaded: all units on one thread
 /// - Not serialized: cable is runtime wiring, not save state data
 /// - Null-safe: LynxMikey works unchanged when _comLynxCable == nullptr
 /// - Supports 2–18 units (real hardware limit is ~18 due to cable loading)
 /// </summary>
 class ComLynxCable final {
+public:
+	/// <summary>Lockstep window length, in CPU cycles (128µs) — shorter than
+	/// one byte at the UART's fastest rate (62500 baud, 176µs), so bytes are
+	/// never delivered more than one byte time late.</summary>
+	static constexpr uint32_t LockstepWindowCycles = 512;
+
+	/// <summary>Interval at which a unit waiting at a window boundary checks
+	/// whether its own emulation is being stopped (see SyncWindow).</summary>
+	static constexpr auto StopCheckInterval = std::chrono::milliseconds(20);
+
 private:
+	struct CableUnit {
+		LynxMikey* Unit = nullptr;
+		vector<uint16_t> Outbox; ///< Bytes sent by this unit during the current window (lockstep)
+		vector<uint16_t> Inbox;  ///< Bytes sent by other units, not yet delivered (lockstep)
+		bool Arrived = false;    ///< Reached the end of the current window (lockstep)
+	};
+
 	/// <summary>Connected Mikey units. Pointer stability guaranteed by
 	/// LynxConsole owning LynxMikey with unique_ptr (no reallocation).</summary>
-	std::vector<LynxMikey*> _connectedUnits;
+	std::vector<CableUnit> _connectedUnits;
+
+	mutable std::mutex _lock;
+	std::condition_variable _windowDone;
+	std::atomic<bool> _lockstep = false;
+	uint32_t _arrivedCount = 0;
+	std::atomic<uint64_t> _windowCount = 0;
+
+	CableUnit* FindUnit(const LynxMikey* unit);
+	void CompleteWindow();
+	void DeliverInbox(CableUnit& unit);
 
 public:
 	ComLynxCable() = default;
@@ -49,11 +95,37 @@ public:
 
 	/// <summary>Broadcast transmitted data to all connected units except the sender.
 	/// Called from LynxMikey::ComLynxTxLoopback() after self-loopback.
-	/// Each recipient receives data via ComLynxRxData() (back-insert into RX queue).</summary>
+	/// Each recipient receives data via ComLynxRxData() (back-insert into RX queue)
+	/// — immediately, or at the end of the window in lockstep mode.</summary>
 	void Broadcast(LynxMikey* sender, uint16_t data);
 
+	/// <summary>Enable/disable lockstep mode (units running on separate threads).
+	/// Bytes not delivered yet are delivered when lockstep is disabled, so
+	/// this must be called while the units are not running.</summary>
+	void SetLockstep(bool enabled);
+	[[nodiscard]] bool IsLockstep() const { return _lockstep; }
+
+	/// <summary>Lockstep: end the unit's current window, wait for the other
+	/// units to end it too (or to be disconnected) and deliver the bytes they
+	/// sent during the window.
+	/// Called by each unit's emulation thread every LockstepWindowCycles.
+	/// isStopping is polled every StopCheckInterval while waiting — when it
+	/// returns true, the unit leaves the window without completing it (its
+	/// emulation is being stopped and it is about to be disconnected).</summary>
+	void SyncWindow(LynxMikey* unit, const std::function<bool()>& isStopping = {});
+
+	/// <summary>Lockstep: mark the unit's current window as done, without waiting.
+	/// Returns true if this completed the window (all units ended it).</summary>
+	bool EndWindow(LynxMikey* unit);
+
+	/// <summary>Lockstep: deliver the bytes received in completed windows to the unit's RX queue.</summary>
+	void ReceivePending(LynxMikey* unit);
+
+	/// <summary>Number of completed lockstep windows.</summary>
+	[[nodiscard]] uint64_t GetWindowCount() const { return _windowCount; }
+
 	/// <summary>Number of currently connected units.</summary>
-	[[nodiscard]] size_t GetConnectedCount() const { return _connectedUnits.size(); }
+	[[nodiscard]] size_t GetConnectedCount() const;
 
 	/// <summary>Check if a specific unit is connected.</summary>
 	[[nodiscard]] bool IsConnected(const LynxMikey* unit) const;
@@ -33,8 +33,18 @@ LynxConsole::LynxConsole(Emulator* emu) {
 
 LynxConsole::~LynxConsole() {
 	if (_mikey) {
-		g_sharedComLynxCable.Disconnect(_mikey.get());
-		_mikey->SetComLynxCable(nullptr);
+		SetComLynxCable(nullptr);
+	}
+}
+
+void LynxConsole::SetComLynxCable(ComLynxCable* cable) {
+	if (_comLynxCable) {
+		_comLynxCable->Disconnect(_mikey.get());
+	}
+	_comLynxCable = cable;
+	_mikey->SetComLynxCable(cable);
+	if (cable) {
+		cable->Connect(_mikey.get());
 	}
 }
 
@@ -262,8 +272,12 @@ LoadRomResult LynxConsole::LoadRom(VirtualFile& romFile) {
 	// Initialize Mikey (timers, display, IRQs) — needs CPU reference for IRQ line
 	// MUST be called before HLE boot state, as Init() zeroes all Mikey state
 	_mikey->Init(_emu, this, _cpu.get(), _memoryManager.get());
-	_mikey->SetComLynxCable(&g_sharedComLynxCable);
-	g_sharedComLynxCable.Connect(_mikey.get());
+
+	// Headless instances (batch environments, input search workers) run on their owner's threads
+	// and must not exchange bytes with the player's consoles (or with each other)
+	if (!_emu->IsHeadless()) {
+		SetComLynxCable(&g_sharedComLynxCable);
+	}
 
 	// Wire cart to Mikey for SYSCTL1 bank strobe
 	_mikey->SetCart(_cart.get());
@@ -337,6 +351,15 @@ void LynxConsole::RunFrame() {
 	uint32_t targetCycles = LynxConstants::CpuCyclesPerFrame;
 	uint64_t startCycle = _cpu->GetCycleCount();
 
+	// ComLynx lockstep: exchange UART bytes with the other units (running on
+	// their own threads) every LockstepWindowCycles. The boundaries are multiples
+	// of the window length, derived from the cycle count at the start of each
+	// frame - they stay correct when a state is loaded or the console is reset
+	uint64_t nextComLynxSync = UINT64_MAX;
+	if (_comLynxCable && _comLynxCable->IsLockstep()) {
+		nextComLynxSync = startCycle - startCycle % ComLynxCable::LockstepWindowCycles + ComLynxCable::LockstepWindowCycles;
+	}
+
 	while (_cpu->GetCycleCount() - startCycle < targetCycles) {
 		_cpu->Exec();
 		// Cache cycle count to avoid redundant pointer-chasing per iteration
@@ -345,6 +368,14 @@ void LynxConsole::RunFrame() {
 		_mikey->Tick(cycle);
 		// Tick audio — _apu is always initialized after LoadRom()
 		_apu->Tick(cycle);
+
+		if (cycle >= nextComLynxSync) [[unlikely]] {
+			// One window per boundary, even if the instruction crossed several of them
+			do {
+				_comLynxCable->SyncWindow(_mikey.get(), [this]() { return _emu->IsStopping(); });
+				nextComLynxSync += ComLynxCable::LockstepWindowCycles;
+			} while (cycle >= nextComLynxSync);
+		}
 	}
 
 	// Flush remaining audio samples
@@ -13,6 +13,7 @@
 #include "Lynx/LynxDefaultVideoFilter.h"
 
 class Emulator;
+class ComLynxCable;
 
 /// <summary>
 /// Atari Lynx portable console emulator.
@@ -49,6 +50,7 @@ private:
 	LynxModel _model = LynxModel::LynxII;
 	LynxRotation _rotation = LynxRotation::None;
 	uint32_t _frameCount = 0;
+	ComLynxCable* _comLynxCable = nullptr;  ///< Cable the console's Mikey is plugged into (null = none)
 
 	uint32_t _frameBuffer[LynxConstants::PixelCount] = {};
 
@@ -90,6 +92,14 @@ public:
 	void LoadBattery();
 	void ApplyHleBootState();
 
+	/// <summary>
+	/// Plug the console into a ComLynx cable (null = unplug). Consoles are plugged into the
+	/// process-wide cable when they're loaded, except headless instances, which are only connected
+	/// to a cable with this. Must be called while the console isn't running.
+	/// </summary>
+	void SetComLynxCable(ComLynxCable* cable);
+	[[nodiscard]] ComLynxCable* GetComLynxCable() { return _comLynxCable; }
+
 	// Component accessors
 	[[nodiscard]] LynxCpu* GetCpu() { return _cpu.get(); }
 	[[nodiscard]] LynxMikey* GetMikey() { return _mikey.get(); }
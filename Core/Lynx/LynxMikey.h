@@ -248,6 +248,8 @@ public:
 	[[nodiscard]] uint16_t GetCurrentScanline() const { return _state.CurrentScanline; }
 	[[nodiscard]] uint32_t GetPaletteColor(int index) const { return _state.Palette[index]; }
 	[[nodiscard]] const LynxTimerState& GetTimerState(int index) const { return _state.Timers[index]; }
+	[[nodiscard]] uint32_t GetUartRxWaiting() const { return _uartRxWaiting; }
+	[[nodiscard]] uint16_t GetUartRxQueueEntry(uint32_t index) const { return _uartRxQueue[(_uartRxOutputPtr + index) & (UartMaxRxQueue - 1)]; }
 
 	/// <summary>Get mutable reference to Mikey state (for debugger/serialization).</summary>
 	[[nodiscard]] LynxMikeyState& GetState() { return _state; }
@@ -81,8 +81,13 @@ void GameDatabase::InitDatabase() {
 		if (!_initialized) {
 			string dbPath = FolderUtilities::CombinePath(FolderUtilities::GetHomeFolder(), "NexenNesDB.txt");
 			ifstream db(dbPath, ios::in | ios::binary);
-			LoadGameDb(db);
-			_initialized = true;
+			if (db) {
+				LoadGameDb(db);
+
+				// Not set when the file is missing, so the database is still loaded if it's added to the
+				// home folder later (or if the home folder changes)
+				_initialized = true;
+			}
 		}
 	}
 }
@@ -132,6 +137,16 @@ bool GameDatabase::GetDbRomSize(uint32_t romCrc, uint32_t& prgSize, uint32_t& ch
 	return false;
 }
 
+bool GameDatabase::GetGameInfo(uint32_t romCrc, GameInfo& info) {
+	InitDatabase();
+	auto result = _gameDatabase.find(romCrc);
+	if (result != _gameDatabase.end()) {
+		info = result->second;
+		return true;
+	}
+	return false;
+}
+
 bool GameDatabase::GetiNesHeader(uint32_t romCrc, NesHeader& nesHeader) {
 	GameInfo info = {};
 	InitDatabase();
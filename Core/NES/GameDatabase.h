@@ -30,4 +30,5 @@ public:
 	static void SetGameInfo(uint32_t romCrc, RomData& romData, bool updateRomData, bool forHeaderlessRom);
 	static bool GetiNesHeader(uint32_t romCrc, NesHeader& nesHeader);
 	static bool GetDbRomSize(uint32_t romCrc, uint32_t& prgSize, uint32_t& chrSize);
+	static bool GetGameInfo(uint32_t romCrc, GameInfo& info);
 };
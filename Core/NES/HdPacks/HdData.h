@@ -1,6 +1,10 @@
 #pragma once
 #include "pch.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
 #include "NES/NesConstants.h"
 #include "Shared/MessageManager.h"
 #include "Utilities/PNGHelper.h"
@@ -183,6 +187,16 @@ public:
 		return result;
 	}
 
+	/// <summary>
+	/// Evaluates conditions whose result is the same for the whole frame, so that the scanlines can
+	/// then be drawn by several threads without writing to the condition.
+	/// </summary>
+	void PrepareCache() {
+		if (_useCache) {
+			CheckCondition(0, 0, nullptr);
+		}
+	}
+
 protected:
 	int8_t _resultCache = -1;
 	bool _useCache = false;
@@ -192,7 +206,8 @@ protected:
 
 struct HdPackBitmapInfo {
 private:
-	bool _initDone = false;
+	std::atomic<bool> _initDone = false;
+	std::atomic<bool> _loadRequested = false;
 	SimpleLock _lock;
 
 public:
@@ -202,25 +217,36 @@ public:
 	uint32_t Width;
 	uint32_t Height;
 
-	void Init() {
-		if (_initDone) {
-			return;
+	/// <summary>Returns true once the PNG has been decoded (PixelData/Width/Height can be used)</summary>
+	[[nodiscard]] bool IsLoaded() {
+		return _initDone.load(std::memory_order_acquire);
+	}
+
+	/// <summary>Marks the bitmap as needed for rendering - returns false if it was already requested</summary>
+	bool MarkRequested() {
+		return !_loadRequested.exchange(true);
+	}
+
+	/// <summary>Decodes the PNG (blocks if another thread is decoding it)</summary>
+	/// <returns>True if this call decoded the bitmap</returns>
+	bool Init() {
+		if (IsLoaded()) {
+			return false;
 		}
 
 		auto lock = _lock.AcquireSafe();
-		if (_initDone) {
-			return;
+		if (IsLoaded()) {
+			return false;
 		}
 
-		// Timer tmr;
 		if (PNGHelper::ReadPNG(FileData, PixelData, Width, Height)) {
-			// MessageManager::Log("[HDPack] PNG file loaded: " + PngName + " (" + std::to_string(tmr.GetElapsedMS()) + ")");
 			PremultiplyAlpha();
 		} else {
 			MessageManager::Log("[HDPack] PNG file " + PngName + " is invalid.");
 		}
 		FileData = {};
-		_initDone = true;
+		_initDone.store(true, std::memory_order_release);
+		return true;
 	}
 
 	void PremultiplyAlpha() {
@@ -238,7 +264,8 @@ public:
 
 struct HdPackTileInfo : public HdTileKey {
 private:
-	bool _needInit = true;
+	std::atomic<bool> _needInit = true;
+	std::once_flag _initFlag;
 
 public:
 	uint32_t X;
@@ -307,11 +334,16 @@ public:
 	}
 
 	__forceinline bool NeedInit() {
-		return _needInit;
+		return _needInit.load(std::memory_order_acquire);
 	}
 
 	__noinline void Init() {
-		_needInit = false;
+		// Can be called by several render threads at once for the same tile
+		std::call_once(_initFlag, [this]() { InitTileData(); });
+	}
+
+private:
+	void InitTileData() {
 		Bitmap->Init();
 
 		uint32_t bitmapOffset = Y * Bitmap->Width + X;
@@ -326,8 +358,10 @@ public:
 		}
 
 		UpdateFlags();
+		_needInit.store(false, std::memory_order_release);
 	}
 
+public:
 	string ToString(int pngIndex) {
 		stringstream out;
 
@@ -421,9 +455,137 @@ struct BgmTrackInfo {
 	uint32_t LoopPosition = 0;
 };
 
+/// <summary>
+/// Read-only hash table mapping tile keys to the HD tiles defined for them (in definition order).
+/// </summary>
+/// <remarks>
+/// Built once after the pack is loaded, and looked up for every HD pixel that isn't cached:
+/// - open addressing (linear probing) over a power-of-two slot array, at most 50% full
+/// - each slot keeps the key's hash so most mismatches are rejected without touching the key
+/// - keys and tile lists are stored in flat arrays (no per-node or per-bucket allocations)
+/// </remarks>
+struct HdTileTable {
+private:
+	struct Slot {
+		uint32_t Hash;
+		uint32_t Entry; ///< Index in _entries + 1 (0 = empty slot)
+	};
+
+	struct Entry {
+		HdTileKey Key;
+		uint32_t FirstTile;
+		uint32_t TileCount;
+	};
+
+	vector<Slot> _slots;
+	vector<Entry> _entries;
+	vector<HdPackTileInfo*> _tiles;
+	uint32_t _mask = 0;
+
+	static __forceinline uint32_t GetSlotIndex(uint32_t hash, uint32_t mask) {
+		// CHR ROM keys hash to TileIndex ^ PaletteColors, spread them over the whole table
+		return ((hash * 0x9E3779B1) >> 7) & mask;
+	}
+
+public:
+	void Build(const unordered_map<HdTileKey, vector<HdPackTileInfo*>>& tilesByKey) {
+		uint32_t slotCount = 16;
+		while (slotCount < tilesByKey.size() * 2) {
+			slotCount <<= 1;
+		}
+
+		_mask = slotCount - 1;
+		_slots.assign(slotCount, {});
+		_entries.clear();
+		_entries.reserve(tilesByKey.size());
+		_tiles.clear();
+
+		for (auto& [key, tiles] : tilesByKey) {
+			_entries.push_back({ key, (uint32_t)_tiles.size(), (uint32_t)tiles.size() });
+			_tiles.insert(_tiles.end(), tiles.begin(), tiles.end());
+
+			uint32_t hash = key.GetHashCode();
+			uint32_t index = GetSlotIndex(hash, _mask);
+			while (_slots[index].Entry) {
+				index = (index + 1) & _mask;
+			}
+			_slots[index] = { hash, (uint32_t)_entries.size() };
+		}
+	}
+
+	/// <summary>Returns the HD tiles defined for this key (empty if there are none)</summary>
+	[[nodiscard]] std::span<HdPackTileInfo* const> Find(const HdTileKey& key) const {
+		if (_slots.empty()) {
+			return {};
+		}
+
+		uint32_t hash = key.GetHashCode();
+		uint32_t index = GetSlotIndex(hash, _mask);
+		while (true) {
+			const Slot& slot = _slots[index];
+			if (!slot.Entry) {
+				return {};
+			}
+			if (slot.Hash == hash) {
+				const Entry& entry = _entries[slot.Entry - 1];
+				if (key == entry.Key) {
+					return { _tiles.data() + entry.FirstTile, entry.TileCount };
+				}
+			}
+			index = (index + 1) & _mask;
+		}
+	}
+
+	[[nodiscard]] size_t GetKeyCount() const { return _entries.size(); }
+};
+
+/// <summary>
+/// Number of HD pack images decoded so far (see HdPackData::GetLoadProgress).
+/// </summary>
+struct HdPackLoadProgress {
+	uint32_t LoadedImages;
+	uint32_t TotalImages;
+};
+
 struct HdPackData {
 private:
-	bool _cancelLoad = false;
+	std::atomic<bool> _cancelLoad = false;
+
+	SimpleLock _queueLock;
+	vector<HdPackBitmapInfo*> _loadOrder;      ///< Every bitmap, in the order the workers decode them
+	vector<HdPackBitmapInfo*> _requestedQueue; ///< Bitmaps the renderer needs now (decoded first)
+	size_t _nextBitmap = 0;
+	std::atomic<uint32_t> _loadedCount = 0;
+
+	HdPackBitmapInfo* GetNextBitmap() {
+		auto lock = _queueLock.AcquireSafe();
+		while (!_requestedQueue.empty()) {
+			HdPackBitmapInfo* bitmap = _requestedQueue.back();
+			_requestedQueue.pop_back();
+			if (!bitmap->IsLoaded()) {
+				return bitmap;
+			}
+		}
+		while (_nextBitmap < _loadOrder.size()) {
+			HdPackBitmapInfo* bitmap = _loadOrder[_nextBitmap++];
+			if (!bitmap->IsLoaded()) {
+				return bitmap;
+			}
+		}
+		return nullptr;
+	}
+
+	void RunLoadWorker() {
+		while (!_cancelLoad) {
+			HdPackBitmapInfo* bitmap = GetNextBitmap();
+			if (!bitmap) {
+				return;
+			}
+			if (bitmap->Init()) {
+				_loadedCount++;
+			}
+		}
+	}
 
 public:
 	static constexpr int BgLayerCount = 40;
@@ -436,7 +598,7 @@ public:
 	vector<HdPackAdditionalSpriteInfo> AdditionalSprites;
 	vector<FallbackTileInfo> FallbackTiles;
 	unordered_set<uint32_t> WatchedMemoryAddresses;
-	unordered_map<HdTileKey, vector<HdPackTileInfo*>> TileByKey;
+	HdTileTable TileByKey;
 	unordered_map<string, string> PatchesByHash;
 	unordered_map<int, BgmTrackInfo> BgmFilesById;
 	unordered_map<int, string> SfxFilesById;
@@ -455,19 +617,54 @@ public:
 	HdPackData(const HdPackData&) = delete;
 	HdPackData& operator=(const HdPackData&) = delete;
 
+	/// <summary>
+	/// Decodes all the pack's PNG files on a pool of worker threads (returns once they are all decoded).
+	/// </summary>
+	/// <remarks>
+	/// Bitmaps requested by the renderer (RequestLoad) are decoded first, the others in file order
+	/// (backgrounds first, since they cover large parts of the screen).
+	/// </remarks>
 	void LoadAsync() {
-		for (auto& bitmap : BackgroundFileData) {
-			bitmap->Init();
-			if (_cancelLoad) {
-				return;
+		Timer timer;
+		{
+			auto lock = _queueLock.AcquireSafe();
+			for (auto& bitmap : BackgroundFileData) {
+				_loadOrder.push_back(bitmap.get());
 			}
-		}
-		for (auto& bitmap : ImageFileData) {
-			bitmap->Init();
-			if (_cancelLoad) {
-				return;
+			for (auto& bitmap : ImageFileData) {
+				_loadOrder.push_back(bitmap.get());
 			}
 		}
+
+		uint32_t workerCount = std::clamp(std::thread::hardware_concurrency(), 2u, 9u) - 1;
+		workerCount = std::min(workerCount, (uint32_t)_loadOrder.size());
+
+		vector<std::thread> workers;
+		for (uint32_t i = 1; i < workerCount; i++) {
+			workers.emplace_back([this]() { RunLoadWorker(); });
+		}
+		RunLoadWorker();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+
+		if (!_cancelLoad) {
+			MessageManager::Log("[HDPack] " + std::to_string(_loadedCount) + " PNG files decoded in " + std::to_string((int)timer.GetElapsedMS()) + " ms (" + std::to_string(workerCount) + " threads)");
+		}
+	}
+
+	/// <summary>
+	/// Called by the renderer when it needs a bitmap that isn't decoded yet - moves it to the front of the queue.
+	/// </summary>
+	void RequestLoad(HdPackBitmapInfo* bitmap) {
+		if (bitmap->MarkRequested()) {
+			auto lock = _queueLock.AcquireSafe();
+			_requestedQueue.push_back(bitmap);
+		}
+	}
+
+	[[nodiscard]] HdPackLoadProgress GetLoadProgress() {
+		return { _loadedCount, (uint32_t)(BackgroundFileData.size() + ImageFileData.size()) };
 	}
 
 	void CancelLoad() {
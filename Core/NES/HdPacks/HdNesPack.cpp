@@ -12,17 +12,40 @@
 #include "Utilities/PNGHelper.h"
 
 template <uint32_t scale>
-HdNesPack<scale>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData) {
+HdNesPack<scale>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads) {
 	_console = console;
 	_settings = settings;
 	_hdData = hdData;
 
 	InitializeFallbackTiles();
 	CleanupInvalidRules();
+
+	uint32_t threadCount = std::clamp(renderThreads ? renderThreads : std::thread::hardware_concurrency(), 1u, HdNesPack::MaxRenderThreads);
+	for (uint32_t i = 1; i < threadCount; i++) {
+		_workers.push_back(std::make_unique<HdRenderWorker>());
+		HdRenderWorker* worker = _workers.back().get();
+		worker->Thread = std::thread([this, worker]() {
+			while (true) {
+				worker->WaitWork.Wait();
+				if (_stopWorkers) {
+					break;
+				}
+				RenderChunks(worker->Band);
+				if (--_pendingWorkers == 0) {
+					_pendingWorkers.notify_one();
+				}
+			}
+		});
+	}
 }
 
 template <uint32_t scale>
 HdNesPack<scale>::~HdNesPack() {
+	_stopWorkers = true;
+	for (unique_ptr<HdRenderWorker>& worker : _workers) {
+		worker->WaitWork.Signal();
+		worker->Thread.join();
+	}
 }
 
 template <uint32_t scale>
@@ -224,23 +247,29 @@ void HdNesPack<scale>::DrawTile(HdPpuTileInfo& tileInfo, HdPackTileInfo& hdPackT
 }
 
 template <uint32_t scale>
-void HdNesPack<scale>::OnLineStart(HdPpuPixelInfo& lineFirstPixel, uint8_t y) {
-	_scrollX = ((lineFirstPixel.TmpVideoRamAddr & 0x1F) << 3) | lineFirstPixel.XScroll | ((lineFirstPixel.TmpVideoRamAddr & 0x400) ? 0x100 : 0);
-	_useCachedTile = false;
+void HdNesPack<scale>::OnLineStart(HdRenderBand& band, HdPpuPixelInfo& lineFirstPixel, uint8_t y) {
+	band.ScrollX = ((lineFirstPixel.TmpVideoRamAddr & 0x1F) << 3) | lineFirstPixel.XScroll | ((lineFirstPixel.TmpVideoRamAddr & 0x400) ? 0x100 : 0);
+	band.UseCachedTile = false;
 
 	int32_t scrollY = (((lineFirstPixel.TmpVideoRamAddr & 0x3E0) >> 2) | ((lineFirstPixel.TmpVideoRamAddr & 0x7000) >> 12)) + ((lineFirstPixel.TmpVideoRamAddr & 0x800) ? 240 : 0);
 
 	for (int layer = 0; layer < 4; layer++) {
 		for (int i = 0; i < _activeBgCount[layer]; i++) {
-			HdBgConfig& cfg = _bgConfig[layer * HdNesPack::PriorityLevelsPerLayer + i];
+			HdBgConfig& cfg = band.BgConfig[layer * HdNesPack::PriorityLevelsPerLayer + i];
 			if (cfg.BackgroundIndex < 0) {
 				continue;
 			}
 
 			HdBackgroundInfo& bgInfo = _hdData->BackgroundsByPriority[cfg.BgPriority][cfg.BackgroundIndex];
-			bgInfo.Data->Init();
+			if (!bgInfo.Data->IsLoaded()) {
+				// Don't block the frame while the PNG is being decoded - hide the background until it's ready
+				_hdData->RequestLoad(bgInfo.Data);
+				cfg.BgMinX = -1;
+				cfg.BgMaxX = -1;
+				continue;
+			}
 
-			cfg.BgScrollX = (int32_t)(_scrollX * bgInfo.HorizontalScrollRatio);
+			cfg.BgScrollX = (int32_t)(band.ScrollX * bgInfo.HorizontalScrollRatio);
 			cfg.BgScrollY = (int32_t)(scrollY * bgInfo.VerticalScrollRatio);
 			if (y >= -cfg.BgScrollY && (y + bgInfo.Top + cfg.BgScrollY + 1) * scale <= bgInfo.Data->Height) {
 				cfg.BgMinX = -cfg.BgScrollX;
@@ -298,6 +327,14 @@ void HdNesPack<scale>::OnBeforeApplyFilter() {
 	}
 
 	ProcessAdditionalSprites();
+
+	for (int i = 0; i < 40; i++) {
+		// Per-line fields are set by OnLineStart
+		_mainBand.BgConfig[i] = _bgConfig[i];
+		for (unique_ptr<HdRenderWorker>& worker : _workers) {
+			worker->Band.BgConfig[i] = _bgConfig[i];
+		}
+	}
 }
 
 template <uint32_t scale>
@@ -398,23 +435,23 @@ void HdNesPack<scale>::InsertAdditionalSprite(int32_t sourceX, int32_t sourceY,
 }
 
 template <uint32_t scale>
-HdPackTileInfo* HdNesPack<scale>::GetCachedMatchingTile(uint32_t x, uint32_t y, HdPpuTileInfo* tile) {
-	if (((_scrollX + x) & 0x07) == 0) {
-		_useCachedTile = false;
+HdPackTileInfo* HdNesPack<scale>::GetCachedMatchingTile(HdRenderBand& band, uint32_t x, uint32_t y, HdPpuTileInfo* tile) {
+	if (((band.ScrollX + x) & 0x07) == 0) {
+		band.UseCachedTile = false;
 	}
 
 	bool disableCache = false;
 	HdPackTileInfo* hdPackTileInfo;
-	if (_useCachedTile) {
-		hdPackTileInfo = _cachedTile;
+	if (band.UseCachedTile) {
+		hdPackTileInfo = band.CachedTile;
 	} else {
 		hdPackTileInfo = GetMatchingTile(x, y, tile, &disableCache);
 
 		if (!disableCache && _cacheEnabled) {
 			// Use this tile for the next 8 horizontal pixels
 			// Disable cache if a sprite condition is used, because sprites are not on a 8x8 grid
-			_cachedTile = hdPackTileInfo;
-			_useCachedTile = true;
+			band.CachedTile = hdPackTileInfo;
+			band.UseCachedTile = true;
 		}
 	}
 	return hdPackTileInfo;
@@ -422,34 +459,39 @@ HdPackTileInfo* HdNesPack<scale>::GetCachedMatchingTile(uint32_t x, uint32_t y,
 
 template <uint32_t scale>
 HdPackTileInfo* HdNesPack<scale>::GetMatchingTile(uint32_t x, uint32_t y, HdPpuTileInfo* tile, bool* disableCache) {
-	auto hdTile = _hdData->TileByKey.find(*tile);
-	if (hdTile == _hdData->TileByKey.end()) {
+	std::span<HdPackTileInfo* const> hdTiles = _hdData->TileByKey.Find(*tile);
+	if (hdTiles.empty()) {
 		int32_t fallbackTileIndex = GetFallbackTile(tile->TileIndex);
 		if (fallbackTileIndex >= 0) {
 			int32_t orgIndex = tile->TileIndex;
 			tile->TileIndex = fallbackTileIndex;
-			hdTile = _hdData->TileByKey.find(*tile);
-			if (hdTile == _hdData->TileByKey.end()) {
-				hdTile = _hdData->TileByKey.find(tile->GetKey(true));
-				if (hdTile == _hdData->TileByKey.end()) {
+			hdTiles = _hdData->TileByKey.Find(*tile);
+			if (hdTiles.empty()) {
+				hdTiles = _hdData->TileByKey.Find(tile->GetKey(true));
+				if (hdTiles.empty()) {
 					tile->TileIndex = orgIndex;
 				}
 			}
 		}
 
-		if (hdTile == _hdData->TileByKey.end()) {
-			hdTile = _hdData->TileByKey.find(tile->GetKey(true));
+		if (hdTiles.empty()) {
+			hdTiles = _hdData->TileByKey.Find(tile->GetKey(true));
 		}
 	}
 
-	if (hdTile != _hdData->TileByKey.end()) {
-		for (HdPackTileInfo* hdPackTile : hdTile->second) {
+	if (!hdTiles.empty()) {
+		for (HdPackTileInfo* hdPackTile : hdTiles) {
 			if (disableCache != nullptr && hdPackTile->ForceDisableCache) {
 				*disableCache = true;
 			}
 
 			if (hdPackTile->MatchesCondition(x, y, tile)) {
 				if (hdPackTile->NeedInit()) {
+					if (!hdPackTile->Bitmap->IsLoaded()) {
+						// PNG hasn't been decoded by the loader threads yet, draw the original tile for now
+						_hdData->RequestLoad(hdPackTile->Bitmap);
+						return nullptr;
+					}
 					hdPackTile->Init();
 				}
 				return hdPackTile;
@@ -461,8 +503,8 @@ HdPackTileInfo* HdNesPack<scale>::GetMatchingTile(uint32_t x, uint32_t y, HdPpuT
 }
 
 template <uint32_t scale>
-void HdNesPack<scale>::DrawBackgroundLayer(uint8_t priority, uint32_t x, uint32_t y, uint32_t* outputBuffer, uint32_t screenWidth) {
-	HdBgConfig bgConfig = _bgConfig[(int)priority];
+void HdNesPack<scale>::DrawBackgroundLayer(HdRenderBand& band, uint8_t priority, uint32_t x, uint32_t y, uint32_t* outputBuffer, uint32_t screenWidth) {
+	HdBgConfig bgConfig = band.BgConfig[(int)priority];
 	if ((int32_t)x >= bgConfig.BgMinX && (int32_t)x <= bgConfig.BgMaxX) {
 		HdBackgroundInfo& bgInfo = _hdData->BackgroundsByPriority[bgConfig.BgPriority][bgConfig.BackgroundIndex];
 		switch (bgInfo.BlendMode) {
@@ -480,14 +522,14 @@ void HdNesPack<scale>::DrawBackgroundLayer(uint8_t priority, uint32_t x, uint32_
 }
 
 template <uint32_t scale>
-void HdNesPack<scale>::GetPixels(uint32_t x, uint32_t y, HdPpuPixelInfo& pixelInfo, uint32_t* outputBuffer, uint32_t screenWidth) {
+void HdNesPack<scale>::GetPixels(HdRenderBand& band, uint32_t x, uint32_t y, HdPpuPixelInfo& pixelInfo, uint32_t* outputBuffer, uint32_t screenWidth) {
 	HdPackTileInfo* hdPackTileInfo = nullptr;
 	HdPackTileInfo* hdPackSpriteInfo = nullptr;
 
 	bool hasSprite = pixelInfo.SpriteCount > 0;
 	bool renderOriginalTiles = ((_hdData->OptionFlags & (int)HdPackOptions::DontRenderOriginalTiles) == 0);
 	if (pixelInfo.Tile.TileIndex != HdPpuTileInfo::NoTile) {
-		hdPackTileInfo = GetCachedMatchingTile(x, y, &pixelInfo.Tile);
+		hdPackTileInfo = GetCachedMatchingTile(band, x, y, &pixelInfo.Tile);
 	}
 
 	int lowestBgSprite = 999;
@@ -495,7 +537,7 @@ void HdNesPack<scale>::GetPixels(uint32_t x, uint32_t y, HdPpuPixelInfo& pixelIn
 	DrawColor(_palette[pixelInfo.Tile.PpuBackgroundColor], outputBuffer, screenWidth);
 
 	for (int i = 0; i < _activeBgCount[0]; i++) {
-		DrawBackgroundLayer(HdNesPack::BehindBgSpritesPriority + i, x, y, outputBuffer, screenWidth);
+		DrawBackgroundLayer(band, HdNesPack::BehindBgSpritesPriority + i, x, y, outputBuffer, screenWidth);
 	}
 
 	if (hasSprite) {
@@ -516,7 +558,7 @@ void HdNesPack<scale>::GetPixels(uint32_t x, uint32_t y, HdPpuPixelInfo& pixelIn
 	}
 
 	for (int i = 0; i < _activeBgCount[1]; i++) {
-		DrawBackgroundLayer(HdNesPack::BehindBgPriority + i, x, y, outputBuffer, screenWidth);
+		DrawBackgroundLayer(band, HdNesPack::BehindBgPriority + i, x, y, outputBuffer, screenWidth);
 	}
 
 	if (hdPackTileInfo) {
@@ -529,7 +571,7 @@ void HdNesPack<scale>::GetPixels(uint32_t x, uint32_t y, HdPpuPixelInfo& pixelIn
 	}
 
 	for (int i = 0; i < _activeBgCount[2]; i++) {
-		DrawBackgroundLayer(HdNesPack::BehindFgSpritesPriority + i, x, y, outputBuffer, screenWidth);
+		DrawBackgroundLayer(band, HdNesPack::BehindFgSpritesPriority + i, x, y, outputBuffer, screenWidth);
 	}
 
 	if (hasSprite) {
@@ -546,27 +588,72 @@ void HdNesPack<scale>::GetPixels(uint32_t x, uint32_t y, HdPpuPixelInfo& pixelIn
 	}
 
 	for (int i = 0; i < _activeBgCount[3]; i++) {
-		DrawBackgroundLayer(HdNesPack::ForegroundPriority + i, x, y, outputBuffer, screenWidth);
+		DrawBackgroundLayer(band, HdNesPack::ForegroundPriority + i, x, y, outputBuffer, screenWidth);
 	}
 }
 
 template <uint32_t scale>
 void HdNesPack<scale>::Process(HdScreenInfo* hdScreenInfo, uint32_t* outputBuffer, OverscanDimensions& overscan) {
 	_hdScreenInfo = hdScreenInfo;
-	uint32_t hdScale = GetScale();
-	uint32_t screenWidth = (NesConstants::ScreenWidth - overscan.Left - overscan.Right) * hdScale;
+	_outputBuffer = outputBuffer;
+	_overscan = overscan;
 
 	OnBeforeApplyFilter();
-	for (uint32_t i = overscan.Top, iMax = 240 - overscan.Bottom; i < iMax; i++) {
-		OnLineStart(hdScreenInfo->ScreenTiles[i << 8], i);
-		uint32_t bufferIndex = (i - overscan.Top) * screenWidth * hdScale;
+
+	if (!CanRenderInParallel()) {
+		RenderLines(_mainBand, overscan.Top, 240 - overscan.Bottom);
+		return;
+	}
+
+	// Each scanline only depends on its own HdRenderBand state, so the output is identical to rendering them in order
+	for (unique_ptr<HdPackCondition>& condition : _hdData->Conditions) {
+		condition->PrepareCache();
+	}
+
+	_nextLine = overscan.Top;
+	_lastLine = 240 - overscan.Bottom;
+	_pendingWorkers = (uint32_t)_workers.size();
+	for (unique_ptr<HdRenderWorker>& worker : _workers) {
+		worker->WaitWork.Signal();
+	}
+	RenderChunks(_mainBand);
+	for (uint32_t pending = _pendingWorkers; pending > 0; pending = _pendingWorkers) {
+		_pendingWorkers.wait(pending);
+	}
+}
+
+template <uint32_t scale>
+bool HdNesPack<scale>::CanRenderInParallel() {
+	// Fallback tiles permanently replace the tile index in the screen buffer while drawing, which conditions
+	// on other pixels (tileNearby, tileAtPosition, etc.) can see - these packs are drawn in scanline order
+	return !_workers.empty() && _fallbackTiles.empty();
+}
+
+template <uint32_t scale>
+void HdNesPack<scale>::RenderChunks(HdRenderBand& band) {
+	while (true) {
+		uint32_t firstLine = _nextLine.fetch_add(HdNesPack::LinesPerChunk);
+		if (firstLine >= _lastLine) {
+			break;
+		}
+		RenderLines(band, firstLine, std::min(firstLine + HdNesPack::LinesPerChunk, _lastLine));
+	}
+}
+
+template <uint32_t scale>
+void HdNesPack<scale>::RenderLines(HdRenderBand& band, uint32_t firstLine, uint32_t lastLine) {
+	uint32_t screenWidth = (NesConstants::ScreenWidth - _overscan.Left - _overscan.Right) * scale;
+
+	for (uint32_t i = firstLine; i < lastLine; i++) {
+		OnLineStart(band, _hdScreenInfo->ScreenTiles[i << 8], i);
+		uint32_t bufferIndex = (i - _overscan.Top) * screenWidth * scale;
 		uint32_t lineStartIndex = bufferIndex;
-		for (uint32_t j = overscan.Left, jMax = 256 - overscan.Right; j < jMax; j++) {
-			GetPixels(j, i, hdScreenInfo->ScreenTiles[i * 256 + j], outputBuffer + bufferIndex, screenWidth);
-			bufferIndex += hdScale;
+		for (uint32_t j = _overscan.Left, jMax = 256 - _overscan.Right; j < jMax; j++) {
+			GetPixels(band, j, i, _hdScreenInfo->ScreenTiles[i * 256 + j], _outputBuffer + bufferIndex, screenWidth);
+			bufferIndex += scale;
 		}
 
-		ProcessGrayscaleAndEmphasis(hdScreenInfo->ScreenTiles[i * 256], outputBuffer + lineStartIndex, screenWidth);
+		ProcessGrayscaleAndEmphasis(_hdScreenInfo->ScreenTiles[i * 256], _outputBuffer + lineStartIndex, screenWidth);
 	}
 }
 
@@ -622,16 +709,16 @@ void HdNesPack<scale>::ProcessGrayscaleAndEmphasis(HdPpuPixelInfo& pixelInfo, ui
 	}
 }
 
-template HdNesPack<1>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<2>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<3>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<4>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<5>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<6>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<7>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<8>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<9>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
-template HdNesPack<10>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
+template HdNesPack<1>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<2>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<3>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<4>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<5>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<6>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<7>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<8>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<9>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
+template HdNesPack<10>::HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads);
 
 template HdNesPack<1>::~HdNesPack();
 template HdNesPack<2>::~HdNesPack();
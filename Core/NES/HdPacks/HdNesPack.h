@@ -1,6 +1,8 @@
 #pragma once
 #include "pch.h"
+#include <atomic>
 #include "NES/HdPacks/HdData.h"
+#include "Utilities/AutoResetEvent.h"
 
 class NesConsole;
 class EmuSettings;
@@ -48,6 +50,24 @@ private:
 	static constexpr uint8_t BehindFgSpritesPriority = 2 * PriorityLevelsPerLayer;
 	static constexpr uint8_t ForegroundPriority = 3 * PriorityLevelsPerLayer;
 
+	// Scanlines are rendered in chunks of this many lines, pulled by the worker threads as they finish the previous one
+	static constexpr uint32_t LinesPerChunk = 16;
+	static constexpr uint32_t MaxRenderThreads = 4;
+
+	/// <summary>State that changes while a scanline is being drawn (each render thread has its own)</summary>
+	struct HdRenderBand {
+		HdBgConfig BgConfig[40] = {};
+		HdPackTileInfo* CachedTile = nullptr;
+		bool UseCachedTile = false;
+		int32_t ScrollX = 0;
+	};
+
+	struct HdRenderWorker {
+		std::thread Thread;
+		AutoResetEvent WaitWork;
+		HdRenderBand Band;
+	};
+
 	NesConsole* _console = nullptr;
 	EmuSettings* _settings = nullptr;
 	HdPackData* _hdData = nullptr;
@@ -56,10 +76,16 @@ private:
 	HdBgConfig _bgConfig[40] = {};
 
 	uint32_t _palette[512] = {};
-	HdPackTileInfo* _cachedTile = nullptr;
 	bool _cacheEnabled = false;
-	bool _useCachedTile = false;
-	int32_t _scrollX = 0;
+
+	HdRenderBand _mainBand;
+	vector<unique_ptr<HdRenderWorker>> _workers;
+	std::atomic<bool> _stopWorkers = false;
+	std::atomic<uint32_t> _pendingWorkers = 0;
+	std::atomic<uint32_t> _nextLine = 0;
+	uint32_t _lastLine = 0;
+	uint32_t* _outputBuffer = nullptr;
+	OverscanDimensions _overscan = {};
 
 	unordered_map<HdTileKey, vector<HdPackAdditionalSpriteInfo>> _additionalTilesByKey;
 
@@ -70,15 +96,15 @@ private:
 	__forceinline void DrawColor(uint32_t color, uint32_t* outputBuffer, uint32_t screenWidth);
 	__forceinline void DrawTile(HdPpuTileInfo& tileInfo, HdPackTileInfo& hdPackTileInfo, uint32_t* outputBuffer, uint32_t screenWidth);
 
-	__forceinline HdPackTileInfo* GetCachedMatchingTile(uint32_t x, uint32_t y, HdPpuTileInfo* tile);
+	__forceinline HdPackTileInfo* GetCachedMatchingTile(HdRenderBand& band, uint32_t x, uint32_t y, HdPpuTileInfo* tile);
 	__forceinline HdPackTileInfo* GetMatchingTile(uint32_t x, uint32_t y, HdPpuTileInfo* tile, bool* disableCache = nullptr);
 
-	__forceinline void DrawBackgroundLayer(uint8_t priority, uint32_t x, uint32_t y, uint32_t* outputBuffer, uint32_t screenWidth);
+	__forceinline void DrawBackgroundLayer(HdRenderBand& band, uint8_t priority, uint32_t x, uint32_t y, uint32_t* outputBuffer, uint32_t screenWidth);
 
 	template <HdPackBlendMode blendMode>
 	__forceinline void DrawCustomBackground(HdBackgroundInfo& bgInfo, uint32_t* outputBuffer, uint32_t x, uint32_t y, uint32_t screenWidth);
 
-	void OnLineStart(HdPpuPixelInfo& lineFirstPixel, uint8_t y);
+	void OnLineStart(HdRenderBand& band, HdPpuPixelInfo& lineFirstPixel, uint8_t y);
 	int32_t GetLayerIndex(uint8_t priority);
 	void OnBeforeApplyFilter();
 
@@ -87,14 +113,19 @@ private:
 	void BuildAdditionalTileCache(int32_t x, int32_t y, HdPpuTileInfo& tile, bool checkFallbackTiles);
 	void InsertAdditionalSprite(int32_t x, int32_t y, HdPpuTileInfo& sprite, HdPackAdditionalSpriteInfo& additionalSprite);
 
-	__forceinline void GetPixels(uint32_t x, uint32_t y, HdPpuPixelInfo& pixelInfo, uint32_t* outputBuffer, uint32_t screenWidth);
+	__forceinline void GetPixels(HdRenderBand& band, uint32_t x, uint32_t y, HdPpuPixelInfo& pixelInfo, uint32_t* outputBuffer, uint32_t screenWidth);
 	__forceinline void ProcessGrayscaleAndEmphasis(HdPpuPixelInfo& pixelInfo, uint32_t* outputBuffer, uint32_t hdScreenWidth);
 
 	void CleanupInvalidRules();
 	void InitializeFallbackTiles();
 
+	bool CanRenderInParallel();
+	void RenderChunks(HdRenderBand& band);
+	void RenderLines(HdRenderBand& band, uint32_t firstLine, uint32_t lastLine);
+
 public:
-	HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData);
+	/// <param name="renderThreads">Threads that render the frame (including the emulation thread) - 0 = one per CPU core, up to MaxRenderThreads</param>
+	HdNesPack(NesConsole* console, EmuSettings* settings, HdPackData* hdData, uint32_t renderThreads = 0);
 	virtual ~HdNesPack();
 
 	uint32_t GetScale() override { return scale; }
@@ -227,6 +227,11 @@ void NesConsole::LoadHdPack(VirtualFile& romFile) {
 	}
 }
 
+HdPackLoadProgress NesConsole::GetHdPackLoadProgress() {
+	shared_ptr<HdPackData> hdData = _hdData.lock();
+	return hdData ? hdData->GetLoadProgress() : HdPackLoadProgress {};
+}
+
 void NesConsole::UpdateRegion(bool forceUpdate) {
 	ConsoleRegion region = GetNesConfig().Region;
 	if (region == ConsoleRegion::Auto) {
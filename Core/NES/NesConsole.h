@@ -21,6 +21,7 @@ class HdAudioDevice;
 class HdPackBuilder;
 class Epsm;
 struct HdPackData;
+struct HdPackLoadProgress;
 struct HdPackBuilderOptions;
 
 enum class DebugEventType;
@@ -109,6 +110,8 @@ public:
 
 	void SetNextFrameOverclockStatus(bool disabled);
 
+	HdPackLoadProgress GetHdPackLoadProgress();
+
 	// Inherited via IConsole
 	void Serialize(Serializer& s) override;
 	void Reset() override;
@@ -10,6 +10,8 @@
 #include "Netplay/PlayerListMessage.h"
 #include "Netplay/ForceDisconnectMessage.h"
 #include "Netplay/ServerInformationMessage.h"
+#include "Netplay/StateHashMessage.h"
+#include "Netplay/ResyncRequestMessage.h"
 #include "Netplay/GameServer.h"
 #include "Shared/BaseControlManager.h"
 #include "Shared/Emulator.h"
@@ -72,17 +74,32 @@ void GameClientConnection::ProcessMessage(NetMessage* message) {
 			break;
 
 		case MessageType::SaveState:
+			if (!((SaveStateMessage*)message)->DecodeState(_serverState)) {
+				// Delta is based on a state we don't have, ask for the full state
+				ResyncRequestMessage request(true);
+				SendNetMessage(request);
+				break;
+			}
+
 			if (_gameLoaded) {
 				DisableControllers();
 
 				auto lock = _emu->AcquireLock();
 				ClearInputData();
 				((SaveStateMessage*)message)->LoadState(_emu);
+				ClearStateHashes();
 				_enableControllers = true;
 				InitControlDevice();
 			}
 			break;
 
+		case MessageType::StateHash:
+			if (_gameLoaded) {
+				StateHashMessage* stateHash = (StateHashMessage*)message;
+				CheckStateHashes(stateHash->GetFrameCount(), std::move(stateHash->GetRegionHashes()), true);
+			}
+			break;
+
 		case MessageType::MovieData:
 			if (_gameLoaded) {
 				PushControllerState(((MovieDataMessage*)message)->GetPortNumber(), ((MovieDataMessage*)message)->GetInputState());
@@ -140,6 +157,35 @@ bool GameClientConnection::AttemptLoadGame(const string& filename, uint32_t crc3
 	return false;
 }
 
+void GameClientConnection::CheckStateHashes(uint32_t frameCount, vector<uint32_t>&& hashes, bool fromServer) {
+	auto lock = _stateHashLock.AcquireSafe();
+	std::map<uint32_t, vector<uint32_t>>& otherHashes = fromServer ? _localStateHashes : _serverStateHashes;
+	auto match = otherHashes.find(frameCount);
+	if (match == otherHashes.end()) {
+		// Wait for the other side's hashes for this frame (the client usually runs a few frames behind the server)
+		std::map<uint32_t, vector<uint32_t>>& pendingHashes = fromServer ? _serverStateHashes : _localStateHashes;
+		pendingHashes[frameCount] = std::move(hashes);
+		while (pendingHashes.size() > 4) {
+			pendingHashes.erase(pendingHashes.begin());
+		}
+		return;
+	}
+
+	uint32_t mismatchCount = StateHashMessage::GetMismatchCount(match->second, hashes);
+	otherHashes.erase(otherHashes.begin(), std::next(match));
+	if (mismatchCount > 0) {
+		MessageManager::Log(std::format("[Netplay] Desync detected at frame {} ({}/{} state regions differ), requesting resync.", frameCount, mismatchCount, hashes.size()));
+		ResyncRequestMessage request(false);
+		SendNetMessage(request);
+	}
+}
+
+void GameClientConnection::ClearStateHashes() {
+	auto lock = _stateHashLock.AcquireSafe();
+	_localStateHashes.clear();
+	_serverStateHashes.clear();
+}
+
 void GameClientConnection::PushControllerState(uint8_t port, ControlDeviceState state) {
 	LockHandler lock = _writeLock.AcquireSafe();
 	_inputData[port].push_back(state);
@@ -216,6 +262,11 @@ void GameClientConnection::ProcessNotification(ConsoleNotificationType type, voi
 		InitControlDevice();
 	} else if (type == ConsoleNotificationType::GameLoaded) {
 		_emu->RegisterInputProvider(this);
+	} else if (type == ConsoleNotificationType::PpuFrameDone && _gameLoaded && _enableControllers) {
+		uint32_t frameCount = _emu->GetFrameCount();
+		if (frameCount % StateHashMessage::HashInterval == 0) {
+			CheckStateHashes(frameCount, StateHashMessage::GetRegionHashes(_emu), false);
+		}
 	}
 }
 
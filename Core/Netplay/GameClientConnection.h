@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include <deque>
+#include <map>
 #include "Utilities/AutoResetEvent.h"
 #include "Utilities/SimpleLock.h"
 #include "Shared/BaseControlDevice.h"
@@ -73,6 +74,11 @@ private:
 	NetplayControllerInfo _controllerPort = {GameConnection::SpectatorPort, 0}; ///< Assigned port
 	ClientConnectionData _connectionData = {};                                  ///< Connection parameters (host, port, password, name)
 	string _serverSalt;                                                         ///< Authentication salt from server
+	NetplayStateBase _serverState;                                              ///< Last save state received (base for delta states)
+
+	SimpleLock _stateHashLock;                                ///< Protects the pending state hashes
+	std::map<uint32_t, vector<uint32_t>> _localStateHashes;  ///< Own state hashes, by frame, waiting for the server's
+	std::map<uint32_t, vector<uint32_t>> _serverStateHashes; ///< Server state hashes, by frame, waiting for ours
 
 private:
 	/// <summary>
@@ -135,6 +141,20 @@ private:
 	/// </remarks>
 	bool AttemptLoadGame(const string& filename, uint32_t crc32);
 
+	/// <summary>
+	/// Compare state hashes for a frame with the other side's (once both are available).
+	/// </summary>
+	/// <param name="frameCount">Frame the hashes were calculated for</param>
+	/// <param name="hashes">Region hashes (see StateHashMessage)</param>
+	/// <param name="fromServer">True for the server's hashes, false for the local state's</param>
+	/// <remarks>Sends a ResyncRequestMessage if the states don't match.</remarks>
+	void CheckStateHashes(uint32_t frameCount, vector<uint32_t>&& hashes, bool fromServer);
+
+	/// <summary>
+	/// Discard pending state hashes (after a save state is loaded).
+	/// </summary>
+	void ClearStateHashes();
+
 protected:
 	/// <summary>
 	/// Process received message from server.
@@ -144,7 +164,8 @@ protected:
 	/// Message handling:
 	/// - ServerInformation: Store server metadata
 	/// - GameInformation: Load matching ROM
-	/// - SaveState: Apply save state for late-join
+	/// - SaveState: Apply save state (full or delta) for late-join/resync
+	/// - StateHash: Compare with own state (desync detection)
 	/// - MovieData: Buffer input for emulation
 	/// - PlayerList: Update connected players
 	/// - ForceDisconnect: Display reason and disconnect
@@ -10,70 +10,104 @@
 #include "Netplay/ClientConnectionData.h"
 #include "Netplay/ForceDisconnectMessage.h"
 #include "Netplay/ServerInformationMessage.h"
+#include "Netplay/StateHashMessage.h"
+#include "Netplay/ResyncRequestMessage.h"
 
 GameConnection::GameConnection(Emulator* emu, unique_ptr<Socket> socket) {
 	_emu = emu;
 	_socket.swap(socket);
+	_readBuffer.resize(GameConnection::InitialBufferSize);
 }
 
 GameConnection::~GameConnection() {
 	Disconnect();
 }
 
-void GameConnection::ReadSocket() {
+bool GameConnection::ReadSocket() {
 	auto lock = _socketLock.AcquireSafe();
-	int bytesReceived = _socket->Recv((char*)_readBuffer + _readPosition, GameConnection::MaxMsgLength - _readPosition, 0);
+	if (_readPosition == _readBuffer.size()) {
+		// Buffer is full, a message larger than the buffer (e.g save state) is being received
+		uint32_t maxSize = GameConnection::MaxMsgLength + sizeof(uint32_t);
+		if (_readBuffer.size() >= maxSize) {
+			return false;
+		}
+		_readBuffer.resize(std::min<size_t>(_readBuffer.size() * 2, maxSize));
+	}
+
+	int bytesReceived = _socket->Recv((char*)_readBuffer.data() + _readPosition, (int)(_readBuffer.size() - _readPosition), 0);
 	if (bytesReceived > 0) {
 		_readPosition += bytesReceived;
+		return true;
 	}
+	return false;
 }
 
-bool GameConnection::ExtractMessage(void* buffer, uint32_t& messageLength) {
-	messageLength = _readBuffer[0] | (_readBuffer[1] << 8) | (_readBuffer[2] << 16) | (_readBuffer[3] << 24);
+bool GameConnection::ExtractMessage(uint8_t*& message, uint32_t& messageLength) {
+	if (_readPosition - _parsePosition <= sizeof(messageLength)) {
+		return false;
+	}
+
+	uint8_t* packet = _readBuffer.data() + _parsePosition;
+	messageLength = packet[0] | (packet[1] << 8) | (packet[2] << 16) | (packet[3] << 24);
 
 	if (messageLength > GameConnection::MaxMsgLength) {
 		MessageManager::Log("[Netplay] Invalid data received, closing connection.");
 		Disconnect();
+		_parsePosition = _readPosition = 0;
 		return false;
 	}
 
-	int packetLength = messageLength + sizeof(messageLength);
-
-	if (_readPosition >= packetLength) {
-		memcpy(buffer, _readBuffer + sizeof(messageLength), messageLength);
-		memmove(_readBuffer, _readBuffer + packetLength, _readPosition - packetLength);
-		_readPosition -= packetLength;
+	uint32_t packetLength = messageLength + sizeof(messageLength);
+	if (_readPosition - _parsePosition >= packetLength) {
+		message = packet + sizeof(messageLength);
+		_parsePosition += packetLength;
 		return true;
 	}
 	return false;
 }
 
+void GameConnection::CompactReadBuffer() {
+	uint32_t pendingLength = _readPosition - _parsePosition;
+	if (_parsePosition > 0) {
+		memmove(_readBuffer.data(), _readBuffer.data() + _parsePosition, pendingLength);
+		_readPosition = pendingLength;
+		_parsePosition = 0;
+	}
+
+	if (_readBuffer.size() > GameConnection::InitialBufferSize && pendingLength <= GameConnection::InitialBufferSize) {
+		// Large message has been processed, release the memory
+		_readBuffer.resize(GameConnection::InitialBufferSize);
+		_readBuffer.shrink_to_fit();
+	}
+}
+
 NetMessage* GameConnection::ReadMessage() {
-	ReadSocket();
-
-	if (_readPosition > 4) {
-		uint32_t messageLength;
-		if (ExtractMessage(_messageBuffer, messageLength)) {
-			switch ((MessageType)_messageBuffer[0]) {
-				case MessageType::HandShake:
-					return new HandShakeMessage(_messageBuffer, messageLength);
-				case MessageType::SaveState:
-					return new SaveStateMessage(_messageBuffer, messageLength);
-				case MessageType::InputData:
-					return new InputDataMessage(_messageBuffer, messageLength);
-				case MessageType::MovieData:
-					return new MovieDataMessage(_messageBuffer, messageLength);
-				case MessageType::GameInformation:
-					return new GameInformationMessage(_messageBuffer, messageLength);
-				case MessageType::PlayerList:
-					return new PlayerListMessage(_messageBuffer, messageLength);
-				case MessageType::SelectController:
-					return new SelectControllerMessage(_messageBuffer, messageLength);
-				case MessageType::ForceDisconnect:
-					return new ForceDisconnectMessage(_messageBuffer, messageLength);
-				case MessageType::ServerInformation:
-					return new ServerInformationMessage(_messageBuffer, messageLength);
-			}
+	uint8_t* buffer;
+	uint32_t messageLength;
+	if (ExtractMessage(buffer, messageLength)) {
+		switch ((MessageType)buffer[0]) {
+			case MessageType::HandShake:
+				return new HandShakeMessage(buffer, messageLength);
+			case MessageType::SaveState:
+				return new SaveStateMessage(buffer, messageLength);
+			case MessageType::InputData:
+				return new InputDataMessage(buffer, messageLength);
+			case MessageType::MovieData:
+				return new MovieDataMessage(buffer, messageLength);
+			case MessageType::GameInformation:
+				return new GameInformationMessage(buffer, messageLength);
+			case MessageType::PlayerList:
+				return new PlayerListMessage(buffer, messageLength);
+			case MessageType::SelectController:
+				return new SelectControllerMessage(buffer, messageLength);
+			case MessageType::ForceDisconnect:
+				return new ForceDisconnectMessage(buffer, messageLength);
+			case MessageType::ServerInformation:
+				return new ServerInformationMessage(buffer, messageLength);
+			case MessageType::StateHash:
+				return new StateHashMessage(buffer, messageLength);
+			case MessageType::ResyncRequest:
+				return new ResyncRequestMessage(buffer, messageLength);
 		}
 	}
 	return nullptr;
@@ -84,6 +118,11 @@ void GameConnection::SendNetMessage(NetMessage& message) {
 	message.Send(*_socket.get());
 }
 
+void GameConnection::SendPacket(const string& packet) {
+	auto lock = _socketLock.AcquireSafe();
+	_socket->Send((char*)packet.data(), (int)packet.size(), 0);
+}
+
 void GameConnection::Disconnect() {
 	auto lock = _socketLock.AcquireSafe();
 	_socket->Close();
@@ -94,11 +133,14 @@ bool GameConnection::ConnectionError() {
 }
 
 void GameConnection::ProcessMessages() {
-	NetMessage* message;
-	while ((message = ReadMessage()) != nullptr) {
-		// Loop until all messages have been processed
-		message->Initialize();
-		ProcessMessage(message);
-		delete message;
+	// Read until the socket has no more data, processing all complete messages after each read
+	while (ReadSocket()) {
+		NetMessage* message;
+		while ((message = ReadMessage()) != nullptr) {
+			message->Initialize();
+			ProcessMessage(message);
+			delete message;
+		}
+		CompactReadBuffer();
 	}
 }
\ No newline at end of file
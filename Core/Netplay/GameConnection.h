@@ -22,6 +22,10 @@ class Emulator;
 /// 4. Deserialize message body
 /// 5. Dispatch to ProcessMessage()
 ///
+/// Messages are parsed directly from the read buffer (no intermediate copy).
+/// The buffer starts small and only grows while a large message (e.g save state)
+/// is being received, then shrinks back once it has been processed.
+///
 /// Thread model:
 /// - ProcessMessages() called from connection thread (server/client threads)
 /// - SendNetMessage() may be called from emulation thread
@@ -35,43 +39,51 @@ class Emulator;
 class GameConnection {
 protected:
 	static constexpr int MaxMsgLength = 1500000; ///< Max message size (1.5MB for save states)
+	static constexpr uint32_t InitialBufferSize = 0x4000; ///< Read buffer size when no large message is pending
 
 	unique_ptr<Socket> _socket; ///< TCP socket for communication
 	Emulator* _emu;             ///< Emulator instance reference
 
-	uint8_t _readBuffer[GameConnection::MaxMsgLength] = {};    ///< Socket read buffer
-	uint8_t _messageBuffer[GameConnection::MaxMsgLength] = {}; ///< Message assembly buffer
-	int _readPosition = 0;                                     ///< Current read position in buffer
-	SimpleLock _socketLock;                                    ///< Socket operation synchronization
+	vector<uint8_t> _readBuffer; ///< Socket read buffer (grows up to MaxMsgLength + 4 bytes)
+	uint32_t _readPosition = 0;  ///< Number of bytes received in the buffer
+	uint32_t _parsePosition = 0; ///< Start of the next unprocessed message in the buffer
+	SimpleLock _socketLock;      ///< Socket operation synchronization
 
 private:
 	/// <summary>
 	/// Read available data from socket into buffer.
 	/// </summary>
+	/// <returns>True if any data was received</returns>
 	/// <remarks>
 	/// Non-blocking read:
-	/// - Reads up to MaxMsgLength bytes
+	/// - Grows the buffer when it is full (large message pending)
 	/// - Returns immediately if no data available
 	/// - Accumulates partial messages across calls
 	/// </remarks>
-	void ReadSocket();
+	bool ReadSocket();
 
 	/// <summary>
-	/// Extract complete message from read buffer.
+	/// Find the next complete message in the read buffer.
 	/// </summary>
-	/// <param name="buffer">Output message buffer</param>
+	/// <param name="message">Output pointer to the message (inside the read buffer)</param>
 	/// <param name="messageLength">Output message length</param>
-	/// <returns>True if complete message extracted</returns>
+	/// <returns>True if a complete message is available</returns>
 	/// <remarks>
 	/// Message framing:
 	/// - First 4 bytes: uint32_t message length
 	/// - Remaining bytes: Message type + data
 	/// - Handles partial reads (incomplete messages)
 	/// </remarks>
-	bool ExtractMessage(void* buffer, uint32_t& messageLength);
+	bool ExtractMessage(uint8_t*& message, uint32_t& messageLength);
 
 	/// <summary>
-	/// Read and parse next message from buffer.
+	/// Move the unprocessed data to the start of the buffer, and release the
+	/// memory used by large messages once they have been processed.
+	/// </summary>
+	void CompactReadBuffer();
+
+	/// <summary>
+	/// Parse next message from buffer.
 	/// </summary>
 	/// <returns>Parsed message object or nullptr if no complete message</returns>
 	/// <remarks>
@@ -134,4 +146,16 @@ public:
 	/// - Blocks until sent or error
 	/// </remarks>
 	void SendNetMessage(NetMessage& message);
+
+	/// <summary>
+	/// Send an already serialized message (see NetMessage::GetPacket).
+	/// </summary>
+	/// <param name="packet">Message in its wire format</param>
+	/// <remarks>Used to serialize a message once when it is broadcast to all connections.</remarks>
+	void SendPacket(const string& packet);
+
+	/// <summary>
+	/// Socket used by the connection (used by the server to wait on all connections at once).
+	/// </summary>
+	Socket* GetSocket() { return _socket.get(); }
 };
\ No newline at end of file
@@ -2,11 +2,14 @@
 #include "Netplay/GameServer.h"
 #include "Netplay/GameServerConnection.h"
 #include "Netplay/PlayerListMessage.h"
+#include "Netplay/MovieDataMessage.h"
+#include "Netplay/StateHashMessage.h"
 #include "Shared/Emulator.h"
 #include "Shared/BaseControlManager.h"
 #include "Shared/NotificationManager.h"
 #include "Shared/MessageManager.h"
 #include "Utilities/Socket.h"
+#include "Utilities/ThreadTrace.h"
 #include "Shared/ControllerHub.h"
 
 GameServer::GameServer(Emulator* emu) {
@@ -36,14 +39,13 @@ void GameServer::AcceptConnections() {
 	_listener->Listen(10);
 }
 
-void GameServer::UpdateConnections() {
-	vector<unique_ptr<GameServerConnection>> connectionsToRemove;
+void GameServer::UpdateConnections(const vector<GameServerConnection*>& readableConnections) {
 	for (int i = (int)_openConnections.size() - 1; i >= 0; i--) {
 		if (_openConnections[i]->ConnectionError()) {
 			// Pause emu thread to ensure nothing else modifies/accesses the _openConnections list while removing dead connections
 			auto lock = _emu->AcquireLock();
 			_openConnections.erase(_openConnections.begin() + i);
-		} else {
+		} else if (std::find(readableConnections.begin(), readableConnections.end(), _openConnections[i].get()) != readableConnections.end()) {
 			_openConnections[i]->ProcessMessages();
 		}
 	}
@@ -79,12 +81,21 @@ bool GameServer::SetInput(BaseControlDevice* device) {
 }
 
 void GameServer::RecordInput(const vector<shared_ptr<BaseControlDevice>>& devices) {
+	if (_openConnections.empty()) {
+		return;
+	}
+
+	// Serialize the frame's input once, and send the same packet to all clients
+	string packet;
 	for (const shared_ptr<BaseControlDevice>& device : devices) {
-		for (unique_ptr<GameServerConnection>& connection : _openConnections) {
-			if (!connection->ConnectionError()) {
-				// Send movie stream
-				connection->SendMovieData(device->GetPort(), device->GetRawState());
-			}
+		MovieDataMessage message(device->GetRawState(), device->GetPort());
+		packet += message.GetPacket();
+	}
+
+	for (unique_ptr<GameServerConnection>& connection : _openConnections) {
+		if (!connection->ConnectionError()) {
+			// Send movie stream
+			connection->SendMovieData(packet);
 		}
 	}
 }
@@ -97,10 +108,23 @@ void GameServer::ProcessNotification(ConsoleNotificationType type, void* paramet
 	if (type == ConsoleNotificationType::GameLoaded) {
 		// Register the server as an input provider/recorder
 		RegisterServerInput();
+	} else if (type == ConsoleNotificationType::PpuFrameDone && !_openConnections.empty()) {
+		uint32_t frameCount = _emu->GetFrameCount();
+		if (frameCount % StateHashMessage::HashInterval == 0) {
+			// Periodic desync check - clients compare these with the hashes of their own state for the same frame
+			StateHashMessage message(frameCount, StateHashMessage::GetRegionHashes(_emu));
+			string packet = message.GetPacket();
+			for (unique_ptr<GameServerConnection>& connection : _openConnections) {
+				if (!connection->ConnectionError()) {
+					connection->SendStateHash(packet);
+				}
+			}
+		}
 	}
 }
 
 void GameServer::Exec() {
+	THREAD_TRACE_NAME("Netplay Server");
 	_listener = std::make_unique<Socket>();
 	_listener->Bind(_port);
 	_listener->Listen(10);
@@ -108,11 +132,43 @@ void GameServer::Exec() {
 	_initialized = true;
 	MessageManager::DisplayMessage("NetPlay", "ServerStarted", std::format("{}", _port));
 
+	vector<Socket*> sockets;
+	vector<GameServerConnection*> connections;
+	vector<bool> readable;
+	vector<GameServerConnection*> readableConnections;
+
 	while (!_stop) {
-		AcceptConnections();
-		UpdateConnections();
+		// Wait until a client connects or sends data (instead of polling every socket every millisecond)
+		sockets.clear();
+		connections.clear();
+		sockets.push_back(_listener.get());
+		for (unique_ptr<GameServerConnection>& connection : _openConnections) {
+			if (!connection->ConnectionError()) {
+				sockets.push_back(connection->GetSocket());
+				connections.push_back(connection.get());
+			}
+		}
+
+		Socket::Poll(sockets, readable, GameServer::PollTimeoutMs);
+
+		readableConnections.clear();
+		for (size_t i = 0; i < connections.size(); i++) {
+			if (readable[i + 1]) {
+				readableConnections.push_back(connections[i]);
+			}
+		}
+
+		if (readable[0]) {
+			size_t connectionCount = _openConnections.size();
+			AcceptConnections();
+			for (size_t i = connectionCount; i < _openConnections.size(); i++) {
+				// Process the handshake of new clients right away, if it has already been received
+				readableConnections.push_back(_openConnections[i].get());
+			}
+		}
 
-		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+		THREAD_TRACE_SCOPE("UpdateConnections");
+		UpdateConnections(readableConnections);
 	}
 }
 
@@ -16,8 +16,9 @@ class Emulator;
 /// </summary>
 /// <remarks>
 /// Architecture:
-/// - Dedicated accept thread for incoming connections
-/// - Per-client GameServerConnection (one thread per client)
+/// - Dedicated server thread waits (Socket::Poll) on the listener and all client
+///   sockets, and only wakes up when a connection or message is received
+/// - Per-client GameServerConnection
 /// - Host player uses local input (IInputProvider)
 /// - Remote clients send input over TCP (IInputRecorder broadcasts)
 ///
@@ -61,8 +62,10 @@ private:
 
 	NetplayControllerInfo _hostControllerPort = {};
 
+	static constexpr int PollTimeoutMs = 50; ///< Max time between checks of the _stop flag/dead connections
+
 	void AcceptConnections();
-	void UpdateConnections();
+	void UpdateConnections(const vector<GameServerConnection*>& readableConnections);
 
 	void Exec();
 
@@ -3,7 +3,6 @@
 #include "Netplay/GameServerConnection.h"
 #include "Netplay/HandShakeMessage.h"
 #include "Netplay/InputDataMessage.h"
-#include "Netplay/MovieDataMessage.h"
 #include "Netplay/GameInformationMessage.h"
 #include "Netplay/SaveStateMessage.h"
 #include "Netplay/ClientConnectionData.h"
@@ -12,6 +11,7 @@
 #include "Netplay/GameServer.h"
 #include "Netplay/ForceDisconnectMessage.h"
 #include "Netplay/ServerInformationMessage.h"
+#include "Netplay/ResyncRequestMessage.h"
 #include "Netplay/NetplayTypes.h"
 #include "Shared/MessageManager.h"
 #include "Shared/Emulator.h"
@@ -47,19 +47,32 @@ void GameServerConnection::SendServerInformation() {
 	SendNetMessage(message);
 }
 
-void GameServerConnection::SendGameInformation() {
+void GameServerConnection::SendGameInformation(bool fullState) {
 	auto lock = _emu->AcquireLock();
 	RomInfo romInfo = _emu->GetRomInfo();
 	GameInformationMessage gameInfo(romInfo.RomFile.GetFileName(), _emu->GetCrc32(), _controllerPort, _emu->IsPaused());
 	SendNetMessage(gameInfo);
-	SaveStateMessage saveState(_emu);
+	SendSaveState(fullState);
+}
+
+void GameServerConnection::SendSaveState(bool fullState) {
+	auto lock = _emu->AcquireLock();
+	if (fullState) {
+		_clientState = {};
+	}
+	SaveStateMessage saveState(_emu, _clientState);
 	SendNetMessage(saveState);
 }
 
-void GameServerConnection::SendMovieData(uint8_t port, ControlDeviceState state) {
+void GameServerConnection::SendMovieData(const string& packet) {
+	if (_handshakeCompleted) {
+		SendPacket(packet);
+	}
+}
+
+void GameServerConnection::SendStateHash(const string& packet) {
 	if (_handshakeCompleted) {
-		MovieDataMessage message(state, port);
-		SendNetMessage(message);
+		SendPacket(packet);
 	}
 }
 
@@ -131,6 +144,17 @@ void GameServerConnection::ProcessMessage(NetMessage* message) {
 			SelectControllerPort(((SelectControllerMessage*)message)->GetController());
 			break;
 
+		case MessageType::ResyncRequest:
+			if (!_handshakeCompleted) {
+				SendForceDisconnectMessage("Handshake has not been completed - invalid packet");
+				return;
+			}
+			if (_emu->IsRunning()) {
+				MessageManager::Log("[Netplay] Client state out of sync, sending new state.");
+				SendSaveState(((ResyncRequestMessage*)message)->IsFullState());
+			}
+			break;
+
 		default:
 			break;
 	}
@@ -161,8 +185,12 @@ void GameServerConnection::SelectControllerPort(NetplayControllerInfo controller
 
 void GameServerConnection::ProcessNotification(ConsoleNotificationType type, void* parameter) {
 	switch (type) {
-		case ConsoleNotificationType::GamePaused:
 		case ConsoleNotificationType::GameLoaded:
+			// The previous game's state is a poor base for the new game's, send a full state
+			SendGameInformation(true);
+			break;
+
+		case ConsoleNotificationType::GamePaused:
 		case ConsoleNotificationType::GameResumed:
 		case ConsoleNotificationType::GameReset:
 		case ConsoleNotificationType::StateLoaded:
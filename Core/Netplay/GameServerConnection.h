@@ -60,6 +60,7 @@ private:
 	string _connectionHash;                     ///< Client authentication hash
 	string _serverPassword;                     ///< Server password (hashed)
 	bool _handshakeCompleted = false;           ///< True after successful authentication
+	NetplayStateBase _clientState;              ///< Last save state sent (base for delta states)
 
 	/// <summary>
 	/// Store input state from client.
@@ -87,8 +88,15 @@ private:
 	/// - ROM filename
 	/// - Region (NTSC/PAL)
 	/// - Emulator settings (for sync)
+	/// Followed by a save state (delta against the last state sent, unless fullState is set).
 	/// </remarks>
-	void SendGameInformation();
+	void SendGameInformation(bool fullState = false);
+
+	/// <summary>
+	/// Send the current state to the client, as a delta against the last state sent.
+	/// </summary>
+	/// <param name="fullState">Send the full state (client doesn't have the base state)</param>
+	void SendSaveState(bool fullState = false);
 
 	/// <summary>
 	/// Assign controller port to client.
@@ -166,13 +174,18 @@ public:
 	/// <summary>
 	/// Send movie data frame to client.
 	/// </summary>
-	/// <param name="port">Controller port</param>
-	/// <param name="state">Input state for this port</param>
+	/// <param name="packet">Serialized MovieDataMessages (one per port) for the frame</param>
 	/// <remarks>
 	/// Called by GameServer::RecordInput() to broadcast inputs.
-	/// Sends MovieDataMessage containing all player inputs for frame.
+	/// The packet is serialized once by the server and shared by all clients.
 	/// </remarks>
-	void SendMovieData(uint8_t port, ControlDeviceState state);
+	void SendMovieData(const string& packet);
+
+	/// <summary>
+	/// Send the server's state hashes for the current frame (serialized once by GameServer).
+	/// </summary>
+	/// <param name="packet">Serialized StateHashMessage</param>
+	void SendStateHash(const string& packet);
 
 	/// <summary>
 	/// Get assigned controller port.
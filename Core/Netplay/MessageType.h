@@ -15,6 +15,8 @@
 ///    - Server → All Clients: MovieData (broadcast all inputs every frame)
 /// 6. Server → Client: GameInformation (on ROM change/reset)
 /// 7. Server → Client: ForceDisconnect (kick/ban player)
+/// 8. Server → All Clients: StateHash (periodic desync check)
+/// 9. Client → Server: ResyncRequest (state hashes didn't match)
 ///
 /// Message format:
 /// - 4 bytes: Message length (uint32_t)
@@ -22,13 +24,15 @@
 /// - N bytes: Serialized message data (Serializer format)
 /// </remarks>
 enum class MessageType : uint8_t {
-	HandShake = 0,        ///< Client authentication (password, version, name)
-	SaveState = 1,        ///< Full save state for late-join sync
-	InputData = 2,        ///< Client input state (controller buttons)
-	MovieData = 3,        ///< Server broadcast of all inputs (movie frame)
-	GameInformation = 4,  ///< ROM info (CRC, region, settings)
-	PlayerList = 5,       ///< Connected player list update
-	SelectController = 6, ///< Controller port selection request
-	ForceDisconnect = 7,  ///< Server disconnect command (kick/ban)
-	ServerInformation = 8 ///< Server info (name, version, password required)
+	HandShake = 0,         ///< Client authentication (password, version, name)
+	SaveState = 1,         ///< Save state (full or delta) for late-join sync/resync
+	InputData = 2,         ///< Client input state (controller buttons)
+	MovieData = 3,         ///< Server broadcast of all inputs (movie frame)
+	GameInformation = 4,   ///< ROM info (CRC, region, settings)
+	PlayerList = 5,        ///< Connected player list update
+	SelectController = 6,  ///< Controller port selection request
+	ForceDisconnect = 7,   ///< Server disconnect command (kick/ban)
+	ServerInformation = 8, ///< Server info (name, version, password required)
+	StateHash = 9,         ///< Per-region hashes of the state at a given frame (desync detection)
+	ResyncRequest = 10     ///< Client request for a new save state
 };
\ No newline at end of file
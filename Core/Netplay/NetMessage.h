@@ -103,7 +103,11 @@ public:
 	/// - Typically < 1ms for small messages (input data)
 	/// - May take 100ms+ for large messages (save states)
 	/// </remarks>
-	void Send(Socket& socket) {
+	/// <summary>
+	/// Serializes the message in its wire format (length prefix + type + data).
+	/// </summary>
+	/// <remarks>Used to serialize a message once when it is sent to several connections.</remarks>
+	string GetPacket() {
 		Serializer s(SaveStateManager::FileFormatVersion, true);
 		Serialize(s);
 
@@ -112,7 +116,11 @@ public:
 
 		string data = out.str();
 		uint32_t messageLength = (uint32_t)data.size() + 1;
-		data = string((char*)&messageLength, 4) + (char)_type + data;
+		return string((char*)&messageLength, 4) + (char)_type + data;
+	}
+
+	void Send(Socket& socket) {
+		string data = GetPacket();
 		socket.Send((char*)data.c_str(), (int)data.size(), 0);
 	}
 
@@ -41,6 +41,19 @@ struct NetplayControllerUsageInfo {
 	bool InUse = false;                         ///< True if slot occupied by player
 };
 
+/// <summary>
+/// Last save state exchanged with a peer, used as the base for delta-encoded save states.
+/// </summary>
+/// <remarks>
+/// The server keeps one per connection (last state sent), the client keeps the last state
+/// received. Messages are delivered in order over TCP, so both sides have the same base.
+/// An Id of 0 means no state has been exchanged yet (next state must be a full state).
+/// </remarks>
+struct NetplayStateBase {
+	uint32_t Id = 0;      ///< Sequence number of the state (0 = none)
+	vector<uint8_t> Data; ///< Uncompressed state data
+};
+
 /// <summary>
 /// Player information in netplay session.
 /// </summary>
@@ -0,0 +1,28 @@
+#pragma once
+#include "pch.h"
+#include "Netplay/NetMessage.h"
+
+/// <summary>
+/// Sent by a client when its state no longer matches the server's (see StateHashMessage).
+/// </summary>
+class ResyncRequestMessage : public NetMessage {
+private:
+	bool _fullState = false;
+
+protected:
+	void Serialize(Serializer& s) override {
+		SV(_fullState);
+	}
+
+public:
+	ResyncRequestMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) {}
+
+	/// <param name="fullState">True when the client can't apply a delta (it doesn't have the server's base state)</param>
+	ResyncRequestMessage(bool fullState) : NetMessage(MessageType::ResyncRequest) {
+		_fullState = fullState;
+	}
+
+	[[nodiscard]] bool IsFullState() {
+		return _fullState;
+	}
+};
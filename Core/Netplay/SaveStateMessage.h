@@ -1,39 +1,96 @@
 #pragma once
 #include "pch.h"
 #include "Netplay/NetMessage.h"
+#include "Netplay/NetplayTypes.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/CheatManager.h"
 #include "Shared/SaveStateManager.h"
+#include "Shared/RewindData.h"
 
+/// <summary>
+/// Save state sent by the server on join, game/settings changes and resync requests.
+/// </summary>
+/// <remarks>
+/// The state is sent as an XOR delta against the last state sent on the connection
+/// (like rewind history), which is mostly zeroes and compresses to a fraction of the
+/// full state with the message's fast compression. The first state (and any state
+/// requested after a base mismatch) is sent in full.
+/// </remarks>
 class SaveStateMessage : public NetMessage {
 private:
 	vector<CheatCode> _activeCheats;
-	vector<uint8_t> _stateData;
+	vector<uint8_t> _stateData; ///< Full state, or XOR delta against the base state
+	uint32_t _stateId = 0;      ///< Sequence number of this state
+	uint32_t _baseStateId = 0;  ///< State the delta is based on (0 = full state)
 
 protected:
 	void Serialize(Serializer& s) override {
 		SVVector(_stateData);
 		SVVector(_activeCheats);
+		SV(_stateId);
+		SV(_baseStateId);
+	}
+
+	/// <summary>
+	/// Set the state to send, as a delta against the peer's current base state (if any).
+	/// </summary>
+	/// <param name="state">Uncompressed state data</param>
+	/// <param name="peerState">Last state sent to the peer - replaced by this state</param>
+	void SetState(vector<uint8_t>&& state, NetplayStateBase& peerState) {
+		_stateId = peerState.Id + 1;
+		_baseStateId = peerState.Id;
+		_stateData = state;
+		if (_baseStateId != 0) {
+			RewindData::XorState(_stateData, peerState.Data);
+		}
+
+		peerState.Id = _stateId;
+		peerState.Data = std::move(state);
 	}
 
 public:
 	SaveStateMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) {}
 
-	SaveStateMessage(Emulator* emu) : NetMessage(MessageType::SaveState) {
+	SaveStateMessage(vector<uint8_t>&& state, const vector<CheatCode>& activeCheats, NetplayStateBase& peerState) : NetMessage(MessageType::SaveState) {
+		_activeCheats = activeCheats;
+		SetState(std::move(state), peerState);
+	}
+
+	SaveStateMessage(Emulator* emu, NetplayStateBase& peerState) : NetMessage(MessageType::SaveState) {
 		// Used when sending state to clients
 		stringstream state;
 		{
 			auto lock = emu->AcquireLock();
 			_activeCheats = emu->GetCheatManager()->GetCheats();
-			emu->Serialize(state, true);
+			emu->Serialize(state, true, 0);
 		}
 
-		uint32_t dataSize = (uint32_t)state.tellp();
-		_stateData.resize(dataSize);
-		state.read((char*)_stateData.data(), dataSize);
+		string data = std::move(state).str();
+		SetState(vector<uint8_t>(data.begin(), data.end()), peerState);
 	}
 
+	/// <summary>
+	/// Rebuild the full state from the delta (on the receiving side).
+	/// </summary>
+	/// <param name="peerState">Last state received - replaced by this state</param>
+	/// <returns>False if the delta is based on a state other than the last one received</returns>
+	bool DecodeState(NetplayStateBase& peerState) {
+		if (_baseStateId != 0) {
+			if (_baseStateId != peerState.Id) {
+				return false;
+			}
+			RewindData::XorState(_stateData, peerState.Data);
+		}
+
+		peerState.Id = _stateId;
+		peerState.Data = _stateData;
+		return true;
+	}
+
+	[[nodiscard]] bool IsDelta() { return _baseStateId != 0; }
+	[[nodiscard]] vector<uint8_t>& GetStateData() { return _stateData; }
+
 	void LoadState(Emulator* emu) {
 		std::stringstream ss;
 		ss.write((char*)_stateData.data(), _stateData.size());
@@ -0,0 +1,73 @@
+#pragma once
+#include "pch.h"
+#include "Netplay/NetMessage.h"
+#include "Shared/Emulator.h"
+#include "Utilities/CRC32.h"
+
+/// <summary>
+/// Per-region hashes of the emulation state at a given frame, sent periodically by the
+/// server so clients can detect desyncs without transferring the state itself.
+/// </summary>
+/// <remarks>
+/// Both sides hash their state on the same frames (every HashInterval frames). When a
+/// client's hashes don't match the server's, it sends a ResyncRequestMessage and the server
+/// replies with a delta-encoded SaveStateMessage.
+/// </remarks>
+class StateHashMessage : public NetMessage {
+private:
+	uint32_t _frameCount = 0;
+	vector<uint32_t> _regionHashes;
+
+protected:
+	void Serialize(Serializer& s) override {
+		SV(_frameCount);
+		SVVector(_regionHashes);
+	}
+
+public:
+	static constexpr uint32_t HashInterval = 300;  ///< Frames between desync checks
+	static constexpr uint32_t RegionSize = 0x1000; ///< Bytes of state covered by each hash
+
+	StateHashMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) {}
+
+	StateHashMessage(uint32_t frameCount, const vector<uint32_t>& regionHashes) : NetMessage(MessageType::StateHash) {
+		_frameCount = frameCount;
+		_regionHashes = regionHashes;
+	}
+
+	[[nodiscard]] uint32_t GetFrameCount() { return _frameCount; }
+	[[nodiscard]] vector<uint32_t>& GetRegionHashes() { return _regionHashes; }
+
+	/// <summary>
+	/// Hash each RegionSize block of the state data.
+	/// </summary>
+	static vector<uint32_t> GetRegionHashes(vector<uint8_t>& state) {
+		vector<uint32_t> hashes;
+		hashes.reserve((state.size() + RegionSize - 1) / RegionSize);
+		for (size_t i = 0; i < state.size(); i += RegionSize) {
+			hashes.push_back(CRC32::GetCRC(state.data() + i, std::min<size_t>(RegionSize, state.size() - i)));
+		}
+		return hashes;
+	}
+
+	/// <summary>
+	/// Hash the emulator's current state (without settings, which may legitimately differ).
+	/// </summary>
+	/// <remarks>Must be called from the emulation thread (or with the emulator lock held).</remarks>
+	static vector<uint32_t> GetRegionHashes(Emulator* emu) {
+		vector<uint8_t> state = emu->SerializeToBuffer();
+		return GetRegionHashes(state);
+	}
+
+	/// <summary>
+	/// Count the regions that differ between 2 sets of hashes (regions missing from either side count as different).
+	/// </summary>
+	static uint32_t GetMismatchCount(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+		size_t commonCount = std::min(a.size(), b.size());
+		uint32_t mismatchCount = (uint32_t)(std::max(a.size(), b.size()) - commonCount);
+		for (size_t i = 0; i < commonCount; i++) {
+			mismatchCount += a[i] != b[i] ? 1 : 0;
+		}
+		return mismatchCount;
+	}
+};
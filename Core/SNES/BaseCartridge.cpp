@@ -947,6 +947,9 @@ Gameboy* BaseCartridge::GetGameboy() {
 }
 
 void BaseCartridge::RunCoprocessors() {
+	// Catch up the cycle-synchronized coprocessors (they otherwise only run when the CPU accesses the bus)
+	SyncCoprocessors();
+
 	// These coprocessors are run at the end of the frame, or as needed
 	if (_necDsp) {
 		_necDsp->Run();
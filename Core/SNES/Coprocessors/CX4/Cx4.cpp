@@ -63,13 +63,15 @@ void Cx4::Run() {
 
 	while (_state.CycleCount < targetCycle) {
 		if (_state.Locked) {
-			Step(1);
+			// Only the SNES CPU can unlock the Cx4, skip directly to the target cycle
+			Step(targetCycle - _state.CycleCount);
 		} else if (_state.Suspend.Enabled) {
 			if (_state.Suspend.Duration == 0) {
-				Step(1);
+				Step(targetCycle - _state.CycleCount);
 			} else {
-				Step(1);
-				_state.Suspend.Duration--;
+				uint32_t cycles = (uint32_t)std::min<uint64_t>(_state.Suspend.Duration, targetCycle - _state.CycleCount);
+				Step(cycles);
+				_state.Suspend.Duration -= cycles;
 				if (_state.Suspend.Duration == 0) {
 					_state.Suspend.Enabled = false;
 				}
@@ -53,7 +53,7 @@ private:
 	Cx4State _state;
 
 	/// <summary>Program RAM - 2 pages of 256 instructions each.</summary>
-	uint16_t _prgRam[2][256];
+	uint16_t _prgRam[2][256] = {};
 
 	/// <summary>Data RAM - 3KB of working memory.</summary>
 	uint8_t _dataRam[Cx4::DataRamSize];
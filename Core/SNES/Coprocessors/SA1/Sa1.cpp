@@ -616,7 +616,8 @@ void Sa1::Run() {
 
 	while (_cpu->GetCycleCount() < targetCycle) {
 		if (_state.Sa1Wait || _state.Sa1Reset) {
-			_cpu->IncreaseCycleCount<1>();
+			// Only the SNES CPU can end the wait/reset state, skip directly to the target cycle
+			_cpu->IncreaseCycleCount(targetCycle - _cpu->GetCycleCount());
 		} else if (_state.DmaRunning) {
 			RunDma();
 		} else {
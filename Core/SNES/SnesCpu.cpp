@@ -71,6 +71,7 @@ void SnesCpu::ProcessHaltedState() {
 		// STP was executed, CPU no longer executes any code
 #ifndef DUMMYCPU
 		_memoryManager->IncMasterClock4();
+		_memoryManager->SyncCoprocessors();
 #endif
 	} else {
 		// WAI
@@ -88,6 +89,7 @@ void SnesCpu::Idle() {
 	_memoryManager->SetCpuSpeed(6);
 	ProcessCpuCycle();
 	_memoryManager->IncMasterClock6();
+	_memoryManager->SyncCoprocessors();
 	_emu->ProcessIdleCycle<CpuType::Snes>();
 #endif
 }
@@ -101,6 +103,7 @@ void SnesCpu::IdleOrDummyWrite(uint32_t addr, uint8_t value) {
 		Write(addr, value, MemoryOperationType::DummyWrite);
 	} else {
 		_memoryManager->IncMasterClock6();
+		_memoryManager->SyncCoprocessors();
 		_emu->ProcessIdleCycle<CpuType::Snes>();
 	}
 #endif
@@ -118,6 +121,8 @@ void SnesCpu::ProcessCpuCycle() {
 	_state.CycleCount++;
 	if (_dmaController->HasPendingTransfer()) [[unlikely]] {
 		_state.IrqLock = _dmaController->ProcessPendingTransfers();
+		// Coprocessors may have raised an IRQ during the DMA's idle cycles
+		_memoryManager->SyncCoprocessors();
 	} else {
 		_state.IrqLock = false;
 	}
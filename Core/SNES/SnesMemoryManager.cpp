@@ -238,6 +238,12 @@ void SnesMemoryManager::Exec() {
 		_regs->ProcessIrqCounters();
 	}
 
+	if (_syncCoprocessorsEveryTick) [[unlikely]] {
+		_cart->SyncCoprocessors();
+	}
+}
+
+void SnesMemoryManager::SyncCoprocessors() {
 	_cart->SyncCoprocessors();
 }
 
@@ -285,6 +291,7 @@ void SnesMemoryManager::ProcessEvent() {
 
 uint8_t SnesMemoryManager::Read(uint32_t addr, MemoryOperationType type) {
 	ExecReadTiming();
+	_cart->SyncCoprocessors();
 
 	uint8_t value;
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
@@ -309,12 +316,14 @@ uint8_t SnesMemoryManager::Read(uint32_t addr, MemoryOperationType type) {
 		_cheatManager->ApplyCheat<CpuType::Snes>(addr, value);
 	}
 	IncMasterClock4();
+	_cart->SyncCoprocessors();
 	_emu->ProcessMemoryRead<CpuType::Snes>(addr, value, type);
 	return value;
 }
 
 uint8_t SnesMemoryManager::ReadDma(uint32_t addr, bool forBusA) {
 	IncMasterClock4();
+	_cart->SyncCoprocessors();
 
 	uint8_t value;
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
@@ -366,6 +375,7 @@ void SnesMemoryManager::PeekBlock(uint32_t addr, uint8_t* dest) {
 
 void SnesMemoryManager::Write(uint32_t addr, uint8_t value, MemoryOperationType type) {
 	ExecWriteTiming();
+	_cart->SyncCoprocessors();
 
 	if (_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, type)) {
 		IMemoryHandler* handler = _mappings.GetHandler(addr);
@@ -384,6 +394,7 @@ void SnesMemoryManager::Write(uint32_t addr, uint8_t value, MemoryOperationType
 
 void SnesMemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA) {
 	IncMasterClock4();
+	_cart->SyncCoprocessors();
 	if (_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, MemoryOperationType::DmaWrite)) {
 		IMemoryHandler* handler = _mappings.GetHandler(addr);
 		if (handler) [[likely]] {
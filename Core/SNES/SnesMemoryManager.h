@@ -126,6 +126,9 @@ private:
 	/// <summary>Open bus value.</summary>
 	uint8_t _openBus = 0;
 
+	/// <summary>Also syncs the coprocessors after every master clock tick (see SetSyncCoprocessorsEveryTick).</summary>
+	bool _syncCoprocessorsEveryTick = false;
+
 	/// <summary>Memory mapping tables.</summary>
 	MemoryMappings _mappings = {};
 
@@ -197,6 +200,19 @@ public:
 	/// <summary>Increments master clock by arbitrary value.</summary>
 	void IncrementMasterClockValue(uint16_t value);
 
+	/// <summary>Runs the cycle-synchronized coprocessors (SA-1, GSU, Cx4, SGB) up to the current master clock.</summary>
+	/// <remarks>
+	/// The coprocessors aren't run on every master clock tick - they catch up when the CPU can
+	/// observe them: before every bus access (CPU or DMA) and at the end of every CPU cycle
+	/// (where the IRQ line is sampled). Nothing they depend on changes between these points,
+	/// so running them in larger slices doesn't change their behavior.
+	/// </remarks>
+	void SyncCoprocessors();
+
+	/// <summary>Also syncs the coprocessors after every master clock tick, like before SyncCoprocessors existed.</summary>
+	/// <remarks>Reference mode used by the tests that check the sync points - not saved in save states.</remarks>
+	void SetSyncCoprocessorsEveryTick(bool enabled) { _syncCoprocessorsEveryTick = enabled; }
+
 	/// <summary>Reads byte from memory.</summary>
 	uint8_t Read(uint32_t addr, MemoryOperationType type);
 
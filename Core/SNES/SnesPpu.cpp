@@ -1645,9 +1645,10 @@ void SnesPpu::PrecomputeWindowMasks() {
 	for (uint8_t layer = 0; layer < 6; layer++) {
 		uint8_t activeCount = (uint8_t)_state.Window[0].ActiveLayers[layer] + (uint8_t)_state.Window[1].ActiveLayers[layer];
 
-		// Store window counts for main/sub screen checks
-		_mainWindowCount[layer] = _state.WindowMaskMain[layer] ? activeCount : 0;
-		_subWindowCount[layer] = _state.WindowMaskSub[layer] ? activeCount : 0;
+		// Store window counts for main/sub screen checks (TMW/TSW have no bit for the color window)
+		bool hasScreenMask = layer != SnesPpu::ColorWindowIndex;
+		_mainWindowCount[layer] = (hasScreenMask && _state.WindowMaskMain[layer]) ? activeCount : 0;
+		_subWindowCount[layer] = (hasScreenMask && _state.WindowMaskSub[layer]) ? activeCount : 0;
 
 		// Precompute mask for the full 256-pixel range
 		// Only compute if any window is active for this layer
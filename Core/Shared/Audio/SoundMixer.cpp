@@ -3,6 +3,7 @@
 #include "Shared/Audio/AudioPlayerHud.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
+#include "Shared/FrameProfiler.h"
 #include "Shared/Audio/SoundResampler.h"
 #include "Shared/RewindManager.h"
 #include "Shared/Video/VideoRenderer.h"
@@ -57,10 +58,12 @@ void SoundMixer::StopAudio(bool clearBuffer) {
 }
 
 void SoundMixer::PlayAudioBuffer(int16_t* samples, uint32_t sampleCount, uint32_t sourceRate) {
-	if (sampleCount == 0) {
+	if (sampleCount == 0 || _emu->IsHeadless()) {
+		// Headless instances (batch environments) have no audio output
 		return;
 	}
 
+	PROFILER_SCOPE(_emu->GetFrameProfiler(), FrameProfilerSection::Audio, "PlayAudioBuffer");
 	EmuSettings* settings = _emu->GetSettings();
 	AudioPlayerHud* audioPlayer = _emu->GetAudioPlayerHud();
 	const AudioConfig& cfg = settings->GetAudioConfig();
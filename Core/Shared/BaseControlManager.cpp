@@ -172,6 +172,27 @@ void BaseControlManager::UpdateInputState() {
 	_pollCounter++;
 }
 
+uint64_t BaseControlManager::PeekInputHash() {
+	KeyManager::RefreshKeyState();
+
+	auto lock = _deviceLock.AcquireSafe();
+
+	// FNV-1a over each device's state
+	uint64_t hash = 0xCBF29CE484222325;
+	KeyManager::RunWithoutConsumingMouseMovement([&]() {
+		for (shared_ptr<BaseControlDevice>& device : _controlDevices) {
+			ControlDeviceState prevState = device->GetRawState();
+			device->SetStateFromInput();
+			for (uint8_t value : device->GetRawState().State) {
+				hash = (hash ^ value) * 0x100000001B3;
+			}
+			hash = (hash ^ 0xFF) * 0x100000001B3;
+			device->SetRawState(prevState);
+		}
+	});
+	return hash;
+}
+
 void BaseControlManager::ProcessEndOfFrame() {
 	if (!_wasInputRead) {
 		_lagCounter++;
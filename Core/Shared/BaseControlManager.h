@@ -113,6 +113,13 @@ public:
 	/// </summary>
 	virtual void UpdateInputState();
 
+	/// <summary>
+	/// Hash of the input the controllers would get if they were polled now, without changing their state.
+	/// Only covers input from the host (keyboard/gamepads/mouse) - not input providers (movies, netplay).
+	/// </summary>
+	/// <returns>Hash of all control devices' states</returns>
+	[[nodiscard]] uint64_t PeekInputHash();
+
 	/// <summary>
 	/// Process end of frame (lag detection, poll counter).
 	/// </summary>
@@ -0,0 +1,247 @@
+#include "pch.h"
+#include "Shared/BatchEnvironment.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/BaseControlDevice.h"
+#include "Shared/BatteryManager.h"
+#include "Shared/MessageManager.h"
+#include "Shared/SaveStateManager.h"
+#include "Shared/Video/VideoDecoder.h"
+#include "Shared/Video/BaseVideoFilter.h"
+
+bool BatchEnvironment::Instance::SetInput(BaseControlDevice* device) {
+	// Always provides the input (ports without an input array have no buttons pressed), so the
+	// host's input never reaches the instances
+	device->ClearState();
+	uint8_t port = device->GetPort();
+	if (port < Buttons.size()) {
+		uint32_t buttons = Buttons[port];
+		for (uint8_t bit = 0; buttons != 0; bit++, buttons >>= 1) {
+			if (buttons & 0x01) {
+				device->SetBit(bit);
+			}
+		}
+	}
+	return true;
+}
+
+BatchEnvironment::BatchEnvironment(const BatchEnvironmentConfig& config) {
+	_config = config;
+	_config.InstanceCount = std::max(_config.InstanceCount, 1u);
+	for (BatchRamRange& range : _config.RamRanges) {
+		_ramStride += range.Size;
+	}
+
+	uint32_t threadCount = _config.ThreadCount;
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	threadCount = std::min(threadCount, _config.InstanceCount);
+
+	// The calling thread runs instances too
+	for (uint32_t i = 1; i < threadCount; i++) {
+		_workers.push_back(std::make_unique<Worker>());
+		Worker* worker = _workers.back().get();
+		worker->Thread = std::thread([this, worker]() {
+			while (true) {
+				worker->WaitWork.Wait();
+				if (_stopWorkers) {
+					break;
+				}
+				ProcessJobs();
+				if (--_pendingWorkers == 0) {
+					_pendingWorkers.notify_one();
+				}
+			}
+		});
+	}
+}
+
+BatchEnvironment::~BatchEnvironment() {
+	_stopWorkers = true;
+	for (unique_ptr<Worker>& worker : _workers) {
+		worker->WaitWork.Signal();
+		worker->Thread.join();
+	}
+	ReleaseInstances();
+}
+
+void BatchEnvironment::ReleaseInstances() {
+	for (unique_ptr<Instance>& inst : _instances) {
+		inst->Emu->UnregisterInputProvider(inst.get());
+		inst->Emu->Stop(false, true, false);
+		inst->Emu->Release();
+	}
+	_instances.clear();
+}
+
+bool BatchEnvironment::LoadRom(VirtualFile romFile, VirtualFile patchFile, EmuSettings* settings) {
+	// Read (and patch) the game once, all instances load it from memory
+	vector<uint8_t> romData;
+	if (!romFile.IsValid() || !romFile.ReadFile(romData)) {
+		MessageManager::Log("[BatchEnvironment] Could not read " + romFile.GetFileName());
+		return false;
+	}
+	VirtualFile romImage(romData.data(), romData.size(), romFile.GetFileName());
+	if (patchFile.IsValid() && !romImage.ApplyPatch(patchFile)) {
+		MessageManager::Log("[BatchEnvironment] Could not apply patch " + patchFile.GetFileName());
+		return false;
+	}
+	vector<uint8_t>& image = romImage.GetData();
+
+	ReleaseInstances();
+	for (uint32_t i = 0; i < _config.InstanceCount; i++) {
+		unique_ptr<Instance> inst = std::make_unique<Instance>();
+		inst->Emu = std::make_unique<Emulator>();
+		inst->Emu->InitializeHeadless();
+		if (settings) {
+			inst->Emu->GetSettings()->CopySettings(*settings);
+		}
+
+		// Disable rewind history to reduce memory usage
+		inst->Emu->GetSettings()->GetPreferences().RewindBufferSize = 0;
+
+		// The game's CDL files belong to the main instance
+		inst->Emu->DisableCdlFileSaving();
+
+		if (!inst->Emu->LoadRom(VirtualFile(image.data(), image.size(), romFile.GetFileName()), VirtualFile())) {
+			inst->Emu->Release();
+			ReleaseInstances();
+			return false;
+		}
+
+		// Disable battery saving for this instance
+		inst->Emu->GetBatteryManager()->Initialize("");
+
+		inst->Buttons.resize(_config.PortCount);
+		inst->Emu->RegisterInputProvider(inst.get());
+		if (_config.FrameFormat == BatchFrameFormat::Argb) {
+			inst->VideoFilter.reset(inst->Emu->GetVideoFilter(true));
+		}
+
+		// Sets the version used when the snapshot is loaded
+		inst->State.ResetForFastSave(SaveStateManager::FileFormatVersion);
+		_instances.push_back(std::move(inst));
+	}
+
+	// Start all instances from the first one's power-on state
+	SaveSnapshot(0);
+	Reset();
+	return true;
+}
+
+void BatchEnvironment::ProcessJobs() {
+	uint32_t count = (uint32_t)_instances.size();
+	for (uint32_t i = _nextInstance++; i < count; i = _nextInstance++) {
+		(*_job)(i);
+	}
+}
+
+void BatchEnvironment::RunParallel(const std::function<void(uint32_t)>& job) {
+	// Each thread pulls the next instance as it finishes the previous one
+	_job = &job;
+	_nextInstance = 0;
+	_pendingWorkers = (uint32_t)_workers.size();
+	for (unique_ptr<Worker>& worker : _workers) {
+		worker->WaitWork.Signal();
+	}
+	ProcessJobs();
+	for (uint32_t pending = _pendingWorkers; pending > 0; pending = _pendingWorkers) {
+		_pendingWorkers.wait(pending);
+	}
+	_job = nullptr;
+}
+
+void BatchEnvironment::Step(const uint32_t* inputs, void* frames, BatchStepInfo* info, uint8_t* ram, uint32_t frameCount) {
+	for (uint32_t i = 0; i < _instances.size(); i++) {
+		vector<uint32_t>& buttons = _instances[i]->Buttons;
+		for (uint32_t port = 0; port < buttons.size(); port++) {
+			buttons[port] = inputs ? inputs[i * _config.PortCount + port] : 0;
+		}
+	}
+
+	RunParallel([=, this](uint32_t index) {
+		Instance& inst = *_instances[index];
+		if (!inst.Failed) {
+			try {
+				for (uint32_t i = 0; i < frameCount; i++) {
+					inst.Emu->RunHeadlessFrame();
+				}
+			} catch (std::exception& ex) {
+				MessageManager::Log(std::string("[BatchEnvironment] Instance stopped after an emulation error: ") + ex.what());
+				inst.Failed = true;
+			}
+		}
+
+		// Copied by the thread that ran the frame, while the data is still in its cache
+		CopyFrame(index, frames, info);
+		if (ram) {
+			CopyRam(index, ram + (size_t)index * _ramStride);
+		}
+	});
+}
+
+void BatchEnvironment::CopyFrame(uint32_t index, void* frames, BatchStepInfo* info) {
+	Instance& inst = *_instances[index];
+	const RenderedFrame& frame = inst.Emu->GetVideoDecoder()->GetLastFrame();
+
+	uint32_t width = 0;
+	uint32_t height = 0;
+	if (!inst.Failed && frame.FrameBuffer) {
+		width = frame.Width;
+		height = frame.Height;
+		if (frames && _config.FrameFormat == BatchFrameFormat::Argb) {
+			inst.VideoFilter->SetBaseFrameInfo({frame.Width, frame.Height});
+			FrameInfo size = inst.VideoFilter->SendFrame((uint16_t*)frame.FrameBuffer, frame.FrameNumber, frame.VideoPhaseOffset, frame.Data);
+			width = size.Width;
+			height = width ? std::min(size.Height, _config.FrameStride / width) : 0;
+			uint32_t* out = (uint32_t*)frames + (size_t)index * _config.FrameStride;
+			memcpy(out, inst.VideoFilter->GetOutputBuffer(), (size_t)width * height * sizeof(uint32_t));
+		} else if (frames) {
+			height = width ? std::min(height, _config.FrameStride / width) : 0;
+			uint16_t* out = (uint16_t*)frames + (size_t)index * _config.FrameStride;
+			memcpy(out, frame.FrameBuffer, (size_t)width * height * sizeof(uint16_t));
+		}
+	}
+
+	if (info) {
+		info[index].Width = width;
+		info[index].Height = height;
+		info[index].FrameCount = inst.Failed ? 0 : inst.Emu->GetFrameCount();
+		info[index].Failed = inst.Failed;
+	}
+}
+
+void BatchEnvironment::CopyRam(uint32_t index, uint8_t* ram) {
+	Emulator* emu = _instances[index]->Emu.get();
+	for (BatchRamRange& range : _config.RamRanges) {
+		ConsoleMemoryInfo memory = emu->GetMemory(range.Type);
+		uint32_t size = range.Address < memory.Size ? std::min(range.Size, memory.Size - range.Address) : 0;
+		if (size > 0) {
+			memcpy(ram, (uint8_t*)memory.Memory + range.Address, size);
+		}
+		// Out of range bytes (e.g. memory type the console doesn't have) are returned as 0
+		memset(ram + size, 0, range.Size - size);
+		ram += range.Size;
+	}
+}
+
+void BatchEnvironment::SaveSnapshot(uint32_t index) {
+	Serializer s;
+	s.ResetForFastSave(SaveStateManager::FileFormatVersion);
+	_instances[index]->Emu->StreamHeadlessState(s);
+	_snapshot = s.GetData();
+}
+
+void BatchEnvironment::Reset(const uint8_t* resetFlags) {
+	RunParallel([=, this](uint32_t index) {
+		if (resetFlags && !resetFlags[index]) {
+			return;
+		}
+
+		Instance& inst = *_instances[index];
+		inst.State.ResetForFastLoad(_snapshot);
+		inst.Emu->StreamHeadlessState(inst.State);
+		inst.Failed = false;
+	});
+}
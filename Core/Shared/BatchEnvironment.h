@@ -0,0 +1,144 @@
+#pragma once
+#include "pch.h"
+#include <functional>
+#include <thread>
+#include "Shared/MemoryType.h"
+#include "Shared/Interfaces/IInputProvider.h"
+#include "Utilities/AutoResetEvent.h"
+#include "Utilities/Serializer.h"
+#include "Utilities/VirtualFile.h"
+
+class Emulator;
+class EmuSettings;
+class BaseVideoFilter;
+
+/// <summary>Format of the frames returned by a batch environment</summary>
+enum class BatchFrameFormat : uint8_t {
+	Raw,  ///< Console's 16-bit output, before any video filter (uint16_t per pixel)
+	Argb  ///< Console's default video filter output - no NTSC/scale filters (uint32_t per pixel)
+};
+
+/// <summary>Memory range copied to the RAM observations after each step</summary>
+struct BatchRamRange {
+	MemoryType Type;
+	uint32_t Address;
+	uint32_t Size;
+};
+
+/// <summary>Batch environment settings</summary>
+struct BatchEnvironmentConfig {
+	uint32_t InstanceCount = 1;
+	uint32_t ThreadCount = 0; ///< Threads running the instances, including the caller's (0 = one per core)
+	uint32_t PortCount = 1;   ///< Controller ports driven by the input arrays
+	BatchFrameFormat FrameFormat = BatchFrameFormat::Raw;
+	uint32_t FrameStride = 512 * 480; ///< Pixels per instance in the frame array (rows that don't fit are dropped)
+	vector<BatchRamRange> RamRanges;
+};
+
+/// <summary>Per-instance result of a step (interop structure)</summary>
+struct BatchStepInfo {
+	uint32_t Width;      ///< Frame width
+	uint32_t Height;     ///< Frame height (rows copied to the frame array, when it's given)
+	uint32_t FrameCount; ///< Console's frame counter
+	bool Failed;         ///< The instance stopped after an emulation error (it's no longer run until reset)
+};
+
+/// <summary>
+/// Runs many headless instances of the same game in lockstep, for bots, automated testing and
+/// machine learning.
+/// </summary>
+/// <remarks>
+/// Instances are headless emulators (see Emulator::InitializeHeadless): no video/audio output,
+/// no emulation thread and no frame limiter. Each step runs one or more frames on every instance,
+/// spread over a pool of worker threads, then copies the frames and the selected RAM ranges of
+/// all instances into contiguous arrays provided by the caller:
+/// - inputs: InstanceCount * PortCount button masks (bit N = button N of the controller)
+/// - frames: InstanceCount * FrameStride pixels
+/// - RAM: InstanceCount * GetRamStride() bytes (the RAM ranges, in order)
+///
+/// The game is read (and patched) once - each instance loads it from the shared in-memory image.
+/// Games made of several files (e.g. CD images) aren't supported.
+///
+/// Resets load a snapshot saved with the FastBinary serializer (same as run-ahead). After loading
+/// the game, the snapshot is the power-on state of the first instance, so all instances start
+/// from the same state.
+///
+/// The instances are independent, so the results don't depend on the thread count or on which
+/// thread runs an instance. The environment isn't thread-safe - call it from one thread at a time.
+/// </remarks>
+class BatchEnvironment {
+private:
+	struct Instance : public IInputProvider {
+		unique_ptr<Emulator> Emu;
+		unique_ptr<BaseVideoFilter> VideoFilter;
+		vector<uint32_t> Buttons;
+		Serializer State;
+		bool Failed = false;
+
+		[[nodiscard]] bool SetInput(BaseControlDevice* device) override;
+	};
+
+	struct Worker {
+		std::thread Thread;
+		AutoResetEvent WaitWork;
+	};
+
+	BatchEnvironmentConfig _config;
+	uint32_t _ramStride = 0;
+
+	vector<unique_ptr<Instance>> _instances;
+	vector<uint8_t> _snapshot;
+
+	vector<unique_ptr<Worker>> _workers;
+	const std::function<void(uint32_t)>* _job = nullptr;
+	atomic<bool> _stopWorkers = false;
+	atomic<uint32_t> _pendingWorkers = 0;
+	atomic<uint32_t> _nextInstance = 0;
+
+	void ReleaseInstances();
+	void RunParallel(const std::function<void(uint32_t)>& job);
+	void ProcessJobs();
+
+	void CopyFrame(uint32_t index, void* frames, BatchStepInfo* info);
+	void CopyRam(uint32_t index, uint8_t* ram);
+
+public:
+	BatchEnvironment(const BatchEnvironmentConfig& config);
+	~BatchEnvironment();
+
+	/// <summary>
+	/// Create the instances and load the game in each of them.
+	/// </summary>
+	/// <param name="romFile">Game to load</param>
+	/// <param name="patchFile">Optional patch file (IPS/BPS/UPS)</param>
+	/// <param name="settings">Settings copied to the instances (null = default settings)</param>
+	/// <returns>False if the game couldn't be loaded</returns>
+	[[nodiscard]] bool LoadRom(VirtualFile romFile, VirtualFile patchFile, EmuSettings* settings = nullptr);
+
+	[[nodiscard]] uint32_t GetInstanceCount() { return (uint32_t)_instances.size(); }
+
+	/// <summary>Bytes per instance in the RAM array (total size of the RAM ranges)</summary>
+	[[nodiscard]] uint32_t GetRamStride() { return _ramStride; }
+
+	/// <summary>Get an instance's emulator (to read its state between steps)</summary>
+	[[nodiscard]] Emulator* GetEmulator(uint32_t index) { return _instances[index]->Emu.get(); }
+
+	/// <summary>Set the buttons pressed on a port of an instance, for callers that run the instance's frames themselves</summary>
+	void SetInput(uint32_t index, uint8_t port, uint32_t buttons) { _instances[index]->Buttons[port] = buttons; }
+
+	/// <summary>
+	/// Run frames on all instances, then copy their frames and RAM ranges.
+	/// </summary>
+	/// <param name="inputs">Button masks (InstanceCount * PortCount, null = no buttons pressed)</param>
+	/// <param name="frames">Frame array (InstanceCount * FrameStride pixels, null = no frames)</param>
+	/// <param name="info">Step results (InstanceCount entries, can be null)</param>
+	/// <param name="ram">RAM array (InstanceCount * GetRamStride() bytes, can be null)</param>
+	/// <param name="frameCount">Frames to run with the same input (only the last frame is returned)</param>
+	void Step(const uint32_t* inputs, void* frames, BatchStepInfo* info, uint8_t* ram, uint32_t frameCount = 1);
+
+	/// <summary>Save an instance's current state as the snapshot loaded by Reset</summary>
+	void SaveSnapshot(uint32_t index);
+
+	/// <summary>Load the snapshot in the instances whose flag is set (all instances if null)</summary>
+	void Reset(const uint8_t* resetFlags = nullptr);
+};
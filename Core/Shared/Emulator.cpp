@@ -8,6 +8,7 @@
 #include "Shared/Video/VideoRenderer.h"
 #include "Shared/Video/DebugHud.h"
 #include "Shared/FrameLimiter.h"
+#include "Shared/FrameProfiler.h"
 #include "Shared/MessageManager.h"
 #include "Shared/KeyManager.h"
 #include "Shared/EmuSettings.h"
@@ -18,6 +19,7 @@
 #include "Shared/EmulatorLock.h"
 #include "Shared/DebuggerRequest.h"
 #include "Shared/Movies/MovieManager.h"
+#include "Shared/Movies/Greenzone.h"
 #include "Shared/BatteryManager.h"
 #include "Shared/CheatManager.h"
 #include "Shared/SystemActionManager.h"
@@ -27,6 +29,7 @@
 #include "Netplay/GameClient.h"
 #include "Shared/Interfaces/IConsole.h"
 #include "Shared/Interfaces/IBarcodeReader.h"
+#include "Utilities/ThreadTrace.h"
 #include "Shared/Interfaces/ITapeRecorder.h"
 #include "Shared/BaseControlManager.h"
 #include "SNES/SnesConsole.h"
@@ -113,6 +116,7 @@ Emulator::Emulator() : _settings(new EmuSettings(this)),
                        _soundMixer(new SoundMixer(this)),                // Audio mixing and output
                        _videoRenderer(new VideoRenderer(this)),          // Video output rendering
                        _videoDecoder(new VideoDecoder(this)),            // Video frame decoding/filtering
+                       _frameProfiler(new FrameProfiler()),              // Per-subsystem frame time breakdown
                        _saveStateManager(new SaveStateManager(this)),    // Save state management
                        _cheatManager(new CheatManager(this)),            // Cheat code handling
                        _movieManager(new MovieManager(this)),            // Movie recording/playback
@@ -147,6 +151,11 @@ void Emulator::Initialize(bool enableShortcuts) {
 	_videoRenderer->StartThread();
 }
 
+void Emulator::InitializeHeadless() {
+	_headless = true;
+	_systemActionManager = std::make_unique<SystemActionManager>(this);
+}
+
 void Emulator::Release() {
 	Stop(true);
 
@@ -176,6 +185,7 @@ void Emulator::Run() {
 	PlatformUtilities::DisableScreensaver();
 
 	_emulationThreadId = std::this_thread::get_id();
+	THREAD_TRACE_NAME("Emulation");
 
 	_frameDelay = GetFrameDelay();
 	_stats = std::make_unique<DebugStats>();
@@ -184,12 +194,24 @@ void Emulator::Run() {
 
 	while (!_stopFlag) {
 		try {
+			FRAME_PROFILER_FRAME(_frameProfiler.get());
+
 			uint32_t emulationSpeed = _settings->GetEmulationSpeed();
 			bool useRunAhead = _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_audioPlayerHud && !_rewindManager->IsRewinding() && emulationSpeed > 0 && emulationSpeed <= 100;
-			if (useRunAhead) {
+			if (_greenzoneSeekFrame >= 0) {
+				// TAS editor seek - runs instead of the next frame (and while paused)
+				ProcessGreenzoneSeek();
+			} else if (useRunAhead && IsPreemptiveRunAheadAllowed()) {
+				PROFILER_SCOPE(_frameProfiler.get(), FrameProfilerSection::RunAhead, "RunAhead");
+				RunFrameWithPreemptiveRunAhead();
+			} else if (useRunAhead) {
+				_runAheadStates.Clear();
+				PROFILER_SCOPE(_frameProfiler.get(), FrameProfilerSection::RunAhead, "RunAhead");
 				RunFrameWithRunAhead();
 			} else {
-				_console->RunFrame();
+				_runAheadStates.Clear();
+				RunDisplayedFrame();
+				CaptureGreenzoneState();
 				_rewindManager->ProcessEndOfFrame();
 				_historyViewer->ProcessEndOfFrame();
 				ProcessSystemActions();
@@ -279,7 +301,7 @@ void Emulator::RunFrameWithRunAhead() {
 	_isRunAheadFrame = false;
 
 	// Run one frame normally (with audio/video output)
-	_console->RunFrame();
+	RunDisplayedFrame();
 	_rewindManager->ProcessEndOfFrame();
 	_historyViewer->ProcessEndOfFrame();
 
@@ -293,13 +315,134 @@ void Emulator::RunFrameWithRunAhead() {
 	}
 }
 
+void Emulator::RunHeadlessFrame() {
+	// The calling thread (e.g. a batch environment worker) is the emulation thread until the frame ends
+	_emulationThreadId = std::this_thread::get_id();
+	_console->RunFrame();
+	_emulationThreadId = thread::id();
+}
+
+void Emulator::StreamHeadlessState(Serializer& s) {
+	_emulationThreadId = std::this_thread::get_id();
+	s.Stream(*_console.get(), "", -1);
+	_emulationThreadId = thread::id();
+}
+
+void Emulator::RunDisplayedFrame() {
+	PROFILER_SCOPE(_frameProfiler.get(), FrameProfilerSection::Console, "RunFrame");
+	_console->RunFrame();
+}
+
+bool Emulator::IsPreemptiveRunAheadAllowed() {
+	// Input is peeked from the host before the frame runs, which doesn't work for input that
+	// comes from input providers (movies, netplay). Recorded input must also match the frames
+	// as they were run, which isn't the case for frames that are run again.
+	if (!_settings->GetEmulationConfig().PreemptiveRunAhead) {
+		return false;
+	}
+	return !_movieManager->Playing() && !_movieManager->Recording() && !_gameServer->Started() && !_gameClient->Connected();
+}
+
+void Emulator::RunFrameWithPreemptiveRunAhead() {
+	uint32_t runAheadFrames = _settings->GetEmulationConfig().RunAheadFrames;
+	uint64_t inputHash = _console->GetControlManager()->PeekInputHash();
+
+	_isRunAheadFrame = true;
+	bool runFramesAhead = false;
+	if (!_runAheadStates.IsValid(runAheadFrames, GetFrameCount())) {
+		// First frame (or the state/frame count changed) - the current frame becomes the confirmed frame
+		_runAheadStates.Reset(runAheadFrames);
+		runFramesAhead = true;
+	} else if (_runAheadStates.GetInputHash() != inputHash) {
+		// Input changed - go back to the confirmed frame and run the frames again with the new input
+		runFramesAhead = _runAheadStates.LoadOldest(*_console.get());
+	}
+
+	if (runFramesAhead) {
+		for (uint32_t i = 0; i < runAheadFrames; i++) {
+			_runAheadStates.Save(*_console.get(), SaveStateManager::FileFormatVersion);
+			_console->RunFrame();
+		}
+	}
+
+	// Run one frame normally (with audio/video output) - the oldest snapshot is dropped
+	_runAheadStates.Save(*_console.get(), SaveStateManager::FileFormatVersion);
+	_isRunAheadFrame = false;
+
+	RunDisplayedFrame();
+	_rewindManager->ProcessEndOfFrame();
+	_historyViewer->ProcessEndOfFrame();
+
+	if (ProcessSystemActions()) {
+		_runAheadStates.Clear();
+	} else {
+		_runAheadStates.EndFrame(inputHash, GetFrameCount());
+	}
+}
+
+void Emulator::EnableGreenzone(const GreenzoneConfig& config) {
+	if (!_greenzone) {
+		_greenzone = std::make_unique<Greenzone>();
+	}
+	_greenzone->SetConfig(config);
+}
+
+void Emulator::DisableGreenzone() {
+	_greenzoneSeekFrame = -1;
+	_greenzone.reset();
+}
+
+bool Emulator::RequestGreenzoneSeek(uint32_t frame) {
+	auto lock = AcquireLock();
+	if (!_greenzone || !_greenzone->GetNearestFrame(frame)) {
+		return false;
+	}
+	_greenzoneSeekFrame = frame;
+	return true;
+}
+
+void Emulator::CaptureGreenzoneState() {
+	if (_greenzone) {
+		uint32_t frame = GetFrameCount();
+		if (_greenzone->IsCaptureFrame(frame)) {
+			_greenzone->Capture(*_console.get(), frame, SaveStateManager::FileFormatVersion);
+		}
+	}
+}
+
+void Emulator::ProcessGreenzoneSeek() {
+	int64_t target = _greenzoneSeekFrame.exchange(-1);
+	if (!_greenzone || target < 0) {
+		return;
+	}
+
+	optional<uint32_t> frame = _greenzone->LoadNearest(*_console.get(), (uint32_t)target);
+	if (!frame) {
+		return;
+	}
+	_runAheadStates.Clear();
+
+	// Emulate forward to the target frame - only the last frame is displayed. States are
+	// captured along the way, so seeking around this frame again is instant.
+	for (uint32_t i = *frame; i < (uint32_t)target && !_stopFlag && _greenzoneSeekFrame < 0; i++) {
+		_isRunAheadFrame = i + 1 < (uint32_t)target;
+		_console->RunFrame();
+		_isRunAheadFrame = false;
+		CaptureGreenzoneState();
+	}
+
+	_notificationManager->SendNotification(ConsoleNotificationType::StateLoaded);
+}
+
 void Emulator::OnBeforeSendFrame() {
 	if (!_isRunAheadFrame) {
 		if (_audioPlayerHud) {
 			_audioPlayerHud->Draw(GetFrameCount(), GetFps());
 		}
 
-		if (_stats && _settings->GetPreferences().ShowDebugInfo && _debugger.lock()) {
+		bool showStats = _stats && _settings->GetPreferences().ShowDebugInfo && _debugger.lock();
+		_frameProfiler->SetEnabled(FrameProfiler::Client::Hud, showStats);
+		if (showStats) {
 			double lastFrameTime = _lastFrameTimer.GetElapsedMS();
 			_lastFrameTimer.Reset();
 			_stats->DisplayStats(this, lastFrameTime);
@@ -309,18 +452,23 @@ void Emulator::OnBeforeSendFrame() {
 
 void Emulator::ProcessEndOfFrame() {
 	if (!_isRunAheadFrame) {
-		_frameLimiter->ProcessFrame();
-		while (_frameLimiter->WaitForNextFrame()) {
-			if (_stopFlag || _frameDelay != GetFrameDelay() || _paused || _pauseOnNextFrame || _lockCounter > 0) {
-				// Need to process another event, stop sleeping
-				break;
+		if (!_headless) {
+			{
+				PROFILER_SCOPE(_frameProfiler.get(), FrameProfilerSection::Wait, "FrameLimiter");
+				_frameLimiter->ProcessFrame();
+				while (_frameLimiter->WaitForNextFrame()) {
+					if (_stopFlag || _frameDelay != GetFrameDelay() || _paused || _pauseOnNextFrame || _lockCounter > 0) {
+						// Need to process another event, stop sleeping
+						break;
+					}
+				}
 			}
-		}
 
-		double newFrameDelay = GetFrameDelay();
-		if (newFrameDelay != _frameDelay) {
-			_frameDelay = newFrameDelay;
-			_frameLimiter->SetDelay(_frameDelay);
+			double newFrameDelay = GetFrameDelay();
+			if (newFrameDelay != _frameDelay) {
+				_frameDelay = newFrameDelay;
+				_frameLimiter->SetDelay(_frameDelay);
+			}
 		}
 
 		_console->GetControlManager()->ProcessEndOfFrame();
@@ -354,13 +502,13 @@ void Emulator::Stop(bool sendNotification, bool preventRecentGameSave, bool save
 		_console->SaveBattery();
 	}
 
-	if (!preventRecentGameSave && _console && !_settings->GetPreferences().DisableGameSelectionScreen && !_audioPlayerHud) {
+	if (!preventRecentGameSave && _console && !_settings->GetPreferences().DisableGameSelectionScreen && !_audioPlayerHud && !_headless) {
 		RomInfo romInfo = GetRomInfo();
 		_saveStateManager->SaveRecentGame(romInfo.RomFile.GetFileName(), romInfo.RomFile, romInfo.PatchFile);
 	}
 
 	// Save recent play state while console is still alive (before destruction below)
-	if (_console) {
+	if (_console && !_headless) {
 		(void)_saveStateManager->SaveRecentPlayState();
 	}
 
@@ -372,6 +520,9 @@ void Emulator::Stop(bool sendNotification, bool preventRecentGameSave, bool save
 	_videoDecoder->StopThread();
 	_rewindManager->Reset();
 
+	// Queued save states render their thumbnail with the current console's video filter
+	_saveStateManager->FlushPendingWrites();
+
 	if (_console) {
 		_console.reset();
 	}
@@ -436,8 +587,10 @@ bool Emulator::LoadRom(VirtualFile romFile, VirtualFile patchFile, bool stopRom,
 	try {
 		result = InternalLoadRom(romFile, patchFile, stopRom, forPowerCycle);
 	} catch (std::exception& ex) {
-		_videoDecoder->StartThread();
-		_videoRenderer->StartThread();
+		if (!_headless) {
+			_videoDecoder->StartThread();
+			_videoRenderer->StartThread();
+		}
 
 		MessageManager::DisplayMessage("Error", "UnexpectedError", ex.what());
 		Stop(false, true, false);
@@ -608,12 +761,19 @@ bool Emulator::InternalLoadRom(VirtualFile romFile, VirtualFile patchFile, bool
 	_notificationManager->SendNotification(ConsoleNotificationType::GameLoaded, &params);
 	_threadPaused = false;
 
-	if (!forPowerCycle && !_audioPlayerHud) {
+	if (!forPowerCycle && !_audioPlayerHud && !_headless) {
 		ConsoleRegion region = _console->GetRegion();
 		string modelName = region == ConsoleRegion::Pal ? "PAL" : (region == ConsoleRegion::Dendy ? "Dendy" : "NTSC");
 		MessageManager::DisplayMessage(modelName, FolderUtilities::GetFilename(GetRomInfo().RomFile.GetFileName(), false));
 	}
 
+	if (_headless) {
+		// Frames are run by the caller (RunHeadlessFrame) - clear the flag set by Stop() above,
+		// code running in the frame (e.g. ComLynx lockstep waits) checks it with IsStopping()
+		_stopFlag = false;
+		return true;
+	}
+
 	_videoDecoder->StartThread();
 	_videoRenderer->StartThread();
 
@@ -638,6 +798,9 @@ void Emulator::InitConsole(unique_ptr<IConsole>& newConsole, ConsoleMemoryInfo o
 		}
 	}
 
+	// Queued save states render their thumbnail with the current console's video filter
+	_saveStateManager->FlushPendingWrites();
+
 	_console.reset(newConsole);
 	_consoleType = _console->GetConsoleType();
 	_notificationManager->RegisterNotificationListener(_console.lock());
@@ -898,6 +1061,7 @@ void Emulator::OnBeforePause(bool clearAudioBuffer) {
 }
 
 void Emulator::WaitForPauseEnd() {
+	PROFILER_SCOPE(_frameProfiler.get(), FrameProfilerSection::Wait, "Paused");
 	_notificationManager->SendNotification(ConsoleNotificationType::GamePaused);
 
 	OnBeforePause(false);
@@ -906,7 +1070,7 @@ void Emulator::WaitForPauseEnd() {
 	PlatformUtilities::EnableScreensaver();
 	PlatformUtilities::RestoreTimerResolution();
 
-	while (_paused && !_rewindManager->IsRewinding() && !_stopFlag && !_debugger) {
+	while (_paused && !_rewindManager->IsRewinding() && !_stopFlag && !_debugger && _greenzoneSeekFrame < 0) {
 		// Sleep until emulation is resumed
 		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(30));
 
@@ -938,6 +1102,7 @@ EmulatorLock Emulator::AcquireLock(bool allowDebuggerLock) {
 }
 
 void Emulator::Lock() {
+	THREAD_TRACE_SCOPE("EmulatorLock");
 	SuspendDebugger(false);
 	_lockCounter++;
 	_runLock.Acquire();
@@ -962,6 +1127,8 @@ void Emulator::SuspendDebugger(bool release) {
 
 void Emulator::WaitForLock() {
 	if (_lockCounter > 0) {
+		PROFILER_SCOPE(_frameProfiler.get(), FrameProfilerSection::Wait, "WaitForLock");
+
 		// Need to temporarely pause the emu (to save/load a state, etc.)
 		_runLock.Release();
 
@@ -1035,6 +1202,9 @@ DeserializeResult Emulator::Deserialize(istream& in, uint32_t fileFormatVersion,
 		return DeserializeResult::SpecificError;
 	}
 
+	// Frames run ahead by preemptive run-ahead no longer follow the loaded state
+	_runAheadStates.Clear();
+
 	if (sendNotification) {
 		_notificationManager->SendNotification(ConsoleNotificationType::StateLoaded);
 	}
@@ -1080,6 +1250,17 @@ ShortcutState Emulator::IsShortcutAllowed(EmulatorShortcut shortcut, uint32_t sh
 	return console ? console->IsShortcutAllowed(shortcut, shortcutParam) : ShortcutState::Default;
 }
 
+bool Emulator::IsIdleLoopSkipAllowed() {
+	// Skipping an idle loop can shift the point in the loop where the game sees an event (but not the event itself),
+	// so it is disabled whenever the emulation must match another run exactly (movies, netplay, run-ahead),
+	// and while debugging (breakpoints and the trace logger must see every instruction)
+	EmulationConfig& cfg = _settings->GetEmulationConfig();
+	if (!cfg.SkipIdleLoops || cfg.RunAheadFrames > 0 || _debugger) {
+		return false;
+	}
+	return !_movieManager->Playing() && !_movieManager->Recording() && !_gameServer->Started() && !_gameClient->Connected();
+}
+
 bool Emulator::IsKeyboardConnected() {
 	shared_ptr<IConsole> console = GetConsole();
 	return console ? console->GetControlManager()->IsKeyboardConnected() : false;
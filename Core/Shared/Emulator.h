@@ -6,6 +6,7 @@
 #include "Core/Shared/EmulatorLock.h"
 #include "Core/Shared/Interfaces/IConsole.h"
 #include "Core/Shared/LightweightCdlRecorder.h"
+#include "Core/Shared/RunAheadStateRing.h"
 #include "Core/Shared/Audio/AudioPlayerTypes.h"
 #include "Utilities/Timer.h"
 #include "Utilities/safe_ptr.h"
@@ -27,6 +28,9 @@ class CheatManager;
 class MovieManager;
 class HistoryViewer;
 class FrameLimiter;
+class FrameProfiler;
+class Greenzone;
+struct GreenzoneConfig;
 class DebugStats;
 class BaseControlManager;
 class VirtualFile;
@@ -118,6 +122,7 @@ private:
 	const unique_ptr<SoundMixer> _soundMixer;                   ///< Audio mixing/output
 	const unique_ptr<VideoRenderer> _videoRenderer;             ///< Video output/filters
 	const unique_ptr<VideoDecoder> _videoDecoder;               ///< Frame decoding
+	const unique_ptr<FrameProfiler> _frameProfiler;             ///< Per-subsystem frame time breakdown
 	const unique_ptr<SaveStateManager> _saveStateManager;       ///< Save state management
 	const unique_ptr<CheatManager> _cheatManager;               ///< Cheat code support
 	const unique_ptr<MovieManager> _movieManager;               ///< TAS recording/playback
@@ -146,9 +151,22 @@ private:
 	atomic<bool> _isRunAheadFrame;
 	bool _frameRunning = false;
 
+	/// <summary>Headless instance (batch environments) - no video threads, frames are run by the caller</summary>
+	bool _headless = false;
+
+	/// <summary>The debugger never saves the game's CDL files (see DisableCdlFileSaving)</summary>
+	bool _cdlFileSavingDisabled = false;
+
 	/// <summary>Persistent FastBinary serializer for run-ahead (eliminates all string key overhead + buffer reuse)</summary>
 	Serializer _runAheadSerializer;
 
+	/// <summary>Snapshots of the frames run ahead, for preemptive run-ahead</summary>
+	RunAheadStateRing _runAheadStates;
+
+	/// <summary>TAS greenzone (null when disabled) - states captured at the end of frames</summary>
+	unique_ptr<Greenzone> _greenzone;
+	atomic<int64_t> _greenzoneSeekFrame = -1;
+
 	RomInfo _rom;
 	ConsoleType _consoleType = {};
 
@@ -169,6 +187,11 @@ private:
 	void ProcessAutoSaveState();
 	bool ProcessSystemActions();
 	void RunFrameWithRunAhead();
+	void RunDisplayedFrame();
+	void RunFrameWithPreemptiveRunAhead();
+	[[nodiscard]] bool IsPreemptiveRunAheadAllowed();
+	void CaptureGreenzoneState();
+	void ProcessGreenzoneSeek();
 
 	void BlockDebuggerRequests();
 	void ResetDebugger(bool startDebugger = false);
@@ -190,6 +213,30 @@ public:
 	void Initialize(bool enableShortcuts = true);
 	void Release();
 
+	/// <summary>
+	/// Initialize a headless instance (used by batch environments): no video decode/render threads,
+	/// no emulation thread, no audio output and no frame limiter. Loading a ROM doesn't start the
+	/// emulation - frames are run by the caller with RunHeadlessFrame.
+	/// </summary>
+	void InitializeHeadless();
+
+	/// <summary>Check if this is a headless instance (see InitializeHeadless)</summary>
+	[[nodiscard]] bool IsHeadless() { return _headless; }
+
+	/// <summary>Run one frame on the calling thread (headless instances only)</summary>
+	void RunHeadlessFrame();
+
+	/// <summary>Save or load the console's state with a FastBinary serializer on the calling thread (headless instances only)</summary>
+	void StreamHeadlessState(Serializer& s);
+
+	/// <summary>
+	/// Prevent this instance's debugger from saving the game's CDL files, for instances that run
+	/// the same game as the main instance (batch environments, input search workers) - their
+	/// CDL data would overwrite the main instance's file. Call before attaching the debugger.
+	/// </summary>
+	void DisableCdlFileSaving() { _cdlFileSavingDisabled = true; }
+	[[nodiscard]] bool IsCdlFileSavingDisabled() { return _cdlFileSavingDisabled; }
+
 	void Run();
 	void Stop(bool sendNotification, bool preventRecentGameSave = false, bool saveBattery = true);
 
@@ -330,6 +377,9 @@ public:
 	/// <summary>Get video decoder</summary>
 	VideoDecoder* GetVideoDecoder() { return _videoDecoder.get(); }
 
+	/// <summary>Get frame profiler (per-subsystem frame time breakdown)</summary>
+	FrameProfiler* GetFrameProfiler() { return _frameProfiler.get(); }
+
 	/// <summary>Get shortcut key handler</summary>
 	ShortcutKeyHandler* GetShortcutKeyHandler() { return _shortcutKeyHandler.get(); }
 
@@ -364,6 +414,26 @@ public:
 	/// <summary>Get history viewer</summary>
 	HistoryViewer* GetHistoryViewer() { return _historyViewer.get(); }
 
+	/// <summary>Get TAS greenzone (null when disabled) - call with the emulation lock held</summary>
+	Greenzone* GetGreenzone() { return _greenzone.get(); }
+
+	/// <summary>
+	/// Enable (or reconfigure) the TAS greenzone - call with the emulation lock held.
+	/// </summary>
+	/// <param name="config">Greenzone settings (existing states are kept)</param>
+	void EnableGreenzone(const GreenzoneConfig& config);
+
+	/// <summary>Disable the TAS greenzone and free its states - call with the emulation lock held</summary>
+	void DisableGreenzone();
+
+	/// <summary>
+	/// Seek to a frame using the greenzone: the emulation thread loads the nearest state before
+	/// it and emulates the frames after it (without audio/video output), before the next frame.
+	/// </summary>
+	/// <param name="frame">Target frame (frame count)</param>
+	/// <returns>False if the greenzone has no state at or before this frame</returns>
+	bool RequestGreenzoneSeek(uint32_t frame);
+
 	/// <summary>Get netplay server</summary>
 	GameServer* GetGameServer() { return _gameServer.get(); }
 
@@ -464,9 +534,15 @@ public:
 	/// <summary>Check if emulator running (ROM loaded)</summary>
 	[[nodiscard]] bool IsRunning() { return _console != nullptr; }
 
+	/// <summary>Check if the emulation thread was asked to stop (see Stop)</summary>
+	[[nodiscard]] bool IsStopping() { return _stopFlag; }
+
 	/// <summary>Check if currently executing run-ahead frame</summary>
 	[[nodiscard]] bool IsRunAheadFrame() { return _isRunAheadFrame; }
 
+	/// <summary>Check if the CPU cores may skip idle loops (setting enabled and no cycle-exact replay required)</summary>
+	[[nodiscard]] bool IsIdleLoopSkipAllowed();
+
 	/// <summary>Get timing info for CPU type</summary>
 	TimingInfo GetTimingInfo(CpuType cpuType);
 
@@ -0,0 +1,69 @@
+#include "pch.h"
+#include <bit>
+#include "Shared/FrameProfiler.h"
+
+thread_local FrameProfilerScope* FrameProfilerScope::_current = nullptr;
+
+uint32_t FrameProfiler::GetBucket(uint64_t ns) {
+	uint64_t us = ns / 1000;
+	return std::min<uint32_t>((uint32_t)std::bit_width(us), FrameProfilerBucketCount - 1);
+}
+
+void FrameProfiler::SetEnabled(Client client, bool enabled) {
+	if (enabled) {
+		_enabledClients.fetch_or((uint8_t)client);
+	} else {
+		_enabledClients.fetch_and((uint8_t)~(uint8_t)client);
+	}
+}
+
+void FrameProfiler::EndFrame() {
+	std::lock_guard<std::mutex> lock(_lock);
+
+	for (int i = 0; i < (int)FrameProfilerSection::Count; i++) {
+		uint64_t ns = _pendingNs[i].exchange(0, std::memory_order_relaxed);
+		_window[i][_windowPos] = ns;
+		_stats.Sections[i].Histogram[GetBucket(ns)]++;
+	}
+
+	_windowPos = (_windowPos + 1) % WindowSize;
+	_windowCount = std::min(_windowCount + 1, WindowSize);
+	_stats.FrameCount++;
+}
+
+void FrameProfiler::Reset() {
+	std::lock_guard<std::mutex> lock(_lock);
+	for (atomic<uint64_t>& pending : _pendingNs) {
+		pending = 0;
+	}
+	memset(_window, 0, sizeof(_window));
+	_windowPos = 0;
+	_windowCount = 0;
+	_stats = {};
+}
+
+FrameProfilerStats FrameProfiler::GetStats() {
+	std::lock_guard<std::mutex> lock(_lock);
+
+	FrameProfilerStats stats = _stats;
+	if (_windowCount == 0) {
+		return stats;
+	}
+
+	uint32_t lastPos = (_windowPos + WindowSize - 1) % WindowSize;
+	for (int i = 0; i < (int)FrameProfilerSection::Count; i++) {
+		uint64_t total = 0;
+		uint64_t max = 0;
+		for (uint32_t j = 0; j < _windowCount; j++) {
+			uint64_t ns = _window[i][(lastPos + WindowSize - j) % WindowSize];
+			total += ns;
+			max = std::max(max, ns);
+		}
+
+		FrameProfilerSectionStats& section = stats.Sections[i];
+		section.LastMs = _window[i][lastPos] / 1000000.0;
+		section.AverageMs = total / 1000000.0 / _windowCount;
+		section.MaxMs = max / 1000000.0;
+	}
+	return stats;
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include "pch.h"
+#include <chrono>
+#include <mutex>
+#include "Utilities/ThreadTrace.h"
+
+/// <summary>
+/// Parts of a frame measured by the frame profiler.
+/// </summary>
+/// <remarks>
+/// The times are exclusive: time spent in a nested probe (e.g. audio, which is played from
+/// within IConsole::RunFrame) is only counted in the nested probe's section. All sections except
+/// VideoDecode run on the emulation thread, and add up to the Total section.
+/// </remarks>
+enum class FrameProfilerSection : uint8_t {
+	Total,       ///< Whole Emulator::Run loop iteration
+	Console,     ///< IConsole::RunFrame for the displayed frame (CPU, PPU, APU, coprocessors)
+	RunAhead,    ///< Run-ahead frames and state save/load
+	Rewind,      ///< RewindManager::ProcessEndOfFrame (rewind state capture)
+	Audio,       ///< SoundMixer::PlayAudioBuffer (audio effects, resampling, output)
+	Wait,        ///< Frame limiter, pause and emulation lock waits
+	Other,       ///< Rest of the Emulator::Run loop iteration
+	VideoDecode, ///< VideoDecoder::DecodeFrame (video filters, on the decode thread)
+	Count
+};
+
+/// <summary>Per-frame time histogram bucket count - bucket 0 counts frames under 1 microsecond, bucket N > 0 counts frames that took [2^(N-1), 2^N) microseconds</summary>
+constexpr uint32_t FrameProfilerBucketCount = 18;
+
+/// <summary>
+/// Timing statistics of a frame profiler section.
+/// </summary>
+struct FrameProfilerSectionStats {
+	double LastMs;    ///< Time spent in the last frame
+	double AverageMs; ///< Average time per frame (last 60 frames)
+	double MaxMs;     ///< Max time per frame (last 60 frames)
+	uint32_t Histogram[FrameProfilerBucketCount]; ///< Frame counts per time bucket (since the last reset)
+};
+
+/// <summary>
+/// Frame profiler statistics (interop structure).
+/// </summary>
+struct FrameProfilerStats {
+	uint32_t FrameCount; ///< Frames recorded since the last reset
+	FrameProfilerSectionStats Sections[(int)FrameProfilerSection::Count];
+};
+
+/// <summary>
+/// Breaks down the time taken by each frame between the emulator's subsystems.
+/// </summary>
+/// <remarks>
+/// Probes (FrameProfilerScope) accumulate the time spent in each section during the current
+/// frame, and the per-frame totals are added to the histograms at the end of each frame.
+///
+/// The profiler is enabled by the debug HUD (when the debug info is shown) or through the interop
+/// API. When disabled, a probe costs a single relaxed atomic load - defining
+/// NEXEN_NO_FRAME_PROFILER removes the probes entirely.
+/// </remarks>
+class FrameProfiler {
+public:
+	static constexpr uint32_t WindowSize = 60;
+
+	enum class Client : uint8_t {
+		Api = 0x01,
+		Hud = 0x02
+	};
+
+private:
+	atomic<uint8_t> _enabledClients = 0;
+	atomic<uint64_t> _pendingNs[(int)FrameProfilerSection::Count] = {};
+
+	std::mutex _lock;
+	uint64_t _window[(int)FrameProfilerSection::Count][WindowSize] = {};
+	uint32_t _windowPos = 0;
+	uint32_t _windowCount = 0;
+	FrameProfilerStats _stats = {};
+
+public:
+	[[nodiscard]] static uint64_t GetTimestamp() {
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	[[nodiscard]] static uint32_t GetBucket(uint64_t ns);
+
+	[[nodiscard]] bool IsEnabled() const { return _enabledClients.load(std::memory_order_relaxed) != 0; }
+
+	/// <summary>Enable/disable profiling on behalf of a client - profiling stays on while any client needs it</summary>
+	void SetEnabled(Client client, bool enabled);
+
+	/// <summary>Add time to a section for the current frame (thread-safe)</summary>
+	void AddTime(FrameProfilerSection section, uint64_t ns) {
+		_pendingNs[(int)section].fetch_add(ns, std::memory_order_relaxed);
+	}
+
+	/// <summary>Add the current frame's times to the statistics (called by the emulation thread)</summary>
+	void EndFrame();
+
+	/// <summary>Clear the statistics and histograms</summary>
+	void Reset();
+
+	[[nodiscard]] FrameProfilerStats GetStats();
+};
+
+/// <summary>
+/// Adds the time spent in its scope to a frame profiler section (minus the time spent in the
+/// nested probes on the same thread).
+/// </summary>
+class FrameProfilerScope {
+private:
+	static thread_local FrameProfilerScope* _current;
+
+	FrameProfiler* _profiler = nullptr;
+	FrameProfilerScope* _parent = nullptr;
+	uint64_t _start = 0;
+	uint64_t _childTime = 0;
+	FrameProfilerSection _section = FrameProfilerSection::Other;
+	bool _endFrame = false;
+
+public:
+	/// <param name="profiler">Profiler (nothing is recorded if it's disabled)</param>
+	/// <param name="section">Section to add the time to</param>
+	/// <param name="endFrame">Frame scope - also adds the whole scope to Total and ends the frame</param>
+	FrameProfilerScope(FrameProfiler* profiler, FrameProfilerSection section, bool endFrame = false) {
+		if (profiler->IsEnabled()) {
+			_profiler = profiler;
+			_section = section;
+			_endFrame = endFrame;
+			_parent = _current;
+			_current = this;
+			_start = FrameProfiler::GetTimestamp();
+		}
+	}
+
+	~FrameProfilerScope() {
+		if (!_profiler) {
+			return;
+		}
+
+		uint64_t elapsed = FrameProfiler::GetTimestamp() - _start;
+		_profiler->AddTime(_section, elapsed - std::min(elapsed, _childTime));
+		_current = _parent;
+		if (_parent) {
+			_parent->_childTime += elapsed;
+		}
+
+		if (_endFrame) {
+			_profiler->AddTime(FrameProfilerSection::Total, elapsed);
+			_profiler->EndFrame();
+		}
+	}
+
+	FrameProfilerScope(const FrameProfilerScope&) = delete;
+	FrameProfilerScope& operator=(const FrameProfilerScope&) = delete;
+};
+
+#ifndef NEXEN_NO_FRAME_PROFILER
+#define FRAME_PROFILER_SCOPE(profiler, section) FrameProfilerScope _frameProfilerScope((profiler), (section))
+#define FRAME_PROFILER_FRAME(profiler) FrameProfilerScope _frameProfilerScope((profiler), FrameProfilerSection::Other, true)
+#else
+#define FRAME_PROFILER_SCOPE(profiler, section)
+#define FRAME_PROFILER_FRAME(profiler)
+#endif
+
+/// <summary>
+/// Profiles a scope in both tools: its time is added to a frame profiler section, and it's recorded
+/// as a span named traceName in the thread trace. Either one is removed when compiled out.
+/// </summary>
+#define PROFILER_SCOPE(profiler, section, traceName) \
+	FRAME_PROFILER_SCOPE(profiler, section);          \
+	THREAD_TRACE_SCOPE(traceName)
@@ -0,0 +1,108 @@
+#pragma once
+#include "pch.h"
+
+/// <summary>
+/// Detects side-effect-free polling loops (e.g. waiting for VBlank/VCOUNT or a RAM flag set by an IRQ handler).
+/// </summary>
+/// <remarks>
+/// The CPU core reports every taken backward branch along with a hash of its registers, a counter of the
+/// bus accesses that could have side effects (writes, reads from registers that change on access or over
+/// time) and the master clock.
+///
+/// A loop is considered idle once several consecutive iterations:
+/// - branch from the same address to the same (nearby) target
+/// - start with exactly the same register values
+/// - perform no access that has side effects
+/// - take exactly the same number of cycles
+///
+/// Such an iteration is a pure function of the values it reads, so until an event changes one of those
+/// values (new scanline, IRQ flag, DMA, etc.), running it again produces the exact same state.
+/// The core can then run the rest of the system up to its next event in one step, and resume the loop
+/// from the start of an iteration.
+///
+/// The detector's state is not saved in save states - cores reset it when a state is loaded.
+/// </remarks>
+class IdleLoopDetector {
+private:
+	uint32_t _branchAddr = 0;
+	uint32_t _target = 0;
+	uint64_t _stateHash = 0;
+	uint32_t _sideEffectCount = 0;
+	uint64_t _lastClock = 0;
+	uint32_t _iterationCycles = 0;
+	uint32_t _matchCount = 0;
+
+public:
+	/// <summary>Maximum distance (in bytes) between the backward branch and its target</summary>
+	static constexpr uint32_t MaxLoopSize = 32;
+
+	/// <summary>Maximum length of a single iteration, in master clocks</summary>
+	static constexpr uint32_t MaxIterationCycles = 512;
+
+	/// <summary>Number of identical iterations needed before the loop is considered idle</summary>
+	static constexpr uint32_t ConfirmIterations = 2;
+
+	/// <summary>Forgets the loop currently being tracked</summary>
+	void Reset() {
+		_matchCount = 0;
+		_iterationCycles = 0;
+		_branchAddr = 0;
+		_target = 0;
+	}
+
+	/// <summary>
+	/// Processes a taken branch.
+	/// </summary>
+	/// <param name="branchAddr">Address of the branch instruction</param>
+	/// <param name="target">Address the branch jumps to</param>
+	/// <param name="stateHash">Hash of the CPU registers (see HashState)</param>
+	/// <param name="sideEffectCount">Number of side-effect accesses done by the CPU so far</param>
+	/// <param name="clock">Current master clock</param>
+	/// <returns>True if the loop is idle and its next iterations can be skipped</returns>
+	bool ProcessBranch(uint32_t branchAddr, uint32_t target, uint64_t stateHash, uint32_t sideEffectCount, uint64_t clock) {
+		if (target > branchAddr || branchAddr - target > MaxLoopSize) {
+			_matchCount = 0;
+			_iterationCycles = 0;
+			return false;
+		}
+
+		uint64_t cycles = clock - _lastClock;
+		bool sameLoop = branchAddr == _branchAddr && target == _target && stateHash == _stateHash && sideEffectCount == _sideEffectCount;
+		_lastClock = clock;
+
+		if (sameLoop && cycles == _iterationCycles) {
+			if (_matchCount < ConfirmIterations) {
+				_matchCount++;
+			}
+			return _matchCount >= ConfirmIterations;
+		}
+
+		// Start tracking this loop - the first identical iteration gives the iteration length
+		_branchAddr = branchAddr;
+		_target = target;
+		_stateHash = stateHash;
+		_sideEffectCount = sideEffectCount;
+		_iterationCycles = sameLoop && cycles <= MaxIterationCycles ? (uint32_t)cycles : 0;
+		_matchCount = 0;
+		return false;
+	}
+
+	/// <summary>Address of the idle loop's first instruction (the branch target)</summary>
+	[[nodiscard]] uint32_t GetLoopStart() const { return _target; }
+
+	/// <summary>Length of an iteration of the idle loop, in master clocks</summary>
+	[[nodiscard]] uint32_t GetIterationCycles() const { return _iterationCycles; }
+
+	/// <summary>Accounts for the cycles skipped by the core, so the next real iteration still matches</summary>
+	void ProcessSkippedCycles(uint64_t cycles) { _lastClock += cycles; }
+
+	/// <summary>Hashes the registers that must be identical at the start of each idle loop iteration</summary>
+	[[nodiscard]] static uint64_t HashState(const uint32_t* regs, uint32_t count, uint32_t flags) {
+		uint64_t hash = 0xCBF29CE484222325ull ^ flags;
+		for (uint32_t i = 0; i < count; i++) {
+			hash = (hash ^ regs[i]) * 0x100000001B3ull;
+			hash ^= hash >> 29;
+		}
+		return hash;
+	}
+};
@@ -101,6 +101,16 @@ MouseMovement KeyManager::GetMouseMovement(Emulator* emu, uint32_t mouseSensitiv
 	return mov;
 }
 
+void KeyManager::RunWithoutConsumingMouseMovement(const std::function<void()>& func) {
+	// The lock is reentrant - held for the whole call so movement reported meanwhile isn't lost
+	auto lock = _lock.AcquireSafe();
+	double x = _xMouseMovement;
+	double y = _yMouseMovement;
+	func();
+	_xMouseMovement = x;
+	_yMouseMovement = y;
+}
+
 void KeyManager::SetMousePosition(Emulator* emu, double x, double y) {
 	if (x < 0 || y < 0) {
 		_mousePosition.X = -1;
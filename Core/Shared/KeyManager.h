@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include <functional>
 #include "Shared/Interfaces/IKeyManager.h"
 #include "Utilities/SimpleLock.h"
 
@@ -110,6 +111,13 @@ public:
 	/// <returns>Mouse movement (clears accumulator)</returns>
 	[[nodiscard]] static MouseMovement GetMouseMovement(Emulator* emu, uint32_t mouseSensitivity);
 
+	/// <summary>
+	/// Run a function without consuming the accumulated mouse movement (restored afterwards).
+	/// Used to poll input ahead of the frame (preemptive run-ahead).
+	/// </summary>
+	/// <param name="func">Function that may call GetMouseMovement</param>
+	static void RunWithoutConsumingMouseMovement(const std::function<void()>& func);
+
 	/// <summary>
 	/// Set absolute mouse position.
 	/// </summary>
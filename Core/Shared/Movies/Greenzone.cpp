@@ -0,0 +1,306 @@
+#include "pch.h"
+#include "Shared/Movies/Greenzone.h"
+#include "Shared/RewindData.h"
+#include "Utilities/CompressionHelper.h"
+#include "Utilities/ISerializable.h"
+
+void Greenzone::SetConfig(const GreenzoneConfig& config) {
+	_config = config;
+	_config.CaptureInterval = std::max<uint32_t>(_config.CaptureInterval, 1);
+	_config.KeyframeInterval = std::max<uint32_t>(_config.KeyframeInterval, 1);
+
+	ApplyInvalidation();
+	while (_rawFrames.size() > _config.RawStateCount) {
+		uint32_t frame = _rawFrames.front();
+		_rawFrames.pop_front();
+		Compact(frame);
+	}
+	Trim();
+}
+
+void Greenzone::Capture(ISerializable& console, uint32_t frame, uint32_t version) {
+	ApplyInvalidation();
+
+	auto existing = _states.find(frame);
+	if (existing != _states.end()) {
+		if (existing->second.Type == StateType::Keyframe) {
+			RebaseDeltas(existing);
+		}
+		Remove(existing);
+	}
+
+	_serializer.ResetForFastSave(version);
+	_serializer.Stream(console, "", -1);
+
+	StateEntry& entry = _states[frame];
+	entry.Data = _serializer.GetData();
+	entry.LastUse = ++_useCounter;
+	_memoryUsage += entry.Data.size();
+	_rawFrames.push_back(frame);
+
+	while (_rawFrames.size() > _config.RawStateCount) {
+		uint32_t oldest = _rawFrames.front();
+		_rawFrames.pop_front();
+		Compact(oldest);
+	}
+	Trim();
+}
+
+void Greenzone::InvalidateFrom(uint32_t frame) {
+	_invalidFrom = std::min(_invalidFrom, frame);
+}
+
+void Greenzone::Clear() {
+	_states.clear();
+	_rawFrames.clear();
+	_lruIndex.clear();
+	_memoryUsage = 0;
+	_invalidFrom = NoInvalidation;
+	_keyframeCache = {};
+	_keyframeCacheFrame.reset();
+}
+
+void Greenzone::ApplyInvalidation() {
+	if (_invalidFrom == NoInvalidation) {
+		return;
+	}
+
+	for (auto it = _states.lower_bound(_invalidFrom); it != _states.end(); it++) {
+		_memoryUsage -= it->second.Data.size();
+		if (it->second.Type != StateType::Raw) {
+			_lruIndex.erase({it->second.LastUse, it->first});
+		}
+	}
+	_states.erase(_states.lower_bound(_invalidFrom), _states.end());
+	std::erase_if(_rawFrames, [this](uint32_t frame) { return frame >= _invalidFrom; });
+	if (_keyframeCacheFrame && *_keyframeCacheFrame >= _invalidFrom) {
+		_keyframeCacheFrame.reset();
+	}
+	_invalidFrom = NoInvalidation;
+}
+
+void Greenzone::Remove(std::map<uint32_t, StateEntry>::iterator it) {
+	uint32_t frame = it->first;
+	StateType type = it->second.Type;
+
+	_memoryUsage -= it->second.Data.size();
+	if (type != StateType::Raw) {
+		_lruIndex.erase({it->second.LastUse, frame});
+	}
+	it = _states.erase(it);
+
+	if (type == StateType::Raw) {
+		std::erase(_rawFrames, frame);
+	} else if (type == StateType::Keyframe) {
+		// Deltas based on this keyframe can't be restored without it
+		while (it != _states.end() && it->first - frame < _config.KeyframeInterval) {
+			if (it->second.Type == StateType::Delta && it->second.BaseFrame == frame) {
+				_memoryUsage -= it->second.Data.size();
+				_lruIndex.erase({it->second.LastUse, it->first});
+				it = _states.erase(it);
+			} else {
+				it++;
+			}
+		}
+		if (_keyframeCacheFrame == frame) {
+			_keyframeCacheFrame.reset();
+		}
+	}
+}
+
+void Greenzone::RebaseDeltas(std::map<uint32_t, StateEntry>::iterator keyframe) {
+	uint32_t frame = keyframe->first;
+	vector<uint8_t>* keyframeData = nullptr;
+	if (!GetKeyframeData(frame, keyframeData)) {
+		return;
+	}
+	vector<uint8_t> oldKeyframe = std::move(*keyframeData);
+	_keyframeCacheFrame.reset();
+
+	// The first delta becomes the new keyframe, the next ones are deltas based on it
+	optional<uint32_t> newKeyframe;
+	for (auto it = std::next(keyframe); it != _states.end() && it->first - frame < _config.KeyframeInterval; it++) {
+		StateEntry& entry = it->second;
+		vector<uint8_t> data;
+		if (entry.Type != StateType::Delta || entry.BaseFrame != frame || !CompressionHelper::Decompress(entry.Data, data)) {
+			continue;
+		}
+		RewindData::XorState(data, oldKeyframe);
+
+		_memoryUsage -= entry.Data.size();
+		entry.Data.clear();
+		if (!newKeyframe) {
+			CompressionHelper::Compress(data, CompressionLevel, entry.Data);
+			entry.Type = StateType::Keyframe;
+			newKeyframe = it->first;
+			_keyframeCache = std::move(data);
+			_keyframeCacheFrame = it->first;
+		} else {
+			RewindData::XorState(data, _keyframeCache);
+			CompressionHelper::Compress(data, CompressionLevel, entry.Data);
+			entry.BaseFrame = *newKeyframe;
+		}
+		_memoryUsage += entry.Data.size();
+	}
+}
+
+void Greenzone::SetLastUse(uint32_t frame, StateEntry& entry, uint64_t lastUse) {
+	if (entry.Type != StateType::Raw) {
+		_lruIndex.erase({entry.LastUse, frame});
+		_lruIndex.insert({lastUse, frame});
+	}
+	entry.LastUse = lastUse;
+}
+
+void Greenzone::Compact(uint32_t frame) {
+	auto it = _states.find(frame);
+	if (it == _states.end() || it->second.Type != StateType::Raw) {
+		return;
+	}
+	StateEntry& entry = it->second;
+
+	// Use the nearest keyframe before this state (within KeyframeInterval frames) as the delta's base
+	optional<uint32_t> baseFrame;
+	while (it != _states.begin()) {
+		it--;
+		if (frame - it->first >= _config.KeyframeInterval) {
+			break;
+		}
+		if (it->second.Type == StateType::Keyframe) {
+			baseFrame = it->first;
+			break;
+		}
+	}
+
+	vector<uint8_t>* baseData = nullptr;
+	vector<uint8_t> rawData = std::move(entry.Data);
+	_memoryUsage -= rawData.size();
+
+	if (baseFrame && GetKeyframeData(*baseFrame, baseData)) {
+		vector<uint8_t> delta = rawData;
+		RewindData::XorState(delta, *baseData);
+		CompressionHelper::Compress(delta, CompressionLevel, entry.Data);
+		entry.Type = StateType::Delta;
+		entry.BaseFrame = *baseFrame;
+	} else {
+		CompressionHelper::Compress(rawData, CompressionLevel, entry.Data);
+		entry.Type = StateType::Keyframe;
+
+		// The next states are most likely deltas based on this one
+		_keyframeCache = std::move(rawData);
+		_keyframeCacheFrame = frame;
+	}
+	_memoryUsage += entry.Data.size();
+	_lruIndex.insert({entry.LastUse, frame});
+}
+
+void Greenzone::Trim() {
+	while (_memoryUsage > _config.MaxMemoryBytes) {
+		// Drop the least recently used compressed state (a keyframe along with its deltas)
+		if (!_lruIndex.empty()) {
+			Remove(_states.find(_lruIndex.begin()->second));
+		} else if (_rawFrames.size() > 1) {
+			// Only raw states left - compress the oldest ones to fit in the budget
+			uint32_t oldest = _rawFrames.front();
+			_rawFrames.pop_front();
+			Compact(oldest);
+		} else {
+			break;
+		}
+	}
+}
+
+bool Greenzone::GetKeyframeData(uint32_t frame, vector<uint8_t>*& data) {
+	if (_keyframeCacheFrame != frame) {
+		auto it = _states.find(frame);
+		if (it == _states.end() || it->second.Type != StateType::Keyframe) {
+			return false;
+		}
+		_keyframeCacheFrame.reset();
+		if (!CompressionHelper::Decompress(it->second.Data, _keyframeCache)) {
+			return false;
+		}
+		_keyframeCacheFrame = frame;
+	}
+
+	data = &_keyframeCache;
+	return true;
+}
+
+bool Greenzone::GetStateData(uint32_t frame, StateEntry& entry, vector<uint8_t>& data) {
+	switch (entry.Type) {
+		case StateType::Raw:
+			data = entry.Data;
+			return true;
+
+		case StateType::Keyframe:
+			if (_keyframeCacheFrame == frame) {
+				data = _keyframeCache;
+				return true;
+			}
+			return CompressionHelper::Decompress(entry.Data, data);
+
+		case StateType::Delta: {
+			vector<uint8_t>* baseData = nullptr;
+			if (!CompressionHelper::Decompress(entry.Data, data) || !GetKeyframeData(entry.BaseFrame, baseData)) {
+				return false;
+			}
+			RewindData::XorState(data, *baseData);
+			SetLastUse(entry.BaseFrame, _states[entry.BaseFrame], _useCounter);
+			return true;
+		}
+	}
+	return false;
+}
+
+optional<uint32_t> Greenzone::GetNearestFrame(uint32_t frame) {
+	ApplyInvalidation();
+
+	auto it = _states.upper_bound(frame);
+	if (it == _states.begin()) {
+		return std::nullopt;
+	}
+	return (--it)->first;
+}
+
+bool Greenzone::HasState(uint32_t frame) {
+	ApplyInvalidation();
+	return _states.contains(frame);
+}
+
+optional<uint32_t> Greenzone::LoadNearest(ISerializable& console, uint32_t frame) {
+	optional<uint32_t> nearest = GetNearestFrame(frame);
+	if (!nearest) {
+		return std::nullopt;
+	}
+
+	StateEntry& entry = _states[*nearest];
+	SetLastUse(*nearest, entry, ++_useCounter);
+
+	vector<uint8_t> data;
+	if (!GetStateData(*nearest, entry, data)) {
+		return std::nullopt;
+	}
+
+	_serializer.ResetForFastLoad(std::move(data));
+	_serializer.Stream(console, "", -1);
+	return nearest;
+}
+
+GreenzoneInfo Greenzone::GetInfo() {
+	ApplyInvalidation();
+
+	GreenzoneInfo info = {};
+	info.StateCount = (uint32_t)_states.size();
+	info.MemoryUsage = _memoryUsage;
+	info.FirstFrame = _states.empty() ? -1 : (int64_t)_states.begin()->first;
+	info.LastFrame = _states.empty() ? -1 : (int64_t)_states.rbegin()->first;
+	for (auto& [frame, entry] : _states) {
+		switch (entry.Type) {
+			case StateType::Raw: info.RawStateCount++; break;
+			case StateType::Keyframe: info.KeyframeCount++; break;
+			case StateType::Delta: info.DeltaCount++; break;
+		}
+	}
+	return info;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "pch.h"
+#include <deque>
+#include <map>
+#include <set>
+#include "Utilities/Serializer.h"
+
+class ISerializable;
+
+/// <summary>
+/// Greenzone settings (set by the TAS editor).
+/// </summary>
+struct GreenzoneConfig {
+	uint32_t CaptureInterval = 1;              ///< Capture a state every N frames
+	uint32_t RawStateCount = 120;              ///< Most recently captured states kept uncompressed
+	uint32_t KeyframeInterval = 30;            ///< Max distance (in frames) between a delta state and its keyframe
+	uint64_t MaxMemoryBytes = 256 * 1024 * 1024; ///< Memory budget - least recently used compressed states are dropped above it
+};
+
+/// <summary>
+/// Greenzone statistics (for the TAS editor's UI).
+/// </summary>
+struct GreenzoneInfo {
+	uint32_t StateCount;
+	uint32_t RawStateCount;
+	uint32_t KeyframeCount;
+	uint32_t DeltaCount;
+	uint64_t MemoryUsage;
+	int64_t FirstFrame; ///< -1 if empty
+	int64_t LastFrame;  ///< -1 if empty
+};
+
+/// <summary>
+/// Core-side TAS greenzone - states captured as the movie plays, so seeking to any frame is
+/// (nearly) instant.
+/// </summary>
+/// <remarks>
+/// States are captured with the FastBinary format (same as run-ahead) every CaptureInterval
+/// frames, and kept in 3 tiers:
+/// - The RawStateCount most recently captured states are kept as-is (seeking near the edit point
+///   is the common case and costs no decompression).
+/// - Older states are deflate-compressed: keyframes as full states, the others as an XOR delta
+///   against the keyframe before them (like rewind data), which is mostly zeroes.
+/// - Above the memory budget, the least recently used compressed states are dropped (a keyframe
+///   is dropped along with its deltas), which thins out the distant parts of the movie first.
+///   Compressed states are indexed by last use, so finding the next one to drop is O(log n).
+///
+/// Re-capturing a keyframe's frame rebases its deltas (the first one becomes their new keyframe)
+/// instead of dropping them.
+///
+/// InvalidateFrom() only records the frame (O(1)) - the states after it are dropped the next
+/// time the greenzone is accessed.
+///
+/// Not thread-safe - the emulator calls it from the emulation thread, or with the emulation lock.
+/// </remarks>
+class Greenzone {
+private:
+	enum class StateType : uint8_t {
+		Raw,
+		Keyframe,
+		Delta
+	};
+
+	struct StateEntry {
+		vector<uint8_t> Data;
+		StateType Type = StateType::Raw;
+		uint32_t BaseFrame = 0; ///< Keyframe a delta state is based on
+		uint64_t LastUse = 0;
+	};
+
+	static constexpr uint32_t NoInvalidation = UINT32_MAX;
+	static constexpr int CompressionLevel = 1;
+
+	GreenzoneConfig _config;
+	std::map<uint32_t, StateEntry> _states;
+	std::deque<uint32_t> _rawFrames; ///< Raw states, in capture order (oldest first)
+	std::set<std::pair<uint64_t, uint32_t>> _lruIndex; ///< Compressed states by (LastUse, frame) - least recently used first
+	uint64_t _memoryUsage = 0;
+	uint64_t _useCounter = 0;
+	uint32_t _invalidFrom = NoInvalidation;
+	Serializer _serializer;
+
+	/// <summary>Uncompressed data of the last keyframe used (deltas are usually compacted/loaded in order)</summary>
+	vector<uint8_t> _keyframeCache;
+	optional<uint32_t> _keyframeCacheFrame;
+
+	void ApplyInvalidation();
+	void Remove(std::map<uint32_t, StateEntry>::iterator it);
+	void RebaseDeltas(std::map<uint32_t, StateEntry>::iterator keyframe);
+	void SetLastUse(uint32_t frame, StateEntry& entry, uint64_t lastUse);
+	void Compact(uint32_t frame);
+	void Trim();
+	[[nodiscard]] bool GetKeyframeData(uint32_t frame, vector<uint8_t>*& data);
+	[[nodiscard]] bool GetStateData(uint32_t frame, StateEntry& entry, vector<uint8_t>& data);
+
+public:
+	/// <summary>Change the settings - existing states are kept (and trimmed to the new budget)</summary>
+	void SetConfig(const GreenzoneConfig& config);
+	[[nodiscard]] const GreenzoneConfig& GetConfig() const { return _config; }
+
+	/// <summary>Whether a state is captured at the end of this frame</summary>
+	[[nodiscard]] bool IsCaptureFrame(uint32_t frame) const { return _config.CaptureInterval <= 1 || frame % _config.CaptureInterval == 0; }
+
+	/// <summary>
+	/// Capture the state for a frame (replaces the existing state for it, if any).
+	/// </summary>
+	/// <param name="console">Console to save</param>
+	/// <param name="frame">Frame number</param>
+	/// <param name="version">Save state format version</param>
+	void Capture(ISerializable& console, uint32_t frame, uint32_t version);
+
+	/// <summary>Invalidate all states from this frame onwards (e.g. the movie's input was edited at this frame)</summary>
+	void InvalidateFrom(uint32_t frame);
+
+	/// <summary>Remove all states</summary>
+	void Clear();
+
+	/// <summary>Nearest frame with a state at or before the target frame (nullopt if none)</summary>
+	[[nodiscard]] optional<uint32_t> GetNearestFrame(uint32_t frame);
+
+	[[nodiscard]] bool HasState(uint32_t frame);
+
+	/// <summary>
+	/// Load the nearest state at or before the target frame.
+	/// </summary>
+	/// <param name="console">Console to load the state into</param>
+	/// <param name="frame">Target frame</param>
+	/// <returns>Frame of the state that was loaded (nullopt if none) - the caller emulates the rest</returns>
+	[[nodiscard]] optional<uint32_t> LoadNearest(ISerializable& console, uint32_t frame);
+
+	[[nodiscard]] GreenzoneInfo GetInfo();
+};
@@ -0,0 +1,277 @@
+#include "pch.h"
+#include "Shared/Movies/InputSearch.h"
+#include "Shared/BatchEnvironment.h"
+#include "Shared/Emulator.h"
+#include "Shared/MessageManager.h"
+#include "Shared/RomInfo.h"
+#include "Shared/SaveStateManager.h"
+#include "Shared/Interfaces/IConsole.h"
+#include "Debugger/Debugger.h"
+#include "Debugger/ExpressionEvaluator.h"
+
+namespace {
+	bool IsBetterResult(const InputSearchResult& a, const InputSearchResult& b) {
+		if (a.Score != b.Score) {
+			return a.Score > b.Score;
+		} else if (a.FrameCount != b.FrameCount) {
+			return a.FrameCount < b.FrameCount;
+		}
+		return a.Inputs < b.Inputs;
+	}
+}
+
+InputSearch::InputSearch(Emulator* emu) {
+	_emu = emu;
+}
+
+InputSearch::~InputSearch() {
+	Stop();
+}
+
+bool InputSearch::Start(const InputSearchConfig& config) {
+	Stop();
+
+	if (config.Depth == 0 || config.Candidates.empty() || config.GoalExpression.empty() || !_emu->IsRunning()) {
+		return false;
+	}
+
+	_config = config;
+	_config.FramesPerInput = std::max(_config.FramesPerInput, 1u);
+	_config.MaxResults = std::max(_config.MaxResults, 1u);
+
+	uint32_t threadCount = _config.ThreadCount;
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	// Clone the game's current state
+	{
+		auto lock = _emu->AcquireLock();
+		Serializer s;
+		s.ResetForFastSave(SaveStateManager::FileFormatVersion);
+		s.Stream(*_emu->GetConsole().get(), "", -1);
+		_startState = s.GetData();
+	}
+
+	// Load the game in one instance per thread - the instances are run by the search's threads
+	BatchEnvironmentConfig envConfig = {};
+	envConfig.InstanceCount = threadCount;
+	envConfig.ThreadCount = 1;
+	envConfig.PortCount = _config.Port + 1;
+	_env = std::make_unique<BatchEnvironment>(envConfig);
+	RomInfo& romInfo = _emu->GetRomInfo();
+	if (!_env->LoadRom(romInfo.RomFile, romInfo.PatchFile, _emu->GetSettings())) {
+		_env.reset();
+		return false;
+	}
+
+	for (uint32_t i = 0; i < threadCount; i++) {
+		unique_ptr<Worker> worker = std::make_unique<Worker>();
+		worker->Index = i;
+		worker->Emu = _env->GetEmulator(i);
+		worker->Emu->InitDebugger();
+		worker->Dbg = worker->Emu->InternalGetDebugger();
+
+		// The instance must never break (e.g. "break on BRK" options) - nothing would resume it
+		worker->Dbg->SuspendDebugger(false);
+
+		worker->StartState.ResetForFastSave(SaveStateManager::FileFormatVersion);
+		worker->StartState.ResetForFastLoad(_startState);
+		for (uint32_t depth = 0; depth < _config.Depth; depth++) {
+			worker->States.push_back(std::make_unique<Serializer>());
+		}
+		worker->Inputs.resize(_config.Depth);
+		_workers.push_back(std::move(worker));
+	}
+
+	// Check the expressions against the start state
+	Worker& first = *_workers[0];
+	first.Emu->StreamHeadlessState(first.StartState);
+	for (const string& expression : {_config.GoalExpression, _config.PruneExpression, _config.ScoreExpression}) {
+		EvalResultType resultType;
+		if (!expression.empty()) {
+			first.Dbg->EvaluateExpression(expression, _config.Cpu, resultType, true);
+			if (resultType == EvalResultType::Invalid) {
+				MessageManager::Log("[InputSearch] Invalid expression: " + expression);
+				Stop();
+				return false;
+			}
+		}
+	}
+
+	// Split the tree into enough tasks to keep all threads busy until the end
+	uint32_t candidateCount = (uint32_t)_config.Candidates.size();
+	uint64_t taskCount = 1;
+	_prefixDepth = 0;
+	while (_prefixDepth < _config.Depth && taskCount < (uint64_t)threadCount * 16) {
+		taskCount *= candidateCount;
+		_prefixDepth++;
+	}
+
+	_taskCount = (uint32_t)taskCount;
+	_nextTask = 0;
+	_doneTasks = 0;
+	_sequenceCount = 0;
+	_prunedCount = 0;
+	_resultCount = 0;
+	_results.clear();
+	_stopFlag = false;
+
+	_runningThreads = threadCount;
+	for (unique_ptr<Worker>& worker : _workers) {
+		_threads.emplace_back(&InputSearch::RunWorker, this, std::ref(*worker));
+	}
+
+	MessageManager::Log(std::format("[InputSearch] Started: {} threads, {} tasks", threadCount, _taskCount));
+	return true;
+}
+
+void InputSearch::Stop() {
+	_stopFlag = true;
+	for (std::thread& thread : _threads) {
+		thread.join();
+	}
+	_threads.clear();
+	_workers.clear();
+	_env.reset();
+}
+
+void InputSearch::RunWorker(Worker& worker) {
+	for (uint32_t task = _nextTask++; task < _taskCount && !_stopFlag; task = _nextTask++) {
+		RunTask(worker, task);
+		_doneTasks++;
+	}
+	_runningThreads--;
+}
+
+void InputSearch::RunTask(Worker& worker, uint32_t task) {
+	// The task number is the prefix, in base N (N = candidate count), first input first
+	uint32_t candidateCount = (uint32_t)_config.Candidates.size();
+	for (uint32_t depth = _prefixDepth; depth > 0; depth--) {
+		worker.Inputs[depth - 1] = task % candidateCount;
+		task /= candidateCount;
+	}
+
+	worker.StartState.ResetForFastLoad();
+	worker.Emu->StreamHeadlessState(worker.StartState);
+
+	for (uint32_t depth = 0; depth < _prefixDepth; depth++) {
+		// Sequences shorter than the prefix are run by several tasks - only the first of them
+		// (the one whose following inputs are all the first candidate) counts them
+		bool owner = std::all_of(worker.Inputs.begin() + depth + 1, worker.Inputs.begin() + _prefixDepth, [](uint32_t input) { return input == 0; });
+		NodeResult result = RunInput(worker, depth);
+		if (owner) {
+			_sequenceCount++;
+		}
+
+		if (result != NodeResult::Continue) {
+			if (owner && result == NodeResult::Goal) {
+				AddResult(worker, depth);
+			} else if (owner) {
+				_prunedCount++;
+			}
+			return;
+		}
+	}
+
+	Search(worker, _prefixDepth);
+}
+
+void InputSearch::Search(Worker& worker, uint32_t depth) {
+	if (depth >= _config.Depth) {
+		return;
+	}
+
+	Serializer& state = *worker.States[depth];
+	state.ResetForFastSave(SaveStateManager::FileFormatVersion);
+	worker.Emu->StreamHeadlessState(state);
+
+	uint32_t candidateCount = (uint32_t)_config.Candidates.size();
+	for (uint32_t i = 0; i < candidateCount && !_stopFlag; i++) {
+		if (i > 0) {
+			// Go back to the state before this input (the first candidate runs from it directly)
+			state.ResetForFastLoad();
+			worker.Emu->StreamHeadlessState(state);
+		}
+
+		worker.Inputs[depth] = i;
+		_sequenceCount++;
+		switch (RunInput(worker, depth)) {
+			case NodeResult::Goal:
+				AddResult(worker, depth);
+				break;
+
+			case NodeResult::Pruned:
+				_prunedCount++;
+				break;
+
+			case NodeResult::Continue:
+				Search(worker, depth + 1);
+				break;
+		}
+	}
+}
+
+InputSearch::NodeResult InputSearch::RunInput(Worker& worker, uint32_t depth) {
+	_env->SetInput(worker.Index, _config.Port, _config.Candidates[worker.Inputs[depth]]);
+	try {
+		for (uint32_t i = 0; i < _config.FramesPerInput; i++) {
+			worker.Emu->RunHeadlessFrame();
+		}
+	} catch (std::exception&) {
+		// Emulation error (e.g. the game crashed) - drop the sequence
+		return NodeResult::Pruned;
+	}
+
+	int64_t value = 0;
+	if (Evaluate(worker, _config.GoalExpression, value) && value != 0) {
+		return NodeResult::Goal;
+	} else if (!_config.PruneExpression.empty() && Evaluate(worker, _config.PruneExpression, value) && value != 0) {
+		return NodeResult::Pruned;
+	}
+	return NodeResult::Continue;
+}
+
+bool InputSearch::Evaluate(Worker& worker, const string& expression, int64_t& value) {
+	EvalResultType resultType;
+	value = worker.Dbg->EvaluateExpression(expression, _config.Cpu, resultType, true);
+	return resultType == EvalResultType::Numeric || resultType == EvalResultType::Boolean;
+}
+
+void InputSearch::AddResult(Worker& worker, uint32_t depth) {
+	_resultCount++;
+
+	InputSearchResult result = {};
+	for (uint32_t i = 0; i <= depth; i++) {
+		result.Inputs.push_back(_config.Candidates[worker.Inputs[i]]);
+	}
+	result.FrameCount = (depth + 1) * _config.FramesPerInput;
+	if (!_config.ScoreExpression.empty() && !Evaluate(worker, _config.ScoreExpression, result.Score)) {
+		result.Score = 0;
+	}
+
+	auto lock = _resultLock.AcquireSafe();
+	if (_results.size() >= _config.MaxResults && !IsBetterResult(result, _results.back())) {
+		return;
+	}
+	_results.insert(std::upper_bound(_results.begin(), _results.end(), result, IsBetterResult), std::move(result));
+	if (_results.size() > _config.MaxResults) {
+		_results.pop_back();
+	}
+}
+
+InputSearchProgress InputSearch::GetProgress() {
+	InputSearchProgress progress = {};
+	progress.SequenceCount = _sequenceCount;
+	progress.PrunedCount = _prunedCount;
+	progress.ResultCount = _resultCount;
+	progress.DoneTasks = _doneTasks;
+	progress.TotalTasks = _taskCount;
+	progress.Running = _runningThreads > 0;
+	return progress;
+}
+
+vector<InputSearchResult> InputSearch::GetResults() {
+	auto lock = _resultLock.AcquireSafe();
+	return _results;
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "pch.h"
+#include <thread>
+#include "Shared/CpuType.h"
+#include "Utilities/Serializer.h"
+#include "Utilities/SimpleLock.h"
+
+class Emulator;
+class Debugger;
+class BatchEnvironment;
+
+/// <summary>
+/// Input search settings.
+/// </summary>
+struct InputSearchConfig {
+	uint32_t Depth = 8;          ///< Number of inputs in a sequence
+	uint32_t FramesPerInput = 1; ///< Frames each input is held for
+	vector<uint32_t> Candidates; ///< Button masks tried for each input (bit N = button N of the controller)
+	uint8_t Port = 0;            ///< Controller port the inputs are sent to
+	CpuType Cpu = CpuType::Snes; ///< CPU whose registers/memory the expressions refer to
+	string GoalExpression;       ///< A sequence is a result when this is true after one of its inputs
+	string PruneExpression;      ///< Sequences are abandoned when this is true after one of their inputs (optional)
+	string ScoreExpression;      ///< Ranks the results, evaluated when the goal is reached - higher is better (optional)
+	uint32_t MaxResults = 32;    ///< Best results kept
+	uint32_t ThreadCount = 0;    ///< Worker threads (0 = one per core)
+};
+
+/// <summary>
+/// A sequence of inputs that reaches the goal.
+/// </summary>
+struct InputSearchResult {
+	vector<uint32_t> Inputs; ///< Button masks, one per input (the sequence stops when the goal is reached)
+	uint32_t FrameCount;     ///< Frames run until the goal was reached
+	int64_t Score;           ///< Value of the score expression (0 if there is none)
+};
+
+/// <summary>
+/// Input search progress (interop structure).
+/// </summary>
+struct InputSearchProgress {
+	uint64_t SequenceCount; ///< Input sequences (partial or not) that were run
+	uint64_t PrunedCount;   ///< Sequences abandoned by the prune expression
+	uint64_t ResultCount;   ///< Sequences that reached the goal (including the ones that aren't kept)
+	uint32_t DoneTasks;     ///< Search tasks completed
+	uint32_t TotalTasks;
+	bool Running;
+};
+
+/// <summary>
+/// TAS input search ("bruteforcer") - finds the input sequences that bring the game from its
+/// current state to a goal (e.g. an RNG manipulation or a frame-perfect trick).
+/// </summary>
+/// <remarks>
+/// The game's current state is cloned into one headless instance per worker thread (see
+/// BatchEnvironment) with the FastBinary serializer, and each worker explores part of the tree of
+/// input sequences depth-first: the state before each input is kept (one serializer per depth),
+/// so trying the next candidate only costs a state load and the input's frames.
+///
+/// The tree is split into tasks - one per prefix of the sequences (the first few inputs), enough
+/// to keep all threads busy until the end. Each thread takes the next task when it finishes one.
+///
+/// Goal, prune and score are debugger expressions (see ExpressionEvaluator), evaluated after each
+/// input by a debugger attached to the worker's instance. Labels aren't available - the instances'
+/// debuggers don't have the main instance's labels.
+///
+/// Results are ranked by score (highest first), then by frame count (shortest first), then by
+/// button masks, so they don't depend on the thread count.
+/// </remarks>
+class InputSearch {
+private:
+	struct Worker {
+		uint32_t Index = 0;
+		Emulator* Emu = nullptr;
+		Debugger* Dbg = nullptr;
+		Serializer StartState;
+		vector<unique_ptr<Serializer>> States; ///< State before each input
+		vector<uint32_t> Inputs;               ///< Index of the candidate used for each input
+	};
+
+	enum class NodeResult {
+		Continue,
+		Goal,
+		Pruned
+	};
+
+	Emulator* _emu = nullptr;
+	InputSearchConfig _config;
+	unique_ptr<BatchEnvironment> _env;
+	vector<unique_ptr<Worker>> _workers;
+	vector<std::thread> _threads;
+	vector<uint8_t> _startState;
+
+	uint32_t _prefixDepth = 0;
+	uint32_t _taskCount = 0;
+	atomic<uint32_t> _nextTask = 0;
+	atomic<uint32_t> _doneTasks = 0;
+	atomic<uint32_t> _runningThreads = 0;
+	atomic<bool> _stopFlag = false;
+
+	atomic<uint64_t> _sequenceCount = 0;
+	atomic<uint64_t> _prunedCount = 0;
+	atomic<uint64_t> _resultCount = 0;
+
+	SimpleLock _resultLock;
+	vector<InputSearchResult> _results;
+
+	[[nodiscard]] bool Evaluate(Worker& worker, const string& expression, int64_t& value);
+	[[nodiscard]] NodeResult RunInput(Worker& worker, uint32_t depth);
+	void AddResult(Worker& worker, uint32_t depth);
+	void Search(Worker& worker, uint32_t depth);
+	void RunTask(Worker& worker, uint32_t task);
+	void RunWorker(Worker& worker);
+
+public:
+	InputSearch(Emulator* emu);
+	~InputSearch();
+
+	/// <summary>
+	/// Clone the game's current state and start searching (in the background).
+	/// </summary>
+	/// <returns>False if the settings are invalid (e.g. an expression can't be parsed) or the game couldn't be loaded</returns>
+	[[nodiscard]] bool Start(const InputSearchConfig& config);
+
+	/// <summary>Stop the search (the results found so far are kept)</summary>
+	void Stop();
+
+	[[nodiscard]] InputSearchProgress GetProgress();
+
+	/// <summary>Best results found so far, ranked</summary>
+	[[nodiscard]] vector<InputSearchResult> GetResults();
+};
@@ -24,15 +24,11 @@ void RewindData::ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t
 		if (prevState.IsFullState) {
 			// XOR with previous state to restore state data to its initial state
 			if (!prevState._uncompressedData.empty()) {
-				for (size_t i = 0, len = std::min(prevState._uncompressedData.size(), data.size()); i < len; i++) {
-					data[i] ^= prevState._uncompressedData[i];
-				}
+				XorState(data, prevState._uncompressedData);
 			} else {
 				vector<uint8_t> prevStateData;
 				CompressionHelper::Decompress(prevState._saveStateData, prevStateData);
-				for (size_t i = 0, len = std::min(prevStateData.size(), data.size()); i < len; i++) {
-					data[i] ^= prevStateData[i];
-				}
+				XorState(data, prevStateData);
 			}
 			break;
 		}
@@ -62,6 +62,19 @@ public:
 	/// <param name="position">Position in history (-1 = current)</param>
 	void GetStateData(stringstream& stateData, deque<RewindData>& prevStates, int32_t position);
 
+	/// <summary>
+	/// XOR state data with a base state (creates or applies a delta between 2 states).
+	/// </summary>
+	/// <param name="data">State data, modified in place</param>
+	/// <param name="baseState">State to XOR with (bytes past the end of either buffer are left as-is)</param>
+	/// <remarks>Also used to send netplay save states as deltas (see SaveStateMessage).</remarks>
+	template <typename T, typename U>
+	static void XorState(T& data, const U& baseState) {
+		for (size_t i = 0, len = std::min<size_t>(baseState.size(), data.size()); i < len; i++) {
+			data[i] ^= baseState[i];
+		}
+	}
+
 	/// <summary>Get compressed state size in bytes</summary>
 	[[nodiscard]] uint32_t GetStateSize() const { return (uint32_t)_saveStateData.size(); }
 
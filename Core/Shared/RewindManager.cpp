@@ -3,6 +3,7 @@
 #include "Shared/MessageManager.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
+#include "Shared/FrameProfiler.h"
 #include "Shared/Video/VideoRenderer.h"
 #include "Shared/Audio/SoundMixer.h"
 #include "Shared/BaseControlDevice.h"
@@ -308,6 +309,7 @@ void RewindManager::Stop() {
 }
 
 void RewindManager::ProcessEndOfFrame() {
+	PROFILER_SCOPE(_emu->GetFrameProfiler(), FrameProfilerSection::Rewind, "Rewind");
 	if (_rewindState >= RewindState::Starting) {
 		if (_currentHistory.FrameCount <= 0 && _rewindState != RewindState::Debugging) {
 			// If we're debugging, we want to keep running the emulation to the end of the next frame (even if it's incomplete)
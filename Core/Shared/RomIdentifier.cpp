@@ -0,0 +1,143 @@
+#include "pch.h"
+#include <thread>
+#include "Shared/RomIdentifier.h"
+#include "NES/GameDatabase.h"
+#include "Lynx/LynxGameDatabase.h"
+#include "Utilities/CRC32.h"
+#include "Utilities/VirtualFile.h"
+
+namespace {
+	constexpr size_t ChunkSize = 256 * 1024;
+	constexpr size_t BlockSize = 16 * 1024;
+
+	enum class RomFormat {
+		Unknown,
+		Nes,
+		Lynx
+	};
+
+	/// <summary>Detect the format from the start of the file, returns the size of its header</summary>
+	uint32_t GetHeaderSize(const uint8_t* data, size_t size, const string& extension, RomFormat& format) {
+		if (size >= 16 && memcmp(data, "NES\x1A", 4) == 0) {
+			format = RomFormat::Nes;
+			// The 512-byte trainer isn't part of the database's CRC
+			return (data[6] & 0x04) ? 16 + 512 : 16;
+		} else if (size >= 64 && memcmp(data, "LYNX", 4) == 0) {
+			format = RomFormat::Lynx;
+			return 64;
+		} else if (extension == ".lyx" || extension == ".o") {
+			format = RomFormat::Lynx;
+		}
+		return 0;
+	}
+
+	struct RomHasher {
+		MultiHash Hash;
+		uint32_t ContentCrc = 0;
+		uint64_t Position = 0;
+		uint32_t HeaderSize = 0;
+		RomFormat Format = RomFormat::Unknown;
+
+		void Update(const uint8_t* data, size_t size, const string& extension) {
+			if (Position == 0 && size > 0) {
+				HeaderSize = GetHeaderSize(data, size, extension, Format);
+			}
+
+			// Each block goes through all the hashes while it's in the cache
+			while (size > 0) {
+				size_t blockSize = std::min(size, BlockSize);
+				Hash.Update(data, blockSize);
+				if (HeaderSize > 0 && Position + blockSize > HeaderSize) {
+					size_t skip = Position < HeaderSize ? (size_t)(HeaderSize - Position) : 0;
+					ContentCrc = CRC32::GetCRC(data + skip, blockSize - skip, ContentCrc);
+				}
+				Position += blockSize;
+				data += blockSize;
+				size -= blockSize;
+			}
+		}
+	};
+
+	void FindDatabaseEntry(RomIdentification& result, RomFormat format) {
+		if (format == RomFormat::Nes) {
+			GameInfo info = {};
+			if (GameDatabase::GetGameInfo(result.ContentCrc32, info)) {
+				result.KnownGame = true;
+				result.DbSystem = info.System;
+				result.DbName = info.Board;
+			}
+		} else if (format == RomFormat::Lynx) {
+			const LynxGameDatabase::Entry* entry = LynxGameDatabase::Lookup(result.ContentCrc32);
+			if (entry) {
+				result.KnownGame = true;
+				result.DbSystem = "Lynx";
+				result.DbName = entry->Name;
+			}
+		}
+	}
+}
+
+RomIdentification RomIdentifier::Identify(const string& path) {
+	RomIdentification result = {};
+	result.Path = path;
+
+	VirtualFile file(path);
+	string extension = file.GetFileExtension();
+	RomHasher hasher;
+	if (file.IsArchive()) {
+		vector<uint8_t> data;
+		if (!file.ReadFile(data)) {
+			return result;
+		}
+		hasher.Update(data.data(), data.size(), extension);
+	} else {
+		ifstream input(file.GetFilePath(), std::ios::in | std::ios::binary);
+		if (!input) {
+			return result;
+		}
+
+		vector<uint8_t> buffer(ChunkSize);
+		while (input) {
+			input.read((char*)buffer.data(), buffer.size());
+			hasher.Update(buffer.data(), (size_t)input.gcount(), extension);
+		}
+		if (input.bad()) {
+			return result;
+		}
+	}
+
+	result.Valid = true;
+	result.Size = hasher.Position;
+	result.Hashes = hasher.Hash.Finalize();
+	result.HeaderSize = (uint32_t)std::min<uint64_t>(hasher.HeaderSize, hasher.Position);
+	result.ContentCrc32 = hasher.HeaderSize > 0 ? hasher.ContentCrc : result.Hashes.Crc32;
+	FindDatabaseEntry(result, hasher.Format);
+	return result;
+}
+
+vector<RomIdentification> RomIdentifier::Identify(const vector<string>& paths, uint32_t threadCount) {
+	vector<RomIdentification> results(paths.size());
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	threadCount = (uint32_t)std::min<size_t>(threadCount, paths.size());
+
+	// Each thread takes the next file when it's done with the previous one
+	atomic<size_t> nextFile = 0;
+	auto identifyFiles = [&]() {
+		for (size_t i = nextFile++; i < paths.size(); i = nextFile++) {
+			results[i] = Identify(paths[i]);
+		}
+	};
+
+	// The calling thread identifies files too
+	vector<std::thread> threads;
+	for (uint32_t i = 1; i < threadCount; i++) {
+		threads.emplace_back(identifyFiles);
+	}
+	identifyFiles();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	return results;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/MultiHash.h"
+
+/// <summary>
+/// Hashes and database match of a ROM file.
+/// </summary>
+struct RomIdentification {
+	string Path;
+	bool Valid = false;         ///< False if the file couldn't be read
+	uint64_t Size = 0;          ///< File size in bytes
+	MultiHashResult Hashes;     ///< CRC32/MD5/SHA-1 of the whole file
+	uint32_t HeaderSize = 0;    ///< Bytes before the ROM data (iNES header + trainer, LNX header)
+	uint32_t ContentCrc32 = 0;  ///< CRC32 of the ROM data after the header (the CRC used by the game databases)
+	bool KnownGame = false;     ///< Found in one of the game databases
+	string DbSystem;            ///< Database's system (e.g. "NesNtsc", "Famicom", "Lynx")
+	string DbName;              ///< Database's name for the game (NES: board name, the NES database has no titles)
+};
+
+/// <summary>
+/// Identifies ROM files (e.g. to scan a game library) by hashing them and looking them up in the
+/// game databases.
+/// </summary>
+/// <remarks>
+/// Each file is read once, in chunks: the CRC32, MD5 and SHA-1 of the whole file and the CRC32 of
+/// the ROM data after the header are computed in the same pass (see MultiHash). Files inside
+/// archives ("archive\x1file" paths) are extracted to memory and hashed the same way.
+///
+/// Databases: NES (iNES files, see GameDatabase) and Lynx (LNX and headerless files, see
+/// LynxGameDatabase). The hashes of the other systems' files are returned without a match.
+/// </remarks>
+class RomIdentifier {
+public:
+	/// <summary>Hash a file and look it up in the game databases</summary>
+	[[nodiscard]] static RomIdentification Identify(const string& path);
+
+	/// <summary>
+	/// Identify several files in parallel (blocks until all files are done).
+	/// </summary>
+	/// <param name="paths">Files to identify</param>
+	/// <param name="threadCount">Threads reading and hashing the files (0 = one per core)</param>
+	/// <returns>One result per file, in the same order as the paths</returns>
+	[[nodiscard]] static vector<RomIdentification> Identify(const vector<string>& paths, uint32_t threadCount = 0);
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/Serializer.h"
+#include "Utilities/ISerializable.h"
+
+/// <summary>
+/// Snapshots of the frames emulated ahead of the confirmed frame, for preemptive run-ahead.
+/// </summary>
+/// <remarks>
+/// Regular run-ahead runs RunAheadFrames + 1 frames and saves/loads a state on every host frame.
+/// With preemptive run-ahead, the emulation itself stays RunAheadFrames ahead: the ring holds the
+/// state before each of the last RunAheadFrames frames, which were all run with the same input.
+///
+/// On each host frame, the input is peeked before running the frame:
+/// - Same input as the previous frame: the frames run ahead are still correct, so only the
+///   displayed frame is run (and its state saved).
+/// - Input changed: the oldest snapshot (the confirmed frame) is loaded, and the frames are
+///   run again with the new input before the displayed frame.
+///
+/// The snapshots are discarded whenever the emulation state changes outside of these frames
+/// (reset, state load, settings change) - detected by the frame count not matching.
+/// </remarks>
+class RunAheadStateRing {
+private:
+	vector<unique_ptr<Serializer>> _states;
+	uint32_t _next = 0;
+	uint32_t _count = 0;
+	uint64_t _inputHash = 0;
+	uint32_t _frameCount = 0;
+
+public:
+	/// <summary>
+	/// Checks whether the ring holds one snapshot per run-ahead frame for the current state.
+	/// </summary>
+	/// <param name="runAheadFrames">Run-ahead frame count</param>
+	/// <param name="frameCount">Current frame count (must match the one at the end of the last frame)</param>
+	[[nodiscard]] bool IsValid(uint32_t runAheadFrames, uint32_t frameCount) const {
+		return runAheadFrames > 0 && _states.size() == runAheadFrames && _count == runAheadFrames && _frameCount == frameCount;
+	}
+
+	/// <summary>Input the frames in the ring were run with</summary>
+	[[nodiscard]] uint64_t GetInputHash() const { return _inputHash; }
+
+	/// <summary>Number of snapshots in the ring</summary>
+	[[nodiscard]] uint32_t GetCount() const { return _count; }
+
+	/// <summary>Discards all snapshots and resizes the ring</summary>
+	void Reset(uint32_t runAheadFrames) {
+		while (_states.size() < runAheadFrames) {
+			_states.push_back(std::make_unique<Serializer>());
+		}
+		_states.resize(runAheadFrames);
+		_next = 0;
+		_count = 0;
+	}
+
+	/// <summary>Discards all snapshots (keeps the buffers)</summary>
+	void Clear() {
+		_next = 0;
+		_count = 0;
+	}
+
+	/// <summary>Saves the state before a frame, replacing the oldest snapshot once the ring is full</summary>
+	void Save(ISerializable& console, uint32_t version) {
+		if (_states.empty()) {
+			return;
+		}
+
+		Serializer& s = *_states[_next];
+		s.ResetForFastSave(version);
+		s.Stream(console, "", -1);
+		_next = (_next + 1) % _states.size();
+		_count = std::min<uint32_t>(_count + 1, (uint32_t)_states.size());
+	}
+
+	/// <summary>
+	/// Loads the oldest snapshot (the confirmed frame). The ring keeps all snapshots - they are
+	/// replaced as the frames are run again.
+	/// </summary>
+	/// <returns>False if the ring isn't full</returns>
+	bool LoadOldest(ISerializable& console) {
+		if (_states.empty() || _count != _states.size()) {
+			return false;
+		}
+
+		// When full, the next slot to write is the oldest snapshot
+		Serializer& s = *_states[_next];
+		s.ResetForFastLoad();
+		s.Stream(console, "", -1);
+		return true;
+	}
+
+	/// <summary>Marks the end of a host frame: the frames in the ring were run with this input</summary>
+	void EndFrame(uint64_t inputHash, uint32_t frameCount) {
+		_inputHash = inputHash;
+		_frameCount = frameCount;
+	}
+};
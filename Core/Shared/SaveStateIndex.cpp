@@ -0,0 +1,215 @@
+#include "pch.h"
+#include "Shared/SaveStateIndex.h"
+#include "Shared/SaveStateManager.h"
+#include "Utilities/FolderUtilities.h"
+#include "Utilities/PathUtil.h"
+
+namespace {
+	// Thumbnails are capped at the managed-side preview buffer size (512*478*4)
+	constexpr uint32_t MaxThumbnailSize = 512 * 478 * 4;
+	constexpr uint32_t MaxFilenameLength = 4096;
+
+	template <typename T>
+	void WriteRaw(ostream& stream, T value) {
+		uint8_t bytes[sizeof(T)];
+		for (size_t i = 0; i < sizeof(T); i++) {
+			bytes[i] = (uint8_t)((uint64_t)value >> (i * 8));
+		}
+		stream.write((char*)bytes, sizeof(T));
+	}
+
+	template <typename T>
+	bool ReadRaw(istream& stream, T& value) {
+		uint8_t bytes[sizeof(T)];
+		if (!stream.read((char*)bytes, sizeof(T))) {
+			return false;
+		}
+		uint64_t result = 0;
+		for (size_t i = 0; i < sizeof(T); i++) {
+			result |= (uint64_t)bytes[i] << (i * 8);
+		}
+		value = (T)result;
+		return true;
+	}
+}
+
+bool SaveStateIndex::GetFileStamp(const string& filepath, uint64_t& fileSize, int64_t& lastWriteTime) {
+	std::error_code ec;
+	fs::path path = PathUtil::FromUtf8(filepath);
+	fileSize = fs::file_size(path, ec);
+	if (ec) {
+		return false;
+	}
+	lastWriteTime = (int64_t)fs::last_write_time(path, ec).time_since_epoch().count();
+	return !ec;
+}
+
+void SaveStateIndex::SelectFolder(const string& folderPath) {
+	// GetFolderName() keeps a trailing separator, directory settings usually don't
+	string folder = folderPath;
+	while (folder.size() > 1 && (folder.back() == '/' || folder.back() == '\\')) {
+		folder.pop_back();
+	}
+
+	if (folder == _folder) {
+		return;
+	}
+
+	// Switching folders (e.g. a different ROM was loaded) - persist the previous index first
+	Save();
+	_folder = folder;
+	_entries.clear();
+	Load();
+}
+
+void SaveStateIndex::Load() {
+	_dirty = false;
+
+	ifstream file(FolderUtilities::CombinePath(_folder, IndexFilename), ios::in | ios::binary);
+	if (!file) {
+		return;
+	}
+
+	char magic[4] = {};
+	uint32_t version = 0;
+	uint32_t count = 0;
+	file.read(magic, 4);
+	if (!file || memcmp(magic, "NXSI", 4) != 0 || !ReadRaw(file, version) || version != FormatVersion || !ReadRaw(file, count)) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t nameLength = 0;
+		if (!ReadRaw(file, nameLength) || nameLength == 0 || nameLength > MaxFilenameLength) {
+			break;
+		}
+
+		string name(nameLength, '\0');
+		SaveStateIndexEntry entry;
+		int64_t timestamp = 0;
+		uint8_t origin = 0;
+		uint8_t isPaused = 0;
+		uint32_t pngSize = 0;
+		file.read(name.data(), nameLength);
+		if (!ReadRaw(file, entry.FileSize) || !ReadRaw(file, entry.LastWriteTime) || !ReadRaw(file, timestamp) || !ReadRaw(file, origin) || !ReadRaw(file, entry.SlotNumber) || !ReadRaw(file, isPaused) || !ReadRaw(file, pngSize) || pngSize > MaxThumbnailSize) {
+			break;
+		}
+
+		entry.ThumbnailPng.resize(pngSize);
+		if (pngSize > 0 && !file.read((char*)entry.ThumbnailPng.data(), pngSize)) {
+			break;
+		}
+
+		entry.Timestamp = (time_t)timestamp;
+		entry.Origin = (SaveStateOrigin)origin;
+		entry.IsPaused = isPaused != 0;
+		_entries[name] = std::move(entry);
+	}
+}
+
+void SaveStateIndex::Save() {
+	if (!_dirty || _folder.empty()) {
+		return;
+	}
+	_dirty = false;
+
+	// Write to a temporary file then rename, so a crash mid-write never leaves a truncated index
+	string indexPath = FolderUtilities::CombinePath(_folder, IndexFilename);
+	string tmpPath = indexPath + ".tmp";
+	{
+		ofstream file(tmpPath, ios::out | ios::binary | ios::trunc);
+		if (!file) {
+			return;
+		}
+
+		file.write("NXSI", 4);
+		WriteRaw<uint32_t>(file, FormatVersion);
+		WriteRaw<uint32_t>(file, (uint32_t)_entries.size());
+		for (auto& [name, entry] : _entries) {
+			WriteRaw<uint32_t>(file, (uint32_t)name.size());
+			file.write(name.data(), name.size());
+			WriteRaw<uint64_t>(file, entry.FileSize);
+			WriteRaw<int64_t>(file, entry.LastWriteTime);
+			WriteRaw<int64_t>(file, (int64_t)entry.Timestamp);
+			WriteRaw<uint8_t>(file, (uint8_t)entry.Origin);
+			WriteRaw<uint8_t>(file, entry.SlotNumber);
+			WriteRaw<uint8_t>(file, entry.IsPaused ? 1 : 0);
+			WriteRaw<uint32_t>(file, (uint32_t)entry.ThumbnailPng.size());
+			file.write((char*)entry.ThumbnailPng.data(), entry.ThumbnailPng.size());
+		}
+
+		if (!file) {
+			return;
+		}
+	}
+
+	std::error_code ec;
+	fs::rename(PathUtil::FromUtf8(tmpPath), PathUtil::FromUtf8(indexPath), ec);
+}
+
+bool SaveStateIndex::TryGet(const string& filepath, uint64_t fileSize, int64_t lastWriteTime, SaveStateIndexEntry& entry) {
+	std::lock_guard<std::mutex> lock(_lock);
+	SelectFolder(FolderUtilities::GetFolderName(filepath));
+
+	auto it = _entries.find(FolderUtilities::GetFilename(filepath, true));
+	if (it == _entries.end() || it->second.FileSize != fileSize || it->second.LastWriteTime != lastWriteTime) {
+		return false;
+	}
+
+	entry = it->second;
+	return true;
+}
+
+void SaveStateIndex::Set(const string& filepath, SaveStateIndexEntry entry) {
+	std::lock_guard<std::mutex> lock(_lock);
+	SelectFolder(FolderUtilities::GetFolderName(filepath));
+
+	SaveStateIndexEntry& existing = _entries[FolderUtilities::GetFilename(filepath, true)];
+	if (entry.ThumbnailPng.empty() && existing.FileSize == entry.FileSize && existing.LastWriteTime == entry.LastWriteTime) {
+		entry.ThumbnailPng = std::move(existing.ThumbnailPng);
+	}
+	if (entry.ThumbnailPng.size() > MaxThumbnailSize) {
+		entry.ThumbnailPng.clear();
+	}
+	existing = std::move(entry);
+	_dirty = true;
+}
+
+void SaveStateIndex::SetThumbnail(const string& filepath, uint64_t fileSize, int64_t lastWriteTime, vector<uint8_t> thumbnailPng) {
+	std::lock_guard<std::mutex> lock(_lock);
+	SelectFolder(FolderUtilities::GetFolderName(filepath));
+
+	auto it = _entries.find(FolderUtilities::GetFilename(filepath, true));
+	if (it != _entries.end() && it->second.FileSize == fileSize && it->second.LastWriteTime == lastWriteTime && thumbnailPng.size() <= MaxThumbnailSize) {
+		it->second.ThumbnailPng = std::move(thumbnailPng);
+		_dirty = true;
+	}
+}
+
+void SaveStateIndex::Remove(const string& filepath) {
+	std::lock_guard<std::mutex> lock(_lock);
+	SelectFolder(FolderUtilities::GetFolderName(filepath));
+
+	if (_entries.erase(FolderUtilities::GetFilename(filepath, true)) > 0) {
+		_dirty = true;
+	}
+}
+
+void SaveStateIndex::Prune(const string& folder, const unordered_set<string>& existingFiles) {
+	std::lock_guard<std::mutex> lock(_lock);
+	SelectFolder(folder);
+
+	size_t count = std::erase_if(_entries, [&](const auto& item) { return !existingFiles.contains(item.first); });
+	if (count > 0) {
+		_dirty = true;
+	}
+}
+
+SaveStateIndex::~SaveStateIndex() {
+	Flush();
+}
+
+void SaveStateIndex::Flush() {
+	std::lock_guard<std::mutex> lock(_lock);
+	Save();
+}
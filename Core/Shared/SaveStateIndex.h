@@ -0,0 +1,81 @@
+#pragma once
+#include "pch.h"
+#include <ctime>
+#include <mutex>
+
+enum class SaveStateOrigin : uint8_t;
+
+/// <summary>
+/// Cached metadata and thumbnail for a single save state file.
+/// </summary>
+struct SaveStateIndexEntry {
+	uint64_t FileSize = 0;      ///< Save state file size when the entry was created
+	int64_t LastWriteTime = 0;  ///< Save state file modification time (filesystem clock ticks)
+	time_t Timestamp = 0;       ///< Save timestamp shown in the UI
+	SaveStateOrigin Origin = {};
+	uint8_t SlotNumber = 0;
+	bool IsPaused = false;
+	vector<uint8_t> ThumbnailPng; ///< Pre-encoded PNG preview (empty until generated)
+};
+
+/// <summary>
+/// Per-folder sidecar index for save state files.
+/// </summary>
+/// <remarks>
+/// Listing and previewing save states used to re-open every file, decompress its framebuffer,
+/// run it through a video filter and re-encode a PNG each time the picker was shown.
+/// The index stores that work once per file in a single sidecar file next to the save states:
+/// - Entries are keyed by filename and validated against the file's size and modification time,
+///   so a save state that was replaced, copied in or edited outside Nexen is rebuilt automatically.
+/// - The background save state writer fills in entries (including the thumbnail) as it writes files.
+/// - Entries for files that no longer exist are pruned when the folder is listed.
+///
+/// Thread safety: all methods lock an internal mutex (the writer thread and UI calls share an index).
+/// </remarks>
+class SaveStateIndex {
+private:
+	static constexpr uint32_t FormatVersion = 1;
+
+	std::mutex _lock;
+	string _folder;
+	unordered_map<string, SaveStateIndexEntry> _entries;
+	bool _dirty = false;
+
+	void SelectFolder(const string& folderPath);
+	void Load();
+	void Save();
+
+public:
+	static constexpr const char* IndexFilename = "SaveStates.nexen-index";
+
+	/// <summary>Reads the file's current size and modification time</summary>
+	/// <returns>False if the file does not exist</returns>
+	[[nodiscard]] static bool GetFileStamp(const string& filepath, uint64_t& fileSize, int64_t& lastWriteTime);
+
+	/// <summary>
+	/// Looks up the entry for a save state file.
+	/// </summary>
+	/// <param name="filepath">Full path to the save state file</param>
+	/// <param name="fileSize">Current file size (from GetFileStamp or a directory entry)</param>
+	/// <param name="lastWriteTime">Current modification time</param>
+	/// <param name="entry">Receives a copy of the cached entry</param>
+	/// <returns>True if a valid (not stale) entry exists</returns>
+	[[nodiscard]] bool TryGet(const string& filepath, uint64_t fileSize, int64_t lastWriteTime, SaveStateIndexEntry& entry);
+
+	/// <summary>Adds or replaces the entry for a save state file, keeping an existing thumbnail if none is given and the file is unchanged</summary>
+	void Set(const string& filepath, SaveStateIndexEntry entry);
+
+	/// <summary>Stores a thumbnail for an existing, still valid entry</summary>
+	void SetThumbnail(const string& filepath, uint64_t fileSize, int64_t lastWriteTime, vector<uint8_t> thumbnailPng);
+
+	/// <summary>Removes the entry for a save state file</summary>
+	void Remove(const string& filepath);
+
+	/// <summary>Removes entries of the given folder whose files are not in existingFiles</summary>
+	void Prune(const string& folder, const unordered_set<string>& existingFiles);
+
+	/// <summary>Writes pending changes to the sidecar file</summary>
+	void Flush();
+
+	~SaveStateIndex();
+};
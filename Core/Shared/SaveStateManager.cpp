@@ -3,6 +3,8 @@
 #include "Utilities/ZipWriter.h"
 #include "Utilities/ZipReader.h"
 #include "Utilities/PNGHelper.h"
+#include "Utilities/PathUtil.h"
+#include "Utilities/ThreadTrace.h"
 #include "Shared/SaveStateManager.h"
 #include "Shared/MessageManager.h"
 #include "Shared/Emulator.h"
@@ -268,12 +270,15 @@ bool SaveStateManager::SaveState(const string& filepath, bool showSuccessMessage
 		RomInfo romInfo = _emu->GetRomInfo();
 		snapshot.romName = FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true);
 		snapshot.isPaused = _emu->IsPaused();
+		snapshot.previewFilter.reset(_emu->GetVideoFilter(true));
 
 		_emu->ProcessEvent(EventType::StateSaved);
 	}
 
 	snapshot.filepath = filepath;
 	snapshot.showSuccessMessage = showSuccessMessage;
+	snapshot.traceFlowId = ThreadTrace::NewFlowId();
+	THREAD_TRACE_FLOW_START("SaveState", snapshot.traceFlowId);
 
 	// Enqueue for background compression + write (no lock held)
 	{
@@ -528,6 +533,19 @@ void SaveStateManager::LoadRecentGame(const string& filename, bool resetGame) {
 }
 
 int32_t SaveStateManager::GetSaveStatePreview(const string& saveStatePath, uint8_t* pngData) {
+	// Safety bounds check — buffer is 512*478*4 = 978944 bytes on the managed side
+	constexpr size_t maxBufferSize = 512 * 478 * 4;
+
+	uint64_t fileSize = 0;
+	int64_t lastWriteTime = 0;
+	bool hasStamp = SaveStateIndex::GetFileStamp(saveStatePath, fileSize, lastWriteTime);
+
+	SaveStateIndexEntry entry;
+	if (hasStamp && _index.TryGet(saveStatePath, fileSize, lastWriteTime, entry) && !entry.ThumbnailPng.empty()) {
+		memcpy(pngData, entry.ThumbnailPng.data(), entry.ThumbnailPng.size());
+		return (int32_t)entry.ThumbnailPng.size();
+	}
+
 	ifstream stream(saveStatePath, ios::binary);
 
 	if (!stream) {
@@ -554,33 +572,104 @@ int32_t SaveStateManager::GetSaveStatePreview(const string& saveStatePath, uint8
 		vector<uint8_t> frameData;
 		RenderedFrame frame;
 		if (GetVideoData(frameData, frame, stream)) {
-			FrameInfo baseFrameInfo;
-			baseFrameInfo.Width = frame.Width;
-			baseFrameInfo.Height = frame.Height;
-
 			unique_ptr<BaseVideoFilter> filter(_emu->GetVideoFilter(true));
-			filter->SetBaseFrameInfo(baseFrameInfo);
-			FrameInfo frameInfo = filter->SendFrame((uint16_t*)frameData.data(), 0, 0, nullptr);
-
-			std::stringstream pngStream;
-			PNGHelper::WritePNG(pngStream, filter->GetOutputBuffer(), frameInfo.Width, frameInfo.Height);
-
-			auto pngView = pngStream.view();
-
-			// Safety bounds check — buffer is 512*478*4 = 978944 bytes on the managed side
-			constexpr size_t maxBufferSize = 512 * 478 * 4;
-			if (pngView.size() > maxBufferSize) {
+			vector<uint8_t> png = EncodePreviewPng(filter.get(), frameData.data(), frame.Width, frame.Height);
+			if (png.empty() || png.size() > maxBufferSize) {
 				return -1;
 			}
 
-			memcpy(pngData, pngView.data(), pngView.size());
+			memcpy(pngData, png.data(), png.size());
+			int32_t pngSize = (int32_t)png.size();
+
+			// Cache the thumbnail so the next preview of this file is a single lookup
+			if (hasStamp) {
+				if (!_index.TryGet(saveStatePath, fileSize, lastWriteTime, entry)) {
+					_index.Set(saveStatePath, BuildIndexEntry(saveStatePath, fileSize, lastWriteTime));
+				}
+				_index.SetThumbnail(saveStatePath, fileSize, lastWriteTime, std::move(png));
+			}
 
-			return (int32_t)pngView.size();
+			return pngSize;
 		}
 	}
 	return -1;
 }
 
+vector<uint8_t> SaveStateManager::EncodePreviewPng(BaseVideoFilter* filter, uint8_t* frameBuffer, uint32_t width, uint32_t height) {
+	if (!filter || !frameBuffer || width == 0 || height == 0) {
+		return {};
+	}
+
+	FrameInfo baseFrameInfo;
+	baseFrameInfo.Width = width;
+	baseFrameInfo.Height = height;
+
+	filter->SetBaseFrameInfo(baseFrameInfo);
+	FrameInfo frameInfo = filter->SendFrame((uint16_t*)frameBuffer, 0, 0, nullptr);
+
+	std::stringstream pngStream;
+	if (!PNGHelper::WritePNG(pngStream, filter->GetOutputBuffer(), frameInfo.Width, frameInfo.Height)) {
+		return {};
+	}
+
+	auto pngView = pngStream.view();
+	return vector<uint8_t>(pngView.begin(), pngView.end());
+}
+
+SaveStateIndexEntry SaveStateManager::BuildIndexEntry(const string& filepath, uint64_t fileSize, int64_t lastWriteTime) {
+	namespace fs = std::filesystem;
+
+	SaveStateIndexEntry entry;
+	entry.FileSize = fileSize;
+	entry.LastWriteTime = lastWriteTime;
+
+	string filename = FolderUtilities::GetFilename(filepath, true);
+	entry.Timestamp = ParseTimestampFromFilename(filename);
+	ParseOriginFromFilename(filename, entry.Origin, entry.SlotNumber);
+
+	// If timestamp parsing failed, use file modification time
+	if (entry.Timestamp == 0) {
+		try {
+			auto ftime = fs::last_write_time(PathUtil::FromUtf8(filepath));
+			auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+				ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
+			);
+			entry.Timestamp = std::chrono::system_clock::to_time_t(sctp);
+		} catch (...) {
+		}
+	}
+
+	// v5+: read pause byte (last byte of file) to detect paused save states
+	// Only v5+ saves have the pause byte appended — older formats' last byte is compressed data
+	if (fileSize > 0) {
+		try {
+			ifstream file(filepath, ios::binary);
+			if (file.good()) {
+				// Read header to check format version
+				char hdr[3] = {};
+				file.read(hdr, 3);
+				if (memcmp(hdr, "MSS", 3) == 0) {
+					// Skip emuVersion (4 bytes)
+					file.seekg(4, ios::cur);
+					uint32_t fileFormatVersion = ReadValue(file);
+					if (fileFormatVersion >= 5) {
+						// Seek to last byte for pause flag
+						file.seekg(-1, ios::end);
+						char pauseByte = 0;
+						if (file.get(pauseByte)) {
+							entry.IsPaused = (pauseByte != 0);
+						}
+					}
+				}
+			}
+		} catch (...) {
+			// Ignore — IsPaused defaults to false
+		}
+	}
+
+	return entry;
+}
+
 void SaveStateManager::WriteValue(ostream& stream, uint32_t value) {
 	stream.put(value & 0xFF);
 	stream.put((value >> 8) & 0xFF);
@@ -612,6 +701,49 @@ string SaveStateManager::SaveTimestampedState() {
 	return "";
 }
 
+void SaveStateManager::ParseOriginFromFilename(const string& filename, SaveStateOrigin& origin, uint8_t& slotNumber) {
+	slotNumber = 0;
+
+	// Detect origin from filename pattern
+	// {RomName}_auto.nexen-save -> Auto (legacy)
+	// {RomName}_auto_{YYYY-MM-DD}_{HH-mm-ss}.nexen-save -> Auto
+	// {RomName}_recent_{NN}.nexen-save -> Recent
+	// {RomName}_lua_{timestamp}.nexen-save -> Lua
+	// {RomName}_[slot{NN}]_{timestamp}.nexen-save -> Designated (new format)
+	// {RomName}_designated_{N}_{timestamp}.nexen-save -> Designated (legacy)
+	// {RomName}_{YYYY-MM-DD}_{HH-mm-ss}.nexen-save -> Save
+	if (filename.find("_auto.") != string::npos || filename.find("_auto_") != string::npos) {
+		origin = SaveStateOrigin::Auto;
+	} else if (filename.find("_recent_") != string::npos) {
+		origin = SaveStateOrigin::Recent;
+	} else if (filename.find("_lua_") != string::npos) {
+		origin = SaveStateOrigin::Lua;
+	} else if (auto pos = filename.find("_[slot"); pos != string::npos) {
+		origin = SaveStateOrigin::Designated;
+		// Extract slot number from _[slotNN]_
+		auto numStart = pos + 6; // skip "_[slot"
+		auto endBracket = filename.find(']', numStart);
+		if (endBracket != string::npos && endBracket > numStart) {
+			try {
+				slotNumber = static_cast<uint8_t>(std::stoi(filename.substr(numStart, endBracket - numStart)));
+			} catch (...) {}
+		}
+	} else if (filename.find("_designated_") != string::npos) {
+		origin = SaveStateOrigin::Designated;
+		// Extract slot number from _designated_N_ or _designated_N.
+		auto numStart = filename.find("_designated_") + 12;
+		auto numEnd = numStart;
+		while (numEnd < filename.size() && filename[numEnd] >= '0' && filename[numEnd] <= '9') numEnd++;
+		if (numEnd > numStart) {
+			try {
+				slotNumber = static_cast<uint8_t>(std::stoi(filename.substr(numStart, numEnd - numStart)));
+			} catch (...) {}
+		}
+	} else {
+		origin = SaveStateOrigin::Save;
+	}
+}
+
 vector<SaveStateInfo> SaveStateManager::GetSaveStateList() {
 	vector<SaveStateInfo> states;
 
@@ -625,6 +757,7 @@ vector<SaveStateInfo> SaveStateManager::GetSaveStateList() {
 			return states;
 		}
 
+		unordered_set<string> existingFiles;
 		for (const auto& entry : fs::directory_iterator(folder)) {
 			if (!entry.is_regular_file()) {
 				continue;
@@ -644,90 +777,32 @@ vector<SaveStateInfo> SaveStateManager::GetSaveStateList() {
 				continue;
 			}
 
+			existingFiles.insert(filename);
+
 			SaveStateInfo info;
 			info.filepath = entry.path().string();
 			info.romName = romName;
-			info.timestamp = ParseTimestampFromFilename(filename);
 			info.fileSize = static_cast<uint32_t>(entry.file_size());
 
-			// Detect origin from filename pattern
-			// {RomName}_auto.nexen-save -> Auto (legacy)
-			// {RomName}_auto_{YYYY-MM-DD}_{HH-mm-ss}.nexen-save -> Auto
-			// {RomName}_recent_{NN}.nexen-save -> Recent
-			// {RomName}_lua_{timestamp}.nexen-save -> Lua
-			// {RomName}_[slot{NN}]_{timestamp}.nexen-save -> Designated (new format)
-			// {RomName}_designated_{N}_{timestamp}.nexen-save -> Designated (legacy)
-			// {RomName}_{YYYY-MM-DD}_{HH-mm-ss}.nexen-save -> Save
-			if (filename.find("_auto.") != string::npos || filename.find("_auto_") != string::npos) {
-				info.origin = SaveStateOrigin::Auto;
-			} else if (filename.find("_recent_") != string::npos) {
-				info.origin = SaveStateOrigin::Recent;
-			} else if (filename.find("_lua_") != string::npos) {
-				info.origin = SaveStateOrigin::Lua;
-			} else if (auto pos = filename.find("_[slot"); pos != string::npos) {
-				info.origin = SaveStateOrigin::Designated;
-				// Extract slot number from _[slotNN]_
-				auto numStart = pos + 6; // skip "_[slot"
-				auto endBracket = filename.find(']', numStart);
-				if (endBracket != string::npos && endBracket > numStart) {
-					try {
-						info.slotNumber = static_cast<uint8_t>(std::stoi(filename.substr(numStart, endBracket - numStart)));
-					} catch (...) {}
-				}
-			} else if (filename.find("_designated_") != string::npos) {
-				info.origin = SaveStateOrigin::Designated;
-				// Extract slot number from _designated_N_ or _designated_N.
-				auto numStart = filename.find("_designated_") + 12;
-				auto numEnd = numStart;
-				while (numEnd < filename.size() && filename[numEnd] >= '0' && filename[numEnd] <= '9') numEnd++;
-				if (numEnd > numStart) {
-					try {
-						info.slotNumber = static_cast<uint8_t>(std::stoi(filename.substr(numStart, numEnd - numStart)));
-					} catch (...) {}
-				}
-			} else {
-				info.origin = SaveStateOrigin::Save;
+			// Metadata comes from the index unless the file is new or changed since it was indexed
+			uint64_t fileSize = entry.file_size();
+			int64_t lastWriteTime = (int64_t)entry.last_write_time().time_since_epoch().count();
+			SaveStateIndexEntry indexEntry;
+			if (!_index.TryGet(info.filepath, fileSize, lastWriteTime, indexEntry)) {
+				indexEntry = BuildIndexEntry(info.filepath, fileSize, lastWriteTime);
+				_index.Set(info.filepath, indexEntry);
 			}
 
-			// If timestamp parsing failed, use file modification time
-			if (info.timestamp == 0) {
-				auto ftime = fs::last_write_time(entry);
-				auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-					ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-				);
-				info.timestamp = std::chrono::system_clock::to_time_t(sctp);
-			}
-
-			// v5+: read pause byte (last byte of file) to detect paused save states
-			// Only v5+ saves have the pause byte appended — older formats' last byte is compressed data
-			if (info.fileSize > 0) {
-				try {
-					ifstream file(info.filepath, ios::binary);
-					if (file.good()) {
-						// Read header to check format version
-						char hdr[3] = {};
-						file.read(hdr, 3);
-						if (memcmp(hdr, "MSS", 3) == 0) {
-							// Skip emuVersion (4 bytes)
-							file.seekg(4, ios::cur);
-							uint32_t fileFormatVersion = ReadValue(file);
-							if (fileFormatVersion >= 5) {
-								// Seek to last byte for pause flag
-								file.seekg(-1, ios::end);
-								char pauseByte = 0;
-								if (file.get(pauseByte)) {
-									info.isPaused = (pauseByte != 0);
-								}
-							}
-						}
-					}
-				} catch (...) {
-					// Ignore — isPaused defaults to false
-				}
-			}
+			info.timestamp = indexEntry.Timestamp;
+			info.origin = indexEntry.Origin;
+			info.slotNumber = indexEntry.SlotNumber;
+			info.isPaused = indexEntry.IsPaused;
 
 			states.push_back(info);
 		}
+
+		_index.Prune(folder, existingFiles);
+		_index.Flush();
 	} catch (const std::exception&) {
 		// Ignore filesystem errors
 	}
@@ -744,6 +819,7 @@ bool SaveStateManager::DeleteSaveState(const string& filepath) {
 	try {
 		namespace fs = std::filesystem;
 		if (fs::exists(filepath) && fs::is_regular_file(filepath)) {
+			_index.Remove(filepath);
 			return fs::remove(filepath);
 		}
 	} catch (const std::exception&) {
@@ -986,6 +1062,7 @@ void SaveStateManager::SetPerRomSaveStateDirectory(const string& path) {
 }
 
 void SaveStateManager::BackgroundWriteLoop() {
+	THREAD_TRACE_NAME("Save State Writer");
 	while (true) {
 		SaveStateSnapshot snapshot;
 		{
@@ -998,9 +1075,20 @@ void SaveStateManager::BackgroundWriteLoop() {
 
 			snapshot = std::move(_writeQueue.front());
 			_writeQueue.pop();
+			_writeInProgress = true;
 		}
 
-		WriteSnapshotToDisk(snapshot);
+		{
+			THREAD_TRACE_SCOPE("WriteSaveState");
+			THREAD_TRACE_FLOW_END("SaveState", snapshot.traceFlowId);
+			WriteSnapshotToDisk(snapshot);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_writeMutex);
+			_writeInProgress = false;
+		}
+		_writeDoneCv.notify_all();
 	}
 }
 
@@ -1053,21 +1141,34 @@ void SaveStateManager::WriteSnapshotToDisk(SaveStateSnapshot& snapshot) {
 
 	file.close();
 
+	// Index the new file (metadata + thumbnail) so the save state picker never has to re-open it
+	uint64_t fileSize = 0;
+	int64_t lastWriteTime = 0;
+	if (SaveStateIndex::GetFileStamp(snapshot.filepath, fileSize, lastWriteTime)) {
+		SaveStateIndexEntry entry;
+		entry.FileSize = fileSize;
+		entry.LastWriteTime = lastWriteTime;
+		entry.IsPaused = snapshot.isPaused;
+		string filename = FolderUtilities::GetFilename(snapshot.filepath, true);
+		entry.Timestamp = ParseTimestampFromFilename(filename);
+		if (entry.Timestamp == 0) {
+			entry.Timestamp = std::time(nullptr);
+		}
+		ParseOriginFromFilename(filename, entry.Origin, entry.SlotNumber);
+		entry.ThumbnailPng = EncodePreviewPng(snapshot.previewFilter.get(), snapshot.frameBuffer.data(), snapshot.frameWidth, snapshot.frameHeight);
+
+		_index.Set(snapshot.filepath, std::move(entry));
+		_index.Flush();
+	}
+
 	if (snapshot.showSuccessMessage) {
 		MessageManager::DisplayMessage("SaveStates", FormatSaveStateOsdFromFile(snapshot.filepath, "Saved"));
 	}
 }
 
 void SaveStateManager::FlushPendingWrites() {
-	// Spin until write queue is empty
-	while (true) {
-		{
-			std::lock_guard<std::mutex> lock(_writeMutex);
-			if (_writeQueue.empty()) {
-				return;
-			}
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	// Wait for the queue to drain and for the snapshot being written (if any) to be done
+	std::unique_lock<std::mutex> lock(_writeMutex);
+	_writeDoneCv.wait(lock, [this] { return _writeQueue.empty() && !_writeInProgress; });
 }
 
@@ -5,8 +5,10 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include "Shared/SaveStateIndex.h"
 
 class Emulator;
+class BaseVideoFilter;
 struct RenderedFrame;
 
 /// <summary>
@@ -67,6 +69,8 @@ struct SaveStateSnapshot {
 	string filepath;              ///< Target save state file path
 	bool showSuccessMessage = false; ///< Display success message after write
 	bool isPaused = false;        ///< Whether emulator was paused at time of capture
+	uint64_t traceFlowId = 0;     ///< Thread trace flow id (links the capture to the background write)
+	shared_ptr<BaseVideoFilter> previewFilter; ///< Default video filter used to render the index thumbnail
 };
 
 /// <summary>
@@ -130,12 +134,17 @@ private:
 	/// <summary>Persistent compression buffer for background state writes (single-threaded, no lock needed)</summary>
 	vector<uint8_t> _bgCompressStateBuffer;
 
+	/// <summary>Sidecar index of save state metadata and thumbnails (see SaveStateIndex)</summary>
+	SaveStateIndex _index;
+
 	// ========== Async Write Infrastructure ==========
 	std::thread _writeThread;
 	std::queue<SaveStateSnapshot> _writeQueue;
 	std::mutex _writeMutex;
 	std::condition_variable _writeCv;
+	std::condition_variable _writeDoneCv;
 	bool _shutdownRequested = false;
+	bool _writeInProgress = false;
 
 	/// <summary>Background thread loop — dequeues snapshots, compresses, writes to disk</summary>
 	void BackgroundWriteLoop();
@@ -191,6 +200,15 @@ private:
 	/// <returns>True if screenshot loaded successfully</returns>
 	[[nodiscard]] bool GetVideoData(vector<uint8_t>& out, RenderedFrame& frame, istream& stream);
 
+	/// <summary>
+	/// Build an index entry for a save state file (metadata only, no thumbnail).
+	/// </summary>
+	/// <remarks>Reads the file header and pause byte - only called when the index has no valid entry.</remarks>
+	[[nodiscard]] SaveStateIndexEntry BuildIndexEntry(const string& filepath, uint64_t fileSize, int64_t lastWriteTime);
+
+	/// <summary>Render a raw framebuffer through a video filter and encode it as PNG</summary>
+	[[nodiscard]] static vector<uint8_t> EncodePreviewPng(BaseVideoFilter* filter, uint8_t* frameBuffer, uint32_t width, uint32_t height);
+
 	/// <summary>Write 32-bit value to stream (little-endian)</summary>
 	void WriteValue(ostream& stream, uint32_t value);
 
@@ -209,6 +227,14 @@ public:
 	/// <returns>Unix timestamp, or 0 if parsing failed</returns>
 	[[nodiscard]] static time_t ParseTimestampFromFilename(const string& filename);
 
+	/// <summary>
+	/// Detect origin category and designated slot number from a save state filename.
+	/// </summary>
+	/// <param name="filename">Filename (without path) to parse</param>
+	/// <param name="origin">Receives the origin category</param>
+	/// <param name="slotNumber">Receives the designated slot number (1-3), or 0</param>
+	static void ParseOriginFromFilename(const string& filename, SaveStateOrigin& origin, uint8_t& slotNumber);
+
 	/// <summary>Format OSD notification string with badge and current time</summary>
 	[[nodiscard]] static string FormatSaveStateOsd(const string& badge);
 
@@ -287,6 +313,10 @@ public:
 	/// <param name="saveStatePath">Save state file path</param>
 	/// <param name="pngData">Output PNG data buffer</param>
 	/// <returns>PNG data size in bytes, or -1 on error</returns>
+	/// <remarks>
+	/// Served from the save state index when a thumbnail is cached for the unchanged file,
+	/// otherwise rendered from the file and stored in the index for the next call.
+	/// </remarks>
 	[[nodiscard]] int32_t GetSaveStatePreview(const string& saveStatePath, uint8_t* pngData);
 
 	/// <summary>
@@ -313,6 +343,7 @@ public:
 	/// <summary>
 	/// Get list of all save states for the current ROM.
 	/// Returns saves from the ROM's subdirectory, sorted by timestamp (newest first).
+	/// Metadata comes from the save state index; only new or modified files are opened.
 	/// </summary>
 	/// <returns>Vector of SaveStateInfo structs</returns>
 	[[nodiscard]] vector<SaveStateInfo> GetSaveStateList();
@@ -426,7 +457,7 @@ public:
 	/// <param name="path">Full path to per-ROM save state directory, or empty to use default</param>
 	void SetPerRomSaveStateDirectory(const string& path);
 
-	/// <summary>Block until all pending background writes are complete</summary>
+	/// <summary>Block until all pending background writes (including the one in progress) are complete</summary>
 	void FlushPendingWrites();
 
 	/// <summary>Shut down the background writer thread (called on destruction)</summary>
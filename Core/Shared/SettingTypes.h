@@ -386,6 +386,9 @@ struct EmulationConfig {
 	uint32_t RewindSpeed = 100;
 
 	uint32_t RunAheadFrames = 0;
+
+	bool SkipIdleLoops = false;
+	bool PreemptiveRunAhead = false;
 };
 
 struct OverscanDimensions {
@@ -2,9 +2,7 @@
 #include <algorithm>
 #include "Shared/Video/DebugHud.h"
 #include "Shared/Video/DrawCommand.h"
-#include "Shared/Video/DrawLineCommand.h"
-#include "Shared/Video/DrawPixelCommand.h"
-#include "Shared/Video/DrawRectangleCommand.h"
+#include "Shared/Video/DrawPrimitiveBatch.h"
 #include "Shared/Video/DrawStringCommand.h"
 #include "Shared/Video/DrawScreenBufferCommand.h"
 
@@ -19,7 +17,9 @@ DebugHud::~DebugHud() {
 
 void DebugHud::ClearScreen() {
 	auto lock = _commandLock.AcquireSafe();
+	_records.clear();
 	_commands.clear();
+	_commandCount = 0;
 	_drawPixels.clear();
 	_prevDrawPixels.clear();
 	_dirtyIndices.clear();
@@ -46,9 +46,7 @@ bool DebugHud::Draw(uint32_t* argbBuffer, FrameInfo frameInfo, OverscanDimension
 		}
 
 		// Draw all commands into the flat buffer — O(1) per pixel vs O(1) amortized hash
-		for (unique_ptr<DrawCommand>& command : _commands) {
-			command->Draw(_drawPixels.data(), bufferSize, &_dirtyIndices, argbBuffer, frameInfo, overscan, frameNumber, scaleFactors);
-		}
+		DrawRecords(_drawPixels.data(), bufferSize, &_dirtyIndices, argbBuffer, frameInfo, overscan, frameNumber, scaleFactors);
 
 		// Fast diff: compare only dirty pixel positions against previous frame
 		// Also need to detect pixels that were in prev but not in current
@@ -64,27 +62,54 @@ bool DebugHud::Draw(uint32_t* argbBuffer, FrameInfo frameInfo, OverscanDimension
 		}
 	} else {
 		isDirty = true;
-		for (unique_ptr<DrawCommand>& command : _commands) {
-			command->Draw(nullptr, 0, nullptr, argbBuffer, frameInfo, overscan, frameNumber, scaleFactors);
-		}
+		DrawRecords(nullptr, 0, nullptr, argbBuffer, frameInfo, overscan, frameNumber, scaleFactors);
 	}
 
+	// Records must be compacted before their commands are released (command records check Command->Expired())
+	_records.erase(std::remove_if(_records.begin(), _records.end(), [](const HudDrawRecord& r) { return r.Expired(); }), _records.end());
 	_commands.erase(std::remove_if(_commands.begin(), _commands.end(), [](const unique_ptr<DrawCommand>& c) { return c->Expired(); }), _commands.end());
-	_commandCount = (uint32_t)_commands.size();
+	_commandCount = (uint32_t)_records.size();
 
 	return isDirty;
 }
 
+void DebugHud::DrawRecords(uint32_t* drawnPixels, uint32_t drawnPixelsSize, vector<uint32_t>* dirtyIndices, uint32_t* argbBuffer, FrameInfo& frameInfo, OverscanDimensions& overscan, uint32_t frameNumber, HudScaleFactors& scaleFactors) {
+	size_t count = _records.size();
+	size_t i = 0;
+	while (i < count) {
+		if (_records[i].Type == HudPrimitiveType::Command) {
+			_records[i].Command->Draw(drawnPixels, drawnPixelsSize, dirtyIndices, argbBuffer, frameInfo, overscan, frameNumber, scaleFactors);
+			i++;
+		} else {
+			// Rasterize the whole run of consecutive primitives in one batch
+			size_t end = i + 1;
+			while (end < count && _records[end].Type != HudPrimitiveType::Command) {
+				end++;
+			}
+			_batch.DrawRecords(std::span<HudDrawRecord>(_records.data() + i, end - i), drawnPixels, drawnPixelsSize, dirtyIndices, argbBuffer, frameInfo, overscan, frameNumber, scaleFactors);
+			i = end;
+		}
+	}
+}
+
 void DebugHud::DrawPixel(int x, int y, int color, int frameCount, int startFrame) {
-	AddCommand(std::make_unique<DrawPixelCommand>(x, y, color, frameCount, startFrame));
+	AddPrimitive(HudPrimitiveType::Pixel, x, y, 0, 0, color, frameCount, startFrame);
 }
 
 void DebugHud::DrawLine(int x, int y, int x2, int y2, int color, int frameCount, int startFrame) {
-	AddCommand(std::make_unique<DrawLineCommand>(x, y, x2, y2, color, frameCount, startFrame));
+	AddPrimitive(HudPrimitiveType::Line, x, y, x2, y2, color, frameCount, startFrame);
 }
 
 void DebugHud::DrawRectangle(int x, int y, int width, int height, int color, bool fill, int frameCount, int startFrame) {
-	AddCommand(std::make_unique<DrawRectangleCommand>(x, y, width, height, color, fill, frameCount, startFrame));
+	if (width < 0) {
+		x += width + 1;
+		width = -width;
+	}
+	if (height < 0) {
+		y += height + 1;
+		height = -height;
+	}
+	AddPrimitive(fill ? HudPrimitiveType::FilledRectangle : HudPrimitiveType::Rectangle, x, y, width, height, color, frameCount, startFrame);
 }
 
 void DebugHud::DrawString(int x, int y, const string& text, int color, int backColor, int frameCount, int startFrame, int maxWidth, bool overwritePixels, int fontScale) {
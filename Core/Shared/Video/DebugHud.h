@@ -3,11 +3,18 @@
 #include "Utilities/SimpleLock.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/Video/DrawCommand.h"
+#include "Shared/Video/DrawPrimitiveBatch.h"
 
 class DebugHud {
 private:
 	static constexpr size_t MaxCommandCount = 500000;
+
+	// Draw order for everything on the HUD. Pixels, lines and rectangles are stored inline as POD
+	// records (the vector's capacity acts as a per-frame arena), other commands are referenced.
+	vector<HudDrawRecord> _records;
+	// Owners of the non-primitive commands referenced by _records (strings, screen buffers)
 	vector<unique_ptr<DrawCommand>> _commands;
+	DrawPrimitiveBatch _batch;
 	atomic<uint32_t> _commandCount;
 	SimpleLock _commandLock;
 
@@ -18,6 +25,8 @@ private:
 	// Dirty pixel indices for fast diff/clear without scanning the full buffer
 	vector<uint32_t> _dirtyIndices;
 
+	void DrawRecords(uint32_t* drawnPixels, uint32_t drawnPixelsSize, vector<uint32_t>* dirtyIndices, uint32_t* argbBuffer, FrameInfo& frameInfo, OverscanDimensions& overscan, uint32_t frameNumber, HudScaleFactors& scaleFactors);
+
 public:
 	DebugHud();
 	~DebugHud();
@@ -32,9 +41,21 @@ public:
 	void DrawRectangle(int x, int y, int width, int height, int color, bool fill, int frameCount, int startFrame = -1);
 	void DrawString(int x, int y, const string& text, int color, int backColor, int frameCount, int startFrame = -1, int maxWidth = 0, bool overwritePixels = false, int fontScale = 1);
 
+	__forceinline void AddPrimitive(HudPrimitiveType type, int x, int y, int x2, int y2, int color, int frameCount, int startFrame) {
+		// Invert alpha byte - 0 = opaque, 255 = transparent (this way, no need to specifiy alpha channel all the time)
+		int32_t invertedColor = (~color & 0xFF000000) | (color & 0xFFFFFF);
+
+		auto lock = _commandLock.AcquireSafe();
+		if (_records.size() < DebugHud::MaxCommandCount) {
+			_records.push_back({x, y, x2, y2, invertedColor, startFrame, frameCount > 0 ? frameCount : -1, type, nullptr});
+			_commandCount++;
+		}
+	}
+
 	__forceinline void AddCommand(unique_ptr<DrawCommand> cmd) {
 		auto lock = _commandLock.AcquireSafe();
-		if (_commands.size() < DebugHud::MaxCommandCount) {
+		if (_records.size() < DebugHud::MaxCommandCount) {
+			_records.push_back({0, 0, 0, 0, 0, 0, 0, HudPrimitiveType::Command, cmd.get()});
 			_commands.push_back(std::move(cmd));
 			_commandCount++;
 		}
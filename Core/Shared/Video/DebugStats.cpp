@@ -6,6 +6,7 @@
 #include "Shared/Emulator.h"
 #include "Shared/RewindManager.h"
 #include "Shared/EmuSettings.h"
+#include "Shared/FrameProfiler.h"
 #include <format>
 
 void DebugStats::DisplayStats(Emulator* emu, double lastFrameTime) {
@@ -87,4 +88,40 @@ void DebugStats::DisplayStats(Emulator* emu, double lastFrameTime) {
 	if (rewindStats.HistoryDuration > 0) {
 		hud->DrawString(9, 82, std::format("   Per min.: {:.2f} MB", memUsage * 60 * 60 / rewindStats.HistoryDuration), 0xFFFFFF, 0xFF000000, 1, startFrame);
 	}
+
+	DisplayFrameBreakdown(emu, hud, startFrame);
+}
+
+void DebugStats::DisplayFrameBreakdown(Emulator* emu, DebugHud* hud, int startFrame) {
+	static constexpr std::pair<FrameProfilerSection, const char*> rows[] = {
+		{FrameProfilerSection::Console, "Console"},
+		{FrameProfilerSection::RunAhead, "Run-ahead"},
+		{FrameProfilerSection::Rewind, "Rewind"},
+		{FrameProfilerSection::Audio, "Audio"},
+		{FrameProfilerSection::VideoDecode, "Video filter"},
+		{FrameProfilerSection::Wait, "Wait"},
+		{FrameProfilerSection::Other, "Other"},
+		{FrameProfilerSection::Total, "Total"}
+	};
+
+	FrameProfilerStats stats = emu->GetFrameProfiler()->GetStats();
+
+	int height = 13 + (int)std::size(rows) * 9;
+	hud->DrawRectangle(8, 96, 243, height, 0x40000000, true, 1, startFrame);
+	hud->DrawRectangle(8, 96, 243, height, 0xFFFFFF, false, 1, startFrame);
+
+	hud->DrawString(10, 98, "Frame Time (ms)", 0xFFFFFF, 0xFF000000, 1, startFrame);
+	hud->DrawString(110, 98, "Last", 0xFFFFFF, 0xFF000000, 1, startFrame);
+	hud->DrawString(155, 98, "Avg", 0xFFFFFF, 0xFF000000, 1, startFrame);
+	hud->DrawString(200, 98, "Max", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+	int y = 109;
+	for (auto& [section, name] : rows) {
+		FrameProfilerSectionStats& sectionStats = stats.Sections[(int)section];
+		hud->DrawString(10, y, name, 0xFFFFFF, 0xFF000000, 1, startFrame);
+		hud->DrawString(110, y, std::format("{:.2f}", sectionStats.LastMs), 0xFFFFFF, 0xFF000000, 1, startFrame);
+		hud->DrawString(155, y, std::format("{:.2f}", sectionStats.AverageMs), 0xFFFFFF, 0xFF000000, 1, startFrame);
+		hud->DrawString(200, y, std::format("{:.2f}", sectionStats.MaxMs), 0xFFFFFF, 0xFF000000, 1, startFrame);
+		y += 9;
+	}
 }
@@ -2,6 +2,7 @@
 #include "pch.h"
 
 class Emulator;
+class DebugHud;
 
 /// <summary>
 /// Frame timing statistics display for performance monitoring.
@@ -19,6 +20,9 @@ private:
 	double _lastFrameMin = 9999;      ///< Minimum frame time in last window
 	double _lastFrameMax = 0;         ///< Maximum frame time in last window
 
+	/// <summary>Display the per-subsystem frame time breakdown (see FrameProfiler)</summary>
+	void DisplayFrameBreakdown(Emulator* emu, DebugHud* hud, int startFrame);
+
 public:
 	/// <summary>
 	/// Display performance statistics overlay on current frame.
@@ -31,6 +35,7 @@ public:
 	/// - Average frame time over 60-frame window
 	/// - Min/Max frame times
 	/// - Frame drops (if any)
+	/// - Time spent in each subsystem (last/average/max)
 	/// </remarks>
 	void DisplayStats(Emulator* emu, double lastFrameTime);
 };
\ No newline at end of file
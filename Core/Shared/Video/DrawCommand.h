@@ -109,6 +109,68 @@ protected:
 		}
 	}
 
+	/// <summary>
+	/// Draws logical pixels [x0, x1] on row y with the same result as calling DrawPixel for each of them.
+	/// </summary>
+	/// <remarks>
+	/// The span is scaled and clipped once, then written as contiguous runs of screen pixels,
+	/// which removes the per-pixel bounds and scaling math from rectangles, lines and glyph rows.
+	/// </remarks>
+	void DrawSpan(int32_t x0, int32_t x1, int32_t y, int color) {
+		uint32_t alpha = (color & 0xFF000000);
+		if (alpha == 0) {
+			return;
+		}
+
+		// Negative logical coordinates are always off-screen
+		x0 = std::max(x0, 0);
+		if (x1 < x0 || y < 0) {
+			return;
+		}
+
+		int32_t screenX0, screenX1, screenY0, screenY1;
+		if (_yScale == 1 && _xScale == 1) {
+			screenX0 = x0;
+			screenX1 = x1 + 1;
+			screenY0 = y;
+			screenY1 = y + 1;
+		} else {
+			if (_useIntegerScaling) {
+				int32_t xScale = (int32_t)std::floor(_xScale);
+				screenX0 = x0 * xScale;
+				screenX1 = (x1 + 1) * xScale;
+			} else {
+				screenX0 = (int32_t)(x0 * _xScale);
+				screenX1 = (int32_t)((x1 + 1) * _xScale);
+			}
+			screenY0 = y * _yScale;
+			screenY1 = screenY0 + _yScale;
+		}
+
+		int32_t top = (int32_t)_overscan.Top;
+		int32_t left = (int32_t)_overscan.Left;
+		screenX0 = std::max(screenX0, left);
+		screenX1 = std::min(screenX1, left + (int32_t)_frameInfo.Width);
+		screenY0 = std::max(screenY0, top);
+		screenY1 = std::min(screenY1, top + (int32_t)_frameInfo.Height);
+		if (screenX0 >= screenX1 || screenY0 >= screenY1) {
+			return;
+		}
+
+		for (int32_t row = screenY0; row < screenY1; row++) {
+			int32_t offset = (row - top) * (int32_t)_frameInfo.Width + screenX0 - left;
+			int32_t end = offset + (screenX1 - screenX0);
+			if (!_drawnPixels && alpha == 0xFF000000) {
+				// Opaque pixels written straight to the output need no per-pixel logic
+				std::fill(_argbBuffer + offset, _argbBuffer + end, (uint32_t)color);
+			} else {
+				for (; offset < end; offset++) {
+					InternalDrawPixel(offset, color, alpha);
+				}
+			}
+		}
+	}
+
 	__forceinline void BlendColors(uint8_t output[4], uint8_t input[4], bool keepAlpha = false) {
 		uint8_t alpha = input[3] + 1;
 		uint8_t invertedAlpha = 256 - input[3];
@@ -132,6 +194,23 @@ public:
 	virtual ~DrawCommand() {
 	}
 
+	void SetTarget(uint32_t* drawnPixels, uint32_t drawnPixelsSize, vector<uint32_t>* dirtyIndices, uint32_t* argbBuffer, FrameInfo frameInfo, OverscanDimensions& overscan, HudScaleFactors& scaleFactors) {
+		_argbBuffer = argbBuffer;
+		_drawnPixels = drawnPixels;
+		_drawnPixelsSize = drawnPixelsSize;
+		_dirtyIndices = dirtyIndices;
+		_frameInfo = frameInfo;
+		_overscan = overscan;
+
+		if (scaleFactors.X != 0 && scaleFactors.Y != 0) {
+			_xScale = scaleFactors.X;
+			_yScale = scaleFactors.Y;
+		} else {
+			_yScale = 1;
+			_xScale = 1;
+		}
+	}
+
 	void Draw(uint32_t* drawnPixels, uint32_t drawnPixelsSize, vector<uint32_t>* dirtyIndices, uint32_t* argbBuffer, FrameInfo frameInfo, OverscanDimensions& overscan, uint32_t frameNumber, HudScaleFactors& scaleFactors) {
 		if (_startFrame < 0) {
 			// When no start frame was specified, start on the next drawn frame
@@ -139,21 +218,7 @@ public:
 		}
 
 		if (_startFrame <= (int32_t)frameNumber) {
-			_argbBuffer = argbBuffer;
-			_drawnPixels = drawnPixels;
-			_drawnPixelsSize = drawnPixelsSize;
-			_dirtyIndices = dirtyIndices;
-			_frameInfo = frameInfo;
-			_overscan = overscan;
-
-			if (scaleFactors.X != 0 && scaleFactors.Y != 0) {
-				_xScale = scaleFactors.X;
-				_yScale = scaleFactors.Y;
-			} else {
-				_yScale = 1;
-				_xScale = 1;
-			}
-
+			SetTarget(drawnPixels, drawnPixelsSize, dirtyIndices, argbBuffer, frameInfo, overscan, scaleFactors);
 			InternalDraw();
 
 			_frameCount--;
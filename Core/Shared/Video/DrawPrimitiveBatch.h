@@ -0,0 +1,156 @@
+#pragma once
+#include "pch.h"
+#include "Shared/Video/DrawCommand.h"
+
+enum class HudPrimitiveType : uint8_t {
+	Pixel,
+	Line,
+	Rectangle,
+	FilledRectangle,
+
+	/// Not a primitive - refers to a DrawCommand owned by the DebugHud (strings, screen buffers)
+	Command
+};
+
+/// <summary>
+/// Plain-data draw record for a single HUD primitive.
+/// </summary>
+/// <remarks>
+/// Records are stored by value in a per-HUD vector whose capacity is reused from frame to frame,
+/// so adding a primitive does not allocate and drawing does not need a virtual call per primitive.
+/// Colors are stored with the alpha byte already inverted (0xFF = opaque), like DrawCommand.
+/// </remarks>
+struct HudDrawRecord {
+	int32_t X;
+	int32_t Y;
+	int32_t X2;     ///< Line end X, or rectangle width
+	int32_t Y2;     ///< Line end Y, or rectangle height
+	int32_t Color;
+	int32_t StartFrame;
+	int32_t FrameCount;
+	HudPrimitiveType Type;
+	DrawCommand* Command; ///< Only set for HudPrimitiveType::Command
+
+	/// <summary>
+	/// Applies the same start/frame count rules as DrawCommand::Draw.
+	/// </summary>
+	/// <returns>True if the record should be drawn on this frame</returns>
+	__forceinline bool BeginFrame(uint32_t frameNumber) {
+		if (StartFrame < 0) {
+			// When no start frame was specified, start on the next drawn frame
+			StartFrame = frameNumber;
+		}
+
+		if (StartFrame <= (int32_t)frameNumber) {
+			FrameCount--;
+			return true;
+		}
+		return false;
+	}
+
+	[[nodiscard]] bool Expired() const {
+		return Type == HudPrimitiveType::Command ? Command->Expired() : FrameCount == 0;
+	}
+};
+
+/// <summary>
+/// Rasterizes a run of pixel/line/rectangle records in a single pass.
+/// </summary>
+/// <remarks>
+/// Every primitive is converted to horizontal spans (one per scanline it touches) which are
+/// clipped and scaled once via DrawCommand::DrawSpan. The output is identical to drawing each
+/// primitive pixel by pixel, including double-blending where a primitive overlaps itself.
+/// </remarks>
+class DrawPrimitiveBatch : public DrawCommand {
+private:
+	std::span<HudDrawRecord> _records;
+	uint32_t _frameNumber = 0;
+
+	void DrawLine(const HudDrawRecord& rec) {
+		int x = rec.X;
+		int y = rec.Y;
+		int x2 = rec.X2;
+		int y2 = rec.Y2;
+
+		if (y == y2) {
+			DrawSpan(std::min(x, x2), std::max(x, x2), y, rec.Color);
+			return;
+		}
+
+		// Bresenham, with consecutive pixels on the same scanline merged into one span
+		int dx = abs(x2 - x), sx = x < x2 ? 1 : -1;
+		int dy = abs(y2 - y), sy = y < y2 ? 1 : -1;
+		int err = (dx > dy ? dx : -dy) / 2, e2;
+		int spanStart = x;
+
+		while (true) {
+			if (x == x2 && y == y2) {
+				DrawSpan(std::min(spanStart, x), std::max(spanStart, x), y, rec.Color);
+				break;
+			}
+
+			int prevX = x;
+			e2 = err;
+			if (e2 > -dx) {
+				err -= dy;
+				x += sx;
+			}
+			if (e2 < dy) {
+				err += dx;
+				DrawSpan(std::min(spanStart, prevX), std::max(spanStart, prevX), y, rec.Color);
+				y += sy;
+				spanStart = x;
+			}
+		}
+	}
+
+	void DrawRectangle(const HudDrawRecord& rec) {
+		int x = rec.X;
+		int y = rec.Y;
+		int width = rec.X2;
+		int height = rec.Y2;
+
+		if (rec.Type == HudPrimitiveType::FilledRectangle) {
+			for (int j = 0; j < height; j++) {
+				DrawSpan(x, x + width - 1, y + j, rec.Color);
+			}
+		} else {
+			// Top and bottom edges are drawn separately (even when they are the same row) to match the
+			// per-pixel implementation's blending for 1-pixel-high rectangles
+			DrawSpan(x, x + width - 1, y, rec.Color);
+			DrawSpan(x, x + width - 1, y + height - 1, rec.Color);
+			for (int i = 1; i < height - 1; i++) {
+				DrawSpan(x, x, y + i, rec.Color);
+				DrawSpan(x + width - 1, x + width - 1, y + i, rec.Color);
+			}
+		}
+	}
+
+protected:
+	void InternalDraw() override {
+		for (HudDrawRecord& rec : _records) {
+			if (!rec.BeginFrame(_frameNumber)) {
+				continue;
+			}
+
+			switch (rec.Type) {
+				case HudPrimitiveType::Pixel: DrawSpan(rec.X, rec.X, rec.Y, rec.Color); break;
+				case HudPrimitiveType::Line: DrawLine(rec); break;
+				case HudPrimitiveType::Rectangle:
+				case HudPrimitiveType::FilledRectangle: DrawRectangle(rec); break;
+				case HudPrimitiveType::Command: break;
+			}
+		}
+	}
+
+public:
+	DrawPrimitiveBatch() : DrawCommand(0, 0) {}
+
+	void DrawRecords(std::span<HudDrawRecord> records, uint32_t* drawnPixels, uint32_t drawnPixelsSize, vector<uint32_t>* dirtyIndices, uint32_t* argbBuffer, FrameInfo frameInfo, OverscanDimensions& overscan, uint32_t frameNumber, HudScaleFactors& scaleFactors) {
+		_records = records;
+		_frameNumber = frameNumber;
+		SetTarget(drawnPixels, drawnPixelsSize, dirtyIndices, argbBuffer, frameInfo, overscan, scaleFactors);
+		InternalDraw();
+		_records = {};
+	}
+};
@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "Shared/Video/DrawStringCommand.h"
 
+const std::array<DrawStringCommand::AsciiGlyph, 96> DrawStringCommand::_asciiAtlas = DrawStringCommand::BuildAsciiAtlas();
+
 // 6880 entries sorted by int key for binary search lookup (zero heap allocation)
 const std::array<std::pair<int, char const*>, 6880> DrawStringCommand::_jpFont = {{
 	{0x0080cf, "\x00\x00\x00\x00\x3E\x54\x14\x24\x24\x46\x00\x00"},
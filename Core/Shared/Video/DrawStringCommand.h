@@ -801,6 +801,51 @@ private:
 		return _font[GetCharNumber(ch) * 8];
 	}
 
+	/// Pre-expanded ASCII glyph (descender shift for y/g/p/q already applied)
+	struct AsciiGlyph {
+		uint8_t Width;
+		uint8_t Rows[8];
+	};
+
+	/// Glyph atlas for the 96 ASCII glyphs, built once from _font
+	static const std::array<AsciiGlyph, 96> _asciiAtlas;
+
+	static std::array<AsciiGlyph, 96> BuildAsciiAtlas() {
+		std::array<AsciiGlyph, 96> atlas = {};
+		for (int ch = 0; ch < 96; ch++) {
+			atlas[ch].Width = _font[ch * 8];
+			for (int row = 0; row < 8; row++) {
+				atlas[ch].Rows[row] = row < 7 ? _font[ch * 8 + 1 + row] : 0;
+			}
+		}
+
+		for (char c : {'y', 'g', 'p', 'q'}) {
+			int ch = GetCharNumber(c);
+			for (int row = 7; row > 0; row--) {
+				atlas[ch].Rows[row] = _font[ch * 8 + row];
+			}
+			atlas[ch].Rows[0] = 0;
+		}
+		return atlas;
+	}
+
+	/// <summary>
+	/// Blits one glyph row as runs of foreground/background spans (bit 7 = leftmost column).
+	/// </summary>
+	void DrawGlyphRow(uint8_t rowData, int width, int x, int y, int scale) {
+		int col = 0;
+		while (col < width) {
+			uint8_t shifted = (uint8_t)(rowData << col);
+			bool drawFg = (shifted & 0x80) != 0;
+			int runLength = std::min(drawFg ? std::countl_one(shifted) : std::countl_zero(shifted), width - col);
+			int color = drawFg ? _color : _backColor;
+			for (int sy = 0; sy < scale; sy++) {
+				DrawSpan(x + col * scale, x + (col + runLength) * scale - 1, y + sy, color);
+			}
+			col += runLength;
+		}
+	}
+
 protected:
 	void InternalDraw() {
 		int scale = std::max(1, _fontScale);
@@ -836,9 +881,7 @@ protected:
 					if (_backColor & 0xFF000000) {
 						// Draw bg color for spaces (when bg color is set)
 						for (int row = 0; row < lineHeight; row++) {
-							for (int column = 0; column < spaceWidth; column++) {
-								DrawPixel(x + column, y + row - scale, _backColor);
-							}
+							DrawSpan(x, x + spaceWidth - 1, y + row - scale, _backColor);
 						}
 					}
 
@@ -867,16 +910,7 @@ protected:
 						uint8_t* charDef = (uint8_t*)res->second;
 
 						for (int row = 0; row < 12; row++) {
-							uint8_t rowData = charDef[row];
-							for (int column = 0; column < 8; column++) {
-								int drawFg = (rowData >> (7 - column)) & 0x01;
-								int color = drawFg ? _color : _backColor;
-								for (int sy = 0; sy < scale; sy++) {
-									for (int sx = 0; sx < scale; sx++) {
-										DrawPixel(x + column * scale + sx, y + row * scale + sy - 2 * scale, color);
-									}
-								}
-							}
+							DrawGlyphRow(charDef[row], 8, x, y + row * scale - 2 * scale, scale);
 						}
 						i += 2;
 						x += 8 * scale;
@@ -895,23 +929,12 @@ protected:
 					lineWidth += scaledWidth;
 				}
 
-				int rowOffset = (c == 'y' || c == 'g' || c == 'p' || c == 'q') ? 1 : 0;
+				const AsciiGlyph& glyph = _asciiAtlas[ch];
 				for (int row = 0; row < 8; row++) {
-					uint8_t rowData = ((row == 7 && rowOffset == 0) || (row == 0 && rowOffset == 1)) ? 0 : _font[ch * 8 + 1 + row - rowOffset];
-					for (int col = 0; col < width; col++) {
-						int drawFg = (rowData >> (7 - col)) & 0x01;
-						int color = drawFg ? _color : _backColor;
-						for (int sy = 0; sy < scale; sy++) {
-							for (int sx = 0; sx < scale; sx++) {
-								DrawPixel(x + col * scale + sx, y + row * scale + sy, color);
-							}
-						}
-					}
+					DrawGlyphRow(glyph.Rows[row], width, x, y + row * scale, scale);
 				}
-				for (int col = 0; col < width; col++) {
-					for (int sx = 0; sx < scale; sx++) {
-						DrawPixel(x + col * scale + sx, y - scale, _backColor);
-					}
+				if (width > 0) {
+					DrawSpan(x, x + scaledWidth - 1, y - scale, _backColor);
 				}
 				x += scaledWidth;
 			}
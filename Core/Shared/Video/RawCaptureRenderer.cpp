@@ -0,0 +1,152 @@
+#include "pch.h"
+#include <thread>
+#include "Shared/Video/RawCaptureRenderer.h"
+#include "Shared/Video/RawVideoCapture.h"
+#include "Shared/Video/VideoRenderer.h"
+#include "Shared/Video/BaseVideoFilter.h"
+#include "Shared/Video/ScaleFilter.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/MessageManager.h"
+#include "Utilities/Video/AviRecorder.h"
+#include "Utilities/Video/GifRecorder.h"
+#include "Utilities/Timer.h"
+
+namespace {
+	constexpr uint32_t FramesPerThread = 8;
+
+	struct FilterWorker {
+		unique_ptr<BaseVideoFilter> VideoFilter;
+		unique_ptr<ScaleFilter> Scale;
+	};
+
+	struct BatchItem {
+		RawCaptureFrame Frame;
+		vector<int16_t> Samples;
+		RawCaptureChunkType Type = RawCaptureChunkType::Frame;
+
+		vector<uint32_t> Output;
+		FrameInfo OutputSize = {};
+	};
+
+	void FilterFrame(FilterWorker& worker, BatchItem& item) {
+		RawCaptureFrame& frame = item.Frame;
+		worker.VideoFilter->SetBaseFrameInfo({frame.Width, frame.Height});
+		FrameInfo frameSize = worker.VideoFilter->SendFrame(frame.Buffer.data(), frame.FrameNumber, frame.VideoPhaseOffset, nullptr);
+		uint32_t* outputBuffer = worker.VideoFilter->GetOutputBuffer();
+
+		if (worker.Scale) {
+			outputBuffer = worker.Scale->ApplyFilter(outputBuffer, frameSize.Width, frameSize.Height);
+			frameSize = worker.Scale->GetFrameInfo(frameSize);
+		}
+
+		item.OutputSize = frameSize;
+		item.Output.assign(outputBuffer, outputBuffer + frameSize.Width * frameSize.Height);
+	}
+}
+
+bool RawCaptureRenderer::Render(Emulator* emu, const string& inputFile, const string& outputFile, const RecordAviOptions& options, uint32_t threadCount) {
+	RawVideoCaptureReader reader;
+	if (!reader.Open(inputFile)) {
+		MessageManager::Log("[RawCapture] Invalid raw capture file: " + inputFile);
+		return false;
+	}
+
+	const RawCaptureHeader& header = reader.GetHeader();
+	if (header.Console != emu->GetConsoleType()) {
+		MessageManager::Log("[RawCapture] The raw capture was made with another console type, load a game for it first.");
+		return false;
+	}
+
+	unique_ptr<IVideoRecorder> recorder;
+	if (options.Codec == VideoCodec::GIF) {
+		recorder = std::make_unique<GifRecorder>();
+	} else {
+		recorder = std::make_unique<AviRecorder>(options.Codec, options.CompressionLevel);
+	}
+	if (!recorder->Init(outputFile)) {
+		MessageManager::DisplayMessage("VideoRecorder", "CouldNotWriteToFile", outputFile);
+		return false;
+	}
+
+	if (threadCount == 0) {
+		threadCount = std::clamp(std::thread::hardware_concurrency(), 1u, 16u);
+	}
+
+	VideoFilterType filterType = emu->GetSettings()->GetVideoConfig().VideoFilter;
+	vector<FilterWorker> workers(threadCount);
+	for (FilterWorker& worker : workers) {
+		worker.VideoFilter.reset(emu->GetVideoFilter());
+		worker.Scale = ScaleFilter::GetScaleFilter(emu, filterType);
+	}
+
+	Timer timer;
+	vector<BatchItem> batch;
+	vector<size_t> batchFrames; // Indexes of the batch's frames (batch can grow while reading)
+	uint32_t frameCount = 0;
+	bool endOfFile = false;
+	bool result = true;
+
+	while (!endOfFile && result) {
+		// Read the next batch of frames (and the audio between them)
+		batchFrames.clear();
+		size_t itemCount = 0;
+		while (batchFrames.size() < threadCount * FramesPerThread) {
+			if (itemCount == batch.size()) {
+				batch.emplace_back();
+			}
+			BatchItem& item = batch[itemCount];
+			if (!reader.ReadChunk(item.Type, item.Frame, item.Samples)) {
+				endOfFile = true;
+				break;
+			}
+			if (item.Type == RawCaptureChunkType::Frame) {
+				batchFrames.push_back(itemCount);
+			}
+			itemCount++;
+		}
+
+		// Filter the frames - each thread processes a contiguous range of frames
+		uint32_t batchThreads = std::min<uint32_t>(threadCount, (uint32_t)batchFrames.size());
+		auto filterRange = [&](uint32_t index) {
+			size_t start = batchFrames.size() * index / batchThreads;
+			size_t end = batchFrames.size() * (index + 1) / batchThreads;
+			for (size_t i = start; i < end; i++) {
+				FilterFrame(workers[index], batch[batchFrames[i]]);
+			}
+		};
+
+		vector<std::thread> threads;
+		for (uint32_t i = 1; i < batchThreads; i++) {
+			threads.emplace_back(filterRange, i);
+		}
+		if (batchThreads > 0) {
+			filterRange(0);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		// Send the frames and audio to the recorder, in order
+		for (size_t i = 0; i < itemCount && result; i++) {
+			BatchItem& item = batch[i];
+			if (item.Type == RawCaptureChunkType::Frame) {
+				if (!recorder->IsRecording()) {
+					recorder->StartRecording(item.OutputSize.Width, item.OutputSize.Height, 4, header.SampleRate, header.Fps);
+				}
+				result = recorder->AddFrame(item.Output.data(), item.OutputSize.Width, item.OutputSize.Height, header.Fps);
+				frameCount++;
+			} else {
+				result = recorder->AddSound(item.Samples.data(), (uint32_t)item.Samples.size() / 2, header.SampleRate);
+			}
+		}
+	}
+
+	recorder->StopRecording();
+	if (!result) {
+		MessageManager::Log("[RawCapture] Rendering stopped at frame " + std::to_string(frameCount) + " (resolution or sample rate changed)");
+	} else {
+		MessageManager::Log("[RawCapture] " + std::to_string(frameCount) + " frames rendered in " + std::to_string((int)timer.GetElapsedMS()) + " ms (" + std::to_string(threadCount) + " threads)");
+	}
+	return result;
+}
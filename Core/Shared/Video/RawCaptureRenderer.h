@@ -0,0 +1,33 @@
+#pragma once
+#include "pch.h"
+
+class Emulator;
+struct RecordAviOptions;
+
+/// <summary>
+/// Offline rendering of a raw capture (see RawVideoCapture) to a video file.
+/// </summary>
+/// <remarks>
+/// The frames go through the current video filter settings (video filter + scale filter, e.g.
+/// NTSC or xBRZ 6x) regardless of the CPU time they need, since this isn't done in real time.
+///
+/// The frames are read in batches and each batch is split into frame ranges, filtered in
+/// parallel (1 filter instance per thread). The filtered frames are then sent to the recorder
+/// in order, along with the audio - the recorder encodes them on its own thread while the next
+/// batch is being filtered.
+///
+/// The console type that made the capture must be loaded (it provides the video filter).
+/// </remarks>
+class RawCaptureRenderer {
+public:
+	/// <summary>
+	/// Render a raw capture file to a video file.
+	/// </summary>
+	/// <param name="emu">Emulator (provides the video filter and settings)</param>
+	/// <param name="inputFile">Raw capture file</param>
+	/// <param name="outputFile">Video file to create</param>
+	/// <param name="options">Codec options (the HUD options are ignored)</param>
+	/// <param name="threadCount">Filter threads (0 = based on the CPU's core count)</param>
+	/// <returns>True if all frames were rendered</returns>
+	[[nodiscard]] static bool Render(Emulator* emu, const string& inputFile, const string& outputFile, const RecordAviOptions& options, uint32_t threadCount = 0);
+};
@@ -0,0 +1,245 @@
+#include "pch.h"
+#include "Shared/Video/RawVideoCapture.h"
+#include "Shared/RenderedFrame.h"
+#include "Utilities/CompressionHelper.h"
+
+namespace {
+	constexpr char RawCaptureMagic[4] = {'N', 'X', 'R', 'C'};
+	constexpr uint32_t RawCaptureVersion = 1;
+	constexpr int RawCaptureCompressionLevel = 1;
+
+	template <typename T>
+	void WriteValue(ofstream& file, T value) {
+		file.write((const char*)&value, sizeof(T));
+	}
+
+	template <typename T>
+	bool ReadValue(ifstream& file, T& value) {
+		return (bool)file.read((char*)&value, sizeof(T));
+	}
+
+	constexpr uint32_t FrameInfoSize = sizeof(uint32_t) * 4 + sizeof(double);
+}
+
+RawVideoCapture::~RawVideoCapture() {
+	Stop();
+}
+
+bool RawVideoCapture::Start(const string& filename, ConsoleType console, uint32_t sampleRate, double fps) {
+	_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!_file) {
+		return false;
+	}
+
+	_outputFile = filename;
+	_sampleRate = sampleRate;
+	_file.write(RawCaptureMagic, sizeof(RawCaptureMagic));
+	WriteValue(_file, RawCaptureVersion);
+	WriteValue(_file, (uint32_t)console);
+	WriteValue(_file, sampleRate);
+	WriteValue(_file, fps);
+
+	_stopFlag = false;
+	_writeError = false;
+	_prevWidth = 0;
+	_prevHeight = 0;
+	_writerThread = std::thread([this]() { WriterThread(); });
+	return true;
+}
+
+void RawVideoCapture::Stop() {
+	if (!_writerThread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_queueMutex);
+		_stopFlag = true;
+	}
+	_chunkQueued.notify_one();
+	_writerThread.join();
+	_file.close();
+}
+
+vector<uint8_t> RawVideoCapture::GetBuffer() {
+	std::lock_guard<std::mutex> lock(_queueMutex);
+	if (_freeBuffers.empty()) {
+		return {};
+	}
+	vector<uint8_t> buffer = std::move(_freeBuffers.back());
+	_freeBuffers.pop_back();
+	return buffer;
+}
+
+void RawVideoCapture::Enqueue(PendingChunk&& chunk) {
+	{
+		std::unique_lock<std::mutex> lock(_queueMutex);
+		_chunkWritten.wait(lock, [this] { return _queue.size() < MaxQueuedChunks; });
+		_queue.push_back(std::move(chunk));
+	}
+	_chunkQueued.notify_one();
+}
+
+bool RawVideoCapture::AddFrame(const RenderedFrame& frame) {
+	if (_writeError) {
+		return false;
+	}
+
+	PendingChunk chunk;
+	chunk.Type = RawCaptureChunkType::Frame;
+	chunk.FrameNumber = frame.FrameNumber;
+	chunk.VideoPhaseOffset = frame.VideoPhaseOffset;
+	chunk.Width = frame.Width;
+	chunk.Height = frame.Height;
+	chunk.Scale = frame.Scale;
+	chunk.Data = GetBuffer();
+
+	uint8_t* frameBuffer = (uint8_t*)frame.FrameBuffer;
+	chunk.Data.assign(frameBuffer, frameBuffer + frame.Width * frame.Height * sizeof(uint16_t));
+	Enqueue(std::move(chunk));
+	return true;
+}
+
+bool RawVideoCapture::AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate) {
+	if (_writeError || sampleRate != _sampleRate) {
+		return false;
+	}
+
+	PendingChunk chunk;
+	chunk.Type = RawCaptureChunkType::Audio;
+	chunk.Data = GetBuffer();
+
+	uint8_t* samples = (uint8_t*)soundBuffer;
+	chunk.Data.assign(samples, samples + sampleCount * 2 * sizeof(int16_t));
+	Enqueue(std::move(chunk));
+	return true;
+}
+
+void RawVideoCapture::WriterThread() {
+	while (true) {
+		PendingChunk chunk;
+		{
+			std::unique_lock<std::mutex> lock(_queueMutex);
+			_chunkQueued.wait(lock, [this] { return _stopFlag || !_queue.empty(); });
+			if (_queue.empty()) {
+				// Stop requested, all queued chunks are written
+				break;
+			}
+			chunk = std::move(_queue.front());
+			_queue.pop_front();
+		}
+
+		WriteChunk(chunk);
+
+		{
+			std::lock_guard<std::mutex> lock(_queueMutex);
+			_freeBuffers.push_back(std::move(chunk.Data));
+		}
+		_chunkWritten.notify_one();
+	}
+}
+
+void RawVideoCapture::WriteChunk(PendingChunk& chunk) {
+	_compressBuffer.clear();
+
+	if (chunk.Type == RawCaptureChunkType::Frame) {
+		// XOR with the previous frame - mostly zeroes, which deflate compresses very well
+		if (chunk.Width == _prevWidth && chunk.Height == _prevHeight) {
+			_deltaBuffer.resize(chunk.Data.size());
+			for (size_t i = 0; i < chunk.Data.size(); i++) {
+				_deltaBuffer[i] = chunk.Data[i] ^ _prevFrame[i];
+			}
+			CompressionHelper::Compress(_deltaBuffer, RawCaptureCompressionLevel, _compressBuffer);
+		} else {
+			CompressionHelper::Compress(chunk.Data, RawCaptureCompressionLevel, _compressBuffer);
+		}
+		std::swap(_prevFrame, chunk.Data);
+		_prevWidth = chunk.Width;
+		_prevHeight = chunk.Height;
+
+		WriteValue(_file, (uint8_t)RawCaptureChunkType::Frame);
+		WriteValue(_file, (uint32_t)(FrameInfoSize + _compressBuffer.size()));
+		WriteValue(_file, chunk.FrameNumber);
+		WriteValue(_file, chunk.VideoPhaseOffset);
+		WriteValue(_file, chunk.Width);
+		WriteValue(_file, chunk.Height);
+		WriteValue(_file, chunk.Scale);
+	} else {
+		CompressionHelper::Compress(chunk.Data, RawCaptureCompressionLevel, _compressBuffer);
+		WriteValue(_file, (uint8_t)RawCaptureChunkType::Audio);
+		WriteValue(_file, (uint32_t)_compressBuffer.size());
+	}
+
+	_file.write((const char*)_compressBuffer.data(), _compressBuffer.size());
+	if (!_file) {
+		_writeError = true;
+	}
+}
+
+bool RawVideoCaptureReader::Open(const string& filename) {
+	_file.open(filename, std::ios::in | std::ios::binary);
+	if (!_file) {
+		return false;
+	}
+
+	char magic[4] = {};
+	uint32_t version = 0;
+	uint32_t console = 0;
+	_file.read(magic, sizeof(magic));
+	if (!_file || memcmp(magic, RawCaptureMagic, sizeof(magic)) != 0) {
+		return false;
+	}
+	if (!ReadValue(_file, version) || version != RawCaptureVersion || !ReadValue(_file, console) || !ReadValue(_file, _header.SampleRate) || !ReadValue(_file, _header.Fps)) {
+		return false;
+	}
+	_header.Console = (ConsoleType)console;
+	_prevWidth = 0;
+	_prevHeight = 0;
+	return true;
+}
+
+bool RawVideoCaptureReader::ReadChunk(RawCaptureChunkType& type, RawCaptureFrame& frame, vector<int16_t>& samples) {
+	uint8_t chunkType = 0;
+	uint32_t size = 0;
+	if (!ReadValue(_file, chunkType) || !ReadValue(_file, size)) {
+		return false;
+	}
+
+	type = (RawCaptureChunkType)chunkType;
+	if (type == RawCaptureChunkType::Frame) {
+		if (size < FrameInfoSize || !ReadValue(_file, frame.FrameNumber) || !ReadValue(_file, frame.VideoPhaseOffset) || !ReadValue(_file, frame.Width) || !ReadValue(_file, frame.Height) || !ReadValue(_file, frame.Scale)) {
+			return false;
+		}
+		size -= FrameInfoSize;
+	} else if (type != RawCaptureChunkType::Audio) {
+		return false;
+	}
+
+	_compressedData.resize(size);
+	if (size < sizeof(uint32_t) * 2 || !_file.read((char*)_compressedData.data(), size) || !CompressionHelper::Decompress(_compressedData, _data)) {
+		return false;
+	}
+
+	if (type == RawCaptureChunkType::Audio) {
+		samples.resize(_data.size() / sizeof(int16_t));
+		memcpy(samples.data(), _data.data(), samples.size() * sizeof(int16_t));
+		return true;
+	}
+
+	size_t pixelCount = (size_t)frame.Width * frame.Height;
+	if (_data.size() != pixelCount * sizeof(uint16_t)) {
+		return false;
+	}
+
+	frame.Buffer.resize(pixelCount);
+	memcpy(frame.Buffer.data(), _data.data(), _data.size());
+	if (frame.Width == _prevWidth && frame.Height == _prevHeight) {
+		for (size_t i = 0; i < pixelCount; i++) {
+			frame.Buffer[i] ^= _prevFrame[i];
+		}
+	}
+	_prevFrame = frame.Buffer;
+	_prevWidth = frame.Width;
+	_prevHeight = frame.Height;
+	return true;
+}
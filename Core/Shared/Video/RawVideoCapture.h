@@ -0,0 +1,140 @@
+#pragma once
+#include "pch.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "Shared/SettingTypes.h"
+
+struct RenderedFrame;
+
+/// <summary>
+/// Raw capture file header - the console's output before any video filter.
+/// </summary>
+struct RawCaptureHeader {
+	ConsoleType Console = ConsoleType::Snes;
+	uint32_t SampleRate = 0;
+	double Fps = 0;
+};
+
+/// <summary>
+/// A frame from a raw capture - the console's 16-bit output buffer (as given to BaseVideoFilter::SendFrame).
+/// </summary>
+struct RawCaptureFrame {
+	uint32_t FrameNumber = 0;
+	uint32_t VideoPhaseOffset = 0;
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	double Scale = 1.0;
+	vector<uint16_t> Buffer;
+};
+
+enum class RawCaptureChunkType : uint8_t {
+	Frame = 1,
+	Audio = 2
+};
+
+/// <summary>
+/// Records the console's raw video output (and the audio) to an intermediate file, so it can be
+/// rendered to a video file later with any video filter (see RawCaptureRenderer).
+/// </summary>
+/// <remarks>
+/// File format (little endian):
+/// - Header: "NXRC", version, console type, sample rate, fps
+/// - Chunks, in emulation order: [type:1][size:4][payload]
+///   - Frame: frame number, video phase offset, width, height, scale, then the frame buffer XORed
+///     with the previous frame's (only for frames of the same size) and deflate-compressed
+///   - Audio: stereo 16-bit samples, deflate-compressed
+///
+/// The emulation thread only copies the frame/samples into a pooled buffer - the XOR, compression
+/// and file writes are done on the writer thread.
+///
+/// The data used by some filters on top of the frame buffer (RenderedFrame::Data, e.g. the NES'
+/// HD packs) isn't recorded.
+/// </remarks>
+class RawVideoCapture {
+private:
+	/// <summary>Max chunks waiting to be written before the emulation thread waits (~1 second of frames)</summary>
+	static constexpr size_t MaxQueuedChunks = 120;
+
+	struct PendingChunk {
+		RawCaptureChunkType Type = RawCaptureChunkType::Frame;
+		uint32_t FrameNumber = 0;
+		uint32_t VideoPhaseOffset = 0;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		double Scale = 1.0;
+		vector<uint8_t> Data;
+	};
+
+	string _outputFile;
+	ofstream _file;
+	std::thread _writerThread;
+
+	std::mutex _queueMutex;
+	std::condition_variable _chunkQueued;
+	std::condition_variable _chunkWritten;
+	std::deque<PendingChunk> _queue;
+	vector<vector<uint8_t>> _freeBuffers;
+	bool _stopFlag = false;
+	atomic<bool> _writeError = false;
+
+	uint32_t _sampleRate = 0;
+
+	// Writer thread state
+	vector<uint8_t> _prevFrame;
+	vector<uint8_t> _deltaBuffer;
+	vector<uint8_t> _compressBuffer;
+	uint32_t _prevWidth = 0;
+	uint32_t _prevHeight = 0;
+
+	void WriterThread();
+	void WriteChunk(PendingChunk& chunk);
+	void Enqueue(PendingChunk&& chunk);
+	[[nodiscard]] vector<uint8_t> GetBuffer();
+
+public:
+	~RawVideoCapture();
+
+	/// <summary>Create the file and start the writer thread</summary>
+	[[nodiscard]] bool Start(const string& filename, ConsoleType console, uint32_t sampleRate, double fps);
+
+	/// <summary>Write the remaining chunks and close the file</summary>
+	void Stop();
+
+	/// <summary>Queue a frame (the console's 16-bit output buffer)</summary>
+	/// <returns>False if the file couldn't be written to (recording should be stopped)</returns>
+	bool AddFrame(const RenderedFrame& frame);
+
+	/// <summary>Queue audio samples (stereo)</summary>
+	/// <returns>False if the sample rate changed or the file couldn't be written to</returns>
+	bool AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate);
+
+	[[nodiscard]] string GetOutputFile() { return _outputFile; }
+};
+
+/// <summary>
+/// Reads the chunks of a raw capture file in order (see RawVideoCapture).
+/// </summary>
+class RawVideoCaptureReader {
+private:
+	ifstream _file;
+	RawCaptureHeader _header = {};
+	vector<uint8_t> _compressedData;
+	vector<uint8_t> _data;
+	vector<uint16_t> _prevFrame;
+	uint32_t _prevWidth = 0;
+	uint32_t _prevHeight = 0;
+
+public:
+	/// <summary>Open the file and read its header</summary>
+	[[nodiscard]] bool Open(const string& filename);
+
+	[[nodiscard]] const RawCaptureHeader& GetHeader() const { return _header; }
+
+	/// <summary>
+	/// Read the next chunk - fills either frame or samples, depending on the type.
+	/// </summary>
+	/// <returns>False at the end of the file (or if the file is invalid)</returns>
+	[[nodiscard]] bool ReadChunk(RawCaptureChunkType& type, RawCaptureFrame& frame, vector<int16_t>& samples);
+};
@@ -7,6 +7,8 @@
 #include "Shared/Emulator.h"
 #include "Shared/RewindManager.h"
 #include "Shared/EmuSettings.h"
+#include "Shared/FrameProfiler.h"
+#include "Utilities/ThreadTrace.h"
 #include "Shared/SettingTypes.h"
 #include "Shared/Video/ScaleFilter.h"
 #include "Shared/Video/RotateFilter.h"
@@ -85,6 +87,8 @@ void VideoDecoder::UpdateVideoFilter() {
 }
 
 void VideoDecoder::DecodeFrame(bool forRewind) {
+	PROFILER_SCOPE(_emu->GetFrameProfiler(), FrameProfilerSection::VideoDecode, "DecodeFrame");
+	THREAD_TRACE_FLOW_END("Frame", _frame.FrameNumber);
 	UpdateVideoFilter();
 
 	bool isAudioPlayer = _emu->GetAudioPlayerHud() != nullptr;
@@ -142,6 +146,7 @@ void VideoDecoder::DecodeFrame(bool forRewind) {
 
 void VideoDecoder::DecodeThread() {
 	// This thread will decode the PPU's output (color ID to RGB, intensify r/g/b and produce a HD version of the frame if needed)
+	THREAD_TRACE_NAME("Video Decoder");
 	while (!_stopFlag.load()) {
 		// DecodeFrame returns the final ARGB frame we want to display in the emulator window
 		while (!_frameChanged) {
@@ -160,6 +165,7 @@ uint32_t VideoDecoder::GetFrameCount() {
 }
 
 void VideoDecoder::WaitForAsyncFrameDecode() {
+	THREAD_TRACE_SCOPE("WaitForAsyncFrameDecode");
 	while (_frameChanged) {
 		// Spin until decode is done
 		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(15));
@@ -171,6 +177,18 @@ void VideoDecoder::UpdateFrame(RenderedFrame frame, bool sync, bool forRewind) {
 		return;
 	}
 
+	if (!forRewind) {
+		// Raw capture gets every frame (before frames can be skipped below)
+		_emu->GetVideoRenderer()->AddRawCaptureFrame(frame);
+	}
+
+	if (_emu->IsHeadless()) {
+		// No decode thread - the caller reads the frame once the emulated frame ends (GetLastFrame)
+		_frame = std::move(frame);
+		_frameCount++;
+		return;
+	}
+
 	if (_frameChanged) {
 		// Decoder still processing last frame
 		uint32_t speed = _emu->GetSettings()->GetEmulationSpeed();
@@ -181,6 +199,7 @@ void VideoDecoder::UpdateFrame(RenderedFrame frame, bool sync, bool forRewind) {
 			return;
 		}
 		// At normal or slow speed, wait with yield instead of pure busy-spin
+		THREAD_TRACE_SCOPE("WaitForDecoder");
 		while (_frameChanged) {
 			std::this_thread::yield();
 		}
@@ -192,6 +211,7 @@ void VideoDecoder::UpdateFrame(RenderedFrame frame, bool sync, bool forRewind) {
 	if (sync) {
 		DecodeFrame(forRewind);
 	} else {
+		THREAD_TRACE_FLOW_START("Frame", _frame.FrameNumber);
 		_frameChanged = true;
 		_waitForFrame.Signal();
 	}
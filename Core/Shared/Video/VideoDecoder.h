@@ -87,6 +87,9 @@ public:
 
 	void UpdateFrame(RenderedFrame frame, bool sync, bool forRewind);
 
+	/// <summary>Last frame sent by the console - headless instances only (the decode thread owns it otherwise)</summary>
+	[[nodiscard]] const RenderedFrame& GetLastFrame() { return _frame; }
+
 	void WaitForAsyncFrameDecode();
 
 	[[nodiscard]] bool IsRunning();
@@ -11,6 +11,8 @@
 #include "Utilities/Video/IVideoRecorder.h"
 #include "Utilities/Video/AviRecorder.h"
 #include "Utilities/Video/GifRecorder.h"
+#include "Utilities/ThreadTrace.h"
+#include "Shared/Video/RawVideoCapture.h"
 
 VideoRenderer::VideoRenderer(Emulator* emu) {
 	_emu = emu;
@@ -66,6 +68,7 @@ void VideoRenderer::StopThread() {
 }
 
 void VideoRenderer::RenderThread() {
+	THREAD_TRACE_NAME("Video Renderer");
 	if (_renderer) {
 		_renderer->OnRendererThreadStarted();
 	}
@@ -74,6 +77,7 @@ void VideoRenderer::RenderThread() {
 		// Wait until a frame is ready, or until 32ms have passed (to allow HUD to update at ~30fps when paused)
 		bool forceRender = !_waitForRender.Wait(32);
 		if (_renderer) {
+			THREAD_TRACE_SCOPE("Render");
 			FrameInfo size = _emu->GetVideoDecoder()->GetBaseFrameInfo(true);
 			_scriptHudSurface.UpdateSize(size.Width * _scriptHudScale, size.Height * _scriptHudScale);
 
@@ -87,6 +91,7 @@ void VideoRenderer::RenderThread() {
 				auto lock = _frameLock.AcquireSafe();
 				frame = _lastFrame;
 			}
+			THREAD_TRACE_FLOW_END("Render", frame.FrameNumber);
 
 			_inputHud->DrawControllers(size, frame.InputData);
 			{
@@ -169,6 +174,7 @@ void VideoRenderer::UpdateFrame(RenderedFrame& frame) {
 	if (_renderer) {
 		_renderer->UpdateFrame(frame);
 		_needRedraw = true;
+		THREAD_TRACE_FLOW_START("Render", frame.FrameNumber);
 		_waitForRender.Signal();
 	}
 }
@@ -266,6 +272,13 @@ void VideoRenderer::AddRecordingSound(int16_t* soundBuffer, uint32_t sampleCount
 			StopRecording();
 		}
 	}
+
+	shared_ptr<RawVideoCapture> rawCapture = _rawCapture.lock();
+	if (rawCapture) {
+		if (!rawCapture->AddSound(soundBuffer, sampleCount, sampleRate)) {
+			StopRawCapture();
+		}
+	}
 }
 
 void VideoRenderer::StopRecording() {
@@ -278,5 +291,38 @@ void VideoRenderer::StopRecording() {
 }
 
 bool VideoRenderer::IsRecording() {
+	return _recorder != nullptr || _rawCapture != nullptr;
+}
+
+bool VideoRenderer::IsAviRecording() {
 	return _recorder != nullptr;
 }
+
+void VideoRenderer::StartRawCapture(const string& filename) {
+	shared_ptr<RawVideoCapture> rawCapture = std::make_shared<RawVideoCapture>();
+	if (rawCapture->Start(filename, _emu->GetConsoleType(), _emu->GetSettings()->GetAudioConfig().SampleRate, _emu->GetFps())) {
+		_rawCapture.reset(rawCapture);
+		MessageManager::DisplayMessage("VideoRecorder", "VideoRecorderStarted", filename);
+	} else {
+		MessageManager::DisplayMessage("VideoRecorder", "CouldNotWriteToFile", filename);
+	}
+}
+
+void VideoRenderer::StopRawCapture() {
+	shared_ptr<RawVideoCapture> rawCapture = _rawCapture.lock();
+	if (rawCapture) {
+		MessageManager::DisplayMessage("VideoRecorder", "VideoRecorderStopped", rawCapture->GetOutputFile());
+	}
+	_rawCapture.reset();
+}
+
+bool VideoRenderer::IsRawCapturing() {
+	return _rawCapture != nullptr;
+}
+
+void VideoRenderer::AddRawCaptureFrame(const RenderedFrame& frame) {
+	shared_ptr<RawVideoCapture> rawCapture = _rawCapture.lock();
+	if (rawCapture && !rawCapture->AddFrame(frame)) {
+		StopRawCapture();
+	}
+}
@@ -15,6 +15,7 @@ class DebugHud;
 class InputHud;
 
 class IVideoRecorder;
+class RawVideoCapture;
 enum class VideoCodec;
 
 /// <summary>
@@ -58,6 +59,8 @@ struct RecordAviOptions {
 /// - safe_ptr<IVideoRecorder> for async recorder management
 /// - Records post-filter, pre-HUD or post-HUD frames
 /// - Supports multiple codecs: Raw, ZMBV, Camstudio LZSS
+/// - Raw capture: records the console's output before any filter, to render it later
+///   with any filter (see RawVideoCapture/RawCaptureRenderer)
 /// </remarks>
 class VideoRenderer {
 private:
@@ -93,6 +96,7 @@ private:
 	SimpleLock _frameLock;
 
 	safe_ptr<IVideoRecorder> _recorder;
+	safe_ptr<RawVideoCapture> _rawCapture;
 
 	void RenderThread();
 	bool DrawScriptHud(RenderedFrame& frame);
@@ -122,5 +126,16 @@ public:
 	void StartRecording(const string& filename, RecordAviOptions options);
 	void AddRecordingSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate);
 	void StopRecording();
+
+	/// <summary>Whether a video (AVI/GIF) or raw capture is being recorded</summary>
 	[[nodiscard]] bool IsRecording();
+	[[nodiscard]] bool IsAviRecording();
+
+	/// <summary>Start recording the console's unfiltered output (and audio) to a raw capture file</summary>
+	void StartRawCapture(const string& filename);
+	void StopRawCapture();
+	[[nodiscard]] bool IsRawCapturing();
+
+	/// <summary>Called by the video decoder with the console's unfiltered frame (emulation thread)</summary>
+	void AddRawCaptureFrame(const RenderedFrame& frame);
 };
@@ -8,6 +8,8 @@
 #include "Core/Debugger/CdlManager.h"
 #include "Core/Debugger/Disassembler.h"
 #include "Core/Debugger/DisassemblySearch.h"
+#include "Core/Debugger/MemorySearch.h"
+#include "Core/Debugger/DebuggerRefreshSnapshot.h"
 #include "Core/Debugger/DebugTypes.h"
 #include "Core/Debugger/Breakpoint.h"
 #include "Core/Debugger/BreakpointManager.h"
@@ -159,6 +161,16 @@ DllExport void __stdcall GetPpuState(BaseState& state, CpuType cpuType) {
 	WithDebugger(void, GetPpuState(state, cpuType));
 }
 
+DllExport void __stdcall SetDebuggerRefreshRequest(DebuggerRefreshRequest request) {
+	WithDebugger(void, GetRefreshSnapshot()->SetRequest(request));
+}
+DllExport void __stdcall ClearDebuggerRefreshRequest() {
+	WithDebugger(void, GetRefreshSnapshot()->ClearRequest());
+}
+DllExport uint32_t __stdcall GetDebuggerRefreshSnapshot(uint8_t* buffer, uint32_t bufferSize) {
+	return WithDebugger(uint32_t, GetRefreshSnapshot()->GetSnapshot(buffer, bufferSize));
+}
+
 DllExport void __stdcall SetCpuState(BaseState& state, CpuType cpuType) {
 	WithDebugger(void, SetCpuState(state, cpuType));
 }
@@ -212,6 +224,25 @@ DllExport void __stdcall SetMemoryValue(MemoryType type, uint32_t address, uint8
 DllExport void __stdcall SetMemoryValues(MemoryType type, uint32_t address, uint8_t* data, int32_t length) {
 	WithDebugger(void, GetMemoryDumper()->SetMemoryValues(type, address, data, length));
 }
+
+DllExport void __stdcall ResetMemorySearch(MemoryType type) {
+	WithDebugger(void, GetMemorySearch()->Reset(type));
+}
+DllExport void __stdcall RefreshMemorySearch() {
+	WithDebugger(void, GetMemorySearch()->Refresh());
+}
+DllExport uint32_t __stdcall ApplyMemorySearchFilter(MemorySearchFilter filter) {
+	return WithDebugger(uint32_t, GetMemorySearch()->ApplyFilter(filter));
+}
+DllExport bool __stdcall UndoMemorySearchFilter() {
+	return WithDebugger(bool, GetMemorySearch()->Undo());
+}
+DllExport uint32_t __stdcall GetMemorySearchCandidateCount() {
+	return WithDebugger(uint32_t, GetMemorySearch()->GetCandidateCount());
+}
+DllExport uint32_t __stdcall GetMemorySearchResults(uint32_t offset, MemorySearchResult results[], uint32_t maxCount, MemorySearchValueSize valueSize, bool bigEndian) {
+	return WithDebugger(uint32_t, GetMemorySearch()->GetResults(offset, results, maxCount, valueSize, bigEndian));
+}
 DllExport bool __stdcall HasUndoHistory() {
 	return WithDebugger(bool, GetMemoryDumper()->HasUndoHistory());
 }
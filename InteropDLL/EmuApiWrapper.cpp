@@ -6,6 +6,11 @@
 #include "Core/Shared/SystemActionManager.h"
 #include "Core/Shared/MessageManager.h"
 #include "Core/Shared/SaveStateManager.h"
+#include "Core/Shared/Movies/Greenzone.h"
+#include "Core/Shared/FrameProfiler.h"
+#include "Core/Shared/BatchEnvironment.h"
+#include "Core/Shared/Movies/InputSearch.h"
+#include "Core/Shared/RomIdentifier.h"
 #include <sstream>
 #include "Core/Shared/BatteryManager.h"
 #include "Core/Shared/Interfaces/INotificationListener.h"
@@ -16,9 +21,12 @@
 #include "Core/Shared/DebuggerRequest.h"
 #include "Core/Netplay/GameClient.h"
 #include "Core/Netplay/GameServer.h"
+#include "Core/NES/NesConsole.h"
+#include "Core/NES/HdPacks/HdData.h"
 #include "Utilities/ArchiveReader.h"
 #include "Utilities/FolderUtilities.h"
 #include "Utilities/StringUtilities.h"
+#include "Utilities/ThreadTrace.h"
 #include "InteropNotificationListeners.h"
 
 #ifdef _WIN32
@@ -45,6 +53,8 @@ unique_ptr<IKeyManager> _keyManager;
 unique_ptr<IMouseManager> _mouseManager;
 unique_ptr<Emulator> _emu(new Emulator());
 bool _softwareRenderer = false;
+unique_ptr<BatchEnvironment> _batchEnvironment;
+unique_ptr<InputSearch> _inputSearch;
 
 static void* _windowHandle = nullptr;
 static void* _viewerHandle = nullptr;
@@ -168,6 +178,11 @@ DllExport TimingInfo __stdcall GetTimingInfo(CpuType cpuType) {
 	return _emu->GetTimingInfo(cpuType);
 }
 
+DllExport HdPackLoadProgress __stdcall GetHdPackLoadProgress() {
+	shared_ptr<NesConsole> console = std::dynamic_pointer_cast<NesConsole>(_emu->GetConsole());
+	return console ? console->GetHdPackLoadProgress() : HdPackLoadProgress {};
+}
+
 DllExport void __stdcall TakeScreenshot() {
 	_emu->GetVideoDecoder()->TakeScreenshot();
 }
@@ -218,6 +233,9 @@ DllExport bool __stdcall IsPaused() {
 }
 
 DllExport void __stdcall Release() {
+	_inputSearch.reset();
+	_batchEnvironment.reset();
+
 	if (_emu) {
 		_emu->Stop(true);
 		_emu->Release();
@@ -280,6 +298,54 @@ DllExport void __stdcall GetRomHash(HashType hashType, char* outBuffer, uint32_t
 	StringUtilities::CopyToBuffer(_emu->GetHash(hashType), outBuffer, maxLength);
 }
 
+/// <summary>
+/// Interop struct for returning ROM identification results to managed code.
+/// </summary>
+struct InteropRomIdentification {
+	char md5[33];          ///< Uppercase hex
+	char sha1[41];         ///< Uppercase hex
+	char dbSystem[64];     ///< Database's system (empty if unknown)
+	char dbName[256];      ///< Database's name for the game (empty if unknown)
+	uint64_t size;         ///< File size in bytes
+	uint32_t crc32;        ///< CRC32 of the whole file
+	uint32_t contentCrc32; ///< CRC32 of the ROM data after the header
+	uint32_t headerSize;   ///< Bytes before the ROM data
+	uint8_t valid;         ///< Whether the file could be read
+	uint8_t knownGame;     ///< Whether the game is in one of the game databases
+};
+
+/// <summary>
+/// Hash ROM files and look them up in the game databases, on several threads (blocks until done).
+/// </summary>
+/// <param name="paths">Newline-separated file paths (archive entries use the "archive\x1file" notation)</param>
+/// <param name="threadCount">Threads reading and hashing the files (0 = one per core)</param>
+/// <returns>Number of results written (in the same order as the paths)</returns>
+DllExport uint32_t __stdcall IdentifyRoms(char* paths, uint32_t threadCount, InteropRomIdentification* outInfoArray, uint32_t maxCount) {
+	vector<string> files = StringUtilities::Split(paths, '\n');
+	std::erase(files, "");
+	if (files.size() > maxCount) {
+		files.resize(maxCount);
+	}
+
+	vector<RomIdentification> results = RomIdentifier::Identify(files, threadCount);
+	for (size_t i = 0; i < results.size(); i++) {
+		RomIdentification& result = results[i];
+		InteropRomIdentification& out = outInfoArray[i];
+		memset(&out, 0, sizeof(InteropRomIdentification));
+		StringUtilities::CopyToBuffer(result.Hashes.Md5, out.md5, sizeof(out.md5));
+		StringUtilities::CopyToBuffer(result.Hashes.Sha1, out.sha1, sizeof(out.sha1));
+		StringUtilities::CopyToBuffer(result.DbSystem, out.dbSystem, sizeof(out.dbSystem));
+		StringUtilities::CopyToBuffer(result.DbName, out.dbName, sizeof(out.dbName));
+		out.size = result.Size;
+		out.crc32 = result.Hashes.Crc32;
+		out.contentCrc32 = result.ContentCrc32;
+		out.headerSize = result.HeaderSize;
+		out.valid = result.Valid ? 1 : 0;
+		out.knownGame = result.KnownGame ? 1 : 0;
+	}
+	return (uint32_t)results.size();
+}
+
 DllExport void __stdcall InputBarcode(uint64_t barcode, uint32_t digitCount) {
 	_emu->InputBarcode(barcode, digitCount);
 }
@@ -337,6 +403,161 @@ DllExport bool __stdcall LoadStateFromMemory(uint8_t* data, int32_t size) {
 	return _emu->GetSaveStateManager()->LoadState(stream);
 }
 
+// ========== TAS Greenzone API ==========
+
+DllExport void __stdcall SetGreenzoneConfig(bool enabled, GreenzoneConfig config) {
+	auto lock = _emu->AcquireLock();
+	if (enabled) {
+		_emu->EnableGreenzone(config);
+	} else {
+		_emu->DisableGreenzone();
+	}
+}
+
+DllExport void __stdcall GreenzoneInvalidateFrom(uint32_t frame) {
+	auto lock = _emu->AcquireLock();
+	if (Greenzone* greenzone = _emu->GetGreenzone()) {
+		greenzone->InvalidateFrom(frame);
+	}
+}
+
+DllExport void __stdcall GreenzoneClear() {
+	auto lock = _emu->AcquireLock();
+	if (Greenzone* greenzone = _emu->GetGreenzone()) {
+		greenzone->Clear();
+	}
+}
+
+DllExport bool __stdcall GreenzoneSeek(uint32_t frame) {
+	return _emu->RequestGreenzoneSeek(frame);
+}
+
+DllExport void __stdcall GetGreenzoneInfo(GreenzoneInfo& info) {
+	auto lock = _emu->AcquireLock();
+	Greenzone* greenzone = _emu->GetGreenzone();
+	info = greenzone ? greenzone->GetInfo() : GreenzoneInfo{ .FirstFrame = -1, .LastFrame = -1 };
+}
+
+// ========== Frame Profiler API ==========
+
+DllExport void __stdcall SetFrameProfilerEnabled(bool enabled) {
+	_emu->GetFrameProfiler()->SetEnabled(FrameProfiler::Client::Api, enabled);
+}
+
+DllExport void __stdcall ResetFrameProfiler() {
+	_emu->GetFrameProfiler()->Reset();
+}
+
+DllExport void __stdcall GetFrameProfilerStats(FrameProfilerStats& stats) {
+	stats = _emu->GetFrameProfiler()->GetStats();
+}
+
+// ========== Thread Trace API ==========
+
+DllExport void __stdcall SetThreadTraceEnabled(bool enabled) {
+	ThreadTrace::SetEnabled(enabled);
+}
+
+DllExport bool __stdcall SaveThreadTrace(char* filename) {
+	return ThreadTrace::SaveChromeTrace(filename);
+}
+
+// ========== Batch Environment API ==========
+
+DllExport bool __stdcall BatchEnvCreate(char* romFile, char* patchFile, uint32_t instanceCount, uint32_t threadCount, uint32_t portCount, BatchFrameFormat frameFormat, uint32_t frameStride, BatchRamRange* ramRanges, uint32_t ramRangeCount) {
+	BatchEnvironmentConfig config = {};
+	config.InstanceCount = instanceCount;
+	config.ThreadCount = threadCount;
+	config.PortCount = portCount;
+	config.FrameFormat = frameFormat;
+	config.FrameStride = frameStride;
+	config.RamRanges.assign(ramRanges, ramRanges + ramRangeCount);
+
+	_batchEnvironment = std::make_unique<BatchEnvironment>(config);
+	if (!_batchEnvironment->LoadRom((VirtualFile)romFile, patchFile ? (VirtualFile)patchFile : VirtualFile(), _emu->GetSettings())) {
+		_batchEnvironment.reset();
+		return false;
+	}
+	return true;
+}
+
+DllExport void __stdcall BatchEnvRelease() {
+	_batchEnvironment.reset();
+}
+
+DllExport uint32_t __stdcall BatchEnvGetRamStride() {
+	return _batchEnvironment ? _batchEnvironment->GetRamStride() : 0;
+}
+
+DllExport void __stdcall BatchEnvStep(uint32_t* inputs, void* frames, BatchStepInfo* info, uint8_t* ram, uint32_t frameCount) {
+	if (_batchEnvironment) {
+		_batchEnvironment->Step(inputs, frames, info, ram, frameCount);
+	}
+}
+
+DllExport void __stdcall BatchEnvSaveSnapshot(uint32_t instance) {
+	if (_batchEnvironment && instance < _batchEnvironment->GetInstanceCount()) {
+		_batchEnvironment->SaveSnapshot(instance);
+	}
+}
+
+DllExport void __stdcall BatchEnvReset(uint8_t* resetFlags) {
+	if (_batchEnvironment) {
+		_batchEnvironment->Reset(resetFlags);
+	}
+}
+
+// ========== Input Search API ==========
+
+DllExport bool __stdcall InputSearchStart(uint32_t depth, uint32_t framesPerInput, uint32_t* candidates, uint32_t candidateCount, uint8_t port, CpuType cpuType, char* goalExpression, char* pruneExpression, char* scoreExpression, uint32_t maxResults, uint32_t threadCount) {
+	InputSearchConfig config = {};
+	config.Depth = depth;
+	config.FramesPerInput = framesPerInput;
+	config.Candidates.assign(candidates, candidates + candidateCount);
+	config.Port = port;
+	config.Cpu = cpuType;
+	config.GoalExpression = goalExpression;
+	config.PruneExpression = pruneExpression ? pruneExpression : "";
+	config.ScoreExpression = scoreExpression ? scoreExpression : "";
+	config.MaxResults = maxResults;
+	config.ThreadCount = threadCount;
+
+	if (!_inputSearch) {
+		_inputSearch = std::make_unique<InputSearch>(_emu.get());
+	}
+	return _inputSearch->Start(config);
+}
+
+DllExport void __stdcall InputSearchStop() {
+	if (_inputSearch) {
+		_inputSearch->Stop();
+	}
+}
+
+DllExport void __stdcall InputSearchGetProgress(InputSearchProgress& progress) {
+	progress = _inputSearch ? _inputSearch->GetProgress() : InputSearchProgress{};
+}
+
+/// <summary>
+/// Copy the ranked results: the inputs of result N start at inputs[N * maxInputCount] (the
+/// sequences can be shorter than the search's depth - see inputCounts).
+/// </summary>
+DllExport uint32_t __stdcall InputSearchGetResults(uint32_t* inputs, uint32_t maxInputCount, uint32_t* inputCounts, int64_t* scores, uint32_t maxResults) {
+	if (!_inputSearch) {
+		return 0;
+	}
+
+	vector<InputSearchResult> results = _inputSearch->GetResults();
+	uint32_t count = std::min((uint32_t)results.size(), maxResults);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t inputCount = std::min((uint32_t)results[i].Inputs.size(), maxInputCount);
+		std::copy(results[i].Inputs.begin(), results[i].Inputs.begin() + inputCount, inputs + (size_t)i * maxInputCount);
+		inputCounts[i] = inputCount;
+		scores[i] = results[i].Score;
+	}
+	return count;
+}
+
 DllExport void __stdcall LoadRecentGame(char* filepath, bool resetGame) {
 	_emu->GetSaveStateManager()->LoadRecentGame(filepath, resetGame);
 }
@@ -1,6 +1,7 @@
 #include "Common.h"
 #include "Core/Shared/Emulator.h"
 #include "Core/Shared/Video/VideoRenderer.h"
+#include "Core/Shared/Video/RawCaptureRenderer.h"
 #include "Core/Shared/Audio/SoundMixer.h"
 #include "Core/Shared/Movies/MovieManager.h"
 #include "Core/Shared/Movies/MovieTypes.h"
@@ -15,7 +16,20 @@ DllExport void __stdcall AviStop() {
 	_emu->GetVideoRenderer()->StopRecording();
 }
 DllExport bool __stdcall AviIsRecording() {
-	return _emu->GetVideoRenderer()->IsRecording();
+	return _emu->GetVideoRenderer()->IsAviRecording();
+}
+
+DllExport void __stdcall RawCaptureRecord(char* filename) {
+	_emu->GetVideoRenderer()->StartRawCapture(filename);
+}
+DllExport void __stdcall RawCaptureStop() {
+	_emu->GetVideoRenderer()->StopRawCapture();
+}
+DllExport bool __stdcall RawCaptureIsRecording() {
+	return _emu->GetVideoRenderer()->IsRawCapturing();
+}
+DllExport bool __stdcall RawCaptureRender(char* inputFile, char* outputFile, RecordAviOptions options) {
+	return RawCaptureRenderer::Render(_emu.get(), inputFile, outputFile, options);
 }
 
 DllExport void __stdcall WaveRecord(char* filename) {
@@ -16,12 +16,17 @@ public sealed partial class EmulationConfig : BaseConfig<EmulationConfig> {
 
 	[Reactive][MinMax(0, 10)] public partial UInt32 RunAheadFrames { get; set; } = 0;
 
+	[Reactive] public partial bool SkipIdleLoops { get; set; } = false;
+	[Reactive] public partial bool PreemptiveRunAhead { get; set; } = false;
+
 	public void ApplyConfig() {
 		ConfigApi.SetEmulationConfig(new InteropEmulationConfig() {
 			EmulationSpeed = this.EmulationSpeed,
 			TurboSpeed = this.TurboSpeed,
 			RewindSpeed = this.RewindSpeed,
-			RunAheadFrames = this.RunAheadFrames
+			RunAheadFrames = this.RunAheadFrames,
+			SkipIdleLoops = this.SkipIdleLoops,
+			PreemptiveRunAhead = this.PreemptiveRunAhead
 		});
 	}
 }
@@ -33,6 +38,9 @@ public struct InteropEmulationConfig {
 	public UInt32 RewindSpeed;
 
 	public UInt32 RunAheadFrames;
+
+	[MarshalAs(UnmanagedType.I1)] public bool SkipIdleLoops;
+	[MarshalAs(UnmanagedType.I1)] public bool PreemptiveRunAhead;
 }
 
 public enum ConsoleRegion {
@@ -11,6 +11,7 @@ using System.Threading.Tasks;
 using Avalonia;
 using Nexen.Config;
 using Nexen.Debugger;
+using Nexen.Debugger.ViewModels;
 using Nexen.Utilities;
 
 namespace Nexen.Interop;
@@ -105,6 +106,29 @@ public sealed class DebugApi {
 		return Marshal.PtrToStructure<T>((IntPtr)ptr);
 	}
 
+	[DllImport(DllPath)] public static extern void SetDebuggerRefreshRequest(DebuggerRefreshRequest request);
+	[DllImport(DllPath)] public static extern void ClearDebuggerRefreshRequest();
+
+	/// <summary>
+	/// Fills (or updates) a refresh snapshot buffer with the data requested by SetDebuggerRefreshRequest.
+	/// Only sections whose generation changed since the buffer was last filled are copied - see DebuggerRefreshHeader.UpdatedSections.
+	/// The buffer is resized as needed and must be kept between calls.
+	/// </summary>
+	[DllImport(DllPath, EntryPoint = "GetDebuggerRefreshSnapshot")] private static extern UInt32 GetDebuggerRefreshSnapshotWrapper([In, Out] byte[] buffer, UInt32 bufferSize);
+	public static DebuggerRefreshHeader GetDebuggerRefreshSnapshot(ref byte[] buffer) {
+		UInt32 requiredSize = DebugApi.GetDebuggerRefreshSnapshotWrapper(buffer, (UInt32)buffer.Length);
+		if (requiredSize > buffer.Length) {
+			// Layout changed - a new (zeroed) buffer makes every section get copied
+			buffer = new byte[requiredSize];
+			requiredSize = DebugApi.GetDebuggerRefreshSnapshotWrapper(buffer, (UInt32)buffer.Length);
+		}
+
+		if (requiredSize == 0) {
+			return new DebuggerRefreshHeader();
+		}
+		return MemoryMarshal.Read<DebuggerRefreshHeader>(buffer);
+	}
+
 	[DllImport(DllPath)] private static extern void GetPpuState(IntPtr state, CpuType cpuType);
 	public unsafe static T GetPpuState<[DynamicallyAccessedMembers(DynamicallyAccessedMemberTypes.PublicConstructors | DynamicallyAccessedMemberTypes.NonPublicConstructors)] T>(CpuType cpuType) where T : struct, BaseState {
 		byte* ptr = stackalloc byte[Marshal.SizeOf<T>()];
@@ -286,6 +310,20 @@ public sealed class DebugApi {
 		DebugApi.GetMemoryStateWrapper(type, dst);
 	}
 
+	[DllImport(DllPath)] public static extern void ResetMemorySearch(MemoryType type);
+	[DllImport(DllPath)] public static extern void RefreshMemorySearch();
+	[DllImport(DllPath)] public static extern UInt32 ApplyMemorySearchFilter(InteropMemorySearchFilter filter);
+	[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool UndoMemorySearchFilter();
+	[DllImport(DllPath)] public static extern UInt32 GetMemorySearchCandidateCount();
+
+	[DllImport(DllPath, EntryPoint = "GetMemorySearchResults")] private static extern UInt32 GetMemorySearchResultsWrapper(UInt32 offset, [In, Out] MemorySearchResult[] results, UInt32 maxCount, byte valueSize, [MarshalAs(UnmanagedType.I1)] bool bigEndian);
+	public static MemorySearchResult[] GetMemorySearchResults(UInt32 offset, UInt32 maxCount, MemorySearchValueSize valueSize, bool bigEndian) {
+		MemorySearchResult[] results = new MemorySearchResult[maxCount];
+		UInt32 count = DebugApi.GetMemorySearchResultsWrapper(offset, results, maxCount, (byte)valueSize, bigEndian);
+		Array.Resize(ref results, (int)count);
+		return results;
+	}
+
 	[DllImport(DllPath, EntryPoint = "GetTilemap")] private static extern void GetTilemapWrapper(CpuType cpuType, InteropGetTilemapOptions options, IntPtr state, IntPtr ppuToolsState, byte[] vram, UInt32[] palette, IntPtr outputBuffer, out DebugTilemapInfo tilemapInfo);
 	public unsafe static DebugTilemapInfo GetTilemap(CpuType cpuType, GetTilemapOptions options, BaseState state, BaseState ppuToolsState, byte[] vram, UInt32[] palette, IntPtr outputBuffer) {
 		Debug.Assert(state.GetType().IsValueType);
@@ -1715,6 +1753,75 @@ public unsafe struct TraceRow {
 	}
 }
 
+public struct DebuggerRefreshRequest {
+	public CpuType Cpu;
+	public UInt32 CpuStateSize;
+	public UInt32 PpuStateSize;
+	public UInt32 DisassemblyLineIndex;
+	public UInt32 DisassemblyRowCount;
+	public MemoryType MemType;
+	public UInt32 MemoryStart;
+	public UInt32 MemoryLength;
+}
+
+public enum DebuggerRefreshSection {
+	CpuState,
+	PpuState,
+	Disassembly,
+	Memory
+}
+
+public struct DebuggerRefreshSectionInfo {
+	public UInt64 Generation;
+	public UInt32 Offset;
+	public UInt32 Size;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct DebuggerRefreshHeader {
+	public UInt32 Version;
+	public UInt32 TotalSize;
+	public UInt32 FrameCount;
+	public UInt32 UpdatedSections;
+	public UInt32 DisassemblyRowCount;
+	public UInt32 Reserved;
+	public DebuggerRefreshSectionInfo CpuState;
+	public DebuggerRefreshSectionInfo PpuState;
+	public DebuggerRefreshSectionInfo Disassembly;
+	public DebuggerRefreshSectionInfo Memory;
+
+	public bool IsUpdated(DebuggerRefreshSection section) {
+		return (UpdatedSections & (1u << (int)section)) != 0;
+	}
+}
+
+public struct InteropMemorySearchFilter {
+	public byte ValueSize;
+	[MarshalAs(UnmanagedType.I1)] public bool IsSigned;
+	[MarshalAs(UnmanagedType.I1)] public bool BigEndian;
+	public byte CompareTo;
+	public byte Operator;
+	public Int64 SpecificValue;
+	public UInt32 SpecificAddress;
+
+	public InteropMemorySearchFilter(MemorySearchValueSize valueSize, bool isSigned, bool bigEndian, MemorySearchCompareTo compareTo, MemorySearchOperator op, Int64 specificValue, UInt32 specificAddress) {
+		ValueSize = (byte)valueSize;
+		IsSigned = isSigned;
+		BigEndian = bigEndian;
+		CompareTo = (byte)compareTo;
+		Operator = (byte)op;
+		SpecificValue = specificValue;
+		SpecificAddress = specificAddress;
+	}
+}
+
+public struct MemorySearchResult {
+	public UInt32 Address;
+	public UInt32 Value;
+	public UInt32 PrevRefreshValue;
+	public UInt32 PrevSearchValue;
+}
+
 public struct DisassemblySearchOptions {
 	[MarshalAs(UnmanagedType.I1)] public bool MatchCase;
 	[MarshalAs(UnmanagedType.I1)] public bool MatchWholeWord;
@@ -73,6 +73,7 @@ public sealed class EmuApi {
 	[DllImport(DllPath)] public static extern void SetExclusiveFullscreenMode([MarshalAs(UnmanagedType.I1)] bool fullscreen, IntPtr windowHandle);
 
 	[DllImport(DllPath)] public static extern TimingInfo GetTimingInfo(CpuType cpuType);
+	[DllImport(DllPath)] public static extern HdPackLoadProgress GetHdPackLoadProgress();
 
 	[DllImport(DllPath)] public static extern double GetAspectRatio();
 	[DllImport(DllPath)] public static extern FrameInfo GetBaseScreenSize();
@@ -118,6 +119,27 @@ public sealed class EmuApi {
 	/// <returns>True if the state was loaded successfully.</returns>
 	[DllImport(DllPath)] public static extern bool LoadStateFromMemory(IntPtr data, Int32 size);
 
+	// ========== TAS Greenzone API ==========
+
+	/// <summary>
+	/// Enable (or reconfigure) the core-side greenzone, which captures states at the end of frames.
+	/// </summary>
+	[DllImport(DllPath)] public static extern void SetGreenzoneConfig([MarshalAs(UnmanagedType.I1)] bool enabled, InteropGreenzoneConfig config);
+
+	/// <summary>Invalidate the greenzone's states from this frame onwards (movie edited at this frame).</summary>
+	[DllImport(DllPath)] public static extern void GreenzoneInvalidateFrom(UInt32 frame);
+
+	/// <summary>Remove all of the greenzone's states.</summary>
+	[DllImport(DllPath)] public static extern void GreenzoneClear();
+
+	/// <summary>
+	/// Seek to a frame: the emulation thread loads the nearest greenzone state before it and emulates the rest.
+	/// </summary>
+	/// <returns>False if the greenzone has no state at or before this frame.</returns>
+	[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool GreenzoneSeek(UInt32 frame);
+
+	[DllImport(DllPath)] public static extern void GetGreenzoneInfo(out InteropGreenzoneInfo info);
+
 	// ========== Timestamped Save State API ==========
 
 	[DllImport(DllPath, EntryPoint = "SaveTimestampedState")]
@@ -273,6 +295,28 @@ public sealed class EmuApi {
 	[DllImport(DllPath)] public static extern void ProcessTapeRecorderAction(TapeRecorderAction action, [MarshalAs(UnmanagedType.LPUTF8Str)] string filename = "");
 }
 
+public struct InteropGreenzoneConfig {
+	public UInt32 CaptureInterval;
+	public UInt32 RawStateCount;
+	public UInt32 KeyframeInterval;
+	public UInt64 MaxMemoryBytes;
+}
+
+public struct InteropGreenzoneInfo {
+	public UInt32 StateCount;
+	public UInt32 RawStateCount;
+	public UInt32 KeyframeCount;
+	public UInt32 DeltaCount;
+	public UInt64 MemoryUsage;
+	public Int64 FirstFrame;
+	public Int64 LastFrame;
+}
+
+public struct HdPackLoadProgress {
+	public UInt32 LoadedImages;
+	public UInt32 TotalImages;
+}
+
 public struct TimingInfo {
 	public double Fps;
 	public UInt64 MasterClock;
@@ -11,6 +11,11 @@ sealed class RecordApi {
 	[DllImport(DllPath)] public static extern void AviStop();
 	[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool AviIsRecording();
 
+	[DllImport(DllPath)] public static extern void RawCaptureRecord([MarshalAs(UnmanagedType.LPUTF8Str)] string filename);
+	[DllImport(DllPath)] public static extern void RawCaptureStop();
+	[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool RawCaptureIsRecording();
+	[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool RawCaptureRender([MarshalAs(UnmanagedType.LPUTF8Str)] string inputFile, [MarshalAs(UnmanagedType.LPUTF8Str)] string outputFile, RecordAviOptions options);
+
 	[DllImport(DllPath)] public static extern void WaveRecord([MarshalAs(UnmanagedType.LPUTF8Str)] string filename);
 	[DllImport(DllPath)] public static extern void WaveStop();
 	[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool WaveIsRecording();
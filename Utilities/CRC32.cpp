@@ -35,12 +35,41 @@ extern const uint32_t Crc32Lookup[MaxSlice][256];
 #define __BYTE_ORDER __LITTLE_ENDIAN
 #endif
 
+#if defined(__ARM_FEATURE_CRC32) && __BYTE_ORDER == __LITTLE_ENDIAN
+#define USE_HARDWARE_CRC32
+#include <arm_acle.h>
+
+// ARMv8 CRC32 instructions use the same (IEEE 802.3) polynomial as the lookup tables
+static uint32_t crc32_hardware(const uint8_t* data, size_t length, uint32_t previousCrc32) {
+	uint32_t crc = ~previousCrc32;
+	while (length >= 8) {
+		uint64_t value;
+		memcpy(&value, data, sizeof(value));
+		crc = __crc32d(crc, value);
+		data += 8;
+		length -= 8;
+	}
+	while (length-- != 0) {
+		crc = __crc32b(crc, *data++);
+	}
+	return ~crc;
+}
+#endif
+
 uint32_t CRC32::GetCRC(uint8_t* buffer, std::streamoff length) {
-	return crc32_16bytes(buffer, length, 0);
+	return GetCRC(buffer, (size_t)length, 0);
 }
 
 uint32_t CRC32::GetCRC(vector<uint8_t>& data) {
-	return crc32_16bytes(data.data(), (std::streamoff)data.size(), 0);
+	return GetCRC(data.data(), data.size(), 0);
+}
+
+uint32_t CRC32::GetCRC(const uint8_t* buffer, size_t length, uint32_t previousCrc) {
+#ifdef USE_HARDWARE_CRC32
+	return crc32_hardware(buffer, length, previousCrc);
+#else
+	return crc32_16bytes(buffer, length, previousCrc);
+#endif
 }
 
 uint32_t CRC32::GetCRC(const string& filename) {
@@ -57,7 +86,7 @@ uint32_t CRC32::GetCRC(const string& filename) {
 		file.read((char*)buffer.data(), fileSize);
 		file.close();
 
-		crc = crc32_16bytes(buffer.data(), fileSize, 0);
+		crc = GetCRC(buffer.data(), (size_t)fileSize, 0);
 	}
 	return crc;
 }
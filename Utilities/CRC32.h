@@ -5,6 +5,7 @@
 /// CRC32 checksum calculation utilities using slice-by-16 algorithm for optimal performance.
 /// All public methods are marked [[nodiscard]] to prevent accidentally discarding checksum results.
 /// Implementation adapted from https://github.com/stbrumme/crc32 (zlib license).
+/// On ARMv8 builds with the CRC extension enabled, the CPU's CRC32 instructions are used instead.
 /// </summary>
 class CRC32 {
 private:
@@ -42,6 +43,15 @@ public:
 	/// </remarks>
 	[[nodiscard]] static uint32_t GetCRC(vector<uint8_t>& data);
 
+	/// <summary>
+	/// Continue a CRC32 checksum with more data (streaming).
+	/// </summary>
+	/// <param name="buffer">Pointer to the next data</param>
+	/// <param name="length">Number of bytes to process</param>
+	/// <param name="previousCrc">CRC32 of the previous data (0 for the first block)</param>
+	/// <returns>CRC32 of the previous data followed by this data</returns>
+	[[nodiscard]] static uint32_t GetCRC(const uint8_t* buffer, size_t length, uint32_t previousCrc);
+
 	/// <summary>
 	/// Calculate CRC32 checksum for an entire file.
 	/// </summary>
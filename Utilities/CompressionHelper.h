@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "pch.h"
+#include <span>
 #include <miniz/miniz.h>
 
 /// <summary>
@@ -42,6 +43,16 @@ public:
 	/// Allocates temporary buffer (deleted after compression).
 	/// </remarks>
 	static void Compress(const string& data, int compressionLevel, vector<uint8_t>& output) {
+		Compress(std::span<const uint8_t>((const uint8_t*)data.data(), data.size()), compressionLevel, output);
+	}
+
+	/// <summary>
+	/// Compress binary data (same output format as the string overload).
+	/// </summary>
+	/// <param name="data">Data to compress</param>
+	/// <param name="compressionLevel">Compression level (0=none, 1=fast, 9=best, -1=default)</param>
+	/// <param name="output">Output vector to append compressed data</param>
+	static void Compress(std::span<const uint8_t> data, int compressionLevel, vector<uint8_t>& output) {
 		unsigned long compressedSize = compressBound((unsigned long)data.size());
 
 		uint32_t originalSize = (uint32_t)data.size();
@@ -51,7 +62,7 @@ public:
 		size_t prevSize = output.size();
 		output.resize(prevSize + headerSize + compressedSize);
 
-		compress2(output.data() + prevSize + headerSize, &compressedSize, (unsigned char*)data.c_str(), (unsigned long)data.size(), compressionLevel);
+		compress2(output.data() + prevSize + headerSize, &compressedSize, data.data(), (unsigned long)data.size(), compressionLevel);
 
 		// Write headers
 		uint32_t size = (uint32_t)compressedSize;
@@ -0,0 +1,64 @@
+#include "pch.h"
+#include <format>
+#include "Utilities/MultiHash.h"
+#include "Utilities/CRC32.h"
+
+MultiHash::MultiHash() {
+	MD5_Init(&_md5);
+}
+
+void MultiHash::Update(const uint8_t* data, size_t size) {
+	while (size > 0) {
+		size_t blockSize = std::min(size, BlockSize);
+		_crc32 = CRC32::GetCRC(data, blockSize, _crc32);
+		MD5_Update(&_md5, data, (unsigned long)blockSize);
+		_sha1.update(data, blockSize);
+		data += blockSize;
+		size -= blockSize;
+	}
+}
+
+MultiHashResult MultiHash::Finalize() {
+	MultiHashResult result = {};
+	result.Crc32 = _crc32;
+
+	unsigned char md5[16];
+	MD5_Final(md5, &_md5);
+	result.Md5.reserve(32);
+	for (int i = 0; i < 16; i++) {
+		result.Md5 += std::format("{:02X}", md5[i]);
+	}
+
+	// SHA1::final() resets its own state
+	result.Sha1 = _sha1.final();
+
+	_crc32 = 0;
+	MD5_Init(&_md5);
+	return result;
+}
+
+MultiHashResult MultiHash::Compute(const uint8_t* data, size_t size) {
+	MultiHash hash;
+	hash.Update(data, size);
+	return hash.Finalize();
+}
+
+bool MultiHash::ComputeFile(const string& filename, MultiHashResult& result) {
+	ifstream file(filename, std::ios::in | std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	MultiHash hash;
+	vector<uint8_t> buffer(FileChunkSize);
+	while (file) {
+		file.read((char*)buffer.data(), buffer.size());
+		hash.Update(buffer.data(), (size_t)file.gcount());
+	}
+	if (file.bad()) {
+		return false;
+	}
+
+	result = hash.Finalize();
+	return true;
+}
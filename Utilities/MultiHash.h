@@ -0,0 +1,51 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/md5.h"
+#include "Utilities/sha1.h"
+
+/// <summary>
+/// CRC32, MD5 and SHA-1 of the same data.
+/// </summary>
+struct MultiHashResult {
+	uint32_t Crc32 = 0;
+	string Md5;  ///< Uppercase hex (same format as GetMd5Sum)
+	string Sha1; ///< Uppercase hex (same format as SHA1::GetHash)
+};
+
+/// <summary>
+/// Computes the CRC32, MD5 and SHA-1 of data in a single pass (streaming).
+/// </summary>
+/// <remarks>
+/// The data is split in blocks small enough to stay in the CPU's cache: each block goes through
+/// the 3 hashes before the next one, so the data is only read once from memory. Files are read
+/// in chunks, without loading the whole file in memory.
+/// </remarks>
+class MultiHash {
+private:
+	static constexpr size_t BlockSize = 16 * 1024;
+	static constexpr size_t FileChunkSize = 1024 * 1024;
+
+	uint32_t _crc32 = 0;
+	MD5_CTX _md5;
+	SHA1 _sha1;
+
+public:
+	MultiHash();
+
+	/// <summary>Add data to the hashes</summary>
+	void Update(const uint8_t* data, size_t size);
+
+	/// <summary>Get the hashes of all the data added since the last call (and start over)</summary>
+	[[nodiscard]] MultiHashResult Finalize();
+
+	/// <summary>Hash a memory buffer</summary>
+	[[nodiscard]] static MultiHashResult Compute(const uint8_t* data, size_t size);
+
+	/// <summary>
+	/// Hash a file, reading it in chunks.
+	/// </summary>
+	/// <param name="filename">File to hash</param>
+	/// <param name="result">Hashes of the file</param>
+	/// <returns>False if the file couldn't be read</returns>
+	[[nodiscard]] static bool ComputeFile(const string& filename, MultiHashResult& result);
+};
@@ -44,6 +44,16 @@ void Serializer::ResetForFastLoad() {
 	_readPos = 0;
 }
 
+void Serializer::ResetForFastLoad(vector<uint8_t>&& data) {
+	_data = std::move(data);
+	ResetForFastLoad();
+}
+
+void Serializer::ResetForFastLoad(const vector<uint8_t>& data) {
+	_data.assign(data.begin(), data.end());
+	ResetForFastLoad();
+}
+
 void Serializer::AddKeyPrefix(const string& prefix) {
 	// Single-pass using C++17 node extraction (avoids extra string allocations)
 	vector<string> keys;
@@ -227,6 +227,12 @@ public:
 	/// <summary>Reset for FastBinary load — rewinds read position to start of buffer</summary>
 	void ResetForFastLoad();
 
+	/// <summary>Reset for FastBinary load of a state kept elsewhere (takes ownership of the data)</summary>
+	void ResetForFastLoad(vector<uint8_t>&& data);
+
+	/// <summary>Reset for FastBinary load of a copy of a state kept elsewhere (reuses the buffer's capacity)</summary>
+	void ResetForFastLoad(const vector<uint8_t>& data);
+
 	uint32_t GetVersion() { return _version; }
 	bool IsSaving() { return _saving; }
 
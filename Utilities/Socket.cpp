@@ -23,6 +23,7 @@ using namespace std;
 #include <errno.h>
 #include <netinet/tcp.h>
 #include <netdb.h>
+#include <poll.h>
 #include <unistd.h>
 
 #define INVALID_SOCKET    (uintptr_t)-1
@@ -321,6 +322,34 @@ int Socket::BlockingRecv(char *buf, int len, int timeoutSeconds)
 	return totalReceived;
 }
 
+int Socket::Poll(const vector<Socket*>& sockets, vector<bool>& readable, int timeoutMs) {
+#ifdef _WIN32
+	vector<WSAPOLLFD> fds(sockets.size());
+#else
+	vector<pollfd> fds(sockets.size());
+#endif
+	for (size_t i = 0; i < sockets.size(); i++) {
+		fds[i].fd = (decltype(fds[i].fd))sockets[i]->_socket;
+		fds[i].events = POLLIN;
+		fds[i].revents = 0;
+	}
+
+#ifdef _WIN32
+	int result = WSAPoll(fds.data(), (ULONG)fds.size(), timeoutMs);
+#else
+	int result = poll(fds.data(), (nfds_t)fds.size(), timeoutMs);
+#endif
+
+	readable.assign(sockets.size(), false);
+	if (result > 0) {
+		for (size_t i = 0; i < sockets.size(); i++) {
+			// Errors/hang ups are reported as readable, the next Recv call will flag the connection error
+			readable[i] = (fds[i].revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL)) != 0;
+		}
+	}
+	return result;
+}
+
 void Socket::BufferedSend(char *buf, int len)
 {
 	if(_connectionError || _socket == INVALID_SOCKET) {
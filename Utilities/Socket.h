@@ -142,6 +142,15 @@ public:
 
 	int BlockingRecv(char* buf, int len, int timeoutSeconds);
 
+	/// <summary>
+	/// Waits until at least one of the sockets can be read from (data, incoming connection or disconnection).
+	/// </summary>
+	/// <param name="sockets">Sockets to wait on</param>
+	/// <param name="readable">Set to true for each socket that is ready (same order as sockets)</param>
+	/// <param name="timeoutMs">Maximum time to wait, in milliseconds</param>
+	/// <returns>Number of ready sockets, 0 on timeout, -1 on error</returns>
+	static int Poll(const vector<Socket*>& sockets, vector<bool>& readable, int timeoutMs);
+
 	double GetConnectionDurationSeconds() const;
 	double GetBandwidthKBps() const;
 	bool IsHealthy() const;
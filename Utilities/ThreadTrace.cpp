@@ -0,0 +1,180 @@
+#include "pch.h"
+#include <format>
+#include <mutex>
+#include "Utilities/ThreadTrace.h"
+
+atomic<bool> ThreadTrace::_enabled = false;
+atomic<uint64_t> ThreadTrace::_startTime = 0;
+atomic<uint64_t> ThreadTrace::_nextFlowId = 1;
+thread_local ThreadTrace::ThreadBufferHandle ThreadTrace::_thread;
+
+namespace {
+	void AppendEscaped(string& out, const char* text) {
+		for (const char* c = text ? text : ""; *c; c++) {
+			if (*c == '"' || *c == '\\') {
+				out += '\\';
+			}
+			out += *c;
+		}
+	}
+
+	string FormatTimestamp(uint64_t ns) {
+		return std::format("{}.{:03}", ns / 1000, ns % 1000);
+	}
+}
+
+struct ThreadTrace::Registry {
+	std::mutex Lock;
+	vector<shared_ptr<ThreadBuffer>> Buffers;
+	uint32_t NextThreadId = 1;
+};
+
+ThreadTrace::Registry& ThreadTrace::GetRegistry() {
+	// Never destroyed - threads can still record events while static objects are destroyed
+	static Registry* registry = new Registry();
+	return *registry;
+}
+
+ThreadTrace::ThreadBufferHandle::~ThreadBufferHandle() {
+	if (Buffer) {
+		// The events stay available until the next recording starts
+		Buffer->Active = false;
+	}
+}
+
+ThreadTrace::ThreadBuffer* ThreadTrace::GetThreadBuffer() {
+	if (!_thread.Buffer) {
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.Lock);
+		_thread.Buffer = std::make_shared<ThreadBuffer>();
+		_thread.Buffer->ThreadId = registry.NextThreadId++;
+		_thread.Buffer->ThreadName = _thread.Name;
+		registry.Buffers.push_back(_thread.Buffer);
+	}
+	return _thread.Buffer.get();
+}
+
+void ThreadTrace::Record(EventType type, const char* name, uint64_t timestamp, uint64_t durationOrId) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+	uint64_t index = buffer->WriteIndex.load(std::memory_order_relaxed);
+	Event& evt = buffer->Events[index % RingSize];
+	evt.Timestamp.store(timestamp, std::memory_order_relaxed);
+	evt.DurationOrId.store(durationOrId, std::memory_order_relaxed);
+	evt.Name.store(name, std::memory_order_relaxed);
+	evt.Type.store(type, std::memory_order_relaxed);
+	buffer->WriteIndex.store(index + 1, std::memory_order_release);
+}
+
+void ThreadTrace::SetEnabled(bool enabled) {
+	if (enabled) {
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.Lock);
+
+		// Drop the buffers of the threads that ended during the previous recording
+		std::erase_if(registry.Buffers, [](shared_ptr<ThreadBuffer>& buffer) {
+			return !buffer->Active;
+		});
+		_startTime = GetTimestamp();
+	}
+	_enabled = enabled;
+}
+
+void ThreadTrace::SetThreadName(const char* name) {
+	_thread.Name = name;
+	if (_thread.Buffer) {
+		_thread.Buffer->ThreadName = name;
+	}
+}
+
+string ThreadTrace::GetChromeTrace() {
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+
+	uint64_t startTime = _startTime;
+	string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	auto startEvent = [&]() {
+		if (!first) {
+			out += ",\n";
+		}
+		first = false;
+	};
+
+	struct EventCopy {
+		uint64_t Index;
+		uint64_t Timestamp;
+		uint64_t DurationOrId;
+		const char* Name;
+		EventType Type;
+	};
+	vector<EventCopy> events;
+
+	for (shared_ptr<ThreadBuffer>& buffer : registry.Buffers) {
+		uint32_t tid = buffer->ThreadId;
+
+		startEvent();
+		out += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", tid);
+		const char* threadName = buffer->ThreadName;
+		if (threadName) {
+			AppendEscaped(out, threadName);
+		} else {
+			out += std::format("Thread {}", tid);
+		}
+		out += "\"}}";
+
+		// The owner thread keeps writing while the ring is read - copy the events, then drop those
+		// that may have been overwritten in the meantime
+		uint64_t end = buffer->WriteIndex.load(std::memory_order_acquire);
+		uint64_t start = end > RingSize ? end - RingSize : 0;
+		events.clear();
+		for (uint64_t i = start; i < end; i++) {
+			Event& evt = buffer->Events[i % RingSize];
+			events.push_back({i, evt.Timestamp.load(std::memory_order_relaxed), evt.DurationOrId.load(std::memory_order_relaxed), evt.Name.load(std::memory_order_relaxed), evt.Type.load(std::memory_order_relaxed)});
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		uint64_t newEnd = buffer->WriteIndex.load(std::memory_order_acquire);
+		uint64_t firstValid = newEnd + 1 > RingSize ? newEnd + 1 - RingSize : 0;
+
+		for (EventCopy& evt : events) {
+			if (evt.Index < firstValid || evt.Timestamp < startTime) {
+				continue;
+			}
+
+			startEvent();
+			out += "{\"name\":\"";
+			AppendEscaped(out, evt.Name);
+			out += "\",";
+			string ts = FormatTimestamp(evt.Timestamp - startTime);
+			switch (evt.Type) {
+				case EventType::Span:
+					out += std::format("\"cat\":\"nexen\",\"ph\":\"X\",\"ts\":{},\"dur\":{}", ts, FormatTimestamp(evt.DurationOrId));
+					break;
+
+				case EventType::FlowStart:
+				case EventType::FlowEnd:
+					// Flows are matched by category + id, use the name as the category.
+					// The end binds to the span that encloses it (instead of the next span)
+					out += "\"cat\":\"";
+					AppendEscaped(out, evt.Name);
+					out += "\",";
+					out += evt.Type == EventType::FlowStart ? "\"ph\":\"s\"" : "\"ph\":\"f\",\"bp\":\"e\"";
+					out += std::format(",\"id\":{},\"ts\":{}", evt.DurationOrId, ts);
+					break;
+			}
+			out += std::format(",\"pid\":1,\"tid\":{}}}", tid);
+		}
+	}
+
+	out += "\n]}\n";
+	return out;
+}
+
+bool ThreadTrace::SaveChromeTrace(const string& filename) {
+	ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	string trace = GetChromeTrace();
+	file.write(trace.data(), trace.size());
+	return (bool)file;
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include "pch.h"
+#include <chrono>
+
+/// <summary>
+/// Opt-in timeline of the emulator's threads, exported in the Chrome trace format
+/// (chrome://tracing, Perfetto).
+/// </summary>
+/// <remarks>
+/// Each thread records its events in its own ring buffer (the last 64K events), without any
+/// locking - the buffer's owner is its only writer. The rings are read when the trace is saved.
+///
+/// Event types:
+/// - Spans (ThreadTraceScope): a named time range on a thread (e.g. a frame being decoded, a
+///   wait for a lock)
+/// - Flows: arrows linking a span on one thread to a span on another (e.g. a frame sent by the
+///   emulation thread to the decode thread). A flow is identified by its name + id.
+///
+/// Event and thread names must be string literals (only the pointers are stored).
+///
+/// Spans are only written when they end, as a single "complete" event - a ring that wraps can
+/// drop old spans, but never leaves a begin event without its end. Flow ids must be unique per
+/// flow name (see NewFlowId).
+///
+/// Scopes that are also frame profiler sections use PROFILER_SCOPE (FrameProfiler.h), which feeds
+/// both. NEXEN_NO_THREAD_TRACE compiles the probes out.
+/// </remarks>
+class ThreadTrace {
+public:
+	static constexpr uint32_t RingSize = 0x10000;
+
+	enum class EventType : uint8_t {
+		Span,
+		FlowStart,
+		FlowEnd
+	};
+
+private:
+	struct Event {
+		atomic<uint64_t> Timestamp;
+		atomic<uint64_t> DurationOrId;
+		atomic<const char*> Name;
+		atomic<EventType> Type;
+	};
+
+	struct ThreadBuffer {
+		uint32_t ThreadId = 0;
+		atomic<const char*> ThreadName = nullptr;
+		atomic<bool> Active = true;
+		atomic<uint64_t> WriteIndex = 0;
+		unique_ptr<Event[]> Events = std::make_unique<Event[]>(RingSize);
+	};
+
+	struct ThreadBufferHandle {
+		shared_ptr<ThreadBuffer> Buffer;
+		const char* Name = nullptr;
+		~ThreadBufferHandle();
+	};
+
+	struct Registry;
+
+	static atomic<bool> _enabled;
+	static atomic<uint64_t> _startTime;
+	static atomic<uint64_t> _nextFlowId;
+	static thread_local ThreadBufferHandle _thread;
+
+	static Registry& GetRegistry();
+	static ThreadBuffer* GetThreadBuffer();
+	static void Record(EventType type, const char* name, uint64_t timestamp, uint64_t durationOrId);
+
+public:
+	[[nodiscard]] static uint64_t GetTimestamp() {
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	[[nodiscard]] static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+	/// <summary>Start (discarding the previous events) or stop recording</summary>
+	static void SetEnabled(bool enabled);
+
+	/// <summary>Name the current thread in the trace (can be called before recording starts)</summary>
+	static void SetThreadName(const char* name);
+
+	/// <summary>Get an id for a flow that has no natural id (such as a frame number)</summary>
+	[[nodiscard]] static uint64_t NewFlowId() { return _nextFlowId.fetch_add(1, std::memory_order_relaxed); }
+
+	static void AddSpan(const char* name, uint64_t start, uint64_t end) {
+		if (IsEnabled()) {
+			Record(EventType::Span, name, start, end - start);
+		}
+	}
+
+	static void FlowStart(const char* name, uint64_t id) {
+		if (IsEnabled()) {
+			Record(EventType::FlowStart, name, GetTimestamp(), id);
+		}
+	}
+
+	static void FlowEnd(const char* name, uint64_t id) {
+		if (IsEnabled()) {
+			Record(EventType::FlowEnd, name, GetTimestamp(), id);
+		}
+	}
+
+	/// <summary>Get the events recorded since recording started, as Chrome trace JSON</summary>
+	[[nodiscard]] static string GetChromeTrace();
+
+	/// <summary>Save the events recorded since recording started to a Chrome trace JSON file</summary>
+	[[nodiscard]] static bool SaveChromeTrace(const string& filename);
+};
+
+/// <summary>
+/// Records its scope as a span on the current thread (if the trace is enabled when it starts).
+/// </summary>
+class ThreadTraceScope {
+private:
+	const char* _name;
+	uint64_t _start = 0;
+
+public:
+	ThreadTraceScope(const char* name) : _name(name) {
+		if (ThreadTrace::IsEnabled()) {
+			_start = ThreadTrace::GetTimestamp();
+		}
+	}
+
+	~ThreadTraceScope() {
+		if (_start) {
+			ThreadTrace::AddSpan(_name, _start, ThreadTrace::GetTimestamp());
+		}
+	}
+
+	ThreadTraceScope(const ThreadTraceScope&) = delete;
+	ThreadTraceScope& operator=(const ThreadTraceScope&) = delete;
+};
+
+#ifndef NEXEN_NO_THREAD_TRACE
+#define THREAD_TRACE_SCOPE(name) ThreadTraceScope _threadTraceScope(name)
+#define THREAD_TRACE_FLOW_START(name, id) ThreadTrace::FlowStart(name, id)
+#define THREAD_TRACE_FLOW_END(name, id) ThreadTrace::FlowEnd(name, id)
+#define THREAD_TRACE_NAME(name) ThreadTrace::SetThreadName(name)
+#else
+#define THREAD_TRACE_SCOPE(name)
+#define THREAD_TRACE_FLOW_START(name, id)
+#define THREAD_TRACE_FLOW_END(name, id)
+#define THREAD_TRACE_NAME(name)
+#endif
@@ -1,10 +1,9 @@
 #include "pch.h"
 #include "AviRecorder.h"
+#include "Utilities/ThreadTrace.h"
 
 AviRecorder::AviRecorder(VideoCodec codec, uint32_t compressionLevel) {
 	_recording = false;
-	_stopFlag = false;
-	_framePending = false;
 	_frameBufferLength = 0;
 	_sampleRate = 0;
 	_codec = codec;
@@ -15,8 +14,6 @@ AviRecorder::~AviRecorder() {
 	if (_recording) {
 		StopRecording();
 	}
-
-	_frameBuffer.reset();
 }
 
 bool AviRecorder::Init(const string& filename) {
@@ -37,7 +34,6 @@ bool AviRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 		_height = height;
 		_fps = fps;
 		_frameBufferLength = height * width * bpp;
-		_frameBuffer = std::make_unique<uint8_t[]>(_frameBufferLength);
 
 		_aviWriter = std::make_unique<AviWriter>();
 		if (!_aviWriter->StartWrite(_outputFile, _codec, width, height, bpp, (uint32_t)(_fps * 1000000), audioSampleRate, _compressionLevel)) {
@@ -45,17 +41,9 @@ bool AviRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 			return false;
 		}
 
-		_aviWriterThread = std::thread([this]() {
-			while (!_stopFlag) {
-				_waitFrame.Wait();
-				if (_stopFlag) {
-					break;
-				}
-
-				auto lock = _lock.AcquireSafe();
-				_aviWriter->AddFrame(_frameBuffer.get());
-				_framePending = false;
-			}
+		_frameQueue.Start(_frameBufferLength, "AVI Writer", [this](uint8_t* frameBuffer) {
+			THREAD_TRACE_SCOPE("AviWriter::AddFrame");
+			_aviWriter->AddFrame(frameBuffer);
 		});
 
 		_recording = true;
@@ -67,9 +55,7 @@ void AviRecorder::StopRecording() {
 	if (_recording) {
 		_recording = false;
 
-		_stopFlag = true;
-		_waitFrame.Signal();
-		_aviWriterThread.join();
+		_frameQueue.Stop();
 
 		_aviWriter->EndWrite();
 		_aviWriter.reset();
@@ -81,15 +67,8 @@ bool AviRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 		if (_width != width || _height != height || _fps != fps) {
 			return false;
 		} else {
-			while (_framePending) {
-				// Previous frame isn't done processing yet, wait
-				std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
-			}
-
-			auto lock = _lock.AcquireSafe();
-			_framePending = true;
-			memcpy(_frameBuffer.get(), frameBuffer, _frameBufferLength);
-			_waitFrame.Signal();
+			THREAD_TRACE_SCOPE("AviRecorder::AddFrame");
+			_frameQueue.AddFrame(frameBuffer);
 		}
 	}
 	return true;
@@ -1,10 +1,8 @@
 #pragma once
 #include "pch.h"
-#include <thread>
-#include "Utilities/AutoResetEvent.h"
-#include "Utilities/SimpleLock.h"
 #include "Utilities/Video/AviWriter.h"
 #include "Utilities/Video/IVideoRecorder.h"
+#include "Utilities/Video/VideoFrameQueue.h"
 
 /// <summary>
 /// AVI video recorder with threaded encoding and multiple codec support.
@@ -13,13 +11,15 @@
 /// <remarks>
 /// Features:
 /// - Threaded encoding (AviWriter runs on separate thread)
+/// - Bounded frame queue (absorbs encoding spikes, e.g. ZMBV keyframes)
 /// - Multiple codec support (Raw, Camstudio, ZMBV)
 /// - Audio/video synchronization
 /// - Configurable compression levels
 ///
-/// Threading model:
-/// - AddFrame() buffers frame and signals AviWriter thread
-/// - AviWriter thread encodes and writes to disk
+/// Threading model (see VideoFrameQueue):
+/// - AddFrame() queues a copy of the frame
+///   (only blocks when VideoFrameQueue::MaxQueuedFrames frames are already waiting)
+/// - AviWriter thread encodes the queued frames in order and writes them to disk
 /// - AddSound() writes audio samples directly
 ///
 /// Supported codecs (VideoCodec enum):
@@ -38,21 +38,15 @@
 /// </remarks>
 class AviRecorder final : public IVideoRecorder {
 private:
-	std::thread _aviWriterThread; ///< Background encoding thread
-
 	unique_ptr<AviWriter> _aviWriter; ///< AVI file writer
 
-	string _outputFile;        ///< Output file path
-	SimpleLock _lock;          ///< Thread synchronization lock
-	AutoResetEvent _waitFrame; ///< Frame ready signal
+	string _outputFile; ///< Output file path
 
-	atomic<bool> _stopFlag;     ///< Stop signal for thread
-	atomic<bool> _framePending; ///< Frame waiting for encoding
+	VideoFrameQueue _frameQueue; ///< Frames waiting for encoding (AviWriter thread)
 
-	bool _recording;                         ///< Recording active flag
-	std::unique_ptr<uint8_t[]> _frameBuffer; ///< Frame data buffer
-	uint32_t _frameBufferLength;             ///< Frame buffer size in bytes
-	uint32_t _sampleRate;                    ///< Audio sample rate
+	bool _recording;             ///< Recording active flag
+	uint32_t _frameBufferLength; ///< Frame buffer size in bytes
+	uint32_t _sampleRate;        ///< Audio sample rate
 
 	double _fps;      ///< Frames per second
 	uint32_t _width;  ///< Video width
@@ -84,7 +78,7 @@ public:
 	/// <summary>
 	/// Add video frame (buffered, signals encoding thread).
 	/// </summary>
-	/// <remarks>Copies frame to internal buffer, signals AviWriter thread for encoding.</remarks>
+	/// <remarks>Copies the frame and queues it for the AviWriter thread (waits if the queue is full).</remarks>
 	bool AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps) override;
 
 	/// <summary>Add audio samples (written immediately)</summary>
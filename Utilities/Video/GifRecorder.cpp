@@ -27,15 +27,29 @@ bool GifRecorder::StartRecording(uint32_t width, uint32_t height, [[maybe_unused
 
 	_recording = GifBegin(_gif.get(), _outputFile.c_str(), width, height, 2, 8, false);
 	_frameCounter = 0;
+	if (_recording) {
+		_frameQueue.Start(width * height * 4, "GIF Writer", [this](uint8_t* frameBuffer) { WriteFrame(frameBuffer); });
+	}
 	return _recording;
 }
 
 void GifRecorder::StopRecording() {
 	if (_recording) {
+		_recording = false;
+
+		_frameQueue.Stop();
+
 		GifEnd(_gif.get());
 	}
 }
 
+void GifRecorder::WriteFrame(uint8_t* frameBuffer) {
+	// Console frames rarely have more than 255 colors, quantization is only needed for the others
+	if (!GifWriteFrameExact(_gif.get(), frameBuffer, _width, _height, 2)) {
+		GifWriteFrame(_gif.get(), frameBuffer, _width, _height, 2, 8, false);
+	}
+}
+
 bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps) {
 	if (_width != width || _height != height || _fps != fps) {
 		return false;
@@ -43,9 +57,9 @@ bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 
 	_frameCounter++;
 
-	if (fps < 55 || (_frameCounter % 6) != 0) {
+	if (_recording && (fps < 55 || (_frameCounter % 6) != 0)) {
 		// At 60 FPS, skip 1 of every 6 frames (max FPS for GIFs is 50fps)
-		GifWriteFrame(_gif.get(), (uint8_t*)frameBuffer, width, height, 2, 8, false);
+		_frameQueue.AddFrame(frameBuffer);
 	}
 
 	return true;
@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include "Utilities/Video/IVideoRecorder.h"
+#include "Utilities/Video/VideoFrameQueue.h"
 
 struct GifWriter;
 
@@ -14,9 +15,11 @@ struct GifWriter;
 /// - Lossless compression
 /// - Widely compatible format
 /// - Smaller file size than uncompressed video
+/// - Only the rectangle around the pixels that changed is written for each frame
 ///
 /// Limitations:
-/// - 256 color palette limit (quantized from true color)
+/// - 256 color palette limit - frames whose changed pixels use more colors are quantized
+///   (console games rarely need it, so most frames are written with an exact palette)
 /// - No audio support (AddSound() is no-op)
 /// - Larger than video codecs for long recordings
 ///
@@ -35,11 +38,18 @@ struct GifWriter;
 /// </code>
 ///
 /// Frame delay calculated from FPS for smooth playback.
+///
+/// Threading model (see VideoFrameQueue, same as AviRecorder):
+/// - AddFrame() queues a copy of the frame
+///   (only blocks when VideoFrameQueue::MaxQueuedFrames frames are already waiting)
+/// - The writer thread encodes the queued frames in order
 /// </remarks>
 class GifRecorder final : public IVideoRecorder {
 private:
 	std::unique_ptr<GifWriter> _gif; ///< GIF writer instance
 	bool _recording = false;         ///< Recording active flag
+	VideoFrameQueue _frameQueue;     ///< Frames waiting for encoding (writer thread)
+
 	uint32_t _frameCounter = 0;      ///< Frame count
 	string _outputFile;              ///< Output file path
 	uint32_t _width = 0;             ///< GIF width
@@ -67,7 +77,7 @@ public:
 	/// Add video frame to GIF.
 	/// </summary>
 	/// <remarks>
-	/// Frame data is quantized to 256 colors using palette generation.
+	/// Copies the frame and queues it for the writer thread.
 	/// Frame delay calculated from FPS for accurate timing.
 	/// </remarks>
 	bool AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps) override;
@@ -83,4 +93,7 @@ public:
 
 	/// <summary>Get output file path</summary>
 	string GetOutputFile() override;
+
+private:
+	void WriteFrame(uint8_t* frameBuffer);
 };
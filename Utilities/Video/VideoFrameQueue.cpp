@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "Utilities/Video/VideoFrameQueue.h"
+#include "Utilities/ThreadTrace.h"
+
+VideoFrameQueue::~VideoFrameQueue() {
+	Stop();
+}
+
+void VideoFrameQueue::Start(uint32_t frameSize, const char* threadName, WriteFrameCallback writeFrame) {
+	Stop();
+
+	_frameSize = frameSize;
+	_threadName = threadName;
+	_writeFrame = std::move(writeFrame);
+	_stopFlag = false;
+	_frameQueue.clear();
+	_freeFrameBuffers.clear();
+	_traceFlowBase = ThreadTrace::NewFlowId() << 32;
+	_queuedFrames = 0;
+	_writtenFrames = 0;
+
+	_writerThread = std::thread([this]() { WriterThread(); });
+	_running = true;
+}
+
+void VideoFrameQueue::Stop() {
+	if (_running) {
+		_running = false;
+
+		{
+			std::lock_guard<std::mutex> lock(_queueMutex);
+			_stopFlag = true;
+		}
+		_frameQueued.notify_one();
+		_writerThread.join();
+	}
+}
+
+void VideoFrameQueue::WriterThread() {
+	THREAD_TRACE_NAME(_threadName);
+	while (true) {
+		std::unique_ptr<uint8_t[]> frame;
+		{
+			std::unique_lock<std::mutex> lock(_queueMutex);
+			_frameQueued.wait(lock, [this] { return _stopFlag || !_frameQueue.empty(); });
+			if (_frameQueue.empty()) {
+				// Stop requested, all queued frames are written
+				break;
+			}
+			frame = std::move(_frameQueue.front());
+			_frameQueue.pop_front();
+		}
+
+		THREAD_TRACE_FLOW_END("VideoFrame", _traceFlowBase + _writtenFrames++);
+		_writeFrame(frame.get());
+
+		{
+			std::lock_guard<std::mutex> lock(_queueMutex);
+			_freeFrameBuffers.push_back(std::move(frame));
+		}
+		_frameDone.notify_one();
+	}
+}
+
+void VideoFrameQueue::AddFrame(const void* frameBuffer) {
+	std::unique_ptr<uint8_t[]> frame;
+	{
+		// Only wait when the writer is MaxQueuedFrames frames behind
+		std::unique_lock<std::mutex> lock(_queueMutex);
+		_frameDone.wait(lock, [this] { return _frameQueue.size() < MaxQueuedFrames; });
+		if (!_freeFrameBuffers.empty()) {
+			frame = std::move(_freeFrameBuffers.back());
+			_freeFrameBuffers.pop_back();
+		}
+	}
+
+	if (!frame) {
+		frame = std::make_unique<uint8_t[]>(_frameSize);
+	}
+	memcpy(frame.get(), frameBuffer, _frameSize);
+
+	THREAD_TRACE_FLOW_START("VideoFrame", _traceFlowBase + _queuedFrames++);
+	{
+		std::lock_guard<std::mutex> lock(_queueMutex);
+		_frameQueue.push_back(std::move(frame));
+	}
+	_frameQueued.notify_one();
+}
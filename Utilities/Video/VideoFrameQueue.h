@@ -0,0 +1,64 @@
+#pragma once
+#include "pch.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// Bounded queue of video frames, written in order by a background thread.
+/// Used by the video recorders (AviRecorder, GifRecorder) to keep encoding off the emulation thread.
+/// </summary>
+/// <remarks>
+/// Threading model:
+/// - AddFrame() copies the frame into a buffer from the pool and queues it
+///   (only blocks when MaxQueuedFrames frames are already waiting)
+/// - The writer thread passes the queued frames to the write callback in order
+///   and returns their buffers to the pool
+/// - Stop() lets the writer thread write the frames that are still queued, then joins it
+/// </remarks>
+class VideoFrameQueue {
+public:
+	/// <summary>Max frames waiting for the writer before AddFrame blocks (~130ms at 60 FPS)</summary>
+	static constexpr size_t MaxQueuedFrames = 8;
+
+	/// <summary>Writes a frame (called on the writer thread, with the frame's pooled buffer)</summary>
+	using WriteFrameCallback = std::function<void(uint8_t* frameBuffer)>;
+
+private:
+	std::thread _writerThread;       ///< Background writer thread
+	WriteFrameCallback _writeFrame;  ///< Writes a frame (writer thread)
+	const char* _threadName = "";    ///< Writer thread name
+	uint32_t _frameSize = 0;         ///< Frame buffer size in bytes
+	bool _running = false;           ///< Writer thread started
+
+	std::mutex _queueMutex;                                ///< Protects the frame queue/pool
+	std::condition_variable _frameQueued;                  ///< Signaled when a frame is queued (or on stop)
+	std::condition_variable _frameDone;                    ///< Signaled when a queued frame is written
+	std::deque<std::unique_ptr<uint8_t[]>> _frameQueue;    ///< Frames waiting for the writer (oldest first)
+	vector<std::unique_ptr<uint8_t[]>> _freeFrameBuffers; ///< Recycled frame buffers
+	bool _stopFlag = false;                                ///< Stop signal for the writer thread
+
+	uint64_t _traceFlowBase = 0; ///< Thread trace flow id of the first frame
+	uint64_t _queuedFrames = 0;  ///< Frames queued since Start
+	uint64_t _writtenFrames = 0; ///< Frames written since Start (writer thread)
+
+	void WriterThread();
+
+public:
+	/// <summary>Destructor - stops the writer thread (after writing the queued frames)</summary>
+	~VideoFrameQueue();
+
+	/// <summary>Starts the writer thread.</summary>
+	/// <param name="frameSize">Size of each frame, in bytes</param>
+	/// <param name="threadName">Writer thread name (must outlive the queue, e.g. a string literal)</param>
+	/// <param name="writeFrame">Writes a frame, called in order on the writer thread</param>
+	void Start(uint32_t frameSize, const char* threadName, WriteFrameCallback writeFrame);
+
+	/// <summary>Writes the frames that are still queued, then stops the writer thread</summary>
+	void Stop();
+
+	/// <summary>Copies the frame (frameSize bytes) and queues it for the writer thread</summary>
+	void AddFrame(const void* frameBuffer);
+};
@@ -97,8 +97,9 @@ bool ZmbvCodec::SetupBuffers(zmbv_format_t _format, int blockwidth, int blockhei
 		yblocks++;
 	blockcount = yblocks * xblocks;
 	blocks = std::make_unique<FrameBlock[]>(blockcount);
+	blockMatches = std::make_unique<BlockMatch[]>(blockcount);
 
-	if (!buf1 || !buf2 || !work || !blocks) {
+	if (!buf1 || !buf2 || !work || !blocks || !blockMatches) {
 		FreeBuffers();
 		return false;
 	}
@@ -201,11 +202,9 @@ INLINE void ZmbvCodec::AddXorBlock(int vx, int vy, FrameBlock* block) {
 }
 
 template <class P>
-void ZmbvCodec::AddXorFrame(void) {
-	signed char* vectors = (signed char*)(work.get() + workUsed);
-	/* Align the following xor data on 4 byte boundary*/
-	workUsed = (workUsed + blockcount * 2 + 3) & ~3;
-	for (int b = 0; b < blockcount; b++) {
+void ZmbvCodec::FindBlockMatches(int firstBlock, int lastBlock) {
+	// Only reads oldframe/newframe and writes to its own blocks' matches - safe to run on several threads
+	for (int b = firstBlock; b < lastBlock; b++) {
 		FrameBlock* block = &blocks[b];
 		int bestvx = 0;
 		int bestvy = 0;
@@ -226,11 +225,104 @@ void ZmbvCodec::AddXorFrame(void) {
 				}
 			}
 		}
-		vectors[b * 2 + 0] = (bestvx << 1);
-		vectors[b * 2 + 1] = (bestvy << 1);
-		if (bestchange) {
+		blockMatches[b].vx = bestvx;
+		blockMatches[b].vy = bestvy;
+		blockMatches[b].changed = bestchange != 0;
+	}
+}
+
+void ZmbvCodec::SearchBlockRange(uint32_t threadIndex) {
+	int firstBlock = (int)((int64_t)blockcount * threadIndex / _searchThreadCount);
+	int lastBlock = (int)((int64_t)blockcount * (threadIndex + 1) / _searchThreadCount);
+	switch (format) {
+		case ZMBV_FORMAT_8BPP:
+			FindBlockMatches<int8_t>(firstBlock, lastBlock);
+			break;
+		case ZMBV_FORMAT_15BPP:
+		case ZMBV_FORMAT_16BPP:
+			FindBlockMatches<int16_t>(firstBlock, lastBlock);
+			break;
+
+		default:
+		case ZMBV_FORMAT_32BPP:
+			FindBlockMatches<int32_t>(firstBlock, lastBlock);
+			break;
+	}
+}
+
+void ZmbvCodec::SearchAllBlocks() {
+	if (_searchWorkers.empty()) {
+		SearchBlockRange(0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_searchMutex);
+		_searchPending = (uint32_t)_searchWorkers.size();
+		_searchGeneration++;
+	}
+	_searchStart.notify_all();
+
+	SearchBlockRange(0);
+
+	std::unique_lock<std::mutex> lock(_searchMutex);
+	_searchDone.wait(lock, [this] { return _searchPending == 0; });
+}
+
+void ZmbvCodec::RunSearchWorker(uint32_t threadIndex, uint32_t generation) {
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_searchMutex);
+			_searchStart.wait(lock, [&] { return _stopSearch || _searchGeneration != generation; });
+			if (_stopSearch) {
+				return;
+			}
+			generation = _searchGeneration;
+		}
+
+		SearchBlockRange(threadIndex);
+
+		bool done;
+		{
+			std::lock_guard<std::mutex> lock(_searchMutex);
+			done = --_searchPending == 0;
+		}
+		if (done) {
+			_searchDone.notify_one();
+		}
+	}
+}
+
+void ZmbvCodec::StopSearchWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(_searchMutex);
+		_stopSearch = true;
+	}
+	_searchStart.notify_all();
+	for (std::thread& worker : _searchWorkers) {
+		worker.join();
+	}
+	_searchWorkers.clear();
+	_stopSearch = false;
+}
+
+template <class P>
+void ZmbvCodec::AddXorFrame(void) {
+	signed char* vectors = (signed char*)(work.get() + workUsed);
+	/* Align the following xor data on 4 byte boundary*/
+	workUsed = (workUsed + blockcount * 2 + 3) & ~3;
+
+	/* Find the best motion vector for each block (on all search threads) */
+	SearchAllBlocks();
+
+	/* Write the vectors and xor data in block order */
+	for (int b = 0; b < blockcount; b++) {
+		BlockMatch& match = blockMatches[b];
+		vectors[b * 2 + 0] = (match.vx << 1);
+		vectors[b * 2 + 1] = (match.vy << 1);
+		if (match.changed) {
 			vectors[b * 2 + 0] |= 1;
-			AddXorBlock<P>(bestvx, bestvy, block);
+			AddXorBlock<P>(match.vx, match.vy, &blocks[b]);
 		}
 	}
 }
@@ -243,6 +335,22 @@ bool ZmbvCodec::SetupCompress(int _width, int _height, uint32_t compressionLevel
 	if (deflateInit(&zstream, compressionLevel) != Z_OK)
 		return false;
 
+	// Each thread needs enough blocks to be worth waking up (~1 row of 16x16 blocks at 256px wide)
+	uint32_t blockCount = ((_width + 15) / 16) * ((_height + 15) / 16);
+	uint32_t threadCount = std::clamp<uint32_t>(_maxSearchThreads, 1, std::max<uint32_t>(blockCount / 16, 1));
+	StopSearchWorkers();
+	_searchThreadCount = threadCount;
+
+	// Workers wait for the next search - the generation keeps counting up when the workers are restarted
+	uint32_t generation;
+	{
+		std::lock_guard<std::mutex> lock(_searchMutex);
+		generation = _searchGeneration;
+	}
+	for (uint32_t i = 1; i < threadCount; i++) {
+		_searchWorkers.emplace_back([this, i, generation]() { RunSearchWorker(i, generation); });
+	}
+
 	return true;
 }
 
@@ -369,15 +477,22 @@ int ZmbvCodec::FinishCompressFrame(uint8_t** compressedData) {
 
 void ZmbvCodec::FreeBuffers() {
 	blocks.reset();
+	blockMatches.reset();
 	buf1.reset();
 	buf2.reset();
 	work.reset();
 	_buf.reset();
 }
 
-ZmbvCodec::ZmbvCodec() {
+ZmbvCodec::ZmbvCodec(uint32_t searchThreadCount) {
 	CreateVectorTable();
 	memset(&zstream, 0, sizeof(zstream));
+	_maxSearchThreads = searchThreadCount ? searchThreadCount : std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+}
+
+ZmbvCodec::~ZmbvCodec() {
+	StopSearchWorkers();
+	deflateEnd(&zstream);
 }
 
 int ZmbvCodec::CompressFrame(bool isKeyFrame, uint8_t* frameData, uint8_t** compressedData) {
@@ -22,6 +22,9 @@
 #pragma once
 
 #include "BaseCodec.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <miniz/miniz.h>
 
 #ifdef _MSC_VER
@@ -48,6 +51,11 @@ private:
 		int start = 0;
 		int dx = 0, dy = 0;
 	};
+	/// <summary>Motion search result for a block (see FindBlockMatches)</summary>
+	struct BlockMatch {
+		int vx = 0, vy = 0;
+		bool changed = false;
+	};
 	struct CodecVector {
 		int x = 0, y = 0;
 		int slot = 0;
@@ -76,6 +84,7 @@ private:
 
 	int blockcount = 0;
 	std::unique_ptr<FrameBlock[]> blocks;
+	std::unique_ptr<BlockMatch[]> blockMatches;
 
 	int workUsed = 0, workPos = 0;
 
@@ -90,11 +99,29 @@ private:
 
 	z_stream zstream = {};
 
+	// Motion search workers - each thread searches a range of blocks (the main thread takes the first one)
+	uint32_t _maxSearchThreads = 1;
+	uint32_t _searchThreadCount = 1;
+	vector<std::thread> _searchWorkers;
+	std::mutex _searchMutex;
+	std::condition_variable _searchStart;
+	std::condition_variable _searchDone;
+	uint32_t _searchGeneration = 0;
+	uint32_t _searchPending = 0;
+	bool _stopSearch = false;
+
 	// methods
 	void FreeBuffers(void);
 	void CreateVectorTable(void);
 	bool SetupBuffers(zmbv_format_t format, int blockwidth, int blockheight);
 
+	template <class P>
+	void FindBlockMatches(int firstBlock, int lastBlock);
+	void SearchBlockRange(uint32_t threadIndex);
+	void SearchAllBlocks();
+	void RunSearchWorker(uint32_t threadIndex, uint32_t generation);
+	void StopSearchWorkers();
+
 	template <class P>
 	void AddXorFrame(void);
 	template <class P>
@@ -111,7 +138,12 @@ private:
 	int FinishCompressFrame(uint8_t** compressedData);
 
 public:
-	ZmbvCodec();
+	/// <summary>
+	/// Create the codec.
+	/// </summary>
+	/// <param name="searchThreadCount">Threads used for the motion search (0 = based on the CPU's core count)</param>
+	ZmbvCodec(uint32_t searchThreadCount = 0);
+	~ZmbvCodec();
 	bool SetupCompress(int _width, int _height, uint32_t compressionLevel) override;
 	int CompressFrame(bool isKeyFrame, uint8_t* frameData, uint8_t** compressedData) override;
 	const char* GetFourCC() override;
@@ -770,6 +770,106 @@ bool GifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint
 	return true;
 }
 
+// Writes out a new frame without quantization, when the pixels that changed since the previous
+// frame use 255 colors or less (the usual case for console games).
+// Only the rectangle around the changed pixels is written, with an exact palette built from
+// their colors - unchanged pixels inside it are transparent.
+// Returns false (and writes nothing) if there are too many colors - use GifWriteFrame instead.
+bool GifWriteFrameExact(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay) {
+	if (!writer->f)
+		return false;
+
+	const bool firstFrame = writer->firstFrame;
+	uint8_t* oldImage = writer->oldImage;
+	auto isChanged = [&](uint32_t pixel) {
+		const uint8_t* newPixel = image + pixel * 4;
+		const uint8_t* oldPixel = oldImage + pixel * 4;
+		return firstFrame || newPixel[0] != oldPixel[0] || newPixel[1] != oldPixel[1] || newPixel[2] != oldPixel[2];
+	};
+
+	// find the rectangle around the changed pixels
+	uint32_t left = width, right = 0, top = height, bottom = 0;
+	for (uint32_t yy = 0; yy < height; ++yy) {
+		for (uint32_t xx = 0; xx < width; ++xx) {
+			if (isChanged(yy * width + xx)) {
+				left = xx < left ? xx : left;
+				right = xx > right ? xx : right;
+				top = yy < top ? yy : top;
+				bottom = yy;
+			}
+		}
+	}
+	if (left > right) {
+		// nothing changed - write a single transparent pixel to keep the frame's delay
+		left = right = top = bottom = 0;
+	}
+	const uint32_t rectWidth = right - left + 1;
+	const uint32_t rectHeight = bottom - top + 1;
+
+	// exact palette: index 0 is transparent, colors are looked up in a small hash table
+	GifPalette pal;
+	int colorCount = 1;
+	const uint32_t kHashSize = 1024;
+	uint32_t hashKeys[kHashSize];
+	uint8_t hashIndexes[kHashSize];
+	memset(hashKeys, 0, sizeof(hashKeys));
+
+	uint8_t* rectImage = (uint8_t*)GIF_TEMP_MALLOC(rectWidth * rectHeight * 4);
+	for (uint32_t yy = 0; yy < rectHeight; ++yy) {
+		for (uint32_t xx = 0; xx < rectWidth; ++xx) {
+			uint32_t pixel = (top + yy) * width + left + xx;
+			uint8_t* out = rectImage + (yy * rectWidth + xx) * 4;
+			if (!isChanged(pixel)) {
+				out[3] = kGifTransIndex;
+				continue;
+			}
+
+			const uint8_t* color = image + pixel * 4;
+			uint32_t key = 0x80000000u | (color[0] << 16) | (color[1] << 8) | color[2];
+			uint32_t slot = (key * 2654435761u) >> 22;
+			while (hashKeys[slot] && hashKeys[slot] != key) {
+				slot = (slot + 1) & (kHashSize - 1);
+			}
+			if (!hashKeys[slot]) {
+				if (colorCount == 256) {
+					GIF_TEMP_FREE(rectImage);
+					return false;
+				}
+				hashKeys[slot] = key;
+				hashIndexes[slot] = (uint8_t)colorCount;
+				pal.r[colorCount] = color[0];
+				pal.g[colorCount] = color[1];
+				pal.b[colorCount] = color[2];
+				colorCount++;
+			}
+			out[3] = hashIndexes[slot];
+		}
+	}
+
+	pal.bitDepth = 2; // smallest LZW code size allowed by the format
+	while ((1 << pal.bitDepth) < colorCount)
+		pal.bitDepth++;
+	for (int ii = colorCount; ii < (1 << pal.bitDepth); ++ii)
+		pal.r[ii] = pal.g[ii] = pal.b[ii] = 0;
+
+	// the changed pixels are now displayed exactly
+	for (uint32_t yy = 0; yy < rectHeight; ++yy) {
+		for (uint32_t xx = 0; xx < rectWidth; ++xx) {
+			uint32_t pixel = (top + yy) * width + left + xx;
+			uint8_t index = rectImage[(yy * rectWidth + xx) * 4 + 3];
+			if (index != kGifTransIndex) {
+				memcpy(oldImage + pixel * 4, image + pixel * 4, 3);
+				oldImage[pixel * 4 + 3] = index;
+			}
+		}
+	}
+
+	writer->firstFrame = false;
+	GifWriteLzwImage(writer->f, rectImage, left, top, rectWidth, rectHeight, delay, &pal);
+	GIF_TEMP_FREE(rectImage);
+	return true;
+}
+
 // Writes the EOF code, closes the file handle, and frees temp memory used by a GIF.
 // Many if not most viewers will still display a GIF properly if the EOF code is missing,
 // but it's still a good idea to write it out.
@@ -219,6 +219,37 @@ void SHA1::update(std::istream& is) {
 	}
 }
 
+void SHA1::update(const uint8_t* data, size_t size) {
+	uint32_t block[BLOCK_INTS];
+
+	/* Complete the partial block from the previous update */
+	if (!buffer.empty()) {
+		size_t count = std::min(BLOCK_BYTES - buffer.size(), size);
+		buffer.append((const char*)data, count);
+		data += count;
+		size -= count;
+		if (buffer.size() != BLOCK_BYTES) {
+			return;
+		}
+
+		buffer_to_block(buffer, block);
+		transform(digest, block, transforms);
+		buffer.clear();
+	}
+
+	/* Full blocks are read directly from the data */
+	while (size >= BLOCK_BYTES) {
+		for (size_t i = 0; i < BLOCK_INTS; i++) {
+			block[i] = data[4 * i + 3] | data[4 * i + 2] << 8 | data[4 * i + 1] << 16 | (uint32_t)data[4 * i + 0] << 24;
+		}
+		transform(digest, block, transforms);
+		data += BLOCK_BYTES;
+		size -= BLOCK_BYTES;
+	}
+
+	buffer.append((const char*)data, size);
+}
+
 /*
  * Add padding and return the message digest.
  */
@@ -263,20 +294,12 @@ std::string SHA1::final() {
 }
 
 std::string SHA1::GetHash(vector<uint8_t>& data) {
-	std::stringstream ss;
-	ss.write((char*)data.data(), data.size());
-
-	SHA1 checksum;
-	checksum.update(ss);
-	return checksum.final();
+	return GetHash(data.data(), data.size());
 }
 
 std::string SHA1::GetHash(uint8_t* data, size_t size) {
-	std::stringstream ss;
-	ss.write((char*)data, size);
-
 	SHA1 checksum;
-	checksum.update(ss);
+	checksum.update(data, size);
 	return checksum.final();
 }
 